@@ -139,7 +139,7 @@ function hostNinja() {
   if [[ $SKIP_NINJA == 0 ]]; then
     TARGETS="chromium-efl efl_webprocess chromium-ewk efl_webview_app"
     if [[ $BUILD_EWK_UNITTESTS == 1 ]]; then
-      TARGETS="$TARGETS ewk_unittests"
+      TARGETS="$TARGETS ewk_unittests ewk_perftests"
     fi
     if [[ $BUILD_CONTENT_SHELL == 1 ]]; then
       TARGETS="$TARGETS content_shell_efl"
@@ -74,6 +74,22 @@ Ewk_Cache_Model from(tw::Cache_Model val)
   GLUE_CAST_END()
 }
 
+tw::Memory_Pressure_Level to(Ewk_Memory_Pressure_Level val)
+{
+  GLUE_CAST_START(val)
+    GLUE_CAST_TO (EWK_MEMORY_PRESSURE_LEVEL_MODERATE, TW_MEMORY_PRESSURE_LEVEL_MODERATE)
+    GLUE_CAST_TO (EWK_MEMORY_PRESSURE_LEVEL_CRITICAL, TW_MEMORY_PRESSURE_LEVEL_CRITICAL)
+  GLUE_CAST_END()
+}
+
+Ewk_Memory_Pressure_Level from(tw::Memory_Pressure_Level val)
+{
+  GLUE_CAST_START(val)
+    GLUE_CAST_FROM(EWK_MEMORY_PRESSURE_LEVEL_MODERATE, TW_MEMORY_PRESSURE_LEVEL_MODERATE)
+    GLUE_CAST_FROM(EWK_MEMORY_PRESSURE_LEVEL_CRITICAL, TW_MEMORY_PRESSURE_LEVEL_CRITICAL)
+  GLUE_CAST_END()
+}
+
 tw::Cookie_Accept_Policy to(Ewk_Cookie_Accept_Policy val)
 {
   GLUE_CAST_START(val)
@@ -159,6 +175,35 @@ tw::View_Hit_Test_Request_Callback to(Ewk_View_Hit_Test_Request_Callback callbac
   return reinterpret_cast<tw::View_Hit_Test_Request_Callback>(callback);
 }
 
+tw::Pdf_Export_Status to(Ewk_Pdf_Export_Status val)
+{
+  GLUE_CAST_START(val)
+    GLUE_CAST_TO(EWK_PDF_EXPORT_SUCCEEDED, TW_PDF_EXPORT_SUCCEEDED)
+    GLUE_CAST_TO(EWK_PDF_EXPORT_FAILED, TW_PDF_EXPORT_FAILED)
+    GLUE_CAST_TO(EWK_PDF_EXPORT_CANCELLED, TW_PDF_EXPORT_CANCELLED)
+  GLUE_CAST_END()
+}
+
+Ewk_Pdf_Export_Status from(tw::Pdf_Export_Status val)
+{
+  GLUE_CAST_START(val)
+    GLUE_CAST_FROM(EWK_PDF_EXPORT_SUCCEEDED, TW_PDF_EXPORT_SUCCEEDED)
+    GLUE_CAST_FROM(EWK_PDF_EXPORT_FAILED, TW_PDF_EXPORT_FAILED)
+    GLUE_CAST_FROM(EWK_PDF_EXPORT_CANCELLED, TW_PDF_EXPORT_CANCELLED)
+  GLUE_CAST_END()
+}
+
+tw::View_Pdf_Export_Progress_Callback to(Ewk_View_Pdf_Export_Progress_Callback callback)
+{
+  return reinterpret_cast<tw::View_Pdf_Export_Progress_Callback>(callback);
+}
+
+// Ewk_Pdf_Export_Status and tw::Pdf_Export_Status share their values.
+tw::View_Pdf_Export_Finished_Callback to(Ewk_View_Pdf_Export_Finished_Callback callback)
+{
+  return reinterpret_cast<tw::View_Pdf_Export_Finished_Callback>(callback);
+}
+
 tw::Policy_Decision_Type to(Ewk_Policy_Decision_Type val)
 {
   GLUE_CAST_START(val)
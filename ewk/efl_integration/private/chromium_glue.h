@@ -23,6 +23,8 @@
 #include <tizen_webview/public/tw_content_security_policy.h>
 #include <tizen_webview/public/tw_cookie_accept_policy.h>
 #include <tizen_webview/public/tw_legacy_font_size_mode.h>
+#include <tizen_webview/public/tw_memory_pressure_level.h>
+#include <tizen_webview/public/tw_pdf_export_status.h>
 #include <tizen_webview/public/tw_hit_test.h>
 #include <tizen_webview/public/tw_policy_decision.h>
 #include <tizen_webview/public/tw_touch_event.h>
@@ -38,6 +40,9 @@ namespace tw = tizen_webview;
 tw::Cache_Model to  (Ewk_Cache_Model);
 Ewk_Cache_Model from(tw::Cache_Model);
 
+tw::Memory_Pressure_Level to  (Ewk_Memory_Pressure_Level);
+Ewk_Memory_Pressure_Level from(tw::Memory_Pressure_Level);
+
 tw::Cookie_Accept_Policy to  (Ewk_Cookie_Accept_Policy);
 Ewk_Cookie_Accept_Policy from(tw::Cookie_Accept_Policy);
 
@@ -53,6 +58,12 @@ Ewk_Hit_Test_Result_Context from(tw::Hit_Test_Result_Context);
 
 tw::View_Hit_Test_Request_Callback to(Ewk_View_Hit_Test_Request_Callback);
 
+tw::Pdf_Export_Status to(Ewk_Pdf_Export_Status);
+Ewk_Pdf_Export_Status from(tw::Pdf_Export_Status);
+
+tw::View_Pdf_Export_Progress_Callback to(Ewk_View_Pdf_Export_Progress_Callback);
+tw::View_Pdf_Export_Finished_Callback to(Ewk_View_Pdf_Export_Finished_Callback);
+
 tw::Policy_Decision_Type to(Ewk_Policy_Decision_Type);
 Ewk_Policy_Decision_Type from(tw::Policy_Decision_Type);
 
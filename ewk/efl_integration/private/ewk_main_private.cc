@@ -4,6 +4,7 @@
 
 #include "ewk_main_private.h"
 #include "webview_delegate_ewk.h"
+#include "browser/ipc_message_counter_efl.h"
 
 std::string g_homeDirectory;
 
@@ -20,3 +21,8 @@ const char* ewk_home_directory_get()
 
   return home;
 }
+
+unsigned ewk_ipc_message_received_count_get()
+{
+  return IPCMessageCounterEfl::GetReceivedCount();
+}
@@ -19,5 +19,15 @@
  */
 EAPI const char* ewk_home_directory_get();
 
+/**
+ * Returns the number of IPC messages all renderers sent to the browser.
+ *
+ * Only counted when the engine was started with --count-ipc-messages,
+ * which benchmarks pass through ewk_set_arguments().
+ *
+ * @return number of messages received since startup
+ */
+EAPI unsigned ewk_ipc_message_received_count_get();
+
 #endif // ewk_main_private_h
 
@@ -93,6 +93,13 @@ Eina_Bool ewk_context_notify_low_memory(Ewk_Context* context)
   return true;
 }
 
+Eina_Bool ewk_context_notify_memory_pressure(Ewk_Context* context, Ewk_Memory_Pressure_Level level)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, false);
+  context->NotifyMemoryPressure(chromium_glue::to(level));
+  return true;
+}
+
 Eina_Bool ewk_context_origins_free(Eina_List* origins)
 {
   EINA_SAFETY_ON_NULL_RETURN_VAL(origins, false);
@@ -519,6 +526,32 @@ Eina_Bool ewk_context_inspector_server_stop(Ewk_Context* ewkContext)
   return ewkContext->InspectorServerStop();
 }
 
+int ewk_context_script_register(Ewk_Context* context, const char* script)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, 0);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(script, 0);
+  return context->RegisterScript(script);
+}
+
+Eina_Bool ewk_context_script_unregister(Ewk_Context* context, int script_id)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  return context->UnregisterScript(script_id);
+}
+
+Eina_Bool ewk_context_spare_renderer_enabled_set(Ewk_Context* context, Eina_Bool enable)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  context->SetSpareRendererEnabled(enable);
+  return EINA_TRUE;
+}
+
+Eina_Bool ewk_context_spare_renderer_enabled_get(const Ewk_Context* context)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  return context->GetSpareRendererEnabled();
+}
+
 void ewk_send_widget_info(Ewk_Context *context,
                           int widget_handle,
                           double scale,
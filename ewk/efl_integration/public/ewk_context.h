@@ -59,6 +59,34 @@ EAPI void ewk_context_delete(Ewk_Context* context);
  */
 EAPI Eina_Bool ewk_context_notify_low_memory(Ewk_Context* ewkContext);
 
+/**
+ * \enum    Ewk_Memory_Pressure_Level
+ *
+ * @brief   Contains option for memory pressure level
+ */
+enum Ewk_Memory_Pressure_Level {
+    /// Drop caches that are cheap to rebuild.
+    EWK_MEMORY_PRESSURE_LEVEL_MODERATE,
+    /// Free everything that can be recomputed.
+    EWK_MEMORY_PRESSURE_LEVEL_CRITICAL
+};
+
+/// Creates a type name for the Ewk_Memory_Pressure_Level.
+typedef enum Ewk_Memory_Pressure_Level Ewk_Memory_Pressure_Level;
+
+/**
+ * Notify memory pressure to free unused memory.
+ *
+ * ewk_context_notify_low_memory() is the same as calling this function with
+ * EWK_MEMORY_PRESSURE_LEVEL_CRITICAL.
+ *
+ * @param context context object to notify memory pressure.
+ * @param level how much memory should be freed
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise.
+ */
+EAPI Eina_Bool ewk_context_notify_memory_pressure(Ewk_Context* context, Ewk_Memory_Pressure_Level level);
+
 /**
  * Sets the given proxy URI to network backend of specific context.
  *
@@ -867,6 +895,57 @@ EAPI unsigned int ewk_context_inspector_server_start(Ewk_Context* context, unsig
  */
 EAPI Eina_Bool ewk_context_inspector_server_stop(Ewk_Context* context);
 
+/**
+ * Registers a script to execute in the views of @a context with
+ * ewk_view_registered_script_execute().
+ *
+ * The script is kept in memory shared with the renderer processes, which
+ * receive it once and reuse its compiled code for every execution. Use it
+ * for large scripts executed in many pages, e.g. the bootstrap code of a
+ * web runtime.
+ *
+ * @param context context object
+ * @param script JavaScript source, in UTF-8
+ *
+ * @return id of the script, or @c 0 on failure
+ */
+EAPI int ewk_context_script_register(Ewk_Context* context, const char* script);
+
+/**
+ * Unregisters a script registered with ewk_context_script_register().
+ *
+ * @param context context object
+ * @param script_id id of the script
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE if there is no such script
+ */
+EAPI Eina_Bool ewk_context_script_unregister(Ewk_Context* context, int script_id);
+
+/**
+ * Keeps a renderer process launched and initialized for the next view
+ * created with @a context, which then does not wait for a process to start
+ * before loading its first page. A claimed spare is replaced a few seconds
+ * later, disabling it terminates an unclaimed spare.
+ *
+ * The spare costs the memory of an idle renderer. It is not used when the
+ * engine runs in single process mode.
+ *
+ * @param context context object
+ * @param enable @c EINA_TRUE to keep a spare renderer, @c EINA_FALSE otherwise
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_context_spare_renderer_enabled_set(Ewk_Context* context, Eina_Bool enable);
+
+/**
+ * Returns whether @a context keeps a spare renderer.
+ *
+ * @param context context object
+ *
+ * @return @c EINA_TRUE if it does, @c EINA_FALSE otherwise or on failure
+ */
+EAPI Eina_Bool ewk_context_spare_renderer_enabled_get(const Ewk_Context* context);
+
 
 ///------- belows are extension of chromium-ewk ---------------------------
 
@@ -82,6 +82,38 @@ Eina_Bool ewk_ipc_plugins_sync_message_send(int routingId, Ewk_IPC_Wrt_Message_D
     return tizen_webview::WrtPluginsIpc::SendSyncMessage(routingId, data);
 }
 
+namespace {
+
+struct ReplyCallbackData {
+    Ewk_IPC_Plugins_Reply_Cb callback;
+    void* user_data;
+};
+
+void OnPluginsReply(const tizen_webview::WrtIpcMessageData* reply, bool success, void* user_data)
+{
+    ReplyCallbackData* data = static_cast<ReplyCallbackData*>(user_data);
+    Ewk_IPC_Wrt_Message_Data ewk_reply;
+    static_cast<tizen_webview::WrtIpcMessageData&>(ewk_reply) = *reply;
+    data->callback(&ewk_reply, success, data->user_data);
+    delete data;
+}
+
+} // namespace
+
+Eina_Bool ewk_ipc_plugins_async_message_send(int routingId, const Ewk_IPC_Wrt_Message_Data* data, Ewk_IPC_Plugins_Reply_Cb callback, void* user_data)
+{
+    EINA_SAFETY_ON_NULL_RETURN_VAL(data, false);
+    EINA_SAFETY_ON_NULL_RETURN_VAL(callback, false);
+    ReplyCallbackData* callback_data = new ReplyCallbackData;
+    callback_data->callback = callback;
+    callback_data->user_data = user_data;
+    if (!tizen_webview::WrtPluginsIpc::SendAsyncMessage(routingId, *data, OnPluginsReply, callback_data)) {
+        delete callback_data;
+        return false;
+    }
+    return true;
+}
+
 
 Ewk_IPC_Wrt_Message_Data *ewk_ipc_wrt_message_data_new()
 {
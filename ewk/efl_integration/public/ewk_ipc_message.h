@@ -108,5 +108,28 @@ EAPI Eina_Bool ewk_ipc_wrt_message_send(Ewk_Context* context, const Ewk_IPC_Wrt_
  */
 EAPI Eina_Bool ewk_ipc_plugins_sync_message_send(int routingId, Ewk_IPC_Wrt_Message_Data* data);
 
+/**
+ * Callback for ewk_ipc_plugins_async_message_send
+ *
+ * @param reply the message sent, its value set by the handler. It is only valid during the callback
+ * @param success EINA_FALSE if the view was closed before the answer arrived
+ * @param user_data user data passed to ewk_ipc_plugins_async_message_send
+ */
+typedef void (*Ewk_IPC_Plugins_Reply_Cb)(const Ewk_IPC_Wrt_Message_Data* reply, Eina_Bool success, void* user_data);
+
+/**
+ *  Send Asynchronous IPC message to Wrt
+ *
+ *  Plugins -> Wrt (answer: -> Plugins) (Renderer->Browser -> Renderer)
+ *
+ *  Unlike ewk_ipc_plugins_sync_message_send the renderer is not blocked
+ *  until the answer arrives, @a callback is called with it instead.
+ *  Large values are passed in shared memory.
+ *
+ *  @return EINA_TRUE if the message was sent, in which case @a callback is
+ *          called exactly once, EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_ipc_plugins_async_message_send(int routingId, const Ewk_IPC_Wrt_Message_Data* data, Ewk_IPC_Plugins_Reply_Cb callback, void* user_data);
+
 
 #endif // EWK_IPC_MESSAGE_H
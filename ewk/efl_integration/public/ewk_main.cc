@@ -33,6 +33,8 @@
 #include <Ecore_X.h>
 #endif
 
+#include <base/bind.h>
+
 #include "public/ewk_log.h"
 #include "private/webview_delegate_ewk.h"
 #include "private/ewk_private.h"
@@ -175,6 +177,13 @@ void ewk_home_directory_set(const char* path)
     g_homeDirectory = path;
 }
 
+Eina_Bool ewk_prewarm(Ewk_Prewarm_Done_Cb done, void* user_data)
+{
+  EINA_SAFETY_ON_FALSE_RETURN_VAL(_ewkInitCount, EINA_FALSE);
+  EwkGlobalData::Prewarm(done ? base::Bind(done, user_data) : base::Closure());
+  return EINA_TRUE;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 //Private functions implementations for ewk_main module
 
@@ -67,6 +67,32 @@ EAPI void ewk_set_arguments(int argc, char** argv);
 */
 EAPI void ewk_home_directory_set(const char* path);
 
+/**
+ * Callback for ewk_prewarm().
+ *
+ * @param user_data user data passed to ewk_prewarm()
+ */
+typedef void (*Ewk_Prewarm_Done_Cb)(void* user_data);
+
+/**
+ * Starts the web engine in the background.
+ *
+ * The engine is otherwise started by the first context, e.g. from
+ * ewk_context_default_get(), which then blocks until it is up. Prewarming
+ * starts it in steps run when the main loop is idle and then launches the
+ * GPU process, so that an application can do it while its own UI is shown.
+ * Creating a context before it completed finishes the remaining steps.
+ *
+ * Once @a done is called, contexts are cheap to get and may be asked to
+ * keep a renderer ready with ewk_context_spare_renderer_enabled_set().
+ *
+ * @param done callback called from the main loop once the engine is up, may be @c NULL
+ * @param user_data user data passed to @a done
+ *
+ * @return @c EINA_TRUE on success, @c EINA_FALSE if ewk_init() was not called
+ */
+EAPI Eina_Bool ewk_prewarm(Ewk_Prewarm_Done_Cb done, void* user_data);
+
 #ifdef __cplusplus
 }
 #endif
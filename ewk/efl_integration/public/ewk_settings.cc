@@ -43,6 +43,24 @@ void ewkUpdateWebkitPreferences(Evas_Object *ewkView)
 
 }
 
+Eina_Bool ewk_settings_transaction_begin(Ewk_Settings* settings)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(settings, false);
+  WebView* impl = WebView::FromEvasObject(settings->getEvasObject());
+  EINA_SAFETY_ON_NULL_RETURN_VAL(impl, false);
+  impl->BeginSettingsTransaction();
+  return true;
+}
+
+Eina_Bool ewk_settings_transaction_commit(Ewk_Settings* settings)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(settings, false);
+  WebView* impl = WebView::FromEvasObject(settings->getEvasObject());
+  EINA_SAFETY_ON_NULL_RETURN_VAL(impl, false);
+  impl->CommitSettingsTransaction();
+  return true;
+}
+
 Eina_Bool ewk_settings_fullscreen_enabled_set(Ewk_Settings* settings, Eina_Bool enable)
 {
 #if !defined(EWK_BRINGUP)
@@ -59,6 +59,29 @@ enum _Ewk_List_Style_Position {
 };
 typedef enum _Ewk_List_Style_Position Ewk_List_Style_Position;
 
+/**
+ * Starts a settings transaction.
+ *
+ * Changes made by the setters until the matching
+ * ewk_settings_transaction_commit() are sent to the page at once. Without a
+ * transaction, changes made during one main loop iteration are coalesced.
+ * Transactions can be nested, only the outermost commit sends the changes.
+ *
+ * @param settings settings object to start the transaction on
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_settings_transaction_begin(Ewk_Settings* settings);
+
+/**
+ * Commits a settings transaction started with ewk_settings_transaction_begin().
+ *
+ * @param settings settings object to commit the transaction of
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_settings_transaction_commit(Ewk_Settings* settings);
+
 /*
  * Enables/disables the Javascript Fullscreen API. The Javascript API allows
  * to request full screen mode, for more information see:
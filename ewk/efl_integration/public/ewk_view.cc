@@ -428,13 +428,7 @@ Eina_Bool ewk_view_screenshot_contents_get_async(const Evas_Object* view, Eina_R
 {
   EINA_SAFETY_ON_NULL_RETURN_VAL(callback, NULL);
   EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, NULL);
-  // Zoom level equality (<=0.001) is sufficient compared to high precision std::numeric_value::epsilon.
-  if (!content::ZoomValuesEqual(scale_factor, 1.0)) {
-    LOG(ERROR) << "We only support scale factor of 1.0."
-               << "Scaling option will be supported after hardware acceleration is enabled.";
-    return EINA_FALSE;
-  }
-  return impl->GetSnapshotAsync(view_area, canvas, callback, user_data) ? EINA_TRUE : EINA_FALSE;
+  return impl->GetSnapshotAsync(view_area, scale_factor, canvas, callback, user_data) ? EINA_TRUE : EINA_FALSE;
 }
 
 unsigned int ewk_view_inspector_server_start(Evas_Object* ewkView, unsigned int port)
@@ -604,6 +598,24 @@ Eina_Bool ewk_view_contents_pdf_get(Evas_Object* view, int width, int height, co
   return impl->SaveAsPdf(width, height, fileName);
 }
 
+Eina_Bool ewk_view_contents_pdf_range_get(Evas_Object* view, int width, int height, int first_page, int last_page, const char* fileName, Ewk_View_Pdf_Export_Progress_Callback progress_callback, Ewk_View_Pdf_Export_Finished_Callback finished_callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(fileName, EINA_FALSE);
+  EINA_SAFETY_ON_FALSE_RETURN_VAL(first_page > 0, EINA_FALSE);
+  EINA_SAFETY_ON_FALSE_RETURN_VAL(last_page == 0 || last_page >= first_page, EINA_FALSE);
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+  // The engine counts pages from 0, with a negative last page meaning the end.
+  return impl->SaveAsPdf(width, height, first_page - 1, last_page - 1, fileName,
+                         chromium_glue::to(progress_callback),
+                         chromium_glue::to(finished_callback), user_data);
+}
+
+Eina_Bool ewk_view_contents_pdf_cancel(Evas_Object* view)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+  return impl->CancelPdfExport();
+}
+
 Eina_Bool ewk_view_script_execute(Evas_Object* ewkView, const char* script, Ewk_View_Script_Execute_Callback callback, void* user_data)
 {
   EWK_VIEW_IMPL_GET_OR_RETURN(ewkView, impl, false);
@@ -614,6 +626,12 @@ Eina_Bool ewk_view_script_execute(Evas_Object* ewkView, const char* script, Ewk_
   return false;
 }
 
+Eina_Bool ewk_view_registered_script_execute(Evas_Object* ewkView, int script_id, Ewk_View_Script_Execute_Callback callback, void* user_data)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(ewkView, impl, EINA_FALSE);
+  // callback can be null, so do not test it for null
+  return impl->ExecuteRegisteredScript(script_id, callback, user_data);
+}
 
 Eina_Bool ewk_view_plain_text_get(Evas_Object* view, Ewk_View_Plain_Text_Get_Callback callback, void* user_data)
 {
@@ -978,6 +996,15 @@ void ewk_view_session_data_get(Evas_Object* ewkView, const char** data, unsigned
   impl->GetSessionData(data, length);
 }
 
+Eina_Bool ewk_view_session_data_write(Evas_Object* ewkView, int fd, unsigned flags)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(ewkView, impl, EINA_FALSE);
+  EINA_SAFETY_ON_TRUE_RETURN_VAL(fd < 0, EINA_FALSE);
+
+  return impl->WriteSessionData(fd, flags & EWK_SESSION_DATA_DELTA,
+                                flags & EWK_SESSION_DATA_COMPRESSED);
+}
+
 Eina_Bool ewk_view_mode_set(Evas_Object* ewkView, Ewk_View_Mode view_mode)
 {
   EWK_VIEW_IMPL_GET_OR_RETURN(ewkView, impl, EINA_FALSE);
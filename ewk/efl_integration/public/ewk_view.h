@@ -446,8 +446,11 @@ typedef enum _Ewk_Find_Options Ewk_Find_Options;
 /**
  * Creates a new EFL WebKit view object.
  *
+ * The history is restored once the view is shown or navigated.
+ *
  * @param e canvas object where to create the view object
- * @param data a pointer to data to restore session data
+ * @param data a pointer to data to restore session data, of
+ *        ewk_view_session_data_get() or ewk_view_session_data_write()
  * @param length length of session data to restore session data
  *
  * @return view object on success or @c NULL on failure
@@ -587,6 +590,42 @@ typedef void (*Ewk_View_Plain_Text_Get_Callback)(Evas_Object* o, const char* pla
  */
 typedef void (*Ewk_View_MHTML_Data_Get_Callback)(Evas_Object *o, const char *data, void *user_data);
 
+/**
+ * \enum    Ewk_Pdf_Export_Status
+ *
+ * @brief   Tells how a PDF export started with ewk_view_contents_pdf_range_get ended
+ */
+enum Ewk_Pdf_Export_Status {
+    /// All requested pages have been written.
+    EWK_PDF_EXPORT_SUCCEEDED,
+    /// The file could not be written or the page range is empty.
+    EWK_PDF_EXPORT_FAILED,
+    /// The export was cancelled or the page navigated away.
+    EWK_PDF_EXPORT_CANCELLED
+};
+
+/// Creates a type name for the Ewk_Pdf_Export_Status.
+typedef enum Ewk_Pdf_Export_Status Ewk_Pdf_Export_Status;
+
+/**
+ * Callback for the progress of ewk_view_contents_pdf_range_get, called after every printed page
+ *
+ * @param o the view object
+ * @param pages_printed number of pages printed so far
+ * @param page_count number of pages to print
+ * @param user_data user data
+ */
+typedef void (*Ewk_View_Pdf_Export_Progress_Callback)(Evas_Object* o, int pages_printed, int page_count, void* user_data);
+
+/**
+ * Callback for the completion of ewk_view_contents_pdf_range_get
+ *
+ * @param o the view object
+ * @param status how the export ended
+ * @param user_data user data
+ */
+typedef void (*Ewk_View_Pdf_Export_Finished_Callback)(Evas_Object* o, Ewk_Pdf_Export_Status status, void* user_data);
+
 
 EAPI Eina_Bool ewk_view_vertical_panning_hold_get(Evas_Object* o);
 
@@ -1126,6 +1165,43 @@ EAPI Eina_Bool ewk_view_contents_size_get(Evas_Object* o, Evas_Coord* width, Eva
  */
 EAPI Eina_Bool ewk_view_contents_pdf_get(Evas_Object* o, int width, int height, const char* fileName);
 
+/**
+ * Creates PDF file of a range of pages of the page contents
+ *
+ * The pages are printed a few at a time without blocking the page,
+ * @a progress_callback is called after each of them. The file is written
+ * once all of them are printed.
+ * @a finished_callback is always called once the request has been accepted,
+ * from the main loop. The file is deleted if the export does not succeed.
+ * Only one export can run on a view at a time.
+ *
+ * @param o view object to get page contents.
+ * @param width the suface width of PDF file.
+ * @param height the suface height of PDF file.
+ * @param first_page the first page to print, starting from 1.
+ * @param last_page the last page to print, or 0 to print up to the last page.
+ * @param fileName the file name for creating PDF file.
+ * @param progress_callback progress callback, may be @c NULL
+ * @param finished_callback completion callback, may be @c NULL
+ * @param user_data user data passed to the callbacks
+ *
+ * @return @c EINA_TRUE if the export has been started or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_view_contents_pdf_range_get(Evas_Object* o, int width, int height, int first_page, int last_page, const char* fileName, Ewk_View_Pdf_Export_Progress_Callback progress_callback, Ewk_View_Pdf_Export_Finished_Callback finished_callback, void* user_data);
+
+/**
+ * Cancels the PDF export running on the view
+ *
+ * The finished callback of the export is called with EWK_PDF_EXPORT_CANCELLED
+ * unless the export completes before the cancellation reaches it, never from
+ * within this function. The file of a cancelled export is deleted.
+ *
+ * @param o view object
+ *
+ * @return @c EINA_TRUE if an export was running or @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_view_contents_pdf_cancel(Evas_Object* o);
+
 /**
  * Requests execution of the given script.
  *
@@ -1141,6 +1217,22 @@ EAPI Eina_Bool ewk_view_contents_pdf_get(Evas_Object* o, int width, int height,
  */
 EAPI Eina_Bool ewk_view_script_execute(Evas_Object* o, const char* script, Ewk_View_Script_Execute_Callback callback, void* user_data);
 
+/**
+ * Requests execution of a script registered with ewk_context_script_register()
+ * in the context of the view.
+ *
+ * Unlike ewk_view_script_execute() the script is not sent with every request
+ * and is only compiled by the first execution in a renderer process.
+ *
+ * @param o view object to execute script
+ * @param script_id id of the registered script
+ * @param callback result callback, may be @c NULL
+ * @param user_data user data
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_view_registered_script_execute(Evas_Object* o, int script_id, Ewk_View_Script_Execute_Callback callback, void* user_data);
+
 /**
  * Retrieve the contents in plain text.
  *
@@ -1573,6 +1665,34 @@ EAPI void ewk_view_browser_font_set(Evas_Object* o);
  */
 EAPI void ewk_view_session_data_get(Evas_Object* ewkView, const char** data, unsigned* length);
 
+/**
+ * \enum    Ewk_Session_Data_Flags
+ * @brief   Provides the kind of record ewk_view_session_data_write() writes
+ */
+enum Ewk_Session_Data_Flags {
+    EWK_SESSION_DATA_FULL = 0,
+    EWK_SESSION_DATA_DELTA = 1 << 0, /**< Only the changes since the previous record the view wrote */
+    EWK_SESSION_DATA_COMPRESSED = 1 << 1 /**< Deflated record */
+};
+typedef enum Ewk_Session_Data_Flags Ewk_Session_Data_Flags;
+
+/**
+ * Writes a record of the session data to a file descriptor
+ *
+ * Records written one after another by the same view, the first of them
+ * a full one, can be passed together to ewk_view_add_with_session_data().
+ * A session file is thus kept up to date by appending deltas to it, which
+ * only hold the history entries that changed. A delta is written as a full
+ * record if the view wrote none before or the previous write failed.
+ *
+ * @param ewkView view object whose session needs to be stored
+ * @param fd file descriptor to write to
+ * @param flags bitwise OR of Ewk_Session_Data_Flags
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_view_session_data_write(Evas_Object* ewkView, int fd, unsigned flags);
+
 /**
  * Load the error page which web page is not found.
  *
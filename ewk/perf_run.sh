@@ -0,0 +1,64 @@
+#!/bin/bash
+
+##  @file   perf_run.sh
+##  @brief  Runs the Chromium EFL benchmarks headless, on any Linux box
+##
+##  Starts Xvfb with Mesa's software GL, serves the benchmark corpus over a
+##  local HTTP server and runs ewk_perftests, which writes its JSON report
+##  to $PERF_RESULT_DIR/ewk_perftests.json and the phases it timed, in the
+##  Trace Event Format, to $PERF_RESULT_DIR/ewk_perftests_trace*.json.
+##  Chromium's own startup trace can be added by passing, e.g.
+##  --trace-startup=startup,toplevel --trace-startup-file=<file>.
+##
+##  Usage: perf_run.sh [path to ewk_perftests] [gtest options...]
+##  Iterations are set with PERF_ITERATIONS and PERF_WARMUP_ITERATIONS,
+##  the number of tabs of the thumbnail benchmark with PERF_TABS and the
+##  port the HTTP cache benchmark serves the corpus on with PERF_HTTP_CACHE_PORT.
+
+PERF_EXEC=${1:-/opt/usr/utc_exec/ewk_perftests}
+[ $# -gt 0 ] && shift
+PERF_RESOURCES=${UTC_RESOURCE_PATH:-/opt/usr/resources}
+PERF_RESULTS_ROOT_DIR=${PERF_RESULTS_ROOT_DIR:-/opt/usr/perf_results}
+PERF_DISPLAY=${PERF_DISPLAY:-:99}
+PERF_PORT=${PERF_PORT:-8099}
+
+PERF_RESULT_DIR=$PERF_RESULTS_ROOT_DIR/perf-result-$(date +%y%m%d_%H%M%S)
+
+## Echo setting values
+echo PERF_EXEC=$PERF_EXEC
+echo PERF_RESOURCES=$PERF_RESOURCES
+echo PERF_RESULT_DIR=$PERF_RESULT_DIR
+
+mkdir -p $PERF_RESULT_DIR || exit 1
+
+## Headless X server, GLX on the software rasterizer
+Xvfb $PERF_DISPLAY -screen 0 1280x1024x24 +extension GLX -nolisten tcp &
+XVFB_PID=$!
+export DISPLAY=$PERF_DISPLAY
+export LIBGL_ALWAYS_SOFTWARE=1
+
+## Corpus server, rooted at the resources so that pages share common/
+(cd $PERF_RESOURCES && exec python -m SimpleHTTPServer $PERF_PORT > $PERF_RESULT_DIR/http.log 2>&1) &
+HTTP_PID=$!
+
+trap "kill $HTTP_PID $XVFB_PID 2> /dev/null" EXIT
+sleep 2
+
+export UTC_RESOURCE_PATH=$PERF_RESOURCES
+export PERF_SERVER_URL=http://127.0.0.1:$PERF_PORT/perf/
+export PERF_OUTPUT=$PERF_RESULT_DIR/ewk_perftests.json
+export PERF_TRACE_OUTPUT=$PERF_RESULT_DIR/ewk_perftests_trace.json
+
+echo ====shell script==== ::: start benchmark ::: $PERF_EXEC
+$PERF_EXEC --gtest_output="xml:$PERF_RESULT_DIR/ewk_perftests.xml" "$@" 2> $PERF_RESULT_DIR/ewk_perftests.log
+RESULT=$?
+echo ====shell script==== :::  end benchmark  ::: $PERF_EXEC
+
+if [ -f "$PERF_OUTPUT" ]; then
+  cat $PERF_OUTPUT
+else
+  echo "No report written, see $PERF_RESULT_DIR/ewk_perftests.log"
+  RESULT=1
+fi
+
+exit $RESULT
@@ -0,0 +1,44 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include <glib-object.h>
+#include <Elementary.h>
+
+#include "ewk_main.h"
+#include "utc_blink_perf_base.h"
+
+int main(int argc, char* argv[])
+{
+  /* 1. Initialization of the EFL (and other) libraries */
+#if !GLIB_CHECK_VERSION(2, 36, 0)
+  g_type_init();
+#endif
+  /* Engine switches the benchmarks rely on */
+  std::vector<char*> ewk_argv(argv, argv + argc);
+  ewk_argv.push_back(const_cast<char*>("--count-ipc-messages"));
+  ewk_argv.push_back(NULL);
+  ewk_set_arguments(ewk_argv.size() - 1, &ewk_argv[0]);
+
+  double ewk_init_start = utc_blink_perf_base::Now();
+  ewk_init();
+  utc_blink_perf_report::Get().SetEwkInitTime(ewk_init_start, utc_blink_perf_base::Now());
+  elm_init(0, NULL);
+
+  /* Evas GL, on Mesa's software rasterizer when run by perf_run.sh */
+  elm_config_preferred_engine_set("opengl_x11");
+
+  testing::InitGoogleTest(&argc, argv);
+  int retval = RUN_ALL_TESTS();
+
+  if (!utc_blink_perf_report::Get().Write())
+    retval = 1;
+
+  /* 2. Closing whole EWK */
+  ewk_shutdown();
+  return retval;
+}
@@ -0,0 +1,213 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file   utc_blink_device_sensors_sampling_rate.cpp
+ * @brief  Rate the device sensors run at, depending on the views
+ *
+ * The sensors are faked with --use-fake-device-sensors, which only takes
+ * effect at engine startup, so the fake_sensors test runs the other tests
+ * of this file in a process of its own with the switch. Rates are read from
+ * the interval of the devicemotion events of common/device_motion.html,
+ * which is the time between the sensor samples: the full rate is at most
+ * kMaxFullRateInterval, the reduced one kReducedRateInterval.
+ *
+ * Every view is a client of the sensors from its creation, so the full rate
+ * the sensors fall back to without any client is not reachable from here.
+ */
+
+#include "utc_blink_ewk_base.h"
+
+#include <sys/wait.h>
+
+namespace {
+
+/* Set for the process spawned by the fake_sensors test */
+const char kFakeSensorsEnv[] = "UTC_FAKE_DEVICE_SENSORS";
+
+const char kPage[] = "common/device_motion.html";
+
+const double kMaxFullRateInterval = 75.0;
+const double kReducedRateInterval = 100.0;
+
+/* Time for a rate change to reach the page */
+const double kSettleTime = 0.5;
+const double kMeasureTime = 1.0;
+
+} // namespace
+
+class utc_blink_device_sensors_sampling_rate : public utc_blink_ewk_base
+{
+protected:
+    static bool IsFakeSensorsRun()
+    {
+        return getenv(kFakeSensorsEnv);
+    }
+
+    void LoadFinished(Evas_Object* webview)
+    {
+        EventLoopStop(Success);
+    }
+
+    bool LoadPage(Evas_Object* webview)
+    {
+        return ewk_view_url_set(webview, GetResourceUrl(kPage).c_str()) &&
+               EventLoopStart() == Success;
+    }
+
+    /**
+     * Runs |script| in |webview| and returns its result as a number, -1 on
+     * failure.
+     */
+    double Evaluate(Evas_Object* webview, const char* script)
+    {
+        script_result.clear();
+        if (!ewk_view_script_execute(webview, script, script_executed_cb, this) ||
+            EventLoopStart() != Success)
+            return -1;
+        return atof(script_result.c_str());
+    }
+
+    /**
+     * Median interval of the samples |webview| gets, -1 if it gets none.
+     */
+    double MeasureInterval(Evas_Object* webview)
+    {
+        EventLoopWait(kSettleTime);
+        Evaluate(webview, "reset()");
+        EventLoopWait(kMeasureTime);
+        return Evaluate(webview, "medianInterval()");
+    }
+
+    static void script_executed_cb(Evas_Object* webview, const char* result_value, void* data)
+    {
+        utc_blink_device_sensors_sampling_rate* owner =
+            static_cast<utc_blink_device_sensors_sampling_rate*>(data);
+        owner->script_result = result_value ? result_value : "";
+        owner->EventLoopStop(Success);
+    }
+
+    std::string script_result;
+};
+
+/**
+ * @brief Runs the tests of this file with fake device sensors
+ */
+TEST_F(utc_blink_device_sensors_sampling_rate, fake_sensors)
+{
+    if (IsFakeSensorsRun())
+        return;
+
+    char* argv[] = {
+        const_cast<char*>("/proc/self/exe"),
+        const_cast<char*>("--gtest_filter=utc_blink_device_sensors_sampling_rate.*"
+                          "-utc_blink_device_sensors_sampling_rate.fake_sensors"),
+        const_cast<char*>("--use-fake-device-sensors"),
+        NULL
+    };
+    gchar** envp = g_get_environ();
+    envp = g_environ_setenv(envp, kFakeSensorsEnv, "1", TRUE);
+
+    gchar* output = NULL;
+    gint status = 0;
+    GError* error = NULL;
+    gboolean spawned = g_spawn_sync(NULL, argv, envp, static_cast<GSpawnFlags>(0), NULL, NULL,
+                                    &output, NULL, &status, &error);
+    g_strfreev(envp);
+    if (!spawned) {
+        utc_message("[fake_sensors] :: cannot spawn: %s", error->message);
+        g_error_free(error);
+        FAIL();
+    }
+    utc_message("%s", output);
+    g_free(output);
+    EXPECT_TRUE(WIFEXITED(status) && !WEXITSTATUS(status));
+}
+
+/**
+ * @brief A focused, visible view gets the full rate
+ */
+TEST_F(utc_blink_device_sensors_sampling_rate, focused)
+{
+    if (!IsFakeSensorsRun())
+        return;
+
+    ASSERT_TRUE(LoadPage(GetEwkWebView()));
+    evas_object_focus_set(GetEwkWebView(), EINA_TRUE);
+
+    double interval = MeasureInterval(GetEwkWebView());
+    EXPECT_GT(interval, 0);
+    EXPECT_LE(interval, kMaxFullRateInterval);
+}
+
+/**
+ * @brief A visible view without focus gets the reduced rate
+ */
+TEST_F(utc_blink_device_sensors_sampling_rate, visible)
+{
+    if (!IsFakeSensorsRun())
+        return;
+
+    ASSERT_TRUE(LoadPage(GetEwkWebView()));
+    evas_object_focus_set(GetEwkWebView(), EINA_FALSE);
+
+    EXPECT_GE(MeasureInterval(GetEwkWebView()), kReducedRateInterval);
+
+    /* And the full rate again once focused */
+    evas_object_focus_set(GetEwkWebView(), EINA_TRUE);
+    double interval = MeasureInterval(GetEwkWebView());
+    EXPECT_GT(interval, 0);
+    EXPECT_LE(interval, kMaxFullRateInterval);
+}
+
+/**
+ * @brief A hidden view gets no samples, and the full rate once shown focused
+ */
+TEST_F(utc_blink_device_sensors_sampling_rate, hidden)
+{
+    if (!IsFakeSensorsRun())
+        return;
+
+    ASSERT_TRUE(LoadPage(GetEwkWebView()));
+    evas_object_focus_set(GetEwkWebView(), EINA_TRUE);
+    ASSERT_GT(MeasureInterval(GetEwkWebView()), 0);
+
+    evas_object_hide(GetEwkWebView());
+    EventLoopWait(kSettleTime);
+    double hidden_events = Evaluate(GetEwkWebView(), "getEventCount()");
+    EventLoopWait(kMeasureTime);
+    EXPECT_EQ(hidden_events, Evaluate(GetEwkWebView(), "getEventCount()"));
+
+    evas_object_show(GetEwkWebView());
+    evas_object_focus_set(GetEwkWebView(), EINA_TRUE);
+    double interval = MeasureInterval(GetEwkWebView());
+    EXPECT_GT(interval, 0);
+    EXPECT_LE(interval, kMaxFullRateInterval);
+}
+
+/**
+ * @brief Sensors run at the highest rate any view needs
+ */
+TEST_F(utc_blink_device_sensors_sampling_rate, highest_rate)
+{
+    if (!IsFakeSensorsRun())
+        return;
+
+    ASSERT_TRUE(LoadPage(GetEwkWebView()));
+
+    /* The focused view makes the unfocused one get the full rate too */
+    Evas_Object* focused_view = ewk_view_add(GetEwkEvas());
+    evas_object_resize(focused_view, DEFAULT_WIDTH_OF_WINDOW, DEFAULT_HEIGHT_OF_WINDOW);
+    evas_object_show(focused_view);
+    evas_object_focus_set(focused_view, EINA_TRUE);
+    evas_object_focus_set(GetEwkWebView(), EINA_FALSE);
+
+    double interval = MeasureInterval(GetEwkWebView());
+    EXPECT_GT(interval, 0);
+    EXPECT_LE(interval, kMaxFullRateInterval);
+
+    /* Back to the reduced rate without it */
+    evas_object_del(focused_view);
+    EXPECT_GE(MeasureInterval(GetEwkWebView()), kReducedRateInterval);
+}
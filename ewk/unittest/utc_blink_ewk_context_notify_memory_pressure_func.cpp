@@ -0,0 +1,38 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_notify_memory_pressure : public utc_blink_ewk_base
+{
+};
+
+/**
+ * @brief Checking whether moderate memory pressure is accepted.
+ */
+TEST_F(utc_blink_ewk_context_notify_memory_pressure, POS_TEST_MODERATE)
+{
+  Eina_Bool result = ewk_context_notify_memory_pressure(ewk_view_context_get(GetEwkWebView()),
+                                                        EWK_MEMORY_PRESSURE_LEVEL_MODERATE);
+  utc_check_eq(result, EINA_TRUE);
+}
+
+/**
+ * @brief Checking whether critical memory pressure is accepted.
+ */
+TEST_F(utc_blink_ewk_context_notify_memory_pressure, POS_TEST_CRITICAL)
+{
+  Eina_Bool result = ewk_context_notify_memory_pressure(ewk_view_context_get(GetEwkWebView()),
+                                                        EWK_MEMORY_PRESSURE_LEVEL_CRITICAL);
+  utc_check_eq(result, EINA_TRUE);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context.
+ */
+TEST_F(utc_blink_ewk_context_notify_memory_pressure, NEG_TEST)
+{
+  Eina_Bool result = ewk_context_notify_memory_pressure(NULL, EWK_MEMORY_PRESSURE_LEVEL_CRITICAL);
+  utc_check_ne(result, EINA_TRUE);
+}
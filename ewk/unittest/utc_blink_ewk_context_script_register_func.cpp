@@ -0,0 +1,42 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_script_register : public utc_blink_ewk_base
+{
+};
+
+/**
+ * @brief Checking whether registered scripts get distinct ids.
+ */
+TEST_F(utc_blink_ewk_context_script_register, POS_TEST)
+{
+  Ewk_Context* context = ewk_view_context_get(GetEwkWebView());
+  int first = ewk_context_script_register(context, "var registered = 1;");
+  int second = ewk_context_script_register(context, "var registered = 2;");
+  utc_check_ne(first, 0);
+  utc_check_ne(second, 0);
+  utc_check_ne(first, second);
+
+  ewk_context_script_unregister(context, first);
+  ewk_context_script_unregister(context, second);
+}
+
+/**
+ * @brief Checking whether an empty script is refused.
+ */
+TEST_F(utc_blink_ewk_context_script_register, NEG_TEST_EMPTY_SCRIPT)
+{
+  utc_check_eq(ewk_context_script_register(ewk_view_context_get(GetEwkWebView()), ""), 0);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL arguments.
+ */
+TEST_F(utc_blink_ewk_context_script_register, NEG_TEST)
+{
+  utc_check_eq(ewk_context_script_register(NULL, "var registered = 1;"), 0);
+  utc_check_eq(ewk_context_script_register(ewk_view_context_get(GetEwkWebView()), NULL), 0);
+}
@@ -0,0 +1,31 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_script_unregister : public utc_blink_ewk_base
+{
+};
+
+/**
+ * @brief Checking whether a registered script can be unregistered once.
+ */
+TEST_F(utc_blink_ewk_context_script_unregister, POS_TEST)
+{
+  Ewk_Context* context = ewk_view_context_get(GetEwkWebView());
+  int script_id = ewk_context_script_register(context, "var registered = 1;");
+  ASSERT_NE(0, script_id);
+
+  utc_check_eq(ewk_context_script_unregister(context, script_id), EINA_TRUE);
+  utc_check_eq(ewk_context_script_unregister(context, script_id), EINA_FALSE);
+  utc_check_eq(ewk_view_registered_script_execute(GetEwkWebView(), script_id, NULL, NULL), EINA_FALSE);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context.
+ */
+TEST_F(utc_blink_ewk_context_script_unregister, NEG_TEST)
+{
+  utc_check_eq(ewk_context_script_unregister(NULL, 1), EINA_FALSE);
+}
@@ -0,0 +1,90 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_spare_renderer_enabled_set : public utc_blink_ewk_base
+{
+protected:
+  utc_blink_ewk_context_spare_renderer_enabled_set()
+    : context(NULL)
+    , view(NULL)
+  {
+  }
+
+  void PostSetUp()
+  {
+    context = ewk_context_new();
+  }
+
+  void PreTearDown()
+  {
+    if (view)
+      evas_object_del(view);
+    ewk_context_delete(context);
+  }
+
+  /* Adds a view in the tested context, it gets the spare renderer if any */
+  Evas_Object* AddView()
+  {
+    view = ewk_view_add_with_context(GetEwkEvas(), context);
+    evas_object_resize(view, DEFAULT_WIDTH_OF_WINDOW, DEFAULT_HEIGHT_OF_WINDOW);
+    evas_object_show(view);
+    evas_object_smart_callback_add(view, "load,finished", view_load_finished_cb, this);
+    evas_object_smart_callback_add(view, "load,error", view_load_error_cb, this);
+    return view;
+  }
+
+  static void view_load_finished_cb(void* data, Evas_Object* webview, void* event_info)
+  {
+    static_cast<utc_blink_ewk_context_spare_renderer_enabled_set*>(data)->EventLoopStop(Success);
+  }
+
+  static void view_load_error_cb(void* data, Evas_Object* webview, void* event_info)
+  {
+    static_cast<utc_blink_ewk_context_spare_renderer_enabled_set*>(data)->EventLoopStop(LoadFailure);
+  }
+
+  Ewk_Context* context;
+  Evas_Object* view;
+};
+
+/**
+ * @brief Checking whether the spare renderer can be enabled and disabled.
+ */
+TEST_F(utc_blink_ewk_context_spare_renderer_enabled_set, POS_TEST)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_context_spare_renderer_enabled_get(context));
+
+  ASSERT_EQ(EINA_TRUE, ewk_context_spare_renderer_enabled_set(context, EINA_TRUE));
+  ASSERT_EQ(EINA_TRUE, ewk_context_spare_renderer_enabled_get(context));
+
+  ASSERT_EQ(EINA_TRUE, ewk_context_spare_renderer_enabled_set(context, EINA_FALSE));
+  ASSERT_EQ(EINA_FALSE, ewk_context_spare_renderer_enabled_get(context));
+}
+
+/**
+ * @brief Checking whether a view loads pages in the spare renderer it claimed.
+ */
+TEST_F(utc_blink_ewk_context_spare_renderer_enabled_set, POS_TEST_CLAIMED)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_context_spare_renderer_enabled_set(context, EINA_TRUE));
+  /* Gives the spare time to launch */
+  EventLoopWait(3);
+
+  AddView();
+  ASSERT_EQ(EINA_TRUE, ewk_view_url_set(view, GetResourceUrl("common/sample.html").c_str()));
+  ASSERT_EQ(Success, EventLoopStart());
+  ASSERT_EQ(EINA_TRUE, ewk_view_url_set(view, GetResourceUrl("common/sample_1.html").c_str()));
+  ASSERT_EQ(Success, EventLoopStart());
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context.
+ */
+TEST_F(utc_blink_ewk_context_spare_renderer_enabled_set, NEG_TEST)
+{
+  ASSERT_NE(EINA_TRUE, ewk_context_spare_renderer_enabled_set(NULL, EINA_TRUE));
+  ASSERT_NE(EINA_TRUE, ewk_context_spare_renderer_enabled_get(NULL));
+}
@@ -0,0 +1,37 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_prewarm : public utc_blink_ewk_base
+{
+protected:
+  static void prewarm_done_cb(void* user_data)
+  {
+    utc_blink_ewk_prewarm* owner = NULL;
+    OwnerFromVoid(user_data, &owner);
+    owner->EventLoopStop(Success);
+  }
+};
+
+/**
+ * @brief Checking whether the done callback is called, the engine already runs.
+ */
+TEST_F(utc_blink_ewk_prewarm, POS_TEST)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_prewarm(prewarm_done_cb, this));
+  ASSERT_EQ(Success, EventLoopStart());
+
+  ASSERT_EQ(EINA_TRUE, ewk_view_url_set(GetEwkWebView(), GetResourceUrl("common/sample.html").c_str()));
+  ASSERT_EQ(Success, EventLoopStart());
+}
+
+/**
+ * @brief Checking whether prewarming works without a callback.
+ */
+TEST_F(utc_blink_ewk_prewarm, POS_TEST_NULL_CALLBACK)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_prewarm(NULL, NULL));
+  EventLoopWait(1);
+}
@@ -0,0 +1,35 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_settings_transaction_begin : public utc_blink_ewk_base {
+};
+
+/**
+ * @brief Positive test case of ewk_settings_transaction_begin()
+ */
+TEST_F(utc_blink_ewk_settings_transaction_begin, POS_TEST)
+{
+  Ewk_Settings* settings = ewk_view_settings_get(GetEwkWebView());
+  if (!settings) {
+    FAIL();
+  }
+
+  EXPECT_EQ(ewk_settings_transaction_begin(settings), EINA_TRUE);
+  ewk_settings_javascript_enabled_set(settings, EINA_FALSE);
+  ewk_settings_loads_images_automatically_set(settings, EINA_FALSE);
+  EXPECT_EQ(ewk_settings_transaction_commit(settings), EINA_TRUE);
+
+  EXPECT_EQ(ewk_settings_javascript_enabled_get(settings), EINA_FALSE);
+  EXPECT_EQ(ewk_settings_loads_images_automatically_get(settings), EINA_FALSE);
+}
+
+/**
+ * @brief Negative test case of ewk_settings_transaction_begin()
+ */
+TEST_F(utc_blink_ewk_settings_transaction_begin, NEG_TEST)
+{
+  EXPECT_EQ(ewk_settings_transaction_begin(NULL), EINA_FALSE);
+}
@@ -0,0 +1,84 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+#include <unistd.h>
+
+class utc_blink_ewk_view_contents_pdf_cancel : public utc_blink_ewk_base
+{
+ protected:
+  Ewk_Pdf_Export_Status status;
+
+  void PreSetUp()
+  {
+    status = EWK_PDF_EXPORT_FAILED;
+  }
+
+  /* Callback for load finished */
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(Success);
+  }
+
+  static void PdfExportFinished(Evas_Object* webview, Ewk_Pdf_Export_Status status, void* data)
+  {
+    utc_blink_ewk_view_contents_pdf_cancel* owner = static_cast<utc_blink_ewk_view_contents_pdf_cancel*>(data);
+    utc_message("[PdfExportFinished] :: %d", status);
+    if (owner) {
+      owner->status = status;
+      owner->EventLoopStop(Success);
+    }
+  }
+};
+
+/**
+ * @brief Positive test case of ewk_view_contents_pdf_cancel().
+ * An export is cancelled right after it has been started, the finished
+ * callback has to report the cancellation, from the main loop, and the file
+ * has to be gone by then.
+ */
+TEST_F(utc_blink_ewk_view_contents_pdf_cancel, POS_TEST)
+{
+  char htmlBuffer[] = "<html>"
+                        "<head></head>"
+                        "<body>"
+                          "<div style='height:30000px'></div>"
+                        "</body>"
+                      "</html>";
+
+  if (!ewk_view_html_string_load(GetEwkWebView(), htmlBuffer, NULL, NULL))
+    utc_fail();
+  if (Success != EventLoopStart())
+    utc_fail();
+
+  if (!ewk_view_contents_pdf_range_get(GetEwkWebView(), 600, 800, 1, 0,
+      "/tmp/sample_cancel.pdf", NULL, PdfExportFinished, this))
+    utc_fail();
+
+  Eina_Bool result = ewk_view_contents_pdf_cancel(GetEwkWebView());
+  utc_check_eq(status, EWK_PDF_EXPORT_FAILED);
+  if (Success != EventLoopStart(10.0))
+    utc_fail();
+
+  utc_check_eq(result, EINA_TRUE);
+  utc_check_eq(status, EWK_PDF_EXPORT_CANCELLED);
+  utc_check_ne(access("/tmp/sample_cancel.pdf", F_OK), 0);
+}
+
+/**
+ * @brief Checking whether function works properly when no export is running.
+ */
+TEST_F(utc_blink_ewk_view_contents_pdf_cancel, NEG_TEST1)
+{
+  utc_check_eq(ewk_view_contents_pdf_cancel(GetEwkWebView()), EINA_FALSE);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a webview.
+ */
+TEST_F(utc_blink_ewk_view_contents_pdf_cancel, NEG_TEST2)
+{
+  utc_check_eq(ewk_view_contents_pdf_cancel(NULL), EINA_FALSE);
+}
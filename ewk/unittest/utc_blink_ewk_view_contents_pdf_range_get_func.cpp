@@ -0,0 +1,98 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_contents_pdf_range_get : public utc_blink_ewk_base
+{
+ protected:
+  int pages_printed;
+  int page_count;
+  Ewk_Pdf_Export_Status status;
+
+  void PreSetUp()
+  {
+    pages_printed = 0;
+    page_count = 0;
+    status = EWK_PDF_EXPORT_FAILED;
+  }
+
+  /* Callback for load finished */
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(Success);
+  }
+
+  static void PdfExportProgress(Evas_Object* webview, int pages_printed, int page_count, void* data)
+  {
+    utc_blink_ewk_view_contents_pdf_range_get* owner = static_cast<utc_blink_ewk_view_contents_pdf_range_get*>(data);
+    utc_message("[PdfExportProgress] :: %d/%d", pages_printed, page_count);
+    if (owner) {
+      owner->pages_printed = pages_printed;
+      owner->page_count = page_count;
+    }
+  }
+
+  static void PdfExportFinished(Evas_Object* webview, Ewk_Pdf_Export_Status status, void* data)
+  {
+    utc_blink_ewk_view_contents_pdf_range_get* owner = static_cast<utc_blink_ewk_view_contents_pdf_range_get*>(data);
+    utc_message("[PdfExportFinished] :: %d", status);
+    if (owner) {
+      owner->status = status;
+      owner->EventLoopStop(Success);
+    }
+  }
+};
+
+/**
+ * @brief Positive test case of ewk_view_contents_pdf_range_get().
+ * A page taller than three print pages is loaded and its second page
+ * is exported, progress has to be reported for exactly one page.
+ */
+TEST_F(utc_blink_ewk_view_contents_pdf_range_get, POS_TEST)
+{
+  char htmlBuffer[] = "<html>"
+                        "<head></head>"
+                        "<body>"
+                          "<div style='height:3000px'></div>"
+                        "</body>"
+                      "</html>";
+
+  if (!ewk_view_html_string_load(GetEwkWebView(), htmlBuffer, NULL, NULL))
+    utc_fail();
+  if (Success != EventLoopStart())
+    utc_fail();
+
+  Eina_Bool result = ewk_view_contents_pdf_range_get(GetEwkWebView(), 600, 800, 2, 2,
+      "/tmp/sample_range.pdf", PdfExportProgress, PdfExportFinished, this);
+  if (!result)
+    utc_fail();
+  if (Success != EventLoopStart(10.0))
+    utc_fail();
+
+  utc_check_eq(status, EWK_PDF_EXPORT_SUCCEEDED);
+  utc_check_eq(pages_printed, 1);
+  utc_check_eq(page_count, 1);
+  utc_check_true(ecore_file_exists("/tmp/sample_range.pdf"));
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a webview.
+ */
+TEST_F(utc_blink_ewk_view_contents_pdf_range_get, NEG_TEST1)
+{
+  Eina_Bool result = ewk_view_contents_pdf_range_get(NULL, 200, 200, 1, 0,
+      "/tmp/sample_range.pdf", NULL, NULL, NULL);
+  utc_check_eq(result, EINA_FALSE);
+}
+
+/**
+ * @brief Checking whether function works properly in case of an invalid page range.
+ */
+TEST_F(utc_blink_ewk_view_contents_pdf_range_get, NEG_TEST2)
+{
+  Eina_Bool result = ewk_view_contents_pdf_range_get(GetEwkWebView(), 200, 200, 3, 2,
+      "/tmp/sample_range.pdf", NULL, NULL, NULL);
+  utc_check_eq(result, EINA_FALSE);
+}
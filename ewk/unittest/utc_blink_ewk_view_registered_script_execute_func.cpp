@@ -0,0 +1,87 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_registered_script_execute : public utc_blink_ewk_base
+{
+ protected:
+  utc_blink_ewk_view_registered_script_execute()
+    : script_id(0)
+  {
+  }
+
+  void PostSetUp()
+  {
+    script_id = ewk_context_script_register(ewk_view_context_get(GetEwkWebView()), javaScript);
+  }
+
+  void PreTearDown()
+  {
+    ewk_context_script_unregister(ewk_view_context_get(GetEwkWebView()), script_id);
+  }
+
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(Success);
+  }
+
+  /* Callback for script execution */
+  static void scriptExecutionFinished(Evas_Object* webview, const char* result_value, void* data)
+  {
+    utc_message("[scriptExecutionFinished] :: %s", result_value);
+    utc_blink_ewk_view_registered_script_execute* owner = NULL;
+    OwnerFromVoid(data, &owner);
+    owner->result = result_value ? result_value : "";
+    owner->EventLoopStop(Success);
+  }
+
+  int script_id;
+  std::string result;
+  static const char* const sample;
+  static const char* const javaScript;
+};
+
+const char* const utc_blink_ewk_view_registered_script_execute::sample = "common/sample.html";
+const char* const utc_blink_ewk_view_registered_script_execute::javaScript = "document.getElementById('getParaContent').innerHTML";
+
+/**
+ * @brief Registered script is executed, again after its compiled code is reused and in a new page.
+ */
+TEST_F(utc_blink_ewk_view_registered_script_execute, POS_TEST)
+{
+  ASSERT_NE(0, script_id);
+  ASSERT_EQ(EINA_TRUE, ewk_view_url_set(GetEwkWebView(), GetResourceUrl(sample).c_str()));
+  ASSERT_EQ(Success, EventLoopStart());
+
+  for (int i = 0; i < 2; ++i) {
+    result.clear();
+    ASSERT_EQ(EINA_TRUE, ewk_view_registered_script_execute(GetEwkWebView(), script_id, scriptExecutionFinished, this));
+    ASSERT_EQ(Success, EventLoopStart());
+    ASSERT_STREQ("test content", result.c_str());
+  }
+
+  ASSERT_EQ(EINA_TRUE, ewk_view_reload(GetEwkWebView()));
+  ASSERT_EQ(Success, EventLoopStart());
+  result.clear();
+  ASSERT_EQ(EINA_TRUE, ewk_view_registered_script_execute(GetEwkWebView(), script_id, scriptExecutionFinished, this));
+  ASSERT_EQ(Success, EventLoopStart());
+  ASSERT_STREQ("test content", result.c_str());
+}
+
+/**
+ * @brief Checking whether unknown scripts are refused.
+ */
+TEST_F(utc_blink_ewk_view_registered_script_execute, NEG_TEST_UNKNOWN_SCRIPT)
+{
+  utc_check_eq(ewk_view_registered_script_execute(GetEwkWebView(), script_id + 1000, NULL, NULL), EINA_FALSE);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a webview.
+ */
+TEST_F(utc_blink_ewk_view_registered_script_execute, NEG_TEST)
+{
+  utc_check_eq(ewk_view_registered_script_execute(NULL, script_id, scriptExecutionFinished, this), EINA_FALSE);
+}
@@ -0,0 +1,149 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+class utc_blink_ewk_view_session_data_write_func : public utc_blink_ewk_base
+{
+protected:
+  std::string firstPage;
+  std::string testUrl;
+  std::string lastPage;
+
+  int sessionFd;
+  Evas_Object *otherWebview;
+
+  void PreSetUp()
+  {
+    firstPage = GetResourceUrl("common/sample.html");
+    testUrl   = GetResourceUrl("common/sample_1.html");
+    lastPage  = GetResourceUrl("common/sample_2.html");
+
+    char path[] = "/tmp/utc_blink_session_XXXXXX";
+    sessionFd = mkstemp(path);
+    if (sessionFd >= 0)
+      unlink(path);
+    otherWebview = NULL;
+  }
+
+  void LoadFinished(Evas_Object*)
+  {
+    EventLoopStop(Success);
+  }
+
+  void PostTearDown()
+  {
+    if (otherWebview)
+      evas_object_del(otherWebview);
+    if (sessionFd >= 0)
+      close(sessionFd);
+  }
+
+  /* Everything written to the session file so far */
+  std::string ReadSessionFile()
+  {
+    std::string contents;
+    char buffer[4096];
+    ssize_t size;
+    lseek(sessionFd, 0, SEEK_SET);
+    while ((size = read(sessionFd, buffer, sizeof(buffer))) > 0)
+      contents.append(buffer, size);
+    return contents;
+  }
+
+  void LoadPage(const std::string& url)
+  {
+    ASSERT_EQ(EINA_TRUE, ewk_view_url_set(GetEwkWebView(), url.c_str()));
+    ASSERT_EQ(Success, EventLoopStart());
+  }
+
+  /* Restores the session file in a new view and checks its history */
+  void CheckRestoredSession()
+  {
+    std::string session = ReadSessionFile();
+    ASSERT_FALSE(session.empty());
+
+    otherWebview = ewk_view_add_with_session_data(GetEwkEvas(), session.data(), session.size());
+    ASSERT_TRUE(otherWebview);
+
+    ASSERT_STREQ(testUrl.c_str(), ewk_view_url_get(otherWebview));
+    ASSERT_TRUE(ewk_view_forward_possible(otherWebview));
+    ASSERT_TRUE(ewk_view_back_possible(otherWebview));
+  }
+};
+
+/**
+ * @brief Tests if a full record followed by deltas restores the history.
+ */
+TEST_F(utc_blink_ewk_view_session_data_write_func, POS_TEST)
+{
+  ASSERT_GE(sessionFd, 0);
+
+  LoadPage(firstPage);
+  ASSERT_EQ(EINA_TRUE, ewk_view_session_data_write(GetEwkWebView(), sessionFd, EWK_SESSION_DATA_FULL));
+  LoadPage(testUrl);
+  ASSERT_EQ(EINA_TRUE, ewk_view_session_data_write(GetEwkWebView(), sessionFd, EWK_SESSION_DATA_DELTA));
+  LoadPage(lastPage);
+  ASSERT_EQ(EINA_TRUE, ewk_view_session_data_write(GetEwkWebView(), sessionFd, EWK_SESSION_DATA_DELTA));
+  ASSERT_EQ(EINA_TRUE, ewk_view_back(GetEwkWebView()));
+  ASSERT_EQ(Success, EventLoopStart());
+  ASSERT_EQ(EINA_TRUE, ewk_view_session_data_write(GetEwkWebView(), sessionFd, EWK_SESSION_DATA_DELTA));
+
+  CheckRestoredSession();
+}
+
+/**
+ * @brief Tests if compressed records restore the history, a first delta being written as a full record.
+ */
+TEST_F(utc_blink_ewk_view_session_data_write_func, POS_TEST_COMPRESSED)
+{
+  ASSERT_GE(sessionFd, 0);
+
+  LoadPage(firstPage);
+  LoadPage(testUrl);
+  ASSERT_EQ(EINA_TRUE, ewk_view_session_data_write(GetEwkWebView(), sessionFd,
+                                                   EWK_SESSION_DATA_DELTA | EWK_SESSION_DATA_COMPRESSED));
+  LoadPage(lastPage);
+  ASSERT_EQ(EINA_TRUE, ewk_view_back(GetEwkWebView()));
+  ASSERT_EQ(Success, EventLoopStart());
+  ASSERT_EQ(EINA_TRUE, ewk_view_session_data_write(GetEwkWebView(), sessionFd,
+                                                   EWK_SESSION_DATA_DELTA | EWK_SESSION_DATA_COMPRESSED));
+
+  CheckRestoredSession();
+}
+
+/**
+ * @brief Tests if a truncated session file is refused.
+ */
+TEST_F(utc_blink_ewk_view_session_data_write_func, NEG_TEST_TRUNCATED_DATA)
+{
+  ASSERT_GE(sessionFd, 0);
+
+  LoadPage(firstPage);
+  ASSERT_EQ(EINA_TRUE, ewk_view_session_data_write(GetEwkWebView(), sessionFd, EWK_SESSION_DATA_FULL));
+
+  std::string session = ReadSessionFile();
+  ASSERT_GT(session.size(), 1u);
+  ASSERT_FALSE(ewk_view_add_with_session_data(GetEwkEvas(), session.data(), session.size() - 1));
+}
+
+/**
+ * @brief Tests if returns EINA_FALSE when called with an invalid file descriptor.
+ */
+TEST_F(utc_blink_ewk_view_session_data_write_func, NEG_TEST_INVALID_FD)
+{
+  LoadPage(firstPage);
+  ASSERT_EQ(EINA_FALSE, ewk_view_session_data_write(GetEwkWebView(), -1, EWK_SESSION_DATA_FULL));
+}
+
+/**
+ * @brief Tests if returns EINA_FALSE when called with NULL webview object.
+ */
+TEST_F(utc_blink_ewk_view_session_data_write_func, NEG_TEST_NULL_WEBVIEW)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_view_session_data_write(NULL, sessionFd, EWK_SESSION_DATA_FULL));
+}
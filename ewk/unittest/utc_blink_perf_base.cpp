@@ -0,0 +1,338 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file   utc_blink_perf_base.cpp
+ * @brief  Shared code of the Chromium EFL benchmarks
+ */
+
+#include "utc_blink_perf_base.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "ewk_main_private.h"
+
+namespace {
+
+/* Value of |key| in a /proc/<pid>/status file, in kB */
+long ReadStatusValue(const std::string& path, const char* key)
+{
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file)
+        return 0;
+
+    long value = 0;
+    size_t key_length = strlen(key);
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        if (!strncmp(line, key, key_length) && line[key_length] == ':') {
+            value = atol(line + key_length + 1);
+            break;
+        }
+    }
+    fclose(file);
+    return value;
+}
+
+/* Parent pid as found in /proc/<pid>/stat, or 0 */
+pid_t ReadParentPid(pid_t pid)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return 0;
+
+    char stat[512];
+    size_t length = fread(stat, 1, sizeof(stat) - 1, file);
+    fclose(file);
+    stat[length] = '\0';
+
+    /* The command name may hold spaces and parentheses, skip past its end */
+    const char* fields = strrchr(stat, ')');
+    int ppid = 0;
+    if (!fields || sscanf(fields + 1, " %*c %d", &ppid) != 1)
+        return 0;
+    return ppid;
+}
+
+bool IsRenderer(pid_t pid)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/cmdline", pid);
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    std::string cmdline;
+    char buffer[1024];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        cmdline.append(buffer, length);
+    fclose(file);
+
+    /* Arguments are separated by NUL characters */
+    return cmdline.find(std::string("--type=renderer", sizeof("--type=renderer"))) != std::string::npos;
+}
+
+/* Sum of the RSS of the renderers descending from this process, in kB */
+long RenderersRss()
+{
+    DIR* proc = opendir("/proc");
+    if (!proc)
+        return 0;
+
+    std::map<pid_t, pid_t> parents;
+    struct dirent* entry;
+    while ((entry = readdir(proc))) {
+        pid_t pid = atoi(entry->d_name);
+        if (pid > 0)
+            parents[pid] = ReadParentPid(pid);
+    }
+    closedir(proc);
+
+    pid_t self = getpid();
+    long rss = 0;
+    for (std::map<pid_t, pid_t>::const_iterator it = parents.begin(); it != parents.end(); ++it) {
+        /* Renderers may be forked by a zygote, follow the chain up a bit */
+        pid_t ancestor = it->second;
+        for (int depth = 0; depth < 4 && ancestor > 1 && ancestor != self; ++depth) {
+            std::map<pid_t, pid_t>::const_iterator parent = parents.find(ancestor);
+            ancestor = parent != parents.end() ? parent->second : 0;
+        }
+        if (ancestor != self || !IsRenderer(it->first))
+            continue;
+
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/%d/status", it->first);
+        rss += ReadStatusValue(path, "VmRSS");
+    }
+    return rss;
+}
+
+/* CPU time used by the main (UI) thread, in seconds */
+double MainThreadCpuTime()
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%d/schedstat", getpid());
+    FILE* file = fopen(path, "r");
+    if (file) {
+        unsigned long long run_ns = 0;
+        int matched = fscanf(file, "%llu", &run_ns);
+        fclose(file);
+        if (matched == 1)
+            return run_ns / 1e9;
+    }
+
+    /* Kernels without schedstat, only accurate to a clock tick */
+    snprintf(path, sizeof(path), "/proc/self/task/%d/stat", getpid());
+    file = fopen(path, "r");
+    if (!file)
+        return 0;
+
+    char stat[512];
+    size_t length = fread(stat, 1, sizeof(stat) - 1, file);
+    fclose(file);
+    stat[length] = '\0';
+
+    const char* fields = strrchr(stat, ')');
+    unsigned long utime = 0, stime = 0;
+    if (!fields || sscanf(fields + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime, &stime) != 2)
+        return 0;
+    return static_cast<double>(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+double Percentile(const std::vector<double>& sorted, double percent)
+{
+    size_t rank = static_cast<size_t>(ceil(percent / 100.0 * sorted.size()));
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void WriteString(FILE* out, const std::string& value)
+{
+    fputc('"', out);
+    for (size_t i = 0; i < value.length(); ++i) {
+        if (value[i] == '"' || value[i] == '\\')
+            fputc('\\', out);
+        fputc(value[i], out);
+    }
+    fputc('"', out);
+}
+
+} // namespace
+
+utc_blink_perf_report& utc_blink_perf_report::Get()
+{
+    static utc_blink_perf_report report;
+    return report;
+}
+
+utc_blink_perf_report::utc_blink_perf_report()
+    : ewk_init_start(0)
+    , ewk_init_end(0)
+{
+}
+
+void utc_blink_perf_report::AddSample(const std::string& story, const std::string& metric, double value)
+{
+    stories[story][metric].push_back(value);
+}
+
+void utc_blink_perf_report::AddTraceEvent(const std::string& name, double start, double end)
+{
+    TraceEvent event;
+    event.name = name;
+    event.start = start;
+    event.end = end;
+    trace_events.push_back(event);
+}
+
+void utc_blink_perf_report::SetEwkInitTime(double start, double end)
+{
+    ewk_init_start = start;
+    ewk_init_end = end;
+    AddTraceEvent("ewk_init", start, end);
+}
+
+bool utc_blink_perf_report::Write() const
+{
+    const char* path = getenv("PERF_OUTPUT");
+    FILE* out = path ? fopen(path, "w") : stdout;
+    if (!out) {
+        utc_message("[perf] :: cannot write report to %s", path);
+        return false;
+    }
+
+    fprintf(out, "{\n  \"stories\": {");
+    for (Stories::const_iterator story = stories.begin(); story != stories.end(); ++story) {
+        fprintf(out, "%s\n    ", story == stories.begin() ? "" : ",");
+        WriteString(out, story->first);
+        fprintf(out, ": {");
+        for (Metrics::const_iterator metric = story->second.begin(); metric != story->second.end(); ++metric) {
+            std::vector<double> sorted(metric->second);
+            std::sort(sorted.begin(), sorted.end());
+            double sum = 0;
+            for (size_t i = 0; i < sorted.size(); ++i)
+                sum += sorted[i];
+
+            fprintf(out, "%s\n      ", metric == story->second.begin() ? "" : ",");
+            WriteString(out, metric->first);
+            fprintf(out, ": { \"count\": %zu, \"min\": %.3f, \"max\": %.3f, \"mean\": %.3f,"
+                    " \"median\": %.3f, \"p90\": %.3f, \"p99\": %.3f }",
+                    sorted.size(), sorted.front(), sorted.back(), sum / sorted.size(),
+                    Percentile(sorted, 50), Percentile(sorted, 90), Percentile(sorted, 99));
+        }
+        fprintf(out, "\n    }");
+    }
+    fprintf(out, "\n  }\n}\n");
+
+    if (out != stdout)
+        fclose(out);
+    return WriteTrace();
+}
+
+bool utc_blink_perf_report::WriteTrace() const
+{
+    const char* path = getenv("PERF_TRACE_OUTPUT");
+    if (!path || trace_events.empty())
+        return true;
+
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        utc_message("[perf] :: cannot write trace to %s", path);
+        return false;
+    }
+
+    /* Complete events, in microseconds, all on the main thread */
+    fprintf(out, "{\"traceEvents\": [");
+    for (size_t i = 0; i < trace_events.size(); ++i) {
+        fprintf(out, "%s\n  {\"cat\": \"ewk_perf\", \"ph\": \"X\", \"pid\": %d, \"tid\": %d, \"name\": ",
+                i ? "," : "", getpid(), getpid());
+        WriteString(out, trace_events[i].name);
+        fprintf(out, ", \"ts\": %.0f, \"dur\": %.0f}",
+                trace_events[i].start * 1e6, (trace_events[i].end - trace_events[i].start) * 1e6);
+    }
+    fprintf(out, "\n]}\n");
+    fclose(out);
+    return true;
+}
+
+utc_blink_perf_base::ProcessSample::ProcessSample()
+    : time(0)
+    , main_thread_busy(0)
+    , ipc_messages(0)
+{
+}
+
+utc_blink_perf_base::utc_blink_perf_base()
+    : utc_blink_ewk_base()
+    , iterations(GetEnvInt("PERF_ITERATIONS", 10))
+    , warmup_iterations(GetEnvInt("PERF_WARMUP_ITERATIONS", 1))
+{
+    /* Benchmarks should not pay for logging every page message */
+    SetLogJavascript(false);
+
+    const char* env_url = getenv("PERF_SERVER_URL");
+    if (env_url)
+        server_url = env_url;
+}
+
+std::string utc_blink_perf_base::GetCorpusUrl(const char* page) const
+{
+    if (server_url.empty())
+        return GetResourceUrl((std::string("perf/") + page).c_str());
+
+    std::string url = server_url;
+    if (url[url.length() - 1] != '/')
+        url.append("/");
+    url.append(page);
+    return url;
+}
+
+double utc_blink_perf_base::Now()
+{
+    /* Not ecore_time_get(), which is only monotonic once ecore is initialized */
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+utc_blink_perf_base::ProcessSample utc_blink_perf_base::SampleProcess()
+{
+    ProcessSample sample;
+    sample.time = Now();
+    sample.main_thread_busy = MainThreadCpuTime();
+    sample.ipc_messages = ewk_ipc_message_received_count_get();
+    return sample;
+}
+
+void utc_blink_perf_base::AddProcessSamples(const std::string& story, const ProcessSample& start, const ProcessSample& end)
+{
+    AddSample(story, "main_thread_busy_ms", (end.main_thread_busy - start.main_thread_busy) * 1000);
+    AddSample(story, "ipc_messages", end.ipc_messages - start.ipc_messages);
+}
+
+void utc_blink_perf_base::AddMemorySamples(const std::string& story)
+{
+    AddSample(story, "browser_rss_kb", ReadStatusValue("/proc/self/status", "VmRSS"));
+    AddSample(story, "renderers_rss_kb", RenderersRss());
+}
+
+void utc_blink_perf_base::AddSample(const std::string& story, const std::string& metric, double value)
+{
+    utc_message("[perf] :: %s %s %.3f", story.c_str(), metric.c_str(), value);
+    utc_blink_perf_report::Get().AddSample(story, metric, value);
+}
+
+int utc_blink_perf_base::GetEnvInt(const char* name, int default_value)
+{
+    const char* value = getenv(name);
+    if (!value || atoi(value) < 0)
+        return default_value;
+    return atoi(value);
+}
@@ -0,0 +1,149 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file   utc_blink_perf_base.h
+ * @brief  Shared code of the Chromium EFL benchmarks
+ *
+ * Benchmarks reuse the unit test harness, they only add process metrics
+ * sampled around the measured work and a report of the collected samples.
+ */
+
+#ifndef UTC_BLINK_PERF_BASE_H
+#define UTC_BLINK_PERF_BASE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utc_blink_ewk_base.h"
+
+/**
+ * Collects benchmark samples and writes their statistics as JSON.
+ *
+ * Samples are grouped by story, e.g. a page of the corpus, and by metric.
+ * For every metric the report holds count, min, max, mean, median, p90 and
+ * p99, percentiles being computed with the nearest rank method.
+ *
+ * Phases of the measured work may also be recorded as trace events, written
+ * to $PERF_TRACE_OUTPUT in the Trace Event Format. Timestamps come from the
+ * monotonic clock Chromium traces with, so the file can be looked at next to
+ * a trace recorded with --trace-startup.
+ */
+class utc_blink_perf_report
+{
+public:
+    static utc_blink_perf_report& Get();
+
+    void AddSample(const std::string& story, const std::string& metric, double value);
+
+    /**
+     * Records a phase of the measured work, times in seconds of Now()
+     */
+    void AddTraceEvent(const std::string& name, double start, double end);
+
+    /**
+     * Records the ewk_init() call of main(), which runs before any test
+     */
+    void SetEwkInitTime(double start, double end);
+    double EwkInitStart() const { return ewk_init_start; }
+    double EwkInitEnd() const { return ewk_init_end; }
+
+    /**
+     * Writes the report to $PERF_OUTPUT, or to stdout if it is not set,
+     * and the trace events to $PERF_TRACE_OUTPUT if set.
+     *
+     * @retval true on success, false if the output file could not be written
+     */
+    bool Write() const;
+
+private:
+    typedef std::map<std::string, std::vector<double> > Metrics;
+    typedef std::map<std::string, Metrics> Stories;
+
+    struct TraceEvent {
+        std::string name;
+        double start;
+        double end;
+    };
+
+    utc_blink_perf_report();
+
+    bool WriteTrace() const;
+
+    Stories stories;
+    std::vector<TraceEvent> trace_events;
+    double ewk_init_start;
+    double ewk_init_end;
+};
+
+/**
+ * Base of the benchmark fixtures.
+ *
+ * Iterations are read from $PERF_ITERATIONS and $PERF_WARMUP_ITERATIONS,
+ * pages are loaded from $PERF_SERVER_URL when set, e.g. the HTTP server
+ * started by perf_run.sh, and from the resource directory otherwise.
+ */
+class utc_blink_perf_base: public utc_blink_ewk_base
+{
+public:
+    /**
+     * Returns current time of the monotonic clock, in seconds
+     */
+    static double Now();
+
+    /**
+     * Returns the value of environment variable |name|, or |default_value|
+     * if it is not set or negative
+     */
+    static int GetEnvInt(const char* name, int default_value);
+
+protected:
+    /* Cheap process counters, sampled around the measured work */
+    struct ProcessSample {
+        ProcessSample();
+
+        double time;
+        double main_thread_busy;
+        unsigned ipc_messages;
+    };
+
+    utc_blink_perf_base();
+
+    int Iterations() const { return iterations; }
+    int WarmupIterations() const { return warmup_iterations; }
+
+    /**
+     * Returns url of a page of the benchmark corpus
+     *
+     * @param [in] page  page path, relative to the perf resource directory
+     */
+    std::string GetCorpusUrl(const char* page) const;
+
+    /**
+     * Samples the counters of the browser process
+     */
+    static ProcessSample SampleProcess();
+
+    /**
+     * Records main_thread_busy_ms and ipc_messages between two process
+     * samples under |story|.
+     */
+    void AddProcessSamples(const std::string& story, const ProcessSample& start, const ProcessSample& end);
+
+    /**
+     * Records the current RSS of the browser and of the renderers it spawned
+     * under |story|. Walks /proc, so keep it out of measured intervals.
+     */
+    void AddMemorySamples(const std::string& story);
+
+    void AddSample(const std::string& story, const std::string& metric, double value);
+
+private:
+    int iterations;
+    int warmup_iterations;
+    std::string server_url;
+};
+
+#endif // UTC_BLINK_PERF_BASE_H
@@ -0,0 +1,322 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file   utc_blink_perf_http_cache.cpp
+ * @brief  Cold start of the HTTP cache, per cache backend
+ *
+ * For every backend of --http-cache-backend, every sample spawns two fresh
+ * processes of this binary sharing an empty cache directory
+ * ($XDG_CACHE_HOME). Both serve the corpus from a local file server of
+ * their own, on $PERF_HTTP_CACHE_PORT (8098 by default), with responses
+ * cacheable for an hour, and load all its pages:
+ *   populate  - fills the cache, the server sees every request
+ *   open      - loads the pages again, from the cache written by populate
+ * and records
+ *   cold_open_ms         - first page load of open, which also opens the
+ *                          cache backend
+ *   warm_loads_ms        - all page loads of open
+ *   empty_cache_loads_ms - all page loads of populate
+ *   hit_rate             - share of the requests of populate that open did
+ *                          not send to the server
+ */
+
+#include "utc_blink_perf_base.h"
+
+#include <arpa/inet.h>
+#include <ftw.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+/* Set for the spawned processes, to "populate" or "open" */
+const char kCacheRunEnv[] = "PERF_HTTP_CACHE_RUN";
+/* Prefix of the lines spawned processes report samples with */
+const char kSamplePrefix[] = "PERF_SAMPLE ";
+
+const char* const kBackends[] = {
+    "blockfile",
+    "simple",
+};
+
+const char* const kPages[] = {
+    "article.html",
+    "gallery.html",
+    "scripted_list.html",
+    "table.html",
+};
+
+/**
+ * HTTP/1.0 server of the files under a directory, run on its own thread.
+ * Counts the requests it gets, which are the cache misses and revalidations
+ * of the engine.
+ */
+class LocalFileServer
+{
+public:
+    LocalFileServer()
+        : listen_socket(-1)
+        , requests(0)
+        , running(false)
+    {
+    }
+
+    ~LocalFileServer()
+    {
+        Stop();
+    }
+
+    bool Start(const std::string& root_dir, int port)
+    {
+        root = root_dir;
+        listen_socket = socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_socket < 0)
+            return false;
+
+        int reuse = 1;
+        setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(port);
+        if (bind(listen_socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) ||
+            listen(listen_socket, 16)) {
+            close(listen_socket);
+            listen_socket = -1;
+            return false;
+        }
+
+        running = !pthread_create(&thread, NULL, ThreadMain, this);
+        return running;
+    }
+
+    void Stop()
+    {
+        if (!running)
+            return;
+        /* Wakes up accept() */
+        shutdown(listen_socket, SHUT_RDWR);
+        pthread_join(thread, NULL);
+        close(listen_socket);
+        listen_socket = -1;
+        running = false;
+    }
+
+    int Requests() const
+    {
+        return __sync_fetch_and_add(const_cast<int*>(&requests), 0);
+    }
+
+private:
+    static void* ThreadMain(void* data)
+    {
+        LocalFileServer* server = static_cast<LocalFileServer*>(data);
+        int connection;
+        while ((connection = accept(server->listen_socket, NULL, NULL)) >= 0) {
+            server->Serve(connection);
+            close(connection);
+        }
+        return NULL;
+    }
+
+    void Serve(int connection)
+    {
+        char request[4096];
+        ssize_t length = recv(connection, request, sizeof(request) - 1, 0);
+        if (length <= 0)
+            return;
+        request[length] = '\0';
+        __sync_fetch_and_add(&requests, 1);
+
+        char path[1024];
+        if (sscanf(request, "GET %1023s", path) != 1 || strstr(path, "..")) {
+            Respond(connection, "400 Bad Request", NULL, 0);
+            return;
+        }
+        char* query = strchr(path, '?');
+        if (query)
+            *query = '\0';
+
+        gchar* contents = NULL;
+        gsize size = 0;
+        if (!g_file_get_contents((root + path).c_str(), &contents, &size, NULL)) {
+            Respond(connection, "404 Not Found", NULL, 0);
+            return;
+        }
+        Respond(connection, "200 OK", contents, size);
+        g_free(contents);
+    }
+
+    static void Respond(int connection, const char* status, const char* body, size_t size)
+    {
+        char headers[256];
+        int headers_length = snprintf(headers, sizeof(headers),
+                                      "HTTP/1.0 %s\r\n"
+                                      "Content-Length: %zu\r\n"
+                                      "Cache-Control: max-age=3600\r\n"
+                                      "Connection: close\r\n\r\n",
+                                      status, size);
+        send(connection, headers, headers_length, MSG_NOSIGNAL);
+        while (size > 0) {
+            ssize_t sent = send(connection, body, size, MSG_NOSIGNAL);
+            if (sent <= 0)
+                return;
+            body += sent;
+            size -= sent;
+        }
+    }
+
+    std::string root;
+    int listen_socket;
+    int requests;
+    bool running;
+    pthread_t thread;
+};
+
+int RemoveEntry(const char* path, const struct stat* stat, int type, struct FTW* ftw)
+{
+    return remove(path);
+}
+
+/**
+ * Runs this binary for |run| with |backend| and the cache under |cache_dir|,
+ * and collects the samples it reports.
+ *
+ * @retval false if the process could not be spawned or failed
+ */
+bool SpawnCacheRun(const char* backend, const char* run, const std::string& cache_dir,
+                   std::map<std::string, double>* samples)
+{
+    std::string backend_switch = std::string("--http-cache-backend=") + backend;
+    char* argv[] = {
+        const_cast<char*>("/proc/self/exe"),
+        const_cast<char*>("--gtest_filter=utc_blink_perf_http_cache.run"),
+        const_cast<char*>(backend_switch.c_str()),
+        NULL
+    };
+    gchar** envp = g_get_environ();
+    envp = g_environ_setenv(envp, kCacheRunEnv, run, TRUE);
+    envp = g_environ_setenv(envp, "XDG_CACHE_HOME", cache_dir.c_str(), TRUE);
+    envp = g_environ_setenv(envp, "PERF_OUTPUT", "/dev/null", TRUE);
+    envp = g_environ_unsetenv(envp, "PERF_TRACE_OUTPUT");
+
+    gchar* output = NULL;
+    gint status = 0;
+    GError* error = NULL;
+    gboolean spawned = g_spawn_sync(NULL, argv, envp, static_cast<GSpawnFlags>(0), NULL, NULL,
+                                    &output, NULL, &status, &error);
+    g_strfreev(envp);
+    if (!spawned) {
+        utc_message("[perf] :: cannot spawn %s run: %s", run, error->message);
+        g_error_free(error);
+        return false;
+    }
+
+    gchar** lines = g_strsplit(output, "\n", -1);
+    for (gchar** line = lines; *line; ++line) {
+        char metric[64];
+        double value;
+        if (strncmp(*line, kSamplePrefix, strlen(kSamplePrefix)) ||
+            sscanf(*line + strlen(kSamplePrefix), "%63s %lf", metric, &value) != 2)
+            continue;
+
+        utc_message("[perf] :: http_cache %s %s %s %.3f", backend, run, metric, value);
+        (*samples)[metric] = value;
+    }
+    g_strfreev(lines);
+    g_free(output);
+    return WIFEXITED(status) && !WEXITSTATUS(status);
+}
+
+} // namespace
+
+class utc_blink_perf_http_cache : public utc_blink_perf_base
+{
+protected:
+    static const char* CacheRun()
+    {
+        return getenv(kCacheRunEnv);
+    }
+
+    void LoadFinished(Evas_Object* webview)
+    {
+        EventLoopStop(Success);
+    }
+};
+
+/**
+ * @brief Spawns populate and open runs for every backend and records them
+ */
+TEST_F(utc_blink_perf_http_cache, cold)
+{
+    if (CacheRun())
+        return;
+
+    for (size_t backend = 0; backend < sizeof(kBackends) / sizeof(kBackends[0]); ++backend) {
+        std::string story = std::string("http_cache_") + kBackends[backend];
+        for (int i = 0; i < WarmupIterations() + Iterations(); ++i) {
+            gchar* cache_dir = g_dir_make_tmp("perf_http_cache_XXXXXX", NULL);
+            ASSERT_TRUE(cache_dir);
+
+            std::map<std::string, double> populate, open;
+            bool populated = SpawnCacheRun(kBackends[backend], "populate", cache_dir, &populate);
+            bool opened = populated && SpawnCacheRun(kBackends[backend], "open", cache_dir, &open);
+            nftw(cache_dir, RemoveEntry, 16, FTW_DEPTH | FTW_PHYS);
+            g_free(cache_dir);
+            ASSERT_TRUE(opened);
+            ASSERT_GT(populate["requests"], 0);
+
+            if (i < WarmupIterations())
+                continue;
+
+            AddSample(story, "cold_open_ms", open["first_load_ms"]);
+            AddSample(story, "warm_loads_ms", open["all_loads_ms"]);
+            AddSample(story, "empty_cache_loads_ms", populate["all_loads_ms"]);
+            AddSample(story, "hit_rate", 1 - open["requests"] / populate["requests"]);
+        }
+    }
+}
+
+/**
+ * @brief One populate or open run, only run in processes spawned by the cold test
+ */
+TEST_F(utc_blink_perf_http_cache, run)
+{
+    if (!CacheRun())
+        return;
+
+    int port = GetEnvInt("PERF_HTTP_CACHE_PORT", 8098);
+    LocalFileServer server;
+    ASSERT_TRUE(server.Start(GetResourcePath(""), port));
+
+    double first_load = 0;
+    double start = Now();
+    for (size_t i = 0; i < sizeof(kPages) / sizeof(kPages[0]); ++i) {
+        char url[256];
+        snprintf(url, sizeof(url), "http://127.0.0.1:%d/perf/%s", port, kPages[i]);
+        double load_start = Now();
+        ASSERT_TRUE(ewk_view_url_set(GetEwkWebView(), url));
+        ASSERT_EQ(Success, EventLoopStart());
+        if (!i)
+            first_load = Now() - load_start;
+    }
+    double all_loads = Now() - start;
+
+    /* Cache entries are written in the background, let them land before
+       the process exits */
+    if (!strcmp(CacheRun(), "populate"))
+        EventLoopWait(2.0);
+    server.Stop();
+
+    printf("%srequests %d\n", kSamplePrefix, server.Requests());
+    printf("%sfirst_load_ms %f\n", kSamplePrefix, first_load * 1000);
+    printf("%sall_loads_ms %f\n", kSamplePrefix, all_loads * 1000);
+    fflush(stdout);
+}
@@ -0,0 +1,119 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file   utc_blink_perf_page_load.cpp
+ * @brief  Page load benchmark over the pages of resources/perf
+ *
+ * Every page is loaded Iterations() times after WarmupIterations() unmeasured
+ * loads. For each load the benchmark records, from the navigation request:
+ *   load_started_ms   - "load,started", i.e. the navigation committed
+ *   first_paint_ms    - "frame,rendered", the first visually non-empty paint
+ *   load_finished_ms  - "load,finished"
+ * together with main thread busy time, renderer IPC messages and RSS.
+ */
+
+#include "utc_blink_perf_base.h"
+
+class utc_blink_perf_page_load : public utc_blink_perf_base
+{
+protected:
+    utc_blink_perf_page_load()
+        : navigation_start(0)
+        , load_started(0)
+        , first_paint(0)
+        , load_finished(0)
+    {
+    }
+
+    void PostSetUp()
+    {
+        evas_object_smart_callback_add(GetEwkWebView(), "frame,rendered", frame_rendered_cb, this);
+    }
+
+    void PreTearDown()
+    {
+        evas_object_smart_callback_del(GetEwkWebView(), "frame,rendered", frame_rendered_cb);
+    }
+
+    void LoadStarted(Evas_Object* webview)
+    {
+        if (!load_started)
+            load_started = Now();
+    }
+
+    void LoadFinished(Evas_Object* webview)
+    {
+        load_finished = Now();
+        if (first_paint)
+            EventLoopStop(Success);
+    }
+
+    static void frame_rendered_cb(void* data, Evas_Object* webview, void* event_info)
+    {
+        utc_blink_perf_page_load* owner = static_cast<utc_blink_perf_page_load*>(data);
+        if (owner->first_paint)
+            return;
+
+        owner->first_paint = Now();
+        if (owner->load_finished)
+            owner->EventLoopStop(Success);
+    }
+
+    /**
+     * Loads |page| of the corpus repeatedly and records the measurements
+     * under its name.
+     */
+    void MeasurePage(const char* page)
+    {
+        std::string url = GetCorpusUrl(page);
+        for (int i = 0; i < WarmupIterations() + Iterations(); ++i) {
+            /* A distinct url per iteration, so that every load is a new navigation */
+            char run_url[1024];
+            snprintf(run_url, sizeof(run_url), "%s?run=%d", url.c_str(), i);
+
+            load_started = first_paint = load_finished = 0;
+            ProcessSample start = SampleProcess();
+            navigation_start = start.time;
+            ASSERT_TRUE(ewk_view_url_set(GetEwkWebView(), run_url));
+            ASSERT_EQ(Success, EventLoopStart());
+            ProcessSample end = SampleProcess();
+
+            if (i < WarmupIterations())
+                continue;
+
+            AddSample(page, "load_started_ms", (load_started - navigation_start) * 1000);
+            AddSample(page, "first_paint_ms", (first_paint - navigation_start) * 1000);
+            AddSample(page, "load_finished_ms", (load_finished - navigation_start) * 1000);
+            AddProcessSamples(page, start, end);
+            AddMemorySamples(page);
+        }
+    }
+
+private:
+    double navigation_start;
+    double load_started;
+    double first_paint;
+    double load_finished;
+};
+
+TEST_F(utc_blink_perf_page_load, article)
+{
+    MeasurePage("article.html");
+}
+
+TEST_F(utc_blink_perf_page_load, gallery)
+{
+    MeasurePage("gallery.html");
+}
+
+TEST_F(utc_blink_perf_page_load, scripted_list)
+{
+    MeasurePage("scripted_list.html");
+}
+
+TEST_F(utc_blink_perf_page_load, table)
+{
+    MeasurePage("table.html");
+}
@@ -0,0 +1,147 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file   utc_blink_perf_tab_thumbnails.cpp
+ * @brief  Throughput of taking thumbnails of the open tabs
+ *
+ * $PERF_TABS views (8 by default) load the pages of the corpus in turn, as
+ * the tabs of a browser would. Every iteration then asks all of them for a
+ * thumbnail with ewk_view_screenshot_contents_get_async() at kThumbnailScale
+ * and records, from the first request to the last thumbnail:
+ *   thumbnails_ms           - time to get the thumbnails of all tabs
+ *   thumbnails_per_second   - tabs / thumbnails_ms
+ * together with main thread busy time and renderer IPC messages.
+ *
+ * Tabs stay shown, stacked in the window, so that each keeps the surface the
+ * thumbnail is scaled from.
+ */
+
+#include "utc_blink_perf_base.h"
+
+namespace {
+
+const char* const kTabPages[] = {
+    "article.html",
+    "gallery.html",
+    "scripted_list.html",
+    "table.html",
+};
+
+const float kThumbnailScale = 0.25f;
+
+} // namespace
+
+class utc_blink_perf_tab_thumbnails : public utc_blink_perf_base
+{
+protected:
+    utc_blink_perf_tab_thumbnails()
+        : pending_frames(0)
+        , pending_thumbnails(0)
+        , failed_thumbnails(0)
+    {
+    }
+
+    void PreTearDown()
+    {
+        for (size_t i = 0; i < tabs.size(); ++i)
+            evas_object_del(tabs[i]);
+        tabs.clear();
+    }
+
+    /**
+     * Adds |count| tabs and waits until every one has rendered its page.
+     */
+    bool OpenTabs(int count)
+    {
+        pending_frames = count;
+        for (int i = 0; i < count; ++i) {
+            Evas_Object* tab = ewk_view_add(GetEwkEvas());
+            evas_object_resize(tab, DEFAULT_WIDTH_OF_WINDOW, DEFAULT_HEIGHT_OF_WINDOW);
+            evas_object_show(tab);
+            evas_object_smart_callback_add(tab, "frame,rendered", frame_rendered_cb, this);
+            tabs.push_back(tab);
+
+            std::string url = GetCorpusUrl(kTabPages[i % (sizeof(kTabPages) / sizeof(kTabPages[0]))]);
+            if (!ewk_view_url_set(tab, url.c_str()))
+                return false;
+        }
+
+        bool rendered = EventLoopStart() == Success;
+        for (size_t i = 0; i < tabs.size(); ++i)
+            evas_object_smart_callback_del(tabs[i], "frame,rendered", frame_rendered_cb);
+        return rendered;
+    }
+
+    /**
+     * Requests a thumbnail of every tab and waits for all of them.
+     */
+    bool TakeThumbnails()
+    {
+        pending_thumbnails = tabs.size();
+        failed_thumbnails = 0;
+        for (size_t i = 0; i < tabs.size(); ++i) {
+            Evas_Coord width, height;
+            evas_object_geometry_get(tabs[i], NULL, NULL, &width, &height);
+            Eina_Rectangle area = { 0, 0, width, height };
+            if (!ewk_view_screenshot_contents_get_async(tabs[i], area, kThumbnailScale,
+                                                        GetEwkEvas(), thumbnail_cb, this))
+                return false;
+        }
+
+        return EventLoopStart() == Success && !failed_thumbnails;
+    }
+
+    static void frame_rendered_cb(void* data, Evas_Object* webview, void* event_info)
+    {
+        utc_blink_perf_tab_thumbnails* owner = static_cast<utc_blink_perf_tab_thumbnails*>(data);
+        /* Only the first frame of every tab counts */
+        evas_object_smart_callback_del(webview, "frame,rendered", frame_rendered_cb);
+        if (!--owner->pending_frames)
+            owner->EventLoopStop(Success);
+    }
+
+    static void thumbnail_cb(Evas_Object* image, void* user_data)
+    {
+        utc_blink_perf_tab_thumbnails* owner = static_cast<utc_blink_perf_tab_thumbnails*>(user_data);
+        if (image)
+            evas_object_del(image);
+        else
+            ++owner->failed_thumbnails;
+
+        if (!--owner->pending_thumbnails)
+            owner->EventLoopStop(Success);
+    }
+
+    std::vector<Evas_Object*> tabs;
+
+private:
+    int pending_frames;
+    int pending_thumbnails;
+    int failed_thumbnails;
+};
+
+TEST_F(utc_blink_perf_tab_thumbnails, open_tabs)
+{
+    int tab_count = GetEnvInt("PERF_TABS", 8);
+    ASSERT_GT(tab_count, 0);
+    ASSERT_TRUE(OpenTabs(tab_count));
+
+    char story[32];
+    snprintf(story, sizeof(story), "tab_thumbnails_%d", tab_count);
+    for (int i = 0; i < WarmupIterations() + Iterations(); ++i) {
+        ProcessSample start = SampleProcess();
+        ASSERT_TRUE(TakeThumbnails());
+        ProcessSample end = SampleProcess();
+
+        if (i < WarmupIterations())
+            continue;
+
+        double elapsed = end.time - start.time;
+        AddSample(story, "thumbnails_ms", elapsed * 1000);
+        AddSample(story, "thumbnails_per_second", tabs.size() / elapsed);
+        AddProcessSamples(story, start, end);
+    }
+    AddMemorySamples(story);
+}
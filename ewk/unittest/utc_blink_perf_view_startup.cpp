@@ -0,0 +1,286 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * @file   utc_blink_perf_view_startup.cpp
+ * @brief  Latency of creating ewk views until their first frame
+ *
+ * cold: every sample is a fresh process, spawned from this binary, which
+ *       records the phases of the first view of an application:
+ *         ewk_init_ms     - ewk_init()
+ *         context_ms      - ewk_context_default_get(), which starts the engine
+ *         view_add_ms     - ewk_view_add_with_context()
+ *         first_frame_ms  - from the view being added to the first frame of
+ *                           a small page, i.e. "frame,rendered"
+ *         total_ms        - from ewk_init() to the first frame
+ * warm: in this process, with the engine already running, records
+ *       context_ms for ewk_context_new() and view_add_ms and first_frame_ms
+ *       for additional views.
+ *
+ * Every phase is also recorded as a trace event, see utc_blink_perf_report.
+ */
+
+#include "utc_blink_perf_base.h"
+
+#include <stdio.h>
+#include <sys/wait.h>
+
+namespace {
+
+/* Set for the spawned cold start processes */
+const char kColdRunEnv[] = "PERF_STARTUP_COLD_RUN";
+/* Prefix of the lines cold start processes report samples with */
+const char kSamplePrefix[] = "PERF_SAMPLE ";
+
+const char kFirstFramePage[] =
+    "<html><body style='background: #1a4d8f; color: #fff'><h1>First frame</h1></body></html>";
+
+/* Trace file of the |run|th cold start process, next to the parent's one */
+std::string ColdRunTracePath(int run)
+{
+    std::string path = getenv("PERF_TRACE_OUTPUT");
+    const std::string extension(".json");
+    if (path.length() > extension.length() &&
+        !path.compare(path.length() - extension.length(), extension.length(), extension))
+        path.erase(path.length() - extension.length());
+
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "_cold%d.json", run);
+    return path + suffix;
+}
+
+} // namespace
+
+class utc_blink_perf_view_startup : public ::testing::Test
+{
+protected:
+    /* Phase boundaries of one view, in seconds */
+    struct ViewTimes {
+        double add_start;
+        double add_end;
+        double first_frame;
+    };
+
+    utc_blink_perf_view_startup()
+        : window(NULL)
+        , evas(NULL)
+        , first_frame(0)
+    {
+    }
+
+    /* No view is created up front, the engine must not start before the tests time it */
+    void SetUp()
+    {
+        window = elm_win_add(NULL, "Perf Launcher", ELM_WIN_BASIC);
+        elm_win_title_set(window, "Perf Launcher");
+        evas_object_resize(window, DEFAULT_WIDTH_OF_WINDOW, DEFAULT_HEIGHT_OF_WINDOW);
+        evas_object_show(window);
+        evas = evas_object_evas_get(window);
+    }
+
+    void TearDown()
+    {
+        evas_object_del(window);
+        window = NULL;
+        evas = NULL;
+    }
+
+    static bool IsColdRun()
+    {
+        return getenv(kColdRunEnv);
+    }
+
+    /**
+     * Adds a view in |context| and waits for the first frame of a small page.
+     *
+     * @retval the view, or NULL if no frame was rendered in time
+     */
+    Evas_Object* AddView(Ewk_Context* context, ViewTimes* times)
+    {
+        times->add_start = utc_blink_perf_base::Now();
+        Evas_Object* view = ewk_view_add_with_context(evas, context);
+        evas_object_resize(view, DEFAULT_WIDTH_OF_WINDOW, DEFAULT_HEIGHT_OF_WINDOW);
+        evas_object_show(view);
+        times->add_end = utc_blink_perf_base::Now();
+
+        first_frame = 0;
+        evas_object_smart_callback_add(view, "frame,rendered", frame_rendered_cb, this);
+        Ecore_Timer* timeout = ecore_timer_add(30.0, timeout_cb, this);
+        ewk_view_html_string_load(view, kFirstFramePage, NULL, NULL);
+        ecore_main_loop_begin();
+        evas_object_smart_callback_del(view, "frame,rendered", frame_rendered_cb);
+        if (first_frame)
+            ecore_timer_del(timeout);
+
+        times->first_frame = first_frame;
+        if (!first_frame) {
+            utc_message("[perf] :: no frame rendered");
+            evas_object_del(view);
+            return NULL;
+        }
+        return view;
+    }
+
+    /**
+     * Records the phases of a view added by AddView() under |story|
+     */
+    static void AddViewSamples(const std::string& story, const ViewTimes& times)
+    {
+        utc_blink_perf_report& report = utc_blink_perf_report::Get();
+        report.AddSample(story, "view_add_ms", (times.add_end - times.add_start) * 1000);
+        report.AddSample(story, "first_frame_ms", (times.first_frame - times.add_end) * 1000);
+        report.AddTraceEvent(story + " ewk_view_add", times.add_start, times.add_end);
+        report.AddTraceEvent(story + " first frame", times.add_end, times.first_frame);
+    }
+
+    static void frame_rendered_cb(void* data, Evas_Object* webview, void* event_info)
+    {
+        utc_blink_perf_view_startup* owner = static_cast<utc_blink_perf_view_startup*>(data);
+        if (owner->first_frame)
+            return;
+
+        owner->first_frame = utc_blink_perf_base::Now();
+        ecore_main_loop_quit();
+    }
+
+    static Eina_Bool timeout_cb(void* data)
+    {
+        ecore_main_loop_quit();
+        return ECORE_CALLBACK_CANCEL;
+    }
+
+private:
+    Evas_Object* window;
+    Evas* evas;
+    double first_frame;
+};
+
+/**
+ * @brief Spawns fresh processes of this binary and collects their cold start phases
+ */
+TEST_F(utc_blink_perf_view_startup, cold)
+{
+    if (IsColdRun())
+        return;
+
+    const char* trace_output = getenv("PERF_TRACE_OUTPUT");
+    int warmup = utc_blink_perf_base::GetEnvInt("PERF_WARMUP_ITERATIONS", 1);
+    int iterations = utc_blink_perf_base::GetEnvInt("PERF_ITERATIONS", 10);
+    for (int i = 0; i < warmup + iterations; ++i) {
+        char* argv[] = {
+            const_cast<char*>("/proc/self/exe"),
+            const_cast<char*>("--gtest_filter=utc_blink_perf_view_startup.cold_run"),
+            NULL
+        };
+        gchar** envp = g_get_environ();
+        envp = g_environ_setenv(envp, kColdRunEnv, "1", TRUE);
+        envp = g_environ_setenv(envp, "PERF_OUTPUT", "/dev/null", TRUE);
+        if (trace_output && i >= warmup)
+            envp = g_environ_setenv(envp, "PERF_TRACE_OUTPUT", ColdRunTracePath(i - warmup).c_str(), TRUE);
+        else
+            envp = g_environ_unsetenv(envp, "PERF_TRACE_OUTPUT");
+
+        gchar* output = NULL;
+        gint status = 0;
+        GError* error = NULL;
+        gboolean spawned = g_spawn_sync(NULL, argv, envp, static_cast<GSpawnFlags>(0), NULL, NULL,
+                                        &output, NULL, &status, &error);
+        g_strfreev(envp);
+        if (!spawned) {
+            utc_message("[perf] :: cannot spawn cold run: %s", error->message);
+            g_error_free(error);
+            FAIL();
+        }
+        EXPECT_TRUE(WIFEXITED(status) && !WEXITSTATUS(status));
+
+        int samples = 0;
+        gchar** lines = g_strsplit(output, "\n", -1);
+        for (gchar** line = lines; *line; ++line) {
+            char metric[64];
+            double value;
+            if (strncmp(*line, kSamplePrefix, strlen(kSamplePrefix)) ||
+                sscanf(*line + strlen(kSamplePrefix), "%63s %lf", metric, &value) != 2)
+                continue;
+
+            ++samples;
+            utc_message("[perf] :: view_startup_cold %s %.3f", metric, value);
+            if (i >= warmup)
+                utc_blink_perf_report::Get().AddSample("view_startup_cold", metric, value);
+        }
+        g_strfreev(lines);
+        g_free(output);
+        EXPECT_GT(samples, 0);
+    }
+}
+
+/**
+ * @brief One cold start, only run in processes spawned by the cold test
+ */
+TEST_F(utc_blink_perf_view_startup, cold_run)
+{
+    if (!IsColdRun())
+        return;
+
+    utc_blink_perf_report& report = utc_blink_perf_report::Get();
+    double context_start = utc_blink_perf_base::Now();
+    Ewk_Context* context = ewk_context_default_get();
+    double context_end = utc_blink_perf_base::Now();
+    ASSERT_TRUE(context);
+
+    ViewTimes times;
+    Evas_Object* view = AddView(context, &times);
+    ASSERT_TRUE(view);
+
+    report.AddTraceEvent("ewk_context_default_get", context_start, context_end);
+    report.AddTraceEvent("ewk_view_add", times.add_start, times.add_end);
+    report.AddTraceEvent("first frame", times.add_end, times.first_frame);
+
+    printf("%sewk_init_ms %f\n", kSamplePrefix, (report.EwkInitEnd() - report.EwkInitStart()) * 1000);
+    printf("%scontext_ms %f\n", kSamplePrefix, (context_end - context_start) * 1000);
+    printf("%sview_add_ms %f\n", kSamplePrefix, (times.add_end - times.add_start) * 1000);
+    printf("%sfirst_frame_ms %f\n", kSamplePrefix, (times.first_frame - times.add_end) * 1000);
+    printf("%stotal_ms %f\n", kSamplePrefix, (times.first_frame - report.EwkInitStart()) * 1000);
+    fflush(stdout);
+
+    evas_object_del(view);
+}
+
+/**
+ * @brief Additional contexts and views once the engine runs
+ */
+TEST_F(utc_blink_perf_view_startup, warm)
+{
+    if (IsColdRun())
+        return;
+
+    /* Starts the engine unless another test already did, and stays around
+       as the view an application would already have */
+    Ewk_Context* context = ewk_context_default_get();
+    ViewTimes times;
+    Evas_Object* first_view = AddView(context, &times);
+    ASSERT_TRUE(first_view);
+
+    int warmup = utc_blink_perf_base::GetEnvInt("PERF_WARMUP_ITERATIONS", 1);
+    int iterations = utc_blink_perf_base::GetEnvInt("PERF_ITERATIONS", 10);
+    for (int i = 0; i < warmup + iterations; ++i) {
+        double context_start = utc_blink_perf_base::Now();
+        Ewk_Context* new_context = ewk_context_new();
+        double context_end = utc_blink_perf_base::Now();
+        ASSERT_TRUE(new_context);
+        ewk_context_delete(new_context);
+
+        Evas_Object* view = AddView(context, &times);
+        ASSERT_TRUE(view);
+        evas_object_del(view);
+
+        if (i < warmup)
+            continue;
+
+        utc_blink_perf_report::Get().AddSample("view_startup_warm", "context_ms", (context_end - context_start) * 1000);
+        utc_blink_perf_report::Get().AddTraceEvent("view_startup_warm ewk_context_new", context_start, context_end);
+        AddViewSamples("view_startup_warm", times);
+    }
+
+    evas_object_del(first_view);
+}
@@ -19,6 +19,24 @@ void Ewk_Settings::setCurrentLegacyFontSizeMode(tizen_webview::Legacy_Font_Size_
 #endif
 }
 
+void Ewk_Settings::applyPreferences(content::WebPreferences* preferences) const {
+  preferences->fullscreen_enabled = m_preferences.fullscreen_enabled;
+  preferences->javascript_enabled = m_preferences.javascript_enabled;
+  preferences->loads_images_automatically = m_preferences.loads_images_automatically;
+  preferences->plugins_enabled = m_preferences.plugins_enabled;
+  preferences->force_enable_zoom = m_preferences.force_enable_zoom;
+  preferences->default_font_size = m_preferences.default_font_size;
+  preferences->default_encoding = m_preferences.default_encoding;
+  preferences->editable_link_behavior = m_preferences.editable_link_behavior;
+  preferences->uses_encoding_detector = m_preferences.uses_encoding_detector;
+  preferences->text_autosizing_enabled = m_preferences.text_autosizing_enabled;
+  preferences->font_scale_factor = m_preferences.font_scale_factor;
+  preferences->initial_list_style_position = m_preferences.initial_list_style_position;
+#if !defined(EWK_BRINGUP)
+  preferences->current_legacy_font_size_mode = m_preferences.current_legacy_font_size_mode;
+#endif
+}
+
 void Ewk_Settings::setDefaultTextEncoding(const char* encoding) {
   if (encoding)
     m_preferences.default_encoding = encoding;
@@ -93,6 +93,9 @@ class Ewk_Settings {
     Evas_Object* getEvasObject() { return m_evas_object; }
     content::WebPreferences& getPreferences() { return m_preferences; }
     const content::WebPreferences& getPreferences() const { return m_preferences; }
+    // Copies the preferences the ewk_settings API sets into |preferences|,
+    // leaving the ones content and the command line set as they are.
+    void applyPreferences(content::WebPreferences* preferences) const;
 #if defined(OS_TIZEN_TV)
     void setCacheBuilderEnabled(bool enable) { m_cacheBuilderEnabled = enable; }
 #endif
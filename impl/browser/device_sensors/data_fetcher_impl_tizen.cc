@@ -4,57 +4,49 @@
 
 #include "browser/device_sensors/data_fetcher_impl_tizen.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/memory/singleton.h"
 
 namespace content {
 
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-static sensor_h sensor_orientation_;
-static sensor_h sensor_accelerometer_;
-static sensor_h sensor_gyroscope_;
-static sensor_listener_h listener_orientation_;
-static sensor_listener_h listener_accelerometer_;
-static sensor_listener_h listener_gyroscope_;
-#endif
+namespace {
+
+// Rate of views that are visible but not focused, e.g. next to another
+// application. Their samples may come in batches.
+const int kReducedIntervalMilliseconds = 100;
+const int kReducedMaxBatchLatencyMilliseconds = 200;
+
+template<typename T>
+T* LoadBuffer(const base::subtle::AtomicWord* buffer) {
+  return reinterpret_cast<T*>(base::subtle::Acquire_Load(buffer));
+}
+
+template<typename T>
+void StoreBuffer(base::subtle::AtomicWord* buffer, T* value) {
+  base::subtle::Release_Store(buffer,
+      reinterpret_cast<base::subtle::AtomicWord>(value));
+}
+
+} // namespace
 
 DataFetcherImplTizen::DataFetcherImplTizen()
-    : device_motion_buffer_(NULL),
-      device_orientation_buffer_(NULL),
+    : motion_consumer_(NULL),
+      orientation_consumer_(NULL),
+      device_motion_buffer_(0),
+      device_orientation_buffer_(0),
       has_last_motion_data_(false),
       last_motion_timestamp_(0),
       is_orientation_buffer_ready_(false) {
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  sensor_get_default_sensor(SENSOR_ORIENTATION, &sensor_orientation_);
-  sensor_get_default_sensor(SENSOR_ACCELEROMETER, &sensor_accelerometer_);
-  sensor_get_default_sensor(SENSOR_GYROSCOPE, &sensor_gyroscope_);
-
-  sensor_create_listener(sensor_orientation_, &listener_orientation_);
-  sensor_create_listener(sensor_accelerometer_, &listener_accelerometer_);
-  sensor_create_listener(sensor_gyroscope_, &listener_gyroscope_);
-#else
-  sensor_create(&handle_);
-  sensor_orientation_set_cb(handle_,
-      kInertialSensorIntervalMicroseconds / 1000,
-      DataFetcherImplTizen::onOrientationChanged, this);
-#endif
+  for (int i = 0; i < SensorBackendTizen::SENSOR_TYPE_COUNT; ++i)
+    sensor_rates_[i] = SAMPLING_RATE_NONE;
+  backend_ = SensorBackendTizen::Create(&DataFetcherImplTizen::OnSample, this);
 }
 
 DataFetcherImplTizen::~DataFetcherImplTizen() {
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  sensor_listener_unset_event_cb(listener_orientation_);
-  sensor_listener_stop(listener_orientation_);
-  sensor_destroy_listener(listener_orientation_);
-
-  sensor_listener_unset_event_cb(listener_accelerometer_);
-  sensor_listener_stop(listener_accelerometer_);
-  sensor_destroy_listener(listener_accelerometer_);
-
-  sensor_listener_stop(listener_gyroscope_);
-  sensor_destroy_listener(listener_gyroscope_);
-#else
-  sensor_destroy(handle_);
-#endif
 }
 
 DataFetcherImplTizen* DataFetcherImplTizen::GetInstance() {
@@ -65,262 +57,233 @@ DataFetcherImplTizen* DataFetcherImplTizen::GetInstance() {
 bool DataFetcherImplTizen::StartFetchingDeviceMotionData(
     DeviceMotionHardwareBuffer* buffer) {
   DCHECK(buffer);
-  {
-    base::AutoLock autolock(motion_buffer_lock_);
-    device_motion_buffer_ = buffer;
-  }
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  sensor_listener_set_event_cb(listener_accelerometer_,
-      kInertialSensorIntervalMicroseconds / 1000,
-      DataFetcherImplTizen::onAccelerationChanged, this);
-#else
-  sensor_accelerometer_set_cb(handle_,
-      kInertialSensorIntervalMicroseconds / 1000,
-      DataFetcherImplTizen::onAccelerationChanged, this);
-#endif
-  return Start(CONSUMER_TYPE_MOTION);
+  base::AutoLock autolock(control_lock_);
+  motion_consumer_ = buffer;
+  UpdateSensors();
+  return sensor_rates_[SensorBackendTizen::SENSOR_TYPE_ACCELEROMETER] !=
+      SAMPLING_RATE_NONE || GetSamplingRate() == SAMPLING_RATE_NONE;
 }
 
 void DataFetcherImplTizen::StopFetchingDeviceMotionData() {
-  Stop(CONSUMER_TYPE_MOTION);
-  {
-    base::AutoLock autolock(motion_buffer_lock_);
-    if (device_motion_buffer_) {
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-      sensor_listener_unset_event_cb(listener_accelerometer_);
-#else
-      sensor_accelerometer_set_cb(handle_,
-          kInertialSensorIntervalMicroseconds / 1000, NULL, this);
-#endif
-      device_motion_buffer_ = NULL;
-    }
-  }
+  base::AutoLock autolock(control_lock_);
+  motion_consumer_ = NULL;
+  UpdateSensors();
 }
 
 bool DataFetcherImplTizen::StartFetchingDeviceOrientationData(
     DeviceOrientationHardwareBuffer* buffer) {
   DCHECK(buffer);
-  {
-    base::AutoLock autolock(orientation_buffer_lock_);
-    device_orientation_buffer_ = buffer;
-  }
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  sensor_listener_set_event_cb(listener_orientation_,
-      kInertialSensorIntervalMicroseconds / 1000,
-      DataFetcherImplTizen::onOrientationChanged, this);
-#else
-  sensor_orientation_set_cb(handle_,
-      kInertialSensorIntervalMicroseconds / 1000,
-      DataFetcherImplTizen::onOrientationChanged, this);
-#endif
-  bool success = Start(CONSUMER_TYPE_ORIENTATION);
-
-  {
-    base::AutoLock autolock(orientation_buffer_lock_);
-    // If Start() was unsuccessful then set the buffer ready flag to true
-    // to start firing all-null events.
-    SetOrientationBufferReadyStatus(!success);
-  }
-  return success;
+  base::AutoLock autolock(control_lock_);
+  orientation_consumer_ = buffer;
+  SetOrientationBufferReadyStatus(buffer, false);
+  UpdateSensors();
+  return sensor_rates_[SensorBackendTizen::SENSOR_TYPE_ORIENTATION] !=
+      SAMPLING_RATE_NONE || GetSamplingRate() == SAMPLING_RATE_NONE;
 }
 
 void DataFetcherImplTizen::StopFetchingDeviceOrientationData() {
-  Stop(CONSUMER_TYPE_ORIENTATION);
-  {
-    base::AutoLock autolock(orientation_buffer_lock_);
-    if (device_orientation_buffer_) {
-      SetOrientationBufferReadyStatus(false);
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-      sensor_listener_unset_event_cb(listener_orientation_);
-#else
-      sensor_orientation_set_cb(handle_,
-          kInertialSensorIntervalMicroseconds / 1000, NULL, this);
-#endif
-      device_orientation_buffer_ = NULL;
-    }
-  }
+  base::AutoLock autolock(control_lock_);
+  DeviceOrientationHardwareBuffer* buffer = orientation_consumer_;
+  orientation_consumer_ = NULL;
+  UpdateSensors();
+  if (buffer)
+    SetOrientationBufferReadyStatus(buffer, false);
 }
 
-bool DataFetcherImplTizen::Start(ConsumerType type) {
-  switch(type) {
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  case CONSUMER_TYPE_ORIENTATION:
-    return (SENSOR_ERROR_NONE == sensor_listener_start(listener_orientation_));
-  case CONSUMER_TYPE_MOTION:
-    if (SENSOR_ERROR_NONE != sensor_listener_start(listener_accelerometer_)) {
-      return false;
-    }
-    return (SENSOR_ERROR_NONE == sensor_listener_start(listener_gyroscope_));
-#else
-  case CONSUMER_TYPE_ORIENTATION:
-    return (SENSOR_ERROR_NONE == sensor_start(handle_, SENSOR_ORIENTATION));
-  case CONSUMER_TYPE_MOTION:
-    if (SENSOR_ERROR_NONE != sensor_start(handle_, SENSOR_ACCELEROMETER)) {
-      return false;
-    }
-    return (SENSOR_ERROR_NONE == sensor_start(handle_, SENSOR_GYROSCOPE));
-#endif
-  default:
-    NOTREACHED();
-    return false;
-  }
+void DataFetcherImplTizen::SetSamplingRate(const void* client,
+                                           SamplingRate rate) {
+  base::AutoLock autolock(control_lock_);
+  clients_[client] = rate;
+  UpdateSensors();
+}
 
+void DataFetcherImplTizen::RemoveClient(const void* client) {
+  base::AutoLock autolock(control_lock_);
+  clients_.erase(client);
+  UpdateSensors();
 }
 
-void DataFetcherImplTizen::Stop(ConsumerType type) {
-  switch(type) {
-  case CONSUMER_TYPE_ORIENTATION:
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-    sensor_listener_stop(listener_orientation_);
-#else
-    sensor_stop(handle_, SENSOR_ORIENTATION);
-#endif
-    return;
-  case CONSUMER_TYPE_MOTION:
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-    sensor_listener_stop(listener_accelerometer_);
-    sensor_listener_stop(listener_gyroscope_);
-#else
-    sensor_stop(handle_, SENSOR_ACCELEROMETER);
-    sensor_stop(handle_, SENSOR_GYROSCOPE);
-#endif
+DataFetcherImplTizen::SamplingRate
+DataFetcherImplTizen::GetSamplingRate() const {
+  if (clients_.empty())
+    return SAMPLING_RATE_FULL;
+
+  SamplingRate rate = SAMPLING_RATE_NONE;
+  for (std::map<const void*, SamplingRate>::const_iterator it =
+           clients_.begin(); it != clients_.end(); ++it) {
+    rate = std::max(rate, it->second);
+  }
+  return rate;
+}
+
+void DataFetcherImplTizen::UpdateSensors() {
+  control_lock_.AssertAcquired();
+  SamplingRate rate = GetSamplingRate();
+
+  const SensorBackendTizen::SensorType kMotion =
+      SensorBackendTizen::SENSOR_TYPE_ACCELEROMETER;
+  if (sensor_rates_[kMotion] == SAMPLING_RATE_NONE && motion_consumer_) {
+    // The sample path is idle, start it over.
     memset(&last_motion_data_, 0, sizeof(last_motion_data_));
     has_last_motion_data_ = false;
-    return;
-  default:
-    NOTREACHED();
-    return;
+    last_motion_timestamp_ = 0;
+    StoreBuffer(&device_motion_buffer_, motion_consumer_);
+  }
+  UpdateSensor(kMotion, motion_consumer_ != NULL, rate);
+  if (sensor_rates_[kMotion] == SAMPLING_RATE_NONE)
+    StoreBuffer<DeviceMotionHardwareBuffer>(&device_motion_buffer_, NULL);
+
+  const SensorBackendTizen::SensorType kOrientation =
+      SensorBackendTizen::SENSOR_TYPE_ORIENTATION;
+  if (sensor_rates_[kOrientation] == SAMPLING_RATE_NONE &&
+      orientation_consumer_) {
+    StoreBuffer(&device_orientation_buffer_, orientation_consumer_);
+  }
+  if (!UpdateSensor(kOrientation, orientation_consumer_ != NULL, rate)) {
+    // Fires all-null events instead of none.
+    SetOrientationBufferReadyStatus(orientation_consumer_, true);
+  }
+  if (sensor_rates_[kOrientation] == SAMPLING_RATE_NONE) {
+    StoreBuffer<DeviceOrientationHardwareBuffer>(&device_orientation_buffer_,
+                                                 NULL);
   }
 }
 
-//static
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-void DataFetcherImplTizen::onOrientationChanged(sensor_h sensor,
-    sensor_event_s *event, void* userData) {
-#else
-void DataFetcherImplTizen::onOrientationChanged(unsigned long long timestamp,
-    sensor_data_accuracy_e, float azimuth, float pitch, float roll, void* userData) {
-#endif
-  DataFetcherImplTizen *fetcher = static_cast<DataFetcherImplTizen*>(userData);
-  base::AutoLock autolock(fetcher->orientation_buffer_lock_);
-
-  if (!fetcher->device_orientation_buffer_)
-    return;
+bool DataFetcherImplTizen::UpdateSensor(SensorBackendTizen::SensorType type,
+                                        bool has_consumer,
+                                        SamplingRate rate) {
+  SamplingRate target = has_consumer ? rate : SAMPLING_RATE_NONE;
+  if (target == sensor_rates_[type])
+    return true;
+
+  if (target == SAMPLING_RATE_NONE) {
+    backend_->Stop(type);
+    sensor_rates_[type] = SAMPLING_RATE_NONE;
+    return true;
+  }
 
-  fetcher->device_orientation_buffer_->seqlock.WriteBegin();
+  bool full = target == SAMPLING_RATE_FULL;
+  int interval_ms = full ? kInertialSensorIntervalMicroseconds / 1000
+                         : kReducedIntervalMilliseconds;
+  int max_batch_latency_ms = full ? 0 : kReducedMaxBatchLatencyMilliseconds;
+  if (!backend_->Start(type, interval_ms, max_batch_latency_ms)) {
+    LOG(WARNING) << "Cannot start device sensor " << type;
+    backend_->Stop(type);
+    sensor_rates_[type] = SAMPLING_RATE_NONE;
+    return false;
+  }
+  sensor_rates_[type] = target;
+  return true;
+}
 
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  float azimuth = event->values[0];
-  float pitch = event->values[1];
-  float roll = event->values[2];
-#endif
+//static
+void DataFetcherImplTizen::OnSample(SensorBackendTizen::SensorType type,
+                                    const SensorBackendTizen::Sample& sample,
+                                    void* user_data) {
+  DataFetcherImplTizen* self = static_cast<DataFetcherImplTizen*>(user_data);
+  if (type == SensorBackendTizen::SENSOR_TYPE_ORIENTATION)
+    self->OnOrientationSample(sample);
+  else
+    self->OnAccelerationSample(sample);
+}
 
-  fetcher->device_orientation_buffer_->data.alpha = azimuth;
-  fetcher->device_orientation_buffer_->data.hasAlpha = true;
-  fetcher->device_orientation_buffer_->data.beta = pitch;
-  fetcher->device_orientation_buffer_->data.hasBeta = true;
-  fetcher->device_orientation_buffer_->data.gamma = roll;
-  fetcher->device_orientation_buffer_->data.hasGamma = true;
-  fetcher->device_orientation_buffer_->seqlock.WriteEnd();
+void DataFetcherImplTizen::OnOrientationSample(
+    const SensorBackendTizen::Sample& sample) {
+  DeviceOrientationHardwareBuffer* buffer =
+      LoadBuffer<DeviceOrientationHardwareBuffer>(&device_orientation_buffer_);
+  if (!buffer)
+    return;
 
-  if (!fetcher->is_orientation_buffer_ready_)
-    fetcher->SetOrientationBufferReadyStatus(true);
+  buffer->seqlock.WriteBegin();
+  buffer->data.alpha = sample.values[0];
+  buffer->data.hasAlpha = true;
+  buffer->data.beta = sample.values[1];
+  buffer->data.hasBeta = true;
+  buffer->data.gamma = sample.values[2];
+  buffer->data.hasGamma = true;
+  if (!is_orientation_buffer_ready_) {
+    buffer->data.absolute = true;
+    buffer->data.hasAbsolute = true;
+    buffer->data.allAvailableSensorsAreActive = true;
+    is_orientation_buffer_ready_ = true;
+  }
+  buffer->seqlock.WriteEnd();
 }
 
-//static
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-void DataFetcherImplTizen::onAccelerationChanged(sensor_h sensor,
-    sensor_event_s *event, void* userData) {
-#else
-void DataFetcherImplTizen::onAccelerationChanged(unsigned long long timestamp,
-    sensor_data_accuracy_e, float x, float y, float z, void* userData) {
-#endif
-  DataFetcherImplTizen *self = static_cast<DataFetcherImplTizen*>(userData);
-
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  float x = event->values[0];
-  float y = event->values[1];
-  float z = event->values[2];
-#endif
+void DataFetcherImplTizen::OnAccelerationSample(
+    const SensorBackendTizen::Sample& sample) {
+  DeviceMotionHardwareBuffer* buffer =
+      LoadBuffer<DeviceMotionHardwareBuffer>(&device_motion_buffer_);
+  if (!buffer)
+    return;
+
+  float x = sample.values[0];
+  float y = sample.values[1];
+  float z = sample.values[2];
 
   float gravityX = x * 0.2f;
   float gravityY = y * 0.2f;
   float gravityZ = z * 0.2f;
   bool accelerationAvailable = false;
 
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  unsigned long long timestamp = event->timestamp;
-#endif
-
-  double interval = static_cast<double>(self->last_motion_timestamp_ ?
-      (timestamp - self->last_motion_timestamp_) / 1000 :
+  double interval = static_cast<double>(last_motion_timestamp_ ?
+      (sample.timestamp - last_motion_timestamp_) / 1000 :
       kInertialSensorIntervalMicroseconds / 1000);
-  self->last_motion_timestamp_ = timestamp;
+  last_motion_timestamp_ = sample.timestamp;
 
-  if (self->has_last_motion_data_) {
-    const blink::WebDeviceMotionData* m = &self->last_motion_data_;
+  if (has_last_motion_data_) {
+    const blink::WebDeviceMotionData* m = &last_motion_data_;
     gravityX += (m->accelerationIncludingGravityX - m->accelerationX) * 0.8f;
     gravityY += (m->accelerationIncludingGravityY - m->accelerationY) * 0.8f;
     gravityZ += (m->accelerationIncludingGravityZ - m->accelerationZ) * 0.8f;
     accelerationAvailable = true;
   }
 
-  float alpha, beta, gamma;
-  bool rotationRateAvailable = false;
-
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  sensor_event_s event_gyroscope;
-  if (!sensor_listener_read_data(listener_gyroscope_, &event_gyroscope))
-    rotationRateAvailable = true;
-
-  alpha = event_gyroscope.values[0];
-  beta = event_gyroscope.values[1];
-  gamma = event_gyroscope.values[2];
-#else
-  if (!sensor_gyroscope_read_data(self->handle_, 0, &alpha, &beta, &gamma))
-    rotationRateAvailable = true;
-#endif
-
-  self->device_motion_buffer_->seqlock.WriteBegin();
-
-  self->device_motion_buffer_->data.accelerationIncludingGravityX = x;
-  self->device_motion_buffer_->data.hasAccelerationIncludingGravityX = true;
-  self->device_motion_buffer_->data.accelerationIncludingGravityY = y;
-  self->device_motion_buffer_->data.hasAccelerationIncludingGravityY = true;
-  self->device_motion_buffer_->data.accelerationIncludingGravityZ = z;
-  self->device_motion_buffer_->data.hasAccelerationIncludingGravityZ = true;
-
-  self->device_motion_buffer_->data.accelerationX = x - gravityX;
-  self->device_motion_buffer_->data.hasAccelerationX = accelerationAvailable;
-  self->device_motion_buffer_->data.accelerationY = y - gravityY;
-  self->device_motion_buffer_->data.hasAccelerationY = accelerationAvailable;
-  self->device_motion_buffer_->data.accelerationZ = z - gravityZ;
-  self->device_motion_buffer_->data.hasAccelerationZ = accelerationAvailable;
-
-  self->device_motion_buffer_->data.rotationRateAlpha = alpha;
-  self->device_motion_buffer_->data.hasRotationRateAlpha = rotationRateAvailable;
-  self->device_motion_buffer_->data.rotationRateBeta = beta;
-  self->device_motion_buffer_->data.hasRotationRateBeta = rotationRateAvailable;
-  self->device_motion_buffer_->data.rotationRateGamma = gamma;
-  self->device_motion_buffer_->data.hasRotationRateGamma = rotationRateAvailable;
-
-  self->device_motion_buffer_->data.allAvailableSensorsAreActive =
+  float alpha = 0, beta = 0, gamma = 0;
+  bool rotationRateAvailable =
+      backend_->ReadRotationRate(&alpha, &beta, &gamma);
+
+  buffer->seqlock.WriteBegin();
+
+  buffer->data.accelerationIncludingGravityX = x;
+  buffer->data.hasAccelerationIncludingGravityX = true;
+  buffer->data.accelerationIncludingGravityY = y;
+  buffer->data.hasAccelerationIncludingGravityY = true;
+  buffer->data.accelerationIncludingGravityZ = z;
+  buffer->data.hasAccelerationIncludingGravityZ = true;
+
+  buffer->data.accelerationX = x - gravityX;
+  buffer->data.hasAccelerationX = accelerationAvailable;
+  buffer->data.accelerationY = y - gravityY;
+  buffer->data.hasAccelerationY = accelerationAvailable;
+  buffer->data.accelerationZ = z - gravityZ;
+  buffer->data.hasAccelerationZ = accelerationAvailable;
+
+  buffer->data.rotationRateAlpha = alpha;
+  buffer->data.hasRotationRateAlpha = rotationRateAvailable;
+  buffer->data.rotationRateBeta = beta;
+  buffer->data.hasRotationRateBeta = rotationRateAvailable;
+  buffer->data.rotationRateGamma = gamma;
+  buffer->data.hasRotationRateGamma = rotationRateAvailable;
+
+  buffer->data.allAvailableSensorsAreActive =
       (accelerationAvailable && rotationRateAvailable);
 
-  self->last_motion_data_ = self->device_motion_buffer_->data;
-  self->has_last_motion_data_ = true;
+  last_motion_data_ = buffer->data;
+  has_last_motion_data_ = true;
 
-  self->device_motion_buffer_->data.interval = interval;
+  buffer->data.interval = interval;
 
-  self->device_motion_buffer_->seqlock.WriteEnd();
+  buffer->seqlock.WriteEnd();
 }
 
-void DataFetcherImplTizen::SetOrientationBufferReadyStatus(bool ready) {
-  device_orientation_buffer_->seqlock.WriteBegin();
-  device_orientation_buffer_->data.absolute = ready;
-  device_orientation_buffer_->data.hasAbsolute = ready;
-  device_orientation_buffer_->data.allAvailableSensorsAreActive = ready;
-  device_orientation_buffer_->seqlock.WriteEnd();
+void DataFetcherImplTizen::SetOrientationBufferReadyStatus(
+    DeviceOrientationHardwareBuffer* buffer, bool ready) {
+  buffer->seqlock.WriteBegin();
+  buffer->data.absolute = ready;
+  buffer->data.hasAbsolute = ready;
+  buffer->data.allAvailableSensorsAreActive = ready;
+  buffer->seqlock.WriteEnd();
   is_orientation_buffer_ready_ = ready;
 }
 
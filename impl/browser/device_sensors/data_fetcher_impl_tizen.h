@@ -5,14 +5,12 @@
 #ifndef DATA_FETCHER_IMPL_TIZEN_H_
 #define DATA_FETCHER_IMPL_TIZEN_H_
 
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-#include <sensor/sensor.h>
-#else
-#include <sensors.h>
-#endif
+#include <map>
 
+#include "base/atomicops.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/synchronization/lock.h"
+#include "browser/device_sensors/sensor_backend_tizen.h"
 #include "content/browser/device_sensors/inertial_sensor_consts.h"
 #include "content/common/device_sensors/device_motion_hardware_buffer.h"
 #include "content/common/device_sensors/device_orientation_hardware_buffer.h"
@@ -21,8 +19,23 @@ template<typename T> struct DefaultSingletonTraits;
 
 namespace content {
 
+// Fills the motion and orientation buffers shared with renderers.
+//
+// Sensors run only while a buffer has consumers, at the highest rate any
+// client asks for: views ask for the full rate while they are visible and
+// focused, a reduced and batched one while only visible, and none while
+// hidden. Sensors are paused while no client needs them.
+//
+// Samples are written with the seqlock of the buffers only, the sample
+// path never takes a lock.
 class DataFetcherImplTizen {
  public:
+  enum SamplingRate {
+    SAMPLING_RATE_NONE,
+    SAMPLING_RATE_REDUCED,
+    SAMPLING_RATE_FULL,
+  };
+
   static DataFetcherImplTizen* GetInstance();
 
   // Shared memory related methods.
@@ -33,43 +46,58 @@ class DataFetcherImplTizen {
       DeviceOrientationHardwareBuffer* buffer);
   void StopFetchingDeviceOrientationData();
 
-  virtual bool Start(ConsumerType);
-  virtual void Stop(ConsumerType);
+  // Sets the rate |client| needs samples at. Sensors run at the full rate
+  // while there are no clients at all.
+  void SetSamplingRate(const void* client, SamplingRate rate);
+  void RemoveClient(const void* client);
 
  protected:
   DataFetcherImplTizen();
   virtual ~DataFetcherImplTizen();
-#if !defined(TIZEN_LEGACY_V_2_2_1)
-  static void onOrientationChanged(sensor_h sensor, sensor_event_s *event, void* userData);
-  static void onAccelerationChanged(sensor_h sensor, sensor_event_s *event, void* userData);
-#else
-  static void onOrientationChanged(unsigned long long timestamp,
-                                   sensor_data_accuracy_e, float azimuth,
-                                   float pitch, float roll, void* userData);
-  static void onAccelerationChanged(unsigned long long timestamp,
-                                    sensor_data_accuracy_e, float x, float y,
-                                    float z, void* userData);
-#endif
 
  private:
   friend struct DefaultSingletonTraits<DataFetcherImplTizen>;
 
-  void SetOrientationBufferReadyStatus(bool ready);
-
-  DeviceMotionHardwareBuffer* device_motion_buffer_;
-  DeviceOrientationHardwareBuffer* device_orientation_buffer_;
+  static void OnSample(SensorBackendTizen::SensorType type,
+                       const SensorBackendTizen::Sample& sample,
+                       void* user_data);
+  void OnOrientationSample(const SensorBackendTizen::Sample& sample);
+  void OnAccelerationSample(const SensorBackendTizen::Sample& sample);
+
+  // Brings the sensors in line with the consumers and the clients. Called
+  // with |control_lock_| held.
+  void UpdateSensors();
+  // Returns false if |type| is needed but cannot be started.
+  bool UpdateSensor(SensorBackendTizen::SensorType type,
+                    bool has_consumer,
+                    SamplingRate rate);
+  SamplingRate GetSamplingRate() const;
+
+  // Only written while the sensors of the buffer are stopped.
+  void SetOrientationBufferReadyStatus(
+      DeviceOrientationHardwareBuffer* buffer, bool ready);
+
+  scoped_ptr<SensorBackendTizen> backend_;
+
+  // Guards the consumers, the clients and the state of the sensors. Not
+  // used on the sample path.
+  base::Lock control_lock_;
+  DeviceMotionHardwareBuffer* motion_consumer_;
+  DeviceOrientationHardwareBuffer* orientation_consumer_;
+  std::map<const void*, SamplingRate> clients_;
+  SamplingRate sensor_rates_[SensorBackendTizen::SENSOR_TYPE_COUNT];
+
+  // The buffers of running sensors, read by the sample path with acquire
+  // semantics.
+  base::subtle::AtomicWord device_motion_buffer_;
+  base::subtle::AtomicWord device_orientation_buffer_;
+
+  // Only used on the sample path, or while the sensors are stopped.
   blink::WebDeviceMotionData last_motion_data_;
   bool has_last_motion_data_;
   unsigned long long last_motion_timestamp_;
   bool is_orientation_buffer_ready_;
 
-  base::Lock motion_buffer_lock_;
-  base::Lock orientation_buffer_lock_;
-
-#if defined(TIZEN_LEGACY_V_2_2_1)
-  sensor_h handle_;
-#endif
-
   DISALLOW_COPY_AND_ASSIGN(DataFetcherImplTizen);
 };
 
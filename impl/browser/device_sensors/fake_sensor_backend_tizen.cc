@@ -0,0 +1,115 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/device_sensors/fake_sensor_backend_tizen.h"
+
+#include <cmath>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/message_loop/message_loop_proxy.h"
+
+namespace content {
+
+namespace {
+
+const float kStandardGravity = 9.80665f;
+// Degrees the fake device turns per second.
+const double kAzimuthSpeed = 10.0;
+
+} // namespace
+
+FakeSensorBackendTizen::FakeSensorBackendTizen(SampleCallback callback,
+                                               void* user_data)
+    : callback_(callback),
+      user_data_(user_data),
+      thread_("FakeDeviceSensors"),
+      start_time_(base::TimeTicks::Now()) {
+  for (int i = 0; i < SENSOR_TYPE_COUNT; ++i) {
+    interval_ms_[i] = 0;
+    generation_[i] = 0;
+    running_[i] = false;
+  }
+  thread_.Start();
+}
+
+FakeSensorBackendTizen::~FakeSensorBackendTizen() {
+  thread_.Stop();
+}
+
+bool FakeSensorBackendTizen::Start(SensorType type,
+                                   int interval_ms,
+                                   int max_batch_latency_ms) {
+  DCHECK_GT(interval_ms, 0);
+  {
+    base::AutoLock autolock(delivery_lock_);
+    running_[type] = true;
+  }
+  return thread_.message_loop_proxy()->PostTask(FROM_HERE,
+      base::Bind(&FakeSensorBackendTizen::SetIntervalOnThread,
+                 base::Unretained(this), type, interval_ms));
+}
+
+void FakeSensorBackendTizen::Stop(SensorType type) {
+  {
+    base::AutoLock autolock(delivery_lock_);
+    running_[type] = false;
+  }
+  // Only cancels the pending tick, it would not deliver anything anymore.
+  thread_.message_loop_proxy()->PostTask(FROM_HERE,
+      base::Bind(&FakeSensorBackendTizen::SetIntervalOnThread,
+                 base::Unretained(this), type, 0));
+}
+
+bool FakeSensorBackendTizen::ReadRotationRate(float* alpha,
+                                              float* beta,
+                                              float* gamma) {
+  *alpha = 0.0f;
+  *beta = 0.0f;
+  *gamma = static_cast<float>(kAzimuthSpeed);
+  return true;
+}
+
+void FakeSensorBackendTizen::SetIntervalOnThread(SensorType type,
+                                                 int interval_ms) {
+  // Cancels the pending tick, a running sensor starts over at the new
+  // interval.
+  interval_ms_[type] = interval_ms;
+  generation_[type]++;
+  if (interval_ms)
+    TickOnThread(type, generation_[type]);
+}
+
+void FakeSensorBackendTizen::TickOnThread(SensorType type, int generation) {
+  if (generation != generation_[type] || !interval_ms_[type])
+    return;
+
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start_time_;
+  Sample sample;
+  sample.timestamp = elapsed.InMicroseconds();
+  if (type == SENSOR_TYPE_ORIENTATION) {
+    sample.values[0] =
+        static_cast<float>(std::fmod(elapsed.InSecondsF() * kAzimuthSpeed,
+                                     360.0));
+    sample.values[1] = 0.0f;
+    sample.values[2] = 0.0f;
+  } else {
+    sample.values[0] = 0.0f;
+    sample.values[1] = 0.0f;
+    sample.values[2] = kStandardGravity;
+  }
+  {
+    base::AutoLock autolock(delivery_lock_);
+    if (running_[type])
+      callback_(type, sample, user_data_);
+  }
+
+  thread_.message_loop_proxy()->PostDelayedTask(FROM_HERE,
+      base::Bind(&FakeSensorBackendTizen::TickOnThread,
+                 base::Unretained(this), type, generation),
+      base::TimeDelta::FromMilliseconds(interval_ms_[type]));
+}
+
+} // namespace content
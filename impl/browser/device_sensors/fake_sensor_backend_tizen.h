@@ -0,0 +1,57 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAKE_SENSOR_BACKEND_TIZEN_H_
+#define FAKE_SENSOR_BACKEND_TIZEN_H_
+
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "browser/device_sensors/sensor_backend_tizen.h"
+
+namespace content {
+
+// Generates samples of a device lying flat and slowly turning around its
+// vertical axis, on a thread of its own, at the requested intervals.
+// Samples are delivered one by one, batching is not emulated.
+class FakeSensorBackendTizen : public SensorBackendTizen {
+ public:
+  FakeSensorBackendTizen(SampleCallback callback, void* user_data);
+  virtual ~FakeSensorBackendTizen();
+
+  // SensorBackendTizen implementation.
+  virtual bool Start(SensorType type,
+                     int interval_ms,
+                     int max_batch_latency_ms) override;
+  virtual void Stop(SensorType type) override;
+  virtual bool ReadRotationRate(float* alpha,
+                                float* beta,
+                                float* gamma) override;
+
+ private:
+  void SetIntervalOnThread(SensorType type, int interval_ms);
+  // Delivers a sample of |type| and schedules the next one, unless
+  // |generation| is outdated by a later SetIntervalOnThread().
+  void TickOnThread(SensorType type, int generation);
+
+  SampleCallback callback_;
+  void* user_data_;
+  base::Thread thread_;
+  base::TimeTicks start_time_;
+
+  // Only used on |thread_|.
+  int interval_ms_[SENSOR_TYPE_COUNT];
+  int generation_[SENSOR_TYPE_COUNT];
+
+  // Held while a sample is delivered. Stop() clears |running_| under it,
+  // so that no tick already on its way delivers a sample once it returns.
+  base::Lock delivery_lock_;
+  bool running_[SENSOR_TYPE_COUNT];
+
+  DISALLOW_COPY_AND_ASSIGN(FakeSensorBackendTizen);
+};
+
+} // namespace content
+
+#endif  // FAKE_SENSOR_BACKEND_TIZEN_H_
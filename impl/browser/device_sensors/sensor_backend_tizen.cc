@@ -0,0 +1,281 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/device_sensors/sensor_backend_tizen.h"
+
+#if !defined(TIZEN_LEGACY_V_2_2_1)
+#include <sensor/sensor.h>
+#else
+#include <sensors.h>
+#endif
+
+#include "base/command_line.h"
+#include "base/logging.h"
+#include "browser/device_sensors/fake_sensor_backend_tizen.h"
+#include "common/content_switches_efl.h"
+#include "content/browser/device_sensors/inertial_sensor_consts.h"
+
+namespace content {
+
+namespace {
+
+class CapiSensorBackend : public SensorBackendTizen {
+ public:
+  CapiSensorBackend(SampleCallback callback, void* user_data);
+  virtual ~CapiSensorBackend();
+
+  // SensorBackendTizen implementation.
+  virtual bool Start(SensorType type,
+                     int interval_ms,
+                     int max_batch_latency_ms) override;
+  virtual void Stop(SensorType type) override;
+  virtual bool ReadRotationRate(float* alpha,
+                                float* beta,
+                                float* gamma) override;
+
+ private:
+  void Deliver(SensorType type, unsigned long long timestamp,
+               float v0, float v1, float v2);
+
+#if !defined(TIZEN_LEGACY_V_2_2_1)
+  static void OnOrientationEvent(sensor_h sensor, sensor_event_s* event,
+                                 void* user_data);
+  static void OnAccelerometerEvent(sensor_h sensor, sensor_event_s* event,
+                                   void* user_data);
+
+  sensor_listener_h listeners_[SENSOR_TYPE_COUNT];
+  sensor_listener_h gyroscope_listener_;
+#else
+  static void OnOrientationEvent(unsigned long long timestamp,
+                                 sensor_data_accuracy_e, float azimuth,
+                                 float pitch, float roll, void* user_data);
+  static void OnAccelerometerEvent(unsigned long long timestamp,
+                                   sensor_data_accuracy_e, float x, float y,
+                                   float z, void* user_data);
+
+  // Sets the callback of |type| at |interval_ms|, or unsets it for NULL.
+  void SetCallback(SensorType type, int interval_ms, bool enabled);
+
+  sensor_h handle_;
+#endif
+
+  SampleCallback callback_;
+  void* user_data_;
+  bool started_[SENSOR_TYPE_COUNT];
+
+  DISALLOW_COPY_AND_ASSIGN(CapiSensorBackend);
+};
+
+CapiSensorBackend::CapiSensorBackend(SampleCallback callback, void* user_data)
+    : callback_(callback),
+      user_data_(user_data) {
+  for (int i = 0; i < SENSOR_TYPE_COUNT; ++i)
+    started_[i] = false;
+
+#if !defined(TIZEN_LEGACY_V_2_2_1)
+  sensor_h orientation, accelerometer, gyroscope;
+  sensor_get_default_sensor(SENSOR_ORIENTATION, &orientation);
+  sensor_get_default_sensor(SENSOR_ACCELEROMETER, &accelerometer);
+  sensor_get_default_sensor(SENSOR_GYROSCOPE, &gyroscope);
+
+  sensor_create_listener(orientation, &listeners_[SENSOR_TYPE_ORIENTATION]);
+  sensor_create_listener(accelerometer,
+                         &listeners_[SENSOR_TYPE_ACCELEROMETER]);
+  sensor_create_listener(gyroscope, &gyroscope_listener_);
+#else
+  sensor_create(&handle_);
+#endif
+}
+
+CapiSensorBackend::~CapiSensorBackend() {
+  Stop(SENSOR_TYPE_ORIENTATION);
+  Stop(SENSOR_TYPE_ACCELEROMETER);
+#if !defined(TIZEN_LEGACY_V_2_2_1)
+  for (int i = 0; i < SENSOR_TYPE_COUNT; ++i)
+    sensor_destroy_listener(listeners_[i]);
+  sensor_destroy_listener(gyroscope_listener_);
+#else
+  sensor_destroy(handle_);
+#endif
+}
+
+#if !defined(TIZEN_LEGACY_V_2_2_1)
+bool CapiSensorBackend::Start(SensorType type,
+                              int interval_ms,
+                              int max_batch_latency_ms) {
+  sensor_listener_h listener = listeners_[type];
+  if (started_[type]) {
+    sensor_listener_set_interval(listener, interval_ms);
+  } else {
+    sensor_listener_set_event_cb(listener, interval_ms,
+        type == SENSOR_TYPE_ORIENTATION ? OnOrientationEvent
+                                        : OnAccelerometerEvent,
+        this);
+    if (SENSOR_ERROR_NONE != sensor_listener_start(listener)) {
+      sensor_listener_unset_event_cb(listener);
+      return false;
+    }
+    if (type == SENSOR_TYPE_ACCELEROMETER &&
+        SENSOR_ERROR_NONE != sensor_listener_start(gyroscope_listener_)) {
+      sensor_listener_stop(listener);
+      sensor_listener_unset_event_cb(listener);
+      return false;
+    }
+    started_[type] = true;
+  }
+
+  // Sensors without a batching FIFO deliver every sample on time.
+  int result = sensor_listener_set_max_batch_latency(listener,
+                                                     max_batch_latency_ms);
+  if (result != SENSOR_ERROR_NONE && result != SENSOR_ERROR_NOT_SUPPORTED)
+    LOG(WARNING) << "Cannot set the batch latency of sensor " << type;
+  return true;
+}
+
+void CapiSensorBackend::Stop(SensorType type) {
+  if (!started_[type])
+    return;
+  sensor_listener_stop(listeners_[type]);
+  sensor_listener_unset_event_cb(listeners_[type]);
+  if (type == SENSOR_TYPE_ACCELEROMETER)
+    sensor_listener_stop(gyroscope_listener_);
+  started_[type] = false;
+}
+
+bool CapiSensorBackend::ReadRotationRate(float* alpha,
+                                         float* beta,
+                                         float* gamma) {
+  sensor_event_s event;
+  if (SENSOR_ERROR_NONE != sensor_listener_read_data(gyroscope_listener_,
+                                                     &event)) {
+    return false;
+  }
+  *alpha = event.values[0];
+  *beta = event.values[1];
+  *gamma = event.values[2];
+  return true;
+}
+
+//static
+void CapiSensorBackend::OnOrientationEvent(sensor_h sensor,
+                                           sensor_event_s* event,
+                                           void* user_data) {
+  static_cast<CapiSensorBackend*>(user_data)->Deliver(
+      SENSOR_TYPE_ORIENTATION, event->timestamp,
+      event->values[0], event->values[1], event->values[2]);
+}
+
+//static
+void CapiSensorBackend::OnAccelerometerEvent(sensor_h sensor,
+                                             sensor_event_s* event,
+                                             void* user_data) {
+  static_cast<CapiSensorBackend*>(user_data)->Deliver(
+      SENSOR_TYPE_ACCELEROMETER, event->timestamp,
+      event->values[0], event->values[1], event->values[2]);
+}
+#else
+bool CapiSensorBackend::Start(SensorType type,
+                              int interval_ms,
+                              int max_batch_latency_ms) {
+  // Setting the callback again is how the interval changes, this API has
+  // no batching.
+  SetCallback(type, interval_ms, true);
+  if (started_[type])
+    return true;
+
+  if (type == SENSOR_TYPE_ORIENTATION) {
+    if (SENSOR_ERROR_NONE != sensor_start(handle_, SENSOR_ORIENTATION)) {
+      SetCallback(type, interval_ms, false);
+      return false;
+    }
+  } else {
+    if (SENSOR_ERROR_NONE != sensor_start(handle_, SENSOR_ACCELEROMETER)) {
+      SetCallback(type, interval_ms, false);
+      return false;
+    }
+    if (SENSOR_ERROR_NONE != sensor_start(handle_, SENSOR_GYROSCOPE)) {
+      sensor_stop(handle_, SENSOR_ACCELEROMETER);
+      SetCallback(type, interval_ms, false);
+      return false;
+    }
+  }
+  started_[type] = true;
+  return true;
+}
+
+void CapiSensorBackend::Stop(SensorType type) {
+  if (!started_[type])
+    return;
+  if (type == SENSOR_TYPE_ORIENTATION) {
+    sensor_stop(handle_, SENSOR_ORIENTATION);
+  } else {
+    sensor_stop(handle_, SENSOR_ACCELEROMETER);
+    sensor_stop(handle_, SENSOR_GYROSCOPE);
+  }
+  SetCallback(type, kInertialSensorIntervalMicroseconds / 1000, false);
+  started_[type] = false;
+}
+
+bool CapiSensorBackend::ReadRotationRate(float* alpha,
+                                         float* beta,
+                                         float* gamma) {
+  return !sensor_gyroscope_read_data(handle_, 0, alpha, beta, gamma);
+}
+
+void CapiSensorBackend::SetCallback(SensorType type,
+                                    int interval_ms,
+                                    bool enabled) {
+  if (type == SENSOR_TYPE_ORIENTATION) {
+    sensor_orientation_set_cb(handle_, interval_ms,
+        enabled ? OnOrientationEvent : NULL, this);
+  } else {
+    sensor_accelerometer_set_cb(handle_, interval_ms,
+        enabled ? OnAccelerometerEvent : NULL, this);
+  }
+}
+
+//static
+void CapiSensorBackend::OnOrientationEvent(unsigned long long timestamp,
+                                           sensor_data_accuracy_e,
+                                           float azimuth, float pitch,
+                                           float roll, void* user_data) {
+  static_cast<CapiSensorBackend*>(user_data)->Deliver(
+      SENSOR_TYPE_ORIENTATION, timestamp, azimuth, pitch, roll);
+}
+
+//static
+void CapiSensorBackend::OnAccelerometerEvent(unsigned long long timestamp,
+                                             sensor_data_accuracy_e,
+                                             float x, float y, float z,
+                                             void* user_data) {
+  static_cast<CapiSensorBackend*>(user_data)->Deliver(
+      SENSOR_TYPE_ACCELEROMETER, timestamp, x, y, z);
+}
+#endif
+
+void CapiSensorBackend::Deliver(SensorType type, unsigned long long timestamp,
+                                float v0, float v1, float v2) {
+  Sample sample;
+  sample.timestamp = timestamp;
+  sample.values[0] = v0;
+  sample.values[1] = v1;
+  sample.values[2] = v2;
+  callback_(type, sample, user_data_);
+}
+
+} // namespace
+
+// static
+scoped_ptr<SensorBackendTizen> SensorBackendTizen::Create(
+    SampleCallback callback, void* user_data) {
+  if (CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kUseFakeDeviceSensors)) {
+    return scoped_ptr<SensorBackendTizen>(
+        new FakeSensorBackendTizen(callback, user_data));
+  }
+  return scoped_ptr<SensorBackendTizen>(
+      new CapiSensorBackend(callback, user_data));
+}
+
+} // namespace content
@@ -0,0 +1,58 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SENSOR_BACKEND_TIZEN_H_
+#define SENSOR_BACKEND_TIZEN_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+
+namespace content {
+
+// Source of the samples of DataFetcherImplTizen: the Tizen sensor
+// framework, or generated samples with the --use-fake-device-sensors
+// switch.
+class SensorBackendTizen {
+ public:
+  enum SensorType {
+    SENSOR_TYPE_ORIENTATION,
+    // Also runs the gyroscope, see ReadRotationRate().
+    SENSOR_TYPE_ACCELEROMETER,
+    SENSOR_TYPE_COUNT,
+  };
+
+  struct Sample {
+    // Microseconds, on the clock of the sensor.
+    unsigned long long timestamp;
+    // Azimuth, pitch and roll, or acceleration on the x, y and z axes.
+    float values[3];
+  };
+
+  // Runs on whichever thread the backend delivers samples on.
+  typedef void (*SampleCallback)(SensorType type,
+                                 const Sample& sample,
+                                 void* user_data);
+
+  static scoped_ptr<SensorBackendTizen> Create(SampleCallback callback,
+                                               void* user_data);
+
+  virtual ~SensorBackendTizen() {}
+
+  // Starts |type|, or changes its interval if it runs already. Where the
+  // sensor supports it, samples may be batched and delivered up to
+  // |max_batch_latency_ms| late, letting the device sleep in between.
+  virtual bool Start(SensorType type,
+                     int interval_ms,
+                     int max_batch_latency_ms) = 0;
+  // No sample of |type| is delivered once this returns, so that the sample
+  // path can be reset.
+  virtual void Stop(SensorType type) = 0;
+
+  // Latest gyroscope reading, while the accelerometer runs.
+  virtual bool ReadRotationRate(float* alpha, float* beta, float* gamma) = 0;
+};
+
+} // namespace content
+
+#endif  // SENSOR_BACKEND_TIZEN_H_
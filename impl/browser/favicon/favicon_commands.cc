@@ -150,6 +150,19 @@ bool InitDatabaseCommand::sqlExecute() {
   result = sqlite3_step(stmt);
   CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
 
+  sqlite3_finalize(stmt);
+  sqlite3_free(query);
+
+  query = sqlite3_mprintf("CREATE TABLE IF NOT EXISTS %q (%q TEXT PRIMARY KEY, %q INTEGER);",
+                          db()->faviconUrlToExpiryTable, db()->faviconUrlColumn,
+                          db()->expiresColumn);
+
+  result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
+  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+
+  result = sqlite3_step(stmt);
+  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
+
   sqlite3_finalize(stmt);
   sqlite3_free(query);
   return true;
@@ -164,6 +177,7 @@ bool LoadDatabaseCommand::sqlExecute()
 {
   db()->pageToFaviconUrl.clear();
   db()->faviconUrlToBitmap.clear();
+  db()->faviconUrlToExpiry.clear();
 
   char *query = sqlite3_mprintf("SELECT %q, %q FROM %q;", db()->pageUrlColumn,
                                 db()->faviconUrlColumn, db()->pageUrlToFaviconUrlTable);
@@ -199,6 +213,22 @@ bool LoadDatabaseCommand::sqlExecute()
   sqlite3_finalize(stmt);
   sqlite3_free(query);
 
+  query = sqlite3_mprintf("SELECT %q, %q FROM %q;", db()->faviconUrlColumn,
+                          db()->expiresColumn, db()->faviconUrlToExpiryTable);
+
+  result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
+  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+
+  while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+    GURL faviconUrl(reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0)));
+    db()->faviconUrlToExpiry[faviconUrl] =
+        base::Time::FromInternalValue(sqlite3_column_int64(stmt, 1));
+  }
+
+  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
+  sqlite3_finalize(stmt);
+  sqlite3_free(query);
+
   return true;
 }
 
@@ -210,12 +240,15 @@ ClearDatabaseCommand::ClearDatabaseCommand(FaviconDatabasePrivate *db)
 bool ClearDatabaseCommand::execute() {
   db()->pageToFaviconUrl.clear();
   db()->faviconUrlToBitmap.clear();
+  db()->faviconUrlToExpiry.clear();
+  db()->servedFaviconUrls.clear();
   return true;
 }
 
 bool ClearDatabaseCommand::sqlExecute() {
-  char *query = sqlite3_mprintf("DELETE FROM %q; DELETE FROM %q;",
-                                db()->faviconUrlToBitmapTable, db()->pageUrlToFaviconUrlTable);
+  char *query = sqlite3_mprintf("DELETE FROM %q; DELETE FROM %q; DELETE FROM %q;",
+                                db()->faviconUrlToExpiryTable, db()->faviconUrlToBitmapTable,
+                                db()->pageUrlToFaviconUrlTable);
 
   int result = sqlite3_exec(db()->sqlite, query, 0, 0, 0);
   sqlite3_free(query);
@@ -391,6 +424,7 @@ bool RemoveBitmapCommand::execute() {
   if (it != db()->faviconUrlToBitmap.end()) {
     db()->faviconUrlToBitmap.erase(it);
   }
+  db()->servedFaviconUrls.erase(GURL(m_faviconUrl));
   return true;
 }
 
@@ -408,3 +442,63 @@ bool RemoveBitmapCommand::sqlExecute() {
   sqlite3_free(query);
   return true;
 }
+
+// SET EXPIRATION
+SetExpirationCommand::SetExpirationCommand(FaviconDatabasePrivate *db,
+                                           const GURL &faviconUrl,
+                                           const base::Time &expires)
+  : Command("SetExpiration", db),
+    m_faviconUrl(faviconUrl.spec()),
+    m_expires(expires) {
+}
+
+bool SetExpirationCommand::execute() {
+  db()->faviconUrlToExpiry[GURL(m_faviconUrl)] = m_expires;
+  return true;
+}
+
+bool SetExpirationCommand::sqlExecute() {
+  char *query = sqlite3_mprintf("INSERT OR REPLACE INTO %q VALUES (?, ?);", db()->faviconUrlToExpiryTable);
+
+  sqlite3_stmt *stmt = 0;
+  int result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
+  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+
+  result = sqlite3_bind_text(stmt, 1, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
+  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
+  result = sqlite3_bind_int64(stmt, 2, m_expires.ToInternalValue());
+  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
+
+  result = sqlite3_step(stmt);
+  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
+
+  sqlite3_finalize(stmt);
+  sqlite3_free(query);
+  return true;
+}
+
+// LOAD BITMAP
+LoadBitmapCommand::LoadBitmapCommand(FaviconDatabasePrivate *db, const GURL &faviconUrl)
+  : Command("LoadBitmap", db),
+    m_faviconUrl(faviconUrl.spec()) {
+}
+
+bool LoadBitmapCommand::sqlExecute() {
+  char *query = sqlite3_mprintf("SELECT %q FROM %q WHERE %q = ? ;", db()->bitmapColumn,
+                                db()->faviconUrlToBitmapTable, db()->faviconUrlColumn);
+
+  sqlite3_stmt *stmt = 0;
+  int result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
+  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+
+  result = sqlite3_bind_text(stmt, 1, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
+  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
+
+  result = sqlite3_step(stmt);
+  CHECK_RESULT_MSG(query, result, SQLITE_ROW, stmt, false);
+  m_bitmap = deserialize(sqlite3_column_blob(stmt, 0));
+
+  sqlite3_finalize(stmt);
+  sqlite3_free(query);
+  return true;
+}
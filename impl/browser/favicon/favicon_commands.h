@@ -7,6 +7,7 @@
 
 #include "url/gurl.h"
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
 class FaviconDatabasePrivate;
@@ -133,4 +134,27 @@ class RemoveBitmapCommand : public Command {
   std::string m_faviconUrl;
 };
 
+class SetExpirationCommand : public Command {
+ public:
+  SetExpirationCommand(FaviconDatabasePrivate *db, const GURL &faviconUrl, const base::Time &expires);
+  bool execute();
+  bool sqlExecute();
+ private:
+  std::string m_faviconUrl;
+  base::Time m_expires;
+};
+
+// Reads back a bitmap whose pixels were dropped from memory by
+// FaviconDatabase::PurgeMemory().
+class LoadBitmapCommand : public Command {
+ public:
+  LoadBitmapCommand(FaviconDatabasePrivate *db, const GURL &faviconUrl);
+  bool execute() { return sqlExecute(); }
+  bool sqlExecute();
+  const SkBitmap &bitmap() const { return m_bitmap; }
+ private:
+  std::string m_faviconUrl;
+  SkBitmap m_bitmap;
+};
+
 #endif // FAVICON_COMMANDS_H
@@ -150,6 +150,18 @@ void FaviconDatabase::SetBitmapForFaviconURL(const SkBitmap &bitmap, const GURL
   ScheduleSync();
 }
 
+void FaviconDatabase::SetExpirationForFaviconURL(const base::Time &expires, const GURL &iconUrl) {
+  base::AutoLock locker(d->mutex);
+  if (d->privateBrowsing) {
+    return;
+  }
+  Command *cmd = new SetExpirationCommand(d.get(), iconUrl, expires);
+  cmd->execute();
+  d->commands.push(cmd);
+
+  ScheduleSync();
+}
+
 bool FaviconDatabase::ExistsForPageURL(const GURL &pageUrl) const {
   base::AutoLock locker(d->mutex);
   std::map<GURL, GURL>::const_iterator it = d->pageToFaviconUrl.find(pageUrl);
@@ -164,6 +176,11 @@ bool FaviconDatabase::ExistsForFaviconURL(const GURL &iconUrl) const {
   return d->existsForFaviconURL(iconUrl);
 }
 
+bool FaviconDatabase::IsFreshForFaviconURL(const GURL &iconUrl) const {
+  base::AutoLock locker(d->mutex);
+  return d->isFreshForFaviconURL(iconUrl);
+}
+
 void FaviconDatabase::Clear() {
   Command *cmd = new ClearDatabaseCommand(d.get());
   cmd->execute();
@@ -172,6 +189,25 @@ void FaviconDatabase::Clear() {
   ScheduleSync();
 }
 
+int64 FaviconDatabase::PurgeMemory() {
+  base::AutoLock locker(d->mutex);
+  // bitmaps of not yet synced commands can not be read back from SQLite
+  if (!d->sqlite || !d->commands.empty()) {
+    return 0;
+  }
+  int64 reclaimed = 0;
+  std::map<GURL, SkBitmap>::iterator it = d->faviconUrlToBitmap.begin();
+  for (; it != d->faviconUrlToBitmap.end(); ++it) {
+    // icons already handed out are likely to be asked for again
+    if (it->second.isNull() || d->servedFaviconUrls.count(it->first)) {
+      continue;
+    }
+    reclaimed += it->second.getSize();
+    it->second.reset();
+  }
+  return reclaimed;
+}
+
 void FaviconDatabase::SyncSQLite() {
   scoped_refptr<base::SingleThreadTaskRunner> ptr = content::BrowserThread::GetMessageLoopProxyForThread(content::BrowserThread::DB);
   ptr->PostTask(FROM_HERE, base::Bind(&FaviconDatabasePrivate::performSync, d->weakPtrFactory.GetWeakPtr()));
@@ -184,7 +220,7 @@ void FaviconDatabase::ScheduleSync() {
 }
 
 bool FaviconDatabase::IsDatabaseInitialized() {
-  std::string query("SELECT name FROM sqlite_master WHERE type='table' AND (name = ? OR name = ?);");
+  std::string query("SELECT name FROM sqlite_master WHERE type='table' AND (name = ? OR name = ? OR name = ?);");
 
   sqlite3_stmt *stmt;
   int result = sqlite3_prepare_v2(d->sqlite, query.c_str(), query.size(), &stmt, 0);
@@ -197,7 +233,13 @@ bool FaviconDatabase::IsDatabaseInitialized() {
     sqlite3_finalize(stmt);
     return false;
   }
-  result = sqlite3_bind_text(stmt, 2, d->faviconUrlToBitmapTable, strlen(d->faviconUrlColumn), SQLITE_STATIC);
+  result = sqlite3_bind_text(stmt, 2, d->faviconUrlToBitmapTable, strlen(d->faviconUrlToBitmapTable), SQLITE_STATIC);
+  if (result != SQLITE_OK) {
+    sqlite3_finalize(stmt);
+    return false;
+  }
+  // databases of older versions lack this one, InitDatabase() adds it
+  result = sqlite3_bind_text(stmt, 3, d->faviconUrlToExpiryTable, strlen(d->faviconUrlToExpiryTable), SQLITE_STATIC);
   if (result != SQLITE_OK) {
     sqlite3_finalize(stmt);
     return false;
@@ -208,7 +250,7 @@ bool FaviconDatabase::IsDatabaseInitialized() {
     ++count;
   }
 
-  if (result != SQLITE_DONE || count != 2) {
+  if (result != SQLITE_DONE || count != 3) {
     sqlite3_finalize(stmt);
     return false;
   }
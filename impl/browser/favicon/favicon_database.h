@@ -10,6 +10,7 @@
 #include "third_party/sqlite/sqlite3.h"
 #include "url/gurl.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "base/macros.h"
 
 struct FaviconDatabasePrivate;
@@ -37,9 +38,15 @@ class FaviconDatabase {
 
   void SetFaviconURLForPageURL(const GURL &iconUrl, const GURL &pageUrl);
   void SetBitmapForFaviconURL(const SkBitmap &bitmap, const GURL &iconUrl);
+  void SetExpirationForFaviconURL(const base::Time &expires, const GURL &iconUrl);
   bool ExistsForPageURL(const GURL &pageUrl) const;
   bool ExistsForFaviconURL(const GURL &iconUrl) const;
+  bool IsFreshForFaviconURL(const GURL &iconUrl) const;
   void Clear();
+  // Drops in-memory bitmaps already stored in SQLite that were never returned
+  // by the getters, they are read back on the DB thread when first asked for.
+  // Returns the number of bytes released.
+  int64 PurgeMemory();
 
  private:
   FaviconDatabase();
@@ -4,13 +4,16 @@
 
 #include "favicon_database_p.h"
 #include "favicon_commands.h"
+#include "base/bind.h"
 #include <iostream>
 
 const char *FaviconDatabasePrivate::pageUrlToFaviconUrlTable = "url_to_favicon_url";
 const char *FaviconDatabasePrivate::faviconUrlToBitmapTable = "favicon_url_to_bitmap";
+const char *FaviconDatabasePrivate::faviconUrlToExpiryTable = "favicon_url_to_expiry";
 const char *FaviconDatabasePrivate::pageUrlColumn = "page_url";
 const char *FaviconDatabasePrivate::faviconUrlColumn = "favicon_url";
 const char *FaviconDatabasePrivate::bitmapColumn = "bitmap";
+const char *FaviconDatabasePrivate::expiresColumn = "expires";
 
 GURL FaviconDatabasePrivate::faviconUrlForPageUrl(const GURL &pageUrl) const {
   std::map<GURL, GURL>::const_iterator it = pageToFaviconUrl.find(pageUrl);
@@ -20,13 +23,37 @@ GURL FaviconDatabasePrivate::faviconUrlForPageUrl(const GURL &pageUrl) const {
   return GURL();
 }
 
-SkBitmap FaviconDatabasePrivate::bitmapForFaviconUrl(const GURL &faviconUrl) const {
-  std::map<GURL, SkBitmap>::const_iterator it = faviconUrlToBitmap.find(faviconUrl);
-  if (it != faviconUrlToBitmap.end()) {
+SkBitmap FaviconDatabasePrivate::bitmapForFaviconUrl(const GURL &faviconUrl) {
+  std::map<GURL, SkBitmap>::iterator it = faviconUrlToBitmap.find(faviconUrl);
+  if (it == faviconUrlToBitmap.end()) {
+    return SkBitmap();
+  }
+  if (it->second.isNull()) {
+    // pixels were purged under memory pressure, they are still in SQLite;
+    // read them back on the DB thread, callers get the icon once it is there
+    if (sqlite && loadingFaviconUrls.insert(faviconUrl).second) {
+      taskRunner()->PostTask(FROM_HERE,
+          base::Bind(&FaviconDatabasePrivate::loadBitmap,
+                     weakPtrFactory.GetWeakPtr(), faviconUrl));
+    }
+    return SkBitmap();
+  }
+  servedFaviconUrls.insert(faviconUrl);
+  return it->second;
+}
 
-    return it->second;
+void FaviconDatabasePrivate::loadBitmap(const GURL &faviconUrl) {
+  base::AutoLock locker(mutex);
+  loadingFaviconUrls.erase(faviconUrl);
+  std::map<GURL, SkBitmap>::iterator it = faviconUrlToBitmap.find(faviconUrl);
+  // the icon may have been replaced or removed in the meantime
+  if (it == faviconUrlToBitmap.end() || !it->second.isNull() || !sqlite) {
+    return;
+  }
+  LoadBitmapCommand loadCmd(this, faviconUrl);
+  if (loadCmd.execute()) {
+    it->second = loadCmd.bitmap();
   }
-  return SkBitmap();
 }
 
 bool FaviconDatabasePrivate::existsForFaviconURL(const GURL &faviconUrl) const {
@@ -34,6 +61,15 @@ bool FaviconDatabasePrivate::existsForFaviconURL(const GURL &faviconUrl) const {
   return it != faviconUrlToBitmap.end();
 }
 
+bool FaviconDatabasePrivate::isFreshForFaviconURL(const GURL &faviconUrl) const {
+  if (!existsForFaviconURL(faviconUrl)) {
+    return false;
+  }
+  // icons stored before expiry times were kept are stale
+  std::map<GURL, base::Time>::const_iterator it = faviconUrlToExpiry.find(faviconUrl);
+  return it != faviconUrlToExpiry.end() && it->second > base::Time::Now();
+}
+
 scoped_refptr<base::SingleThreadTaskRunner> FaviconDatabasePrivate::taskRunner() const {
   return content::BrowserThread::GetMessageLoopProxyForThread(content::BrowserThread::DB);
 }
@@ -7,7 +7,9 @@
 
 #include <map>
 #include <queue>
+#include <set>
 #include "url/gurl.h"
+#include "base/time/time.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/sqlite/sqlite3.h"
 #include "base/single_thread_task_runner.h"
@@ -28,15 +30,23 @@ struct FaviconDatabasePrivate : public base::RefCountedThreadSafe<FaviconDatabas
   {}
 
   GURL faviconUrlForPageUrl(const GURL &pageUrl) const;
-  SkBitmap bitmapForFaviconUrl(const GURL &faviconUrl) const;
+  SkBitmap bitmapForFaviconUrl(const GURL &faviconUrl);
 
   bool existsForFaviconURL(const GURL &faviconUrl) const;
+  bool isFreshForFaviconURL(const GURL &faviconUrl) const;
 
   scoped_refptr<base::SingleThreadTaskRunner> taskRunner() const;
   void performSync();
+  void loadBitmap(const GURL &faviconUrl);
 
   std::map<GURL, GURL> pageToFaviconUrl;
   std::map<GURL, SkBitmap> faviconUrlToBitmap;
+  // until when the HTTP response of a favicon is fresh
+  std::map<GURL, base::Time> faviconUrlToExpiry;
+  // icons handed out by bitmapForFaviconUrl(), PurgeMemory() keeps them
+  std::set<GURL> servedFaviconUrls;
+  // purged icons being read back from SQLite on the DB thread
+  std::set<GURL> loadingFaviconUrls;
   std::string path;
   bool privateBrowsing;
 
@@ -48,9 +58,11 @@ struct FaviconDatabasePrivate : public base::RefCountedThreadSafe<FaviconDatabas
 
   static const char *pageUrlToFaviconUrlTable;
   static const char *faviconUrlToBitmapTable;
+  static const char *faviconUrlToExpiryTable;
   static const char *pageUrlColumn;
   static const char *faviconUrlColumn;
   static const char *bitmapColumn;
+  static const char *expiresColumn;
 };
 
 #endif // FAVICON_DATABASE_P_H
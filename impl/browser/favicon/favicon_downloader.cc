@@ -3,29 +3,155 @@
 // found in the LICENSE file.
 
 #include "favicon_downloader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
 #include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "browser/favicon/favicon_service.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/web_contents.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_response_info.h"
+#include "net/url_request/url_request.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/favicon_size.h"
+#include "ui/gfx/screen.h"
+
+using content::BrowserThread;
+
+namespace {
+
+// Icons whose response must be revalidated on every use are still not
+// downloaded again on every page load.
+const int kMinimumFreshnessHours = 1;
+// Icons without HTTP headers, e.g. data: URLs.
+const int kDefaultFreshnessHours = 24;
+// A renderer that hangs does not keep the views waiting for an icon.
+const int kDownloadTimeoutSeconds = 30;
+
+typedef std::map<GURL, FaviconDownloader *> DownloadMap;
+base::LazyInstance<DownloadMap> g_downloads = LAZY_INSTANCE_INITIALIZER;
 
-FaviconDownloader::FaviconDownloader(content::WebContents *webContents,
-                                     const GURL &faviconUrl,
-                                     FaviconDownloader::FaviconDownloaderCallback callback)
+int MaxDimension(const SkBitmap &bitmap) {
+  return std::max(bitmap.width(), bitmap.height());
+}
+
+// Prefers the largest frame that fits in |targetSize|, or else the
+// smallest one that does not.
+bool IsBetterFrame(const SkBitmap &frame, const SkBitmap &best,
+                   int targetSize) {
+  int size = MaxDimension(frame);
+  int bestSize = MaxDimension(best);
+  if (bestSize > targetSize)
+    return size < bestSize;
+  return size > bestSize && size <= targetSize;
+}
+
+} // namespace
+
+FaviconDownloader::Waiter::Waiter(FaviconDownloader *downloader,
+                                  content::WebContents *webContents,
+                                  const FaviconDownloaderCallback &callback)
   : content::WebContentsObserver(webContents),
-    m_faviconUrl(faviconUrl),
-    m_callback(callback),
+    m_downloader(downloader),
+    m_contents(webContents),
+    m_callback(callback) {
+}
+
+void FaviconDownloader::Waiter::RenderProcessGone(
+    base::TerminationStatus status) {
+  if (m_contents == m_downloader->m_downloadContents)
+    m_downloader->DownloadFailed(m_contents);
+}
+
+void FaviconDownloader::Waiter::WebContentsDestroyed() {
+  // Deletes this.
+  m_downloader->DownloadFailed(m_contents);
+}
+
+FaviconDownloader::FaviconDownloader(const GURL &faviconUrl)
+  : m_faviconUrl(faviconUrl),
+    m_targetSize(GetTargetSize()),
+    m_expires(base::Time::Now() +
+              base::TimeDelta::FromHours(kDefaultFreshnessHours)),
+    m_downloadContents(NULL),
     m_weakPtrFactory(this) {
 }
 
-void FaviconDownloader::Start() {
-  DownloadFavicon(m_faviconUrl);
+FaviconDownloader::~FaviconDownloader() {
+}
+
+void FaviconDownloader::Start(content::WebContents *webContents,
+                              const GURL &faviconUrl,
+                              const FaviconDownloaderCallback &callback) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  DownloadMap &downloads = g_downloads.Get();
+  DownloadMap::iterator it = downloads.find(faviconUrl);
+  if (it != downloads.end()) {
+    it->second->m_waiters.push_back(
+        new Waiter(it->second, webContents, callback));
+    return;
+  }
+
+  FaviconDownloader *downloader = new FaviconDownloader(faviconUrl);
+  downloads[faviconUrl] = downloader;
+  downloader->m_waiters.push_back(
+      new Waiter(downloader, webContents, callback));
+  downloader->DownloadFavicon(webContents);
 }
 
-int FaviconDownloader::DownloadFavicon(const GURL &faviconUrl) {
-  return web_contents()->DownloadImage(faviconUrl,
-                                       true,
-                                       0,
-                                       base::Bind(&FaviconDownloader::DidDownloadFavicon,
-                                                  m_weakPtrFactory.GetWeakPtr()));
+int FaviconDownloader::GetTargetSize() {
+  float scale = 1.0f;
+  gfx::Screen *screen = gfx::Screen::GetNativeScreen();
+  if (screen)
+    scale = screen->GetPrimaryDisplay().device_scale_factor();
+  return static_cast<int>(std::ceil(gfx::kFaviconSize * scale));
+}
+
+void FaviconDownloader::ResponseStarted(net::URLRequest *request) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  const net::HttpResponseHeaders *headers = request->response_headers();
+  if (!headers)
+    return;
+
+  const net::HttpResponseInfo &info = request->response_info();
+  base::Time now = base::Time::Now();
+  base::TimeDelta freshness =
+      headers->GetFreshnessLifetime(info.response_time) -
+      headers->GetCurrentAge(info.request_time, info.response_time, now);
+  freshness = std::max(freshness,
+                       base::TimeDelta::FromHours(kMinimumFreshnessHours));
+
+  // Downloads are keyed by the URL they were started for.
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&FaviconDownloader::SetExpiration,
+                 request->url_chain().front(), now + freshness));
+}
+
+void FaviconDownloader::SetExpiration(const GURL &faviconUrl,
+                                      base::Time expires) {
+  DownloadMap::iterator it = g_downloads.Get().find(faviconUrl);
+  if (it != g_downloads.Get().end())
+    it->second->m_expires = expires;
+}
+
+void FaviconDownloader::DownloadFavicon(content::WebContents *webContents) {
+  m_downloadContents = webContents;
+  m_timeout.Start(FROM_HERE,
+                  base::TimeDelta::FromSeconds(kDownloadTimeoutSeconds),
+                  this, &FaviconDownloader::DownloadTimedOut);
+  // The renderer scales frames larger than |m_targetSize| down before
+  // sending them.
+  webContents->DownloadImage(m_faviconUrl,
+                             true,
+                             m_targetSize,
+                             base::Bind(&FaviconDownloader::DidDownloadFavicon,
+                                        m_weakPtrFactory.GetWeakPtr()));
 }
 
 void FaviconDownloader::DidDownloadFavicon(int id,
@@ -34,8 +160,75 @@ void FaviconDownloader::DidDownloadFavicon(int id,
                                            const std::vector<SkBitmap> &bitmaps,
                                            const std::vector<gfx::Size> &originalBitmapSizes) {
   if (bitmaps.empty()) {
-    m_callback.Run(false, GURL(), SkBitmap());
+    Finish(false);
     return;
   }
-  m_callback.Run(true, imageUrl, bitmaps.front());
+
+  size_t best = 0;
+  for (size_t i = 1; i < bitmaps.size(); ++i) {
+    if (IsBetterFrame(bitmaps[i], bitmaps[best], m_targetSize))
+      best = i;
+  }
+
+  SkBitmap bitmap = bitmaps[best];
+  int size = MaxDimension(bitmap);
+  if (size > m_targetSize) {
+    float scale = static_cast<float>(m_targetSize) / size;
+    bitmap = skia::ImageOperations::Resize(
+        bitmap, skia::ImageOperations::RESIZE_BEST,
+        std::max(1, static_cast<int>(bitmap.width() * scale + 0.5f)),
+        std::max(1, static_cast<int>(bitmap.height() * scale + 0.5f)));
+  }
+
+  FaviconService fs;
+  fs.SetBitmapForFaviconURL(bitmap, m_faviconUrl);
+  fs.SetExpirationForFaviconURL(m_expires, m_faviconUrl);
+  Finish(true);
+}
+
+void FaviconDownloader::DownloadFailed(content::WebContents *webContents) {
+  std::vector<FaviconDownloaderCallback> callbacks;
+  ScopedVector<Waiter>::iterator it = m_waiters.begin();
+  while (it != m_waiters.end()) {
+    if ((*it)->contents() == webContents) {
+      callbacks.push_back((*it)->callback());
+      it = m_waiters.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  GURL faviconUrl = m_faviconUrl;
+  if (webContents == m_downloadContents) {
+    // A reply of the failed download is no longer expected.
+    m_weakPtrFactory.InvalidateWeakPtrs();
+    m_timeout.Stop();
+    m_downloadContents = NULL;
+    if (m_waiters.empty()) {
+      g_downloads.Get().erase(m_faviconUrl);
+      delete this;
+    } else {
+      DownloadFavicon(m_waiters.front()->contents());
+    }
+  }
+
+  for (size_t i = 0; i < callbacks.size(); ++i)
+    callbacks[i].Run(false, faviconUrl);
+}
+
+void FaviconDownloader::DownloadTimedOut() {
+  LOG(WARNING) << "Favicon download timed out: " << m_faviconUrl.spec();
+  DownloadFailed(m_downloadContents);
+}
+
+void FaviconDownloader::Finish(bool success) {
+  g_downloads.Get().erase(m_faviconUrl);
+  GURL faviconUrl = m_faviconUrl;
+  std::vector<FaviconDownloaderCallback> callbacks;
+  for (size_t i = 0; i < m_waiters.size(); ++i)
+    callbacks.push_back(m_waiters[i]->callback());
+  delete this;
+
+  for (size_t i = 0; i < callbacks.size(); ++i)
+    callbacks[i].Run(success, faviconUrl);
 }
@@ -5,9 +5,14 @@
 #ifndef FAVICON_DOWNLOADER_H
 #define FAVICON_DOWNLOADER_H
 
+#include <vector>
+
 #include "content/public/browser/web_contents_observer.h"
 #include "base/callback.h"
+#include "base/memory/scoped_vector.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 
 class SkBitmap;
 
@@ -15,32 +20,87 @@ namespace gfx {
 class Size;
 }
 
-// Class used for downloading favicons
-class FaviconDownloader : public content::WebContentsObserver {
+namespace net {
+class URLRequest;
+}
+
+// Class used for downloading favicons into the favicon database.
+//
+// A download is shared by all the views that need the same icon while it
+// is in flight. It runs in the renderer of one of them; when that view goes
+// away, its renderer dies or does not answer in time, the waiters of that
+// view fail and the download starts again from the view of another one.
+// The bitmap closest to the target size is scaled down to it once, before
+// it is stored, together with the time its HTTP response is fresh until, so
+// that fresh icons are not downloaded again.
+class FaviconDownloader {
  public:
-  typedef base::Callback<void(
-          bool success,
-          const GURL &faviconUrl,
-          const SkBitmap &bitmap)>
+  typedef base::Callback<void(bool success, const GURL &faviconUrl)>
       FaviconDownloaderCallback;
-  FaviconDownloader(content::WebContents *webContents,
+
+  // Downloads |faviconUrl| for |webContents| and runs |callback| once it is
+  // stored, or joins a download of it already in flight for any view.
+  static void Start(content::WebContents *webContents,
                     const GURL &faviconUrl,
-                    FaviconDownloaderCallback callback);
-  virtual ~FaviconDownloader() {}
+                    const FaviconDownloaderCallback &callback);
+
+  // Size in pixels favicons are stored at, the favicon size in DIPs at the
+  // scale factor of the primary display.
+  static int GetTargetSize();
 
-  void Start();
+  // Records until when the response of a favicon download is fresh, called
+  // on the IO thread when the response of |request| started.
+  static void ResponseStarted(net::URLRequest *request);
 
  private:
-  int DownloadFavicon(const GURL &faviconUrl);
+  // A view waiting for the icon.
+  class Waiter : public content::WebContentsObserver {
+   public:
+    Waiter(FaviconDownloader *downloader,
+           content::WebContents *webContents,
+           const FaviconDownloaderCallback &callback);
+
+    // Still valid in WebContentsDestroyed(), unlike web_contents().
+    content::WebContents *contents() const { return m_contents; }
+    const FaviconDownloaderCallback &callback() const { return m_callback; }
+
+   private:
+    // content::WebContentsObserver implementation.
+    virtual void RenderProcessGone(base::TerminationStatus status) override;
+    virtual void WebContentsDestroyed() override;
+
+    FaviconDownloader *m_downloader;
+    content::WebContents *m_contents;
+    FaviconDownloaderCallback m_callback;
+    DISALLOW_COPY_AND_ASSIGN(Waiter);
+  };
+
+  explicit FaviconDownloader(const GURL &faviconUrl);
+  ~FaviconDownloader();
+
+  static void SetExpiration(const GURL &faviconUrl, base::Time expires);
+
+  void DownloadFavicon(content::WebContents *webContents);
   // DownloadImage callback
   void DidDownloadFavicon(int id,
                           int httpStatusCode,
                           const GURL &imageUrl,
                           const std::vector<SkBitmap> &bitmaps,
                           const std::vector<gfx::Size> &originalBitmapSizes);
+  // The download from |webContents| will not complete: fails its waiters
+  // and starts again from the view of another one, if any.
+  void DownloadFailed(content::WebContents *webContents);
+  void DownloadTimedOut();
+  // Runs the callbacks and deletes this.
+  void Finish(bool success);
 
   GURL m_faviconUrl;
-  FaviconDownloaderCallback m_callback;
+  int m_targetSize;
+  base::Time m_expires;
+  ScopedVector<Waiter> m_waiters;
+  // The view whose renderer runs the download.
+  content::WebContents *m_downloadContents;
+  base::OneShotTimer<FaviconDownloader> m_timeout;
   base::WeakPtrFactory<FaviconDownloader> m_weakPtrFactory;
   DISALLOW_COPY_AND_ASSIGN(FaviconDownloader);
 };
@@ -63,6 +63,12 @@ void FaviconService::SetBitmapForFaviconURL(const SkBitmap& bitmap,
   m_database->SetBitmapForFaviconURL(bitmap, iconUrl);
 }
 
+void FaviconService::SetExpirationForFaviconURL(const base::Time& expires,
+                                                const GURL& iconUrl) {
+  CHECK_OPEN;
+  m_database->SetExpirationForFaviconURL(expires, iconUrl);
+}
+
 bool FaviconService::ExistsForPageURL(const GURL& pageUrl) const {
   CHECK_OPEN_RET(false);
   return m_database->ExistsForPageURL(pageUrl);
@@ -73,6 +79,11 @@ bool FaviconService::ExistsForFaviconURL(const GURL& iconUrl) const {
   return m_database->ExistsForFaviconURL(iconUrl);
 }
 
+bool FaviconService::IsFreshForFaviconURL(const GURL& iconUrl) const {
+  CHECK_OPEN_RET(false);
+  return m_database->IsFreshForFaviconURL(iconUrl);
+}
+
 void FaviconService::Clear() {
   CHECK_OPEN;
   m_database->Clear();
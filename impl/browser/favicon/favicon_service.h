@@ -5,6 +5,7 @@
 #ifndef FAVICON_SERVICE_H
 #define FAVICON_SERVICE_H
 
+#include "base/time/time.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "url/gurl.h"
 
@@ -27,9 +28,13 @@ class FaviconService {
 
   void SetFaviconURLForPageURL(const GURL &iconUrl, const GURL &pageUrl);
   void SetBitmapForFaviconURL(const SkBitmap &bitmap, const GURL &iconUrl);
+  // Sets until when the stored icon of |iconUrl| is fresh.
+  void SetExpirationForFaviconURL(const base::Time &expires, const GURL &iconUrl);
 
   bool ExistsForPageURL(const GURL &pageUrl) const;
   bool ExistsForFaviconURL(const GURL &iconUrl) const;
+  // Whether the icon of |iconUrl| is stored and has not expired.
+  bool IsFreshForFaviconURL(const GURL &iconUrl) const;
   void Clear();
 #if defined(OS_TIZEN_TV)
   static FaviconDatabase* GetFaviconDatabase();
@@ -0,0 +1,195 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/in_memory_data_efl.h"
+
+#include "base/guid.h"
+#include "base/logging.h"
+#include "content/public/browser/resource_request_info.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_error_job.h"
+#include "net/url_request/url_request_simple_job.h"
+
+const char kInMemoryDataScheme[] = "ewk-data";
+const char kInMemoryDataTokenHeader[] = "X-Ewk-Data-Token";
+
+namespace {
+
+// Buffers kept per view, older ones can no longer be reloaded.
+const size_t kMaxEntriesPerOwner = 8;
+
+// Hands the stored buffer to the network stack without copying it.
+class InMemoryDataJobEfl : public net::URLRequestSimpleJob {
+ public:
+  InMemoryDataJobEfl(net::URLRequest* request,
+                     net::NetworkDelegate* network_delegate,
+                     const scoped_refptr<base::RefCountedMemory>& data,
+                     const std::string& mime_type,
+                     const std::string& charset)
+      : net::URLRequestSimpleJob(request, network_delegate),
+        data_(data),
+        mime_type_(mime_type),
+        charset_(charset) {
+  }
+
+  virtual int GetRefCountedData(
+      std::string* mime_type,
+      std::string* charset,
+      scoped_refptr<base::RefCountedMemory>* data,
+      const net::CompletionCallback& callback) const override {
+    *data = data_;
+    *mime_type = mime_type_;
+    *charset = charset_;
+    return net::OK;
+  }
+
+ private:
+  virtual ~InMemoryDataJobEfl() {}
+
+  scoped_refptr<base::RefCountedMemory> data_;
+  std::string mime_type_;
+  std::string charset_;
+
+  DISALLOW_COPY_AND_ASSIGN(InMemoryDataJobEfl);
+};
+
+// The request must be a main frame navigation of the view owning |token|,
+// which the browser tells from the render view that issued it. Anything else
+// fails instead of going to the network: it is either page script trying to
+// read another view's data, or a load whose buffer was already dropped.
+net::URLRequestJob* CreateJobForToken(net::URLRequest* request,
+                                      net::NetworkDelegate* network_delegate,
+                                      const std::string& token) {
+  const content::ResourceRequestInfo* info =
+      content::ResourceRequestInfo::ForRequest(request);
+  if (!info || info->GetResourceType() != content::RESOURCE_TYPE_MAIN_FRAME) {
+    LOG(WARNING) << "Refusing in-memory data to a subresource request for "
+                 << request->url().spec();
+    return new net::URLRequestErrorJob(
+        request, network_delegate, net::ERR_ACCESS_DENIED);
+  }
+
+  scoped_refptr<base::RefCountedMemory> data;
+  std::string mime_type, charset;
+  if (!InMemoryDataStoreEfl::GetInstance()->Get(
+          token, info->GetChildID(), info->GetRouteID(),
+          &data, &mime_type, &charset)) {
+    VLOG(1) << "No in-memory data for " << request->url().spec();
+    return new net::URLRequestErrorJob(
+        request, network_delegate, net::ERR_FILE_NOT_FOUND);
+  }
+  return new InMemoryDataJobEfl(
+      request, network_delegate, data, mime_type, charset);
+}
+
+} // namespace
+
+InMemoryDataStoreEfl::Owner::Owner() {
+}
+
+InMemoryDataStoreEfl::Owner::~Owner() {
+}
+
+InMemoryDataStoreEfl::InMemoryDataStoreEfl() {
+}
+
+InMemoryDataStoreEfl::~InMemoryDataStoreEfl() {
+}
+
+// static
+InMemoryDataStoreEfl* InMemoryDataStoreEfl::GetInstance() {
+  return Singleton<InMemoryDataStoreEfl>::get();
+}
+
+// static
+GURL InMemoryDataStoreEfl::GetURLForToken(const std::string& token) {
+  return GURL(std::string(kInMemoryDataScheme) + ":" + token);
+}
+
+std::string InMemoryDataStoreEfl::Add(
+    const void* owner,
+    const scoped_refptr<base::RefCountedMemory>& data,
+    const std::string& mime_type,
+    const std::string& charset) {
+  std::string token = base::GenerateGUID();
+
+  base::AutoLock locker(lock_);
+  Entry& entry = entries_[token];
+  entry.owner = owner;
+  entry.data = data;
+  entry.mime_type = mime_type;
+  entry.charset = charset;
+
+  std::deque<std::string>& tokens = owners_[owner].tokens;
+  tokens.push_back(token);
+  if (tokens.size() > kMaxEntriesPerOwner) {
+    entries_.erase(tokens.front());
+    tokens.pop_front();
+  }
+  return token;
+}
+
+void InMemoryDataStoreEfl::AddRenderView(const void* owner,
+                                         int render_process_id,
+                                         int render_view_id) {
+  base::AutoLock locker(lock_);
+  owners_[owner].render_views.insert(
+      std::make_pair(render_process_id, render_view_id));
+}
+
+bool InMemoryDataStoreEfl::Get(const std::string& token,
+                               int render_process_id,
+                               int render_view_id,
+                               scoped_refptr<base::RefCountedMemory>* data,
+                               std::string* mime_type,
+                               std::string* charset) const {
+  base::AutoLock locker(lock_);
+  EntryMap::const_iterator it = entries_.find(token);
+  if (it == entries_.end())
+    return false;
+
+  OwnerMap::const_iterator owner = owners_.find(it->second.owner);
+  if (owner == owners_.end() ||
+      !owner->second.render_views.count(
+          std::make_pair(render_process_id, render_view_id)))
+    return false;
+
+  *data = it->second.data;
+  *mime_type = it->second.mime_type;
+  *charset = it->second.charset;
+  return true;
+}
+
+void InMemoryDataStoreEfl::RemoveForOwner(const void* owner) {
+  base::AutoLock locker(lock_);
+  OwnerMap::iterator it = owners_.find(owner);
+  if (it == owners_.end())
+    return;
+
+  for (size_t i = 0; i < it->second.tokens.size(); ++i)
+    entries_.erase(it->second.tokens[i]);
+  owners_.erase(it);
+}
+
+net::URLRequestJob* InMemoryDataProtocolHandlerEfl::MaybeCreateJob(
+    net::URLRequest* request,
+    net::NetworkDelegate* network_delegate) const {
+  // Non standard scheme, the whole part after the colon is the path.
+  return CreateJobForToken(request, network_delegate, request->url().path());
+}
+
+net::URLRequestJob* InMemoryDataInterceptorEfl::MaybeInterceptRequest(
+    net::URLRequest* request,
+    net::NetworkDelegate* network_delegate) const {
+  std::string token;
+  if (!request->extra_request_headers().GetHeader(kInMemoryDataTokenHeader,
+                                                  &token))
+    return NULL;
+
+  // The header is private to the browser, never let it reach the network.
+  request->RemoveRequestHeaderByName(kInMemoryDataTokenHeader);
+  return CreateJobForToken(request, network_delegate, token);
+}
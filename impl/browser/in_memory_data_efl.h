@@ -0,0 +1,121 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef IN_MEMORY_DATA_EFL_H_
+#define IN_MEMORY_DATA_EFL_H_
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/singleton.h"
+#include "base/synchronization/lock.h"
+#include "net/url_request/url_request_interceptor.h"
+#include "net/url_request/url_request_job_factory.h"
+#include "url/gurl.h"
+
+// Scheme of documents loaded with ewk_view_contents_set() and friends when no
+// base URL was given, e.g. "ewk-data:<token>".
+extern const char kInMemoryDataScheme[];
+
+// Navigations that load in-memory data on top of a real base URL carry the
+// token in this request header instead. Page script can set it too, so it is
+// only honoured on main frame navigations of the view that owns the data.
+extern const char kInMemoryDataTokenHeader[];
+
+// Keeps the buffers passed to EWebView::LoadData() so they can be served to
+// the network stack without being encoded into a data: URL. Every buffer is
+// owned by a view, which keeps its most recent ones alive for back/forward
+// and reload, and is only served to the render views of that view. Safe to
+// use from any thread.
+class InMemoryDataStoreEfl {
+ public:
+  static InMemoryDataStoreEfl* GetInstance();
+
+  // Takes ownership of |data|, returns the token identifying it.
+  std::string Add(const void* owner,
+                  const scoped_refptr<base::RefCountedMemory>& data,
+                  const std::string& mime_type,
+                  const std::string& charset);
+  // Lets the main frame of a render view of |owner| load its buffers. Called
+  // for every render view the view creates.
+  void AddRenderView(const void* owner,
+                     int render_process_id,
+                     int render_view_id);
+  // Fails when there is no such buffer, or when it belongs to a view other
+  // than the one of the given render view.
+  bool Get(const std::string& token,
+           int render_process_id,
+           int render_view_id,
+           scoped_refptr<base::RefCountedMemory>* data,
+           std::string* mime_type,
+           std::string* charset) const;
+  // Drops every buffer of |owner|, called when the view goes away.
+  void RemoveForOwner(const void* owner);
+
+  static GURL GetURLForToken(const std::string& token);
+
+ private:
+  friend struct DefaultSingletonTraits<InMemoryDataStoreEfl>;
+
+  struct Entry {
+    const void* owner;
+    scoped_refptr<base::RefCountedMemory> data;
+    std::string mime_type;
+    std::string charset;
+  };
+  struct Owner {
+    Owner();
+    ~Owner();
+
+    std::deque<std::string> tokens;
+    // Render process and render view ids.
+    std::set<std::pair<int, int> > render_views;
+  };
+  typedef std::map<std::string, Entry> EntryMap;
+  typedef std::map<const void*, Owner> OwnerMap;
+
+  InMemoryDataStoreEfl();
+  ~InMemoryDataStoreEfl();
+
+  mutable base::Lock lock_;
+  EntryMap entries_;
+  OwnerMap owners_;
+
+  DISALLOW_COPY_AND_ASSIGN(InMemoryDataStoreEfl);
+};
+
+// Serves kInMemoryDataScheme URLs to the main frame of the owning view.
+class InMemoryDataProtocolHandlerEfl
+    : public net::URLRequestJobFactory::ProtocolHandler {
+ public:
+  InMemoryDataProtocolHandlerEfl() {}
+
+  virtual net::URLRequestJob* MaybeCreateJob(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(InMemoryDataProtocolHandlerEfl);
+};
+
+// Serves main frame navigations of the owning view tagged with
+// kInMemoryDataTokenHeader, whatever their URL. Other requests with the
+// header fail.
+class InMemoryDataInterceptorEfl : public net::URLRequestInterceptor {
+ public:
+  InMemoryDataInterceptorEfl() {}
+
+  virtual net::URLRequestJob* MaybeInterceptRequest(
+      net::URLRequest* request,
+      net::NetworkDelegate* network_delegate) const override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(InMemoryDataInterceptorEfl);
+};
+
+#endif  // IN_MEMORY_DATA_EFL_H_
@@ -0,0 +1,27 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/ipc_message_counter_efl.h"
+
+#include "content/public/browser/render_process_host.h"
+#include "ipc/ipc_channel_proxy.h"
+
+base::subtle::Atomic32 IPCMessageCounterEfl::received_count_ = 0;
+
+// static
+void IPCMessageCounterEfl::AttachTo(content::RenderProcessHost* host) {
+  // Added to the channel itself rather than as a BrowserMessageFilter, which
+  // would only be shown the message classes it asks for.
+  host->GetChannel()->AddFilter(new IPCMessageCounterEfl());
+}
+
+// static
+unsigned IPCMessageCounterEfl::GetReceivedCount() {
+  return base::subtle::NoBarrier_Load(&received_count_);
+}
+
+bool IPCMessageCounterEfl::OnMessageReceived(const IPC::Message& message) {
+  base::subtle::NoBarrier_AtomicIncrement(&received_count_, 1);
+  return false;
+}
@@ -0,0 +1,37 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef IPC_MESSAGE_COUNTER_EFL_H
+#define IPC_MESSAGE_COUNTER_EFL_H
+
+#include "base/atomicops.h"
+#include "ipc/message_filter.h"
+
+namespace content {
+class RenderProcessHost;
+}
+
+// Counts the messages every renderer sends to the browser, so that
+// benchmarks can tell how chatty a page load is. Only installed when the
+// browser runs with --count-ipc-messages.
+class IPCMessageCounterEfl : public IPC::MessageFilter {
+ public:
+  static void AttachTo(content::RenderProcessHost* host);
+
+  // Messages received from all renderers since startup.
+  static unsigned GetReceivedCount();
+
+  // IPC::MessageFilter implementation, runs on the IO thread.
+  virtual bool OnMessageReceived(const IPC::Message& message) override;
+
+ private:
+  IPCMessageCounterEfl() {}
+  virtual ~IPCMessageCounterEfl() {}
+
+  static base::subtle::Atomic32 received_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(IPCMessageCounterEfl);
+};
+
+#endif // IPC_MESSAGE_COUNTER_EFL_H
@@ -7,12 +7,15 @@
 
 #include "browser/password_manager/content_password_manager_driver.h"
 
+#include "browser/password_manager/password_form_cache.h"
+#include "browser/password_manager/password_store_factory.h"
 #include "components/autofill/content/browser/autofill_driver_impl.h"
 #include "components/autofill/content/common/autofill_messages.h"
 #include "components/autofill/core/common/password_form.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/navigation_details.h"
 #include "content/public/browser/navigation_entry.h"
+#include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/page_transition_types.h"
@@ -68,6 +71,27 @@ void ContentPasswordManagerDriver::DidNavigateMainFrame(
     const content::LoadCommittedDetails& details,
     const content::FrameNavigateParams& params) {
   password_manager_.DidNavigateMainFrame(details.is_in_page);
+  // Redirects may have landed on another realm than the one prefetched.
+  if (!details.is_in_page)
+    PrefetchLogins(params.url);
+}
+
+void ContentPasswordManagerDriver::DidStartProvisionalLoadForFrame(
+    content::RenderFrameHost* render_frame_host,
+    const GURL& validated_url,
+    bool is_error_page,
+    bool is_iframe_srcdoc) {
+  if (render_frame_host->GetParent() || is_error_page)
+    return;
+  PrefetchLogins(validated_url);
+}
+
+void ContentPasswordManagerDriver::PrefetchLogins(const GURL& url) {
+  if (!password_manager_.IsPasswordManagerFillingEnabled() || IsOffTheRecord())
+    return;
+  PasswordFormCache* form_cache = PasswordStoreFactory::GetFormCache();
+  if (form_cache)
+    form_cache->Prefetch(url);
 }
 
 bool ContentPasswordManagerDriver::OnMessageReceived(
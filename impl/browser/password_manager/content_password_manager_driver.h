@@ -45,11 +45,19 @@ class ContentPasswordManagerDriver : public PasswordManagerDriver,
 
   // content::WebContentsObserver overrides.
   virtual bool OnMessageReceived(const IPC::Message& message) override;
+  virtual void DidStartProvisionalLoadForFrame(
+      content::RenderFrameHost* render_frame_host,
+      const GURL& validated_url,
+      bool is_error_page,
+      bool is_iframe_srcdoc) override;
   virtual void DidNavigateMainFrame(
       const content::LoadCommittedDetails& details,
       const content::FrameNavigateParams& params) override;
 
  private:
+  // Warms up the login cache for the page about to load at |url|.
+  void PrefetchLogins(const GURL& url);
+
   // Must outlive this instance.
   PasswordManagerClient* client_;
 
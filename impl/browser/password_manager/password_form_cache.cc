@@ -0,0 +1,184 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifdef TIZEN_AUTOFILL_SUPPORT
+
+#include "browser/password_manager/password_form_cache.h"
+
+#include <algorithm>
+
+#include "base/metrics/histogram.h"
+#include "url/gurl.h"
+
+using autofill::PasswordForm;
+
+namespace {
+
+// Realms kept in memory, a handful of logins each.
+const size_t kMaxCachedRealms = 32;
+
+} // namespace
+
+// One store query for one realm, shared by every consumer asking for it
+// meanwhile. Store results do not tell which query they answer, hence one
+// consumer object per realm.
+class PasswordFormCache::RealmRequest : public PasswordStoreConsumer {
+ public:
+  RealmRequest(PasswordFormCache* cache,
+               const std::string& signon_realm,
+               int generation)
+      : cache_(cache),
+        signon_realm_(signon_realm),
+        generation_(generation) {
+  }
+
+  virtual void OnGetPasswordStoreResults(
+      const std::vector<PasswordForm*>& results) override {
+    cache_->OnRequestDone(this, results);
+  }
+
+  const std::string& signon_realm() const { return signon_realm_; }
+  int generation() const { return generation_; }
+  std::vector<PasswordStoreConsumer*>& consumers() { return consumers_; }
+
+ private:
+  PasswordFormCache* cache_;
+  std::string signon_realm_;
+  int generation_;
+  std::vector<PasswordStoreConsumer*> consumers_;
+
+  DISALLOW_COPY_AND_ASSIGN(RealmRequest);
+};
+
+PasswordFormCache::PasswordFormCache(PasswordStore* password_store)
+    : password_store_(password_store),
+      generation_(0) {
+  DCHECK(password_store_.get());
+  password_store_->AddObserver(this);
+}
+
+PasswordFormCache::~PasswordFormCache() {
+  password_store_->RemoveObserver(this);
+}
+
+void PasswordFormCache::GetLogins(
+    const PasswordForm& form,
+    PasswordStore::AuthorizationPromptPolicy prompt_policy,
+    PasswordStoreConsumer* consumer) {
+  RealmMap::const_iterator cached = realms_.find(form.signon_realm);
+  if (cached != realms_.end()) {
+    UMA_HISTOGRAM_BOOLEAN("PasswordManager.FormCacheHit", true);
+    Deliver(*cached->second, consumer);
+    return;
+  }
+
+  UMA_HISTOGRAM_BOOLEAN("PasswordManager.FormCacheHit", false);
+  StartRequest(form, prompt_policy);
+  requests_[form.signon_realm]->consumers().push_back(consumer);
+}
+
+void PasswordFormCache::Prefetch(const GURL& url) {
+  if (!url.is_valid() || !url.SchemeIsHTTPOrHTTPS())
+    return;
+
+  // Same realm as PasswordFormManager computes for the HTML forms of |url|.
+  PasswordForm form;
+  form.scheme = PasswordForm::SCHEME_HTML;
+  form.origin = url;
+  form.signon_realm = url.GetOrigin().spec();
+  if (realms_.find(form.signon_realm) != realms_.end())
+    return;
+
+  StartRequest(form, PasswordStore::DISALLOW_PROMPT);
+}
+
+void PasswordFormCache::CancelRequests(PasswordStoreConsumer* consumer) {
+  for (RequestMap::iterator it = requests_.begin();
+       it != requests_.end(); ++it) {
+    std::vector<PasswordStoreConsumer*>& consumers = it->second->consumers();
+    consumers.erase(std::remove(consumers.begin(), consumers.end(), consumer),
+                    consumers.end());
+  }
+}
+
+void PasswordFormCache::OnLoginsChanged(
+    const PasswordStoreChangeList& changes) {
+  realms_.clear();
+  realm_order_.clear();
+  ++generation_;
+}
+
+void PasswordFormCache::StartRequest(
+    const PasswordForm& form,
+    PasswordStore::AuthorizationPromptPolicy prompt_policy) {
+  RequestMap::iterator pending = requests_.find(form.signon_realm);
+  if (pending != requests_.end() &&
+      pending->second->generation() == generation_)
+    return;
+
+  // A request started before the last store change may miss it, its
+  // consumers move over to a fresh one.
+  RealmRequest* request =
+      new RealmRequest(this, form.signon_realm, generation_);
+  if (pending != requests_.end()) {
+    request->consumers().swap(pending->second->consumers());
+    stale_requests_.push_back(pending->second);
+    pending->second = linked_ptr<RealmRequest>(request);
+  } else {
+    requests_[form.signon_realm] = linked_ptr<RealmRequest>(request);
+  }
+  password_store_->GetLogins(form, prompt_policy, request);
+}
+
+void PasswordFormCache::OnRequestDone(
+    RealmRequest* request,
+    const std::vector<PasswordForm*>& results) {
+  ScopedVector<PasswordForm> logins;
+  logins.get().assign(results.begin(), results.end());
+
+  RequestMap::iterator it = requests_.find(request->signon_realm());
+  if (it == requests_.end() || it->second.get() != request) {
+    // Superseded by a store change, nobody waits for it any more.
+    for (size_t i = 0; i < stale_requests_.size(); ++i) {
+      if (stale_requests_[i].get() == request) {
+        stale_requests_.erase(stale_requests_.begin() + i);
+        break;
+      }
+    }
+    return;
+  }
+
+  std::vector<PasswordStoreConsumer*> consumers;
+  consumers.swap(request->consumers());
+  bool cacheable = request->generation() == generation_;
+  std::string signon_realm = request->signon_realm();
+  requests_.erase(it);
+
+  for (size_t i = 0; i < consumers.size(); ++i)
+    Deliver(logins, consumers[i]);
+
+  if (!cacheable)
+    return;
+
+  realms_[signon_realm] = linked_ptr<ScopedVector<PasswordForm> >(
+      new ScopedVector<PasswordForm>(logins.Pass()));
+  realm_order_.push_back(signon_realm);
+  if (realm_order_.size() > kMaxCachedRealms) {
+    realms_.erase(realm_order_.front());
+    realm_order_.pop_front();
+  }
+}
+
+// static
+void PasswordFormCache::Deliver(const ScopedVector<PasswordForm>& logins,
+                                PasswordStoreConsumer* consumer) {
+  // Consumers take ownership of what they are given, hand out copies.
+  std::vector<PasswordForm*> results;
+  results.reserve(logins.size());
+  for (size_t i = 0; i < logins.size(); ++i)
+    results.push_back(new PasswordForm(*logins[i]));
+  consumer->OnGetPasswordStoreResults(results);
+}
+
+#endif // TIZEN_AUTOFILL_SUPPORT
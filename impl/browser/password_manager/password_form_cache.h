@@ -0,0 +1,80 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PASSWORD_FORM_CACHE_H
+#define PASSWORD_FORM_CACHE_H
+
+#ifdef TIZEN_AUTOFILL_SUPPORT
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/memory/linked_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "components/autofill/core/common/password_form.h"
+#include "components/password_manager/core/browser/password_store.h"
+#include "components/password_manager/core/browser/password_store_consumer.h"
+
+class GURL;
+
+// Keeps the login database results of recently used signon realms in memory,
+// so that pages which parse their login forms several times, and forms
+// parsed right after a prefetch at navigation time, do not wait on a
+// database query each. Any change to the store drops the whole cache, as
+// public suffix matches make one login visible to several realms.
+//
+// Lives on the UI thread, next to the PasswordStore it caches.
+class PasswordFormCache : public PasswordStore::Observer {
+ public:
+  explicit PasswordFormCache(PasswordStore* password_store);
+  virtual ~PasswordFormCache();
+
+  // Same contract as PasswordStore::GetLogins(), except that |consumer| may
+  // be answered synchronously when the realm of |form| is cached.
+  void GetLogins(const autofill::PasswordForm& form,
+                 PasswordStore::AuthorizationPromptPolicy prompt_policy,
+                 PasswordStoreConsumer* consumer);
+
+  // Starts loading the logins of the page at |url|, if not already cached.
+  void Prefetch(const GURL& url);
+
+  // Must be called by consumers going away with a request pending.
+  void CancelRequests(PasswordStoreConsumer* consumer);
+
+  // PasswordStore::Observer implementation.
+  virtual void OnLoginsChanged(const PasswordStoreChangeList& changes) override;
+
+ private:
+  class RealmRequest;
+  typedef std::map<std::string, linked_ptr<ScopedVector<autofill::PasswordForm> > >
+      RealmMap;
+  typedef std::map<std::string, linked_ptr<RealmRequest> > RequestMap;
+
+  void StartRequest(const autofill::PasswordForm& form,
+                    PasswordStore::AuthorizationPromptPolicy prompt_policy);
+  // Takes ownership of the elements of |results|.
+  void OnRequestDone(RealmRequest* request,
+                     const std::vector<autofill::PasswordForm*>& results);
+  static void Deliver(const ScopedVector<autofill::PasswordForm>& logins,
+                      PasswordStoreConsumer* consumer);
+
+  scoped_refptr<PasswordStore> password_store_;
+  RealmMap realms_;
+  // Cached realms, oldest first.
+  std::deque<std::string> realm_order_;
+  RequestMap requests_;
+  // Requests overtaken by a store change, dropped once they complete.
+  std::vector<linked_ptr<RealmRequest> > stale_requests_;
+  // Bumped whenever the store changes, results of requests started before
+  // are handed out but not cached.
+  int generation_;
+
+  DISALLOW_COPY_AND_ASSIGN(PasswordFormCache);
+};
+
+#endif // TIZEN_AUTOFILL_SUPPORT
+
+#endif  // PASSWORD_FORM_CACHE_H
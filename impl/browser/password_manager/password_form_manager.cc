@@ -11,6 +11,7 @@
 #include "base/metrics/histogram.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "browser/password_manager/password_form_cache.h"
 #include "browser/password_manager/password_manager.h"
 #include "browser/password_manager/password_manager_client.h"
 #include "browser/password_manager/password_manager_driver.h"
@@ -49,6 +50,11 @@ PasswordFormManager::PasswordFormManager(PasswordManager* password_manager,
 }
 
 PasswordFormManager::~PasswordFormManager() {
+  if (state_ == MATCHING_PHASE) {
+    PasswordFormCache* form_cache = PasswordStoreFactory::GetFormCache();
+    if (form_cache)
+      form_cache->CancelRequests(this);
+  }
   UMA_HISTOGRAM_ENUMERATION("PasswordManager.ActionsTakenWithPsl",
                             GetActionsTaken(),
                             kMaxNumActionsTaken);
@@ -267,6 +273,13 @@ void PasswordFormManager::FetchMatchingLoginsFromPasswordStore(
     NOTREACHED();
     return;
   }
+  // Logins of the realm are usually already in memory, prefetched when the
+  // navigation started or loaded for a previous form of the page.
+  PasswordFormCache* form_cache = PasswordStoreFactory::GetFormCache();
+  if (form_cache) {
+    form_cache->GetLogins(observed_form_, prompt_policy, this);
+    return;
+  }
   password_store->GetLogins(observed_form_, prompt_policy, this);
 }
 
@@ -7,6 +7,8 @@
 
 #include "browser/password_manager/password_store_factory.h"
 
+#include "browser/password_manager/password_form_cache.h"
+
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/prefs/pref_service.h"
@@ -24,7 +26,8 @@
 
 PasswordStoreService::PasswordStoreService(
     scoped_refptr<PasswordStore> password_store)
-    : password_store_(password_store)
+    : password_store_(password_store),
+      form_cache_(new PasswordFormCache(password_store.get()))
 {
 }
 
@@ -39,6 +42,7 @@ scoped_refptr<PasswordStore> PasswordStoreService::GetPasswordStore()
 
 void PasswordStoreService::Shutdown()
 {
+  form_cache_.reset();
   if (password_store_)
     password_store_->Shutdown();
 }
@@ -52,6 +56,15 @@ scoped_refptr<PasswordStore> PasswordStoreFactory::GetPasswordStore()
   return service->GetPasswordStore();
 }
 
+// static
+PasswordFormCache* PasswordStoreFactory::GetFormCache()
+{
+  PasswordStoreService* service = GetInstance()->GetService();
+  if (!service)
+    return NULL;
+  return service->GetFormCache();
+}
+
 // static
 PasswordStoreFactory* PasswordStoreFactory::GetInstance()
 {
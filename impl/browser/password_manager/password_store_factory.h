@@ -9,8 +9,10 @@
 #ifdef TIZEN_AUTOFILL_SUPPORT
 
 #include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/memory/singleton.h"
 
+class PasswordFormCache;
 class PasswordStore;
 
 // A wrapper of PasswordStore so we can use it as a profiled keyed service.
@@ -22,11 +24,13 @@ class PasswordStoreService {
   virtual ~PasswordStoreService();
 
   scoped_refptr<PasswordStore> GetPasswordStore();
+  PasswordFormCache* GetFormCache() { return form_cache_.get(); }
 
   virtual void Shutdown() override;
 
  private:
   scoped_refptr<PasswordStore> password_store_;
+  scoped_ptr<PasswordFormCache> form_cache_;
   DISALLOW_COPY_AND_ASSIGN(PasswordStoreService);
 };
 
@@ -35,6 +39,8 @@ class PasswordStoreService {
 class PasswordStoreFactory {
  public:
   static scoped_refptr<PasswordStore> GetPasswordStore();
+  // In-memory front of the store, NULL when the store failed to load.
+  static PasswordFormCache* GetFormCache();
 
   static PasswordStoreFactory* GetInstance();
   PasswordStoreService* GetService() { return service_; }
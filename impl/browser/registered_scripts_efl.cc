@@ -0,0 +1,169 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/registered_scripts_efl.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+#include "base/memory/shared_memory.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+
+#include "common/render_messages_efl.h"
+
+using content::BrowserThread;
+using content::RenderProcessHost;
+
+namespace {
+
+// Copies |size| bytes of |data| to new shared memory that renderers can
+// only map read-only.
+scoped_ptr<base::SharedMemory> CreateReadOnlyCopy(const void* data,
+                                                  size_t size) {
+  base::SharedMemoryCreateOptions options;
+  options.size = size;
+  options.share_read_only = true;
+
+  scoped_ptr<base::SharedMemory> memory(new base::SharedMemory);
+  if (!memory->Create(options) || !memory->Map(size))
+    return scoped_ptr<base::SharedMemory>();
+
+  memcpy(memory->memory(), data, size);
+  return memory.Pass();
+}
+
+} // namespace
+
+struct RegisteredScriptsEfl::CodeCache {
+  CodeCache() : size(0) {}
+
+  scoped_ptr<base::SharedMemory> memory;
+  uint32 size;
+  // Compile time of the renderer that produced the cache, without it.
+  base::TimeDelta cold_compile_time;
+};
+
+struct RegisteredScriptsEfl::Script {
+  Script() : source_size(0) {}
+
+  scoped_ptr<base::SharedMemory> source;
+  uint32 source_size;
+  // By id of the render process host that produced them.
+  std::map<int, linked_ptr<CodeCache> > code_caches;
+
+  // Ids of the renderer processes |source| and their code cache were sent
+  // to, or that compiled the script themselves.
+  std::set<int> processes_with_source;
+  std::set<int> processes_with_code_cache;
+};
+
+RegisteredScriptsEfl::RegisteredScriptsEfl()
+    : next_script_id_(1) {
+}
+
+RegisteredScriptsEfl::~RegisteredScriptsEfl() {
+}
+
+int RegisteredScriptsEfl::Register(const std::string& source) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (source.empty())
+    return 0;
+
+  linked_ptr<Script> script(new Script);
+  script->source = CreateReadOnlyCopy(source.data(), source.size());
+  if (!script->source) {
+    LOG(ERROR) << "Cannot allocate " << source.size()
+               << " bytes of shared memory for a registered script";
+    return 0;
+  }
+  script->source_size = source.size();
+
+  int script_id = next_script_id_++;
+  scripts_[script_id] = script;
+  return script_id;
+}
+
+bool RegisteredScriptsEfl::Unregister(int script_id) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  ScriptMap::iterator it = scripts_.find(script_id);
+  if (it == scripts_.end())
+    return false;
+
+  const std::set<int>& processes = it->second->processes_with_source;
+  for (std::set<int>::const_iterator process = processes.begin();
+       process != processes.end(); ++process) {
+    RenderProcessHost* host = RenderProcessHost::FromID(*process);
+    if (host)
+      host->Send(new EwkViewMsg_UnregisterScript(script_id));
+  }
+  scripts_.erase(it);
+  return true;
+}
+
+bool RegisteredScriptsEfl::SendTo(RenderProcessHost* host, int script_id) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  ScriptMap::iterator it = scripts_.find(script_id);
+  if (it == scripts_.end())
+    return false;
+
+  Script* script = it->second.get();
+  int process_id = host->GetID();
+  if (!script->processes_with_source.count(process_id)) {
+    base::SharedMemoryHandle handle;
+    if (!script->source->ShareReadOnlyToProcess(host->GetHandle(), &handle))
+      return false;
+    host->Send(new EwkViewMsg_RegisterScript(script_id, handle,
+                                             script->source_size));
+    script->processes_with_source.insert(process_id);
+  }
+
+  std::map<int, linked_ptr<CodeCache> >::const_iterator code_cache =
+      script->code_caches.find(process_id);
+  if (code_cache != script->code_caches.end() &&
+      !script->processes_with_code_cache.count(process_id)) {
+    base::SharedMemoryHandle handle;
+    if (code_cache->second->memory->ShareReadOnlyToProcess(host->GetHandle(),
+                                                           &handle)) {
+      host->Send(new EwkViewMsg_SetScriptCodeCache(script_id, handle,
+          code_cache->second->size, code_cache->second->cold_compile_time));
+      script->processes_with_code_cache.insert(process_id);
+    }
+  }
+  return true;
+}
+
+void RegisteredScriptsEfl::SetCodeCache(int script_id,
+                                        int render_process_id,
+                                        const std::vector<uint8>& code_cache,
+                                        base::TimeDelta compile_time) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  ScriptMap::iterator it = scripts_.find(script_id);
+  if (it == scripts_.end() || code_cache.empty())
+    return;
+
+  Script* script = it->second.get();
+  // The producer keeps its compiled script.
+  script->processes_with_code_cache.insert(render_process_id);
+  if (script->code_caches.count(render_process_id))
+    return;
+
+  // Only kept for a relaunch of the same host: a compromised renderer must
+  // not get to plant code that renderers of other sites would run.
+  linked_ptr<CodeCache> cache(new CodeCache);
+  cache->memory = CreateReadOnlyCopy(&code_cache[0], code_cache.size());
+  if (!cache->memory)
+    return;
+  cache->size = code_cache.size();
+  cache->cold_compile_time = compile_time;
+  script->code_caches[render_process_id] = cache;
+}
+
+void RegisteredScriptsEfl::RenderProcessLaunched(int render_process_id) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  for (ScriptMap::iterator it = scripts_.begin(); it != scripts_.end(); ++it) {
+    it->second->processes_with_source.erase(render_process_id);
+    it->second->processes_with_code_cache.erase(render_process_id);
+  }
+}
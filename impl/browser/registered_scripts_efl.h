@@ -0,0 +1,71 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef REGISTERED_SCRIPTS_EFL_H
+#define REGISTERED_SCRIPTS_EFL_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/linked_ptr.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
+
+namespace base {
+class SharedMemory;
+}
+
+namespace content {
+class RenderProcessHost;
+}
+
+// Scripts an embedder registered with a context, to execute them in its
+// views any number of times without shipping and compiling them again.
+//
+// The source of a script is kept in read-only shared memory, mapped once
+// by every renderer that executes it, see RegisteredScriptRunnerEfl. The
+// first compile in a renderer produces a V8 code cache. A cache comes from
+// a renderer and cannot be trusted, so it is only ever sent back to the
+// process of the same host when it is relaunched, never to other renderers.
+//
+// Lives on the UI thread.
+class RegisteredScriptsEfl {
+ public:
+  RegisteredScriptsEfl();
+  ~RegisteredScriptsEfl();
+
+  // Returns the id of the new script, or 0 if it cannot be shared.
+  int Register(const std::string& source);
+  bool Unregister(int script_id);
+
+  // Sends |script_id|, and the code cache |host| produced for it if any, to
+  // the renderer of |host| unless it has them already. Returns false for
+  // unknown scripts.
+  bool SendTo(content::RenderProcessHost* host, int script_id);
+
+  // Keeps the code cache the renderer of |render_process_id| produced while
+  // compiling |script_id| for |compile_time|.
+  void SetCodeCache(int script_id,
+                    int render_process_id,
+                    const std::vector<uint8>& code_cache,
+                    base::TimeDelta compile_time);
+
+  // A renderer process (re)launched and has none of the scripts.
+  void RenderProcessLaunched(int render_process_id);
+
+ private:
+  struct CodeCache;
+  struct Script;
+  typedef std::map<int, linked_ptr<Script> > ScriptMap;
+
+  ScriptMap scripts_;
+  int next_script_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegisteredScriptsEfl);
+};
+
+#endif // REGISTERED_SCRIPTS_EFL_H
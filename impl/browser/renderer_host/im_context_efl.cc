@@ -7,6 +7,12 @@
 #include "base/logging.h"
 #include "base/strings/string16.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/third_party/icu/icu_utf.h"
+#include "content/browser/frame_host/frame_tree.h"
+#include "content/browser/frame_host/frame_tree_node.h"
+#include "content/browser/frame_host/render_frame_host_impl.h"
+#include "content/browser/renderer_host/render_view_host_delegate.h"
+#include "content/browser/renderer_host/render_view_host_impl.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "browser/renderer_host/render_widget_host_view_efl.h"
 
@@ -49,6 +55,33 @@ Ecore_IMF_Context* CreateIMFContext(Evas* evas) {
   return context;
 }
 
+// Number of characters in |text|[begin, end), a surrogate pair counts once.
+int CountCharacters(const base::string16& text, size_t begin, size_t end) {
+  int count = 0;
+  for (size_t i = begin; i < end; ++i) {
+    if (!CBU16_IS_TRAIL(text[i]))
+      ++count;
+  }
+  return count;
+}
+
+// Moves |chars| characters away from |position| in |text|, backwards if
+// |chars| is negative, and returns the UTF-16 index reached.
+size_t AdvanceCharacters(const base::string16& text, size_t position, int chars) {
+  while (chars < 0 && position > 0) {
+    --position;
+    if (!CBU16_IS_TRAIL(text[position]))
+      ++chars;
+  }
+  while (chars > 0 && position < text.length()) {
+    ++position;
+    if (position < text.length() && CBU16_IS_TRAIL(text[position]))
+      ++position;
+    --chars;
+  }
+  return position;
+}
+
 } // namespace
 
 namespace content {
@@ -71,6 +104,8 @@ IMContextEfl::IMContextEfl(RenderWidgetHostViewEfl* view, Ecore_IMF_Context* con
       current_mode_(ui::TEXT_INPUT_MODE_DEFAULT),
       current_type_(ui::TEXT_INPUT_TYPE_NONE),
       can_compose_inline_(false),
+      surrounding_cursor_(0),
+      surrounding_cursor_chars_(-1),
       is_handling_keydown_(false),
       is_ime_ctx_reset_(false) {
   IM_CTX_LOG;
@@ -247,6 +282,28 @@ void IMContextEfl::UpdateCaretBounds(const gfx::Rect& caret_bounds) {
   }
 }
 
+void IMContextEfl::UpdateSurroundingText(const base::string16& text,
+                                         size_t offset,
+                                         const gfx::Range& range) {
+  size_t cursor = range.GetMax();
+  if (!range.IsValid() || cursor < offset || cursor - offset > text.length()) {
+    ClearSurroundingText();
+    return;
+  }
+
+  surrounding_text_ = text;
+  surrounding_cursor_ = cursor - offset;
+  surrounding_text_utf8_ = base::UTF16ToUTF8(text);
+  surrounding_cursor_chars_ = CountCharacters(text, 0, surrounding_cursor_);
+}
+
+void IMContextEfl::ClearSurroundingText() {
+  surrounding_text_.clear();
+  surrounding_text_utf8_.clear();
+  surrounding_cursor_ = 0;
+  surrounding_cursor_chars_ = -1;
+}
+
 void IMContextEfl::OnFocusIn() {
   CancelComposition();
 
@@ -273,6 +330,7 @@ void IMContextEfl::OnFocusOut() {
   is_focused_ = false;
 
   CancelComposition();
+  ClearSurroundingText();
 
   ecore_imf_context_focus_out(context_);
 
@@ -452,10 +510,47 @@ void IMContextEfl::OnCandidateInputPanelGeometryChanged() {
 }
 
 bool IMContextEfl::OnRetrieveSurrounding(char** text, int* offset) {
-  return false;
+  // Nothing reported yet, and password fields are never handed out.
+  if (surrounding_cursor_chars_ < 0 || current_type_ == ui::TEXT_INPUT_TYPE_PASSWORD)
+    return false;
+
+  if (text)
+    *text = strdup(surrounding_text_utf8_.c_str());
+  if (offset)
+    *offset = surrounding_cursor_chars_;
+  return true;
 }
 
 void IMContextEfl::OnDeleteSurrounding(void* event_info) {
+  Ecore_IMF_Event_Delete_Surrounding* event =
+      static_cast<Ecore_IMF_Event_Delete_Surrounding*>(event_info);
+  if (!event || surrounding_cursor_chars_ < 0)
+    return;
+
+  // Only ranges touching the caret can be deleted by extending the selection.
+  if (event->offset > 0 || event->offset + event->n_chars < 0) {
+    IM_CTX_LOG << "range not adjacent to the caret: " << event->offset
+               << " " << event->n_chars;
+    return;
+  }
+
+  RenderFrameHostImpl* frame = GetFocusedFrame();
+  if (!frame)
+    return;
+
+  size_t begin = AdvanceCharacters(surrounding_text_, surrounding_cursor_,
+                                   event->offset);
+  size_t end = AdvanceCharacters(surrounding_text_, surrounding_cursor_,
+                                 event->offset + event->n_chars);
+  frame->ExtendSelectionAndDelete(surrounding_cursor_ - begin,
+                                  end - surrounding_cursor_);
+
+  // Keep the cache in step until the renderer reports the new selection,
+  // the IME usually asks for the surrounding text again right away.
+  surrounding_text_.erase(begin, end - begin);
+  surrounding_cursor_ = begin;
+  surrounding_text_utf8_ = base::UTF16ToUTF8(surrounding_text_);
+  surrounding_cursor_chars_ = CountCharacters(surrounding_text_, 0, begin);
 }
 
 void IMContextEfl::OnCandidateInputPanelLanguageChanged(Ecore_IMF_Context*, int) {
@@ -535,4 +630,16 @@ RenderWidgetHostImpl* IMContextEfl::GetRenderWidgetHostImpl() const {
   return RenderWidgetHostImpl::From(rwh);
 }
 
+RenderFrameHostImpl* IMContextEfl::GetFocusedFrame() const {
+  RenderWidgetHostImpl* rwhi = GetRenderWidgetHostImpl();
+  if (!rwhi || !rwhi->IsRenderView())
+    return NULL;
+
+  RenderViewHostImpl* rvh =
+      static_cast<RenderViewHostImpl*>(RenderViewHost::From(rwhi));
+  FrameTreeNode* focused_frame =
+      rvh->GetDelegate()->GetFrameTree()->GetFocusedFrame();
+  return focused_frame ? focused_frame->current_frame_host() : NULL;
+}
+
 } // namespace content
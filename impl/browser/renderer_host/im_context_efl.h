@@ -5,9 +5,13 @@
 #ifndef IM_CONTEXT_EFL
 #define IM_CONTEXT_EFL
 
+#include <queue>
+
+#include "base/strings/string16.h"
 #include "ui/base/ime/text_input_mode.h"
 #include "ui/base/ime/text_input_type.h"
 #include "ui/base/ime/composition_text.h"
+#include "ui/gfx/range/range.h"
 #include "ui/gfx/rect.h"
 #include "content/public/browser/native_web_keyboard_event.h"
 #include "browser/renderer_host/web_event_factory_efl.h"
@@ -21,6 +25,7 @@ typedef struct _Ecore_IMF_Context Ecore_IMF_Context;
 
 namespace content {
 
+class RenderFrameHostImpl;
 class RenderWidgetHostViewEfl;
 
 class IMContextEfl {
@@ -38,6 +43,11 @@ class IMContextEfl {
   void UpdateInputMethodState(ui::TextInputType, bool can_compose_inline,
                               bool show_if_needed);
   void UpdateCaretBounds(const gfx::Rect& caret_bounds);
+  // Caches the window of text around the selection that the renderer sends
+  // with every selection change, so that the IME can be answered without
+  // a round trip.
+  void UpdateSurroundingText(const base::string16& text, size_t offset,
+                             const gfx::Range& range);
 
   void OnFocusIn();
   void OnFocusOut();
@@ -52,8 +62,8 @@ class IMContextEfl {
   bool IsShow();
   gfx::Rect GetIMERect() const { return ime_rect_; }
   void SetIMERect(const gfx::Rect& rect) { ime_rect_ = rect; }
-  CommitQueue GetCommitQueue() { return commit_queue_; }
-  PreeditQueue GetPreeditQueue() { return preedit_queue_; }
+  const CommitQueue& GetCommitQueue() const { return commit_queue_; }
+  const PreeditQueue& GetPreeditQueue() const { return preedit_queue_; }
   void CommitQueuePop() { commit_queue_.pop(); }
   void PreeditQueuePop() { preedit_queue_.pop(); }
   void ClearQueues();
@@ -91,6 +101,8 @@ class IMContextEfl {
   void OnCandidateInputPanelLanguageChanged(Ecore_IMF_Context* context, int value);
 
   RenderWidgetHostImpl* GetRenderWidgetHostImpl() const;
+  RenderFrameHostImpl* GetFocusedFrame() const;
+  void ClearSurroundingText();
 
   RenderWidgetHostViewEfl* view_;
 
@@ -114,6 +126,14 @@ class IMContextEfl {
 
   gfx::Rect ime_rect_;
 
+  // Text around the selection as last reported by the renderer, the caret
+  // position is kept both in UTF-16 units, as the renderer counts, and in
+  // characters, as Ecore IMF counts.
+  base::string16 surrounding_text_;
+  std::string surrounding_text_utf8_;
+  size_t surrounding_cursor_;
+  int surrounding_cursor_chars_;
+
   CommitQueue commit_queue_;
   PreeditQueue preedit_queue_;
 
@@ -4,12 +4,15 @@
 
 #include "browser/renderer_host/render_message_filter_efl.h"
 
+#include "browser_context_efl.h"
 #include "common/web_contents_utils.h"
 #include "common/render_messages_efl.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/web_contents.h"
 #include "net/url_request/url_request_context_getter.h"
+#include "eweb_context.h"
 #include "web_contents_delegate_efl.h"
 
 #if defined(TIZEN_MULTIMEDIA_SUPPORT)
@@ -31,6 +34,7 @@ void RenderMessageFilterEfl::OverrideThreadForMessage(const IPC::Message& messag
 {
   switch (message.type()) {
   case EwkHostMsg_DecideNavigationPolicy::ID:
+  case EflViewHostMsg_CacheStats::ID:
     *thread = content::BrowserThread::UI;
     break;
   }
@@ -40,6 +44,7 @@ bool RenderMessageFilterEfl::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(RenderMessageFilterEfl, message)
     IPC_MESSAGE_HANDLER(EwkHostMsg_DecideNavigationPolicy, OnDecideNavigationPolicy)
+    IPC_MESSAGE_HANDLER(EflViewHostMsg_CacheStats, OnCacheStats)
 #if defined(TIZEN_MULTIMEDIA_SUPPORT)
     IPC_MESSAGE_HANDLER(EflViewHostMsg_GstWebAudioDecode, OnGstWebAudioDecode)
 #endif
@@ -60,6 +65,21 @@ void RenderMessageFilterEfl::OnDecideNavigationPolicy(NavigationPolicyParams par
   }
 }
 
+void RenderMessageFilterEfl::OnCacheStats(const CacheStatsEfl& stats) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+
+  content::RenderProcessHost* host =
+      content::RenderProcessHost::FromID(render_process_id_);
+  if (!host)
+    return;
+
+  content::BrowserContextEfl* browser_context =
+      static_cast<content::BrowserContextEfl*>(host->GetBrowserContext());
+  if (browser_context && browser_context->WebContext())
+    browser_context->WebContext()->web_cache_manager()->ObserveStats(
+        render_process_id_, stats);
+}
+
 #if defined(TIZEN_MULTIMEDIA_SUPPORT)
 void RenderMessageFilterEfl::OnGstWebAudioDecode(
     base::SharedMemoryHandle encoded_data_handle,
@@ -18,6 +18,7 @@
 #include "base/memory/shared_memory.h"
 #endif
 
+struct CacheStatsEfl;
 struct NavigationPolicyParams;
 
 namespace net {
@@ -39,6 +40,7 @@ class RenderMessageFilterEfl : public content::BrowserMessageFilter {
 
  private:
   void OnDecideNavigationPolicy(NavigationPolicyParams, bool* handled);
+  void OnCacheStats(const CacheStatsEfl& stats);
   void OnReceivedHitTestData(int view, const _Ewk_Hit_Test& hit_test_data,
       const NodeAttributesMap& node_attributes);
 
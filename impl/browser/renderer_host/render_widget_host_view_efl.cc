@@ -48,12 +48,16 @@
 #include "third_party/WebKit/public/web/WebViewModeEnums.h"
 #include "ui/gfx/display.h"
 #include "ui/gfx/rect.h"
+#include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/screen.h"
 #include "ui/views/widget/desktop_aura/desktop_screen.h"
 #include "ui/events/event_utils.h"
 #include "ui/events/gestures/gesture_types.h"
 #include "ui/events/gestures/gesture_recognizer.h"
 #include "browser/motion/wkext_motion.h"
+#if defined(OS_TIZEN)
+#include "browser/device_sensors/data_fetcher_impl_tizen.h"
+#endif
 #include "content/common/input_messages.h"
 #include "components/clipboard/clipboard_helper_efl.h"
 #include "common/webcursor_efl.h"
@@ -70,6 +74,17 @@
 #define MAX_SURFACE_WIDTH_EGL 4096 //max supported Framebuffer width
 #define MAX_SURFACE_HEIGHT_EGL 4096 //max supported Framebuffer height
 
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+
+// Lets glReadPixels() write straight into kN32_SkColorType bitmaps.
+#if SK_R32_SHIFT == 16
+#define kN32ReadbackFormat GL_BGRA
+#else
+#define kN32ReadbackFormat GL_RGBA
+#endif
+
 namespace content {
 
 void RenderWidgetHostViewBase::GetDefaultScreenInfo(
@@ -117,6 +132,13 @@ RenderWidgetHostViewEfl::RenderWidgetHostViewEfl(RenderWidgetHost* widget, EWebV
     surface_id_(0),
     is_hw_accelerated_(true),
     is_modifier_key_(false),
+    copy_vertex_buffer_obj_(0),
+    composition_animator_(NULL),
+#if defined(OS_TIZEN)
+    magnifier_image_(NULL),
+    magnifier_surface_(NULL),
+    magnifier_vertex_buffer_obj_(0),
+#endif
     should_restore_selection_menu_(false),
     selection_acked_on_tap_(false),
     was_scrolled_(false),
@@ -131,8 +153,9 @@ RenderWidgetHostViewEfl::RenderWidgetHostViewEfl(RenderWidgetHost* widget, EWebV
 #endif
 #endif
 
-  device_scale_factor_ = gfx::Screen::GetNativeScreen()->
-      GetPrimaryDisplay().device_scale_factor();
+  gfx::Screen* screen = gfx::Screen::GetNativeScreen();
+  device_scale_factor_ = screen->GetPrimaryDisplay().device_scale_factor();
+  screen->AddObserver(this);
 
   set_eweb_view(eweb_view);
   host_->SetView(this);
@@ -166,9 +189,17 @@ void RenderWidgetHostViewEfl::Init(Evas_Object* view, const gfx::Size& size) {
 #if defined(OS_TIZEN_MOBILE)
   disambiguation_popup_.reset(new DisambiguationPopupEfl(content_image_, this));
 #endif
+
+  UpdateSensorSamplingRate();
 }
 
 RenderWidgetHostViewEfl::~RenderWidgetHostViewEfl() {
+  gfx::Screen::GetNativeScreen()->RemoveObserver(this);
+#if defined(OS_TIZEN)
+  DataFetcherImplTizen::GetInstance()->RemoveClient(this);
+#endif
+  CancelPendingComposition();
+  Release_EvasGL();
   if (im_context_)
     delete im_context_;
 }
@@ -183,6 +214,10 @@ gfx::Rect RenderWidgetHostViewEfl::GetViewBoundsInPix() const {
   return gfx::Rect(x, y, w, h);
 }
 
+// Data key of the view a magnifier image is attached to. Views share the
+// image when one replaces another, only the last one attached owns it.
+static const char* kMagnifierOwnerKey = "magnifier-owner";
+
 static const char* vertexShaderSourceSimple =
   "attribute vec4 a_position;   \n"
   "attribute vec2 a_texCoord;   \n"
@@ -338,15 +373,23 @@ void RenderWidgetHostViewEfl::PaintTextureToSurface(GLuint texture_id) {
 
   switch (current_orientation_) {
     case 270:
-      GL_CHECK(gl_api->glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_obj_270_));
+      DrawTexture(vertex_buffer_obj_270_, texture_id);
       break;
     case 90:
-      GL_CHECK(gl_api->glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_obj_90_));
+      DrawTexture(vertex_buffer_obj_90_, texture_id);
       break;
     default:
-      GL_CHECK(gl_api->glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_obj_));
+      DrawTexture(vertex_buffer_obj_, texture_id);
   } // switch(current_orientation_)
 
+  evas_gl_make_current(evas_gl_, 0, 0);
+}
+
+void RenderWidgetHostViewEfl::DrawTexture(GLuint vertex_buffer,
+                                          GLuint texture_id) {
+  Evas_GL_API* gl_api = evasGlApi();
+
+  GL_CHECK(gl_api->glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer));
   GL_CHECK(gl_api->glEnableVertexAttribArray(position_attrib_));
   // Below 5 * sizeof(GLfloat) value specifies the size of a vertex
   // attribute (x, y, z, u, v).
@@ -366,7 +409,6 @@ void RenderWidgetHostViewEfl::PaintTextureToSurface(GLuint texture_id) {
   GL_CHECK(gl_api->glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, NULL));
 
   GL_CHECK(gl_api->glBindTexture(GL_TEXTURE_2D, 0));
-  evas_gl_make_current(evas_gl_, 0, 0);
 }
 
 void RenderWidgetHostViewEfl::EvasObjectImagePixelsGetCallback(void* data, Evas_Object* obj) {
@@ -400,6 +442,7 @@ void RenderWidgetHostViewEfl::Init_EvasGL(int width, int height) {
   if(height > MAX_SURFACE_HEIGHT_EGL)
     height = MAX_SURFACE_HEIGHT_EGL;
 
+  evas_gl_surface_size_ = gfx::Size(width, height);
   evas_gl_surface_ = evas_gl_surface_create(evas_gl_, evas_gl_config_, width, height);
   if (!evas_gl_surface_) {
     LOG(ERROR) << "set_eweb_view -- Create evas gl Surface Fail";
@@ -420,10 +463,60 @@ void RenderWidgetHostViewEfl::Init_EvasGL(int width, int height) {
   m_IsEvasGLInit = 1;
 }
 
+void RenderWidgetHostViewEfl::Release_EvasGL() {
+  if (!m_IsEvasGLInit)
+    return;
+
+#if defined(OS_TIZEN)
+  DetachMagnifier();
+#endif
+
+  CancelPendingReadbacks();
+
+  evas_object_image_pixels_get_callback_set(content_image_, NULL, NULL);
+  evas_object_image_native_surface_set(content_image_, NULL);
+
+  evas_gl_make_current(evas_gl_, evas_gl_surface_, evas_gl_context_);
+  evas_gl_api_->glDeleteProgram(program_id_);
+  if (copy_vertex_buffer_obj_)
+    evas_gl_api_->glDeleteBuffers(1, &copy_vertex_buffer_obj_);
+  copy_vertex_buffer_obj_ = 0;
+  evas_gl_api_->glDeleteBuffers(1, &vertex_buffer_obj_);
+  evas_gl_api_->glDeleteBuffers(1, &vertex_buffer_obj_270_);
+  evas_gl_api_->glDeleteBuffers(1, &vertex_buffer_obj_90_);
+  evas_gl_api_->glDeleteBuffers(1, &index_buffer_obj_);
+  evas_gl_make_current(evas_gl_, NULL, NULL);
+
+  if (evas_gl_surface_)
+    evas_gl_surface_destroy(evas_gl_, evas_gl_surface_);
+  if (evas_gl_context_)
+    evas_gl_context_destroy(evas_gl_, evas_gl_context_);
+  evas_gl_config_free(evas_gl_config_);
+  evas_gl_free(evas_gl_);
+
+  evas_gl_surface_ = NULL;
+  evas_gl_context_ = NULL;
+  evas_gl_config_ = NULL;
+  evas_gl_api_ = NULL;
+  evas_gl_ = NULL;
+  m_IsEvasGLInit = 0;
+}
+
+int64 RenderWidgetHostViewEfl::ReleaseGpuResourcesIfHidden() {
+  if (!host_->is_hidden() || !m_IsEvasGLInit)
+    return 0;
+
+  // RGBA color plus 24 bit depth and 8 bit stencil per pixel.
+  int64 released = static_cast<int64>(evas_gl_surface_size_.GetArea()) * 8;
+  Release_EvasGL();
+  return released;
+}
+
 bool RenderWidgetHostViewEfl::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(RenderWidgetHostViewEfl, message)
     IPC_MESSAGE_HANDLER(EwkHostMsg_PlainTextGetContents, OnPlainTextGetContents)
+    IPC_MESSAGE_HANDLER(EwkHostMsg_RegisteredScriptExecuted, OnRegisteredScriptExecuted)
     IPC_MESSAGE_HANDLER(EwkHostMsg_WebAppIconUrlGet, OnWebAppIconUrlGet)
     IPC_MESSAGE_HANDLER(EwkHostMsg_WebAppIconUrlsGet, OnWebAppIconUrlsGet)
     IPC_MESSAGE_HANDLER(EwkHostMsg_WebAppCapableGet, OnWebAppCapableGet)
@@ -544,9 +637,7 @@ gfx::NativeViewAccessible RenderWidgetHostViewEfl::GetNativeViewAccessible() {
 }
 
 bool RenderWidgetHostViewEfl::IsSurfaceAvailableForCopy() const {
-#warning "[M37] GetBackingStore does not exist. backing store removed from chromium"
-  //return !!host_->GetBackingStore(false);
-  return false;
+  return m_IsEvasGLInit && texture_id_;
 }
 
 void RenderWidgetHostViewEfl::Show() {
@@ -576,11 +667,33 @@ void RenderWidgetHostViewEfl::UnlockMouse() {
 }
 
 void RenderWidgetHostViewEfl::WasShown() {
+  if (is_hw_accelerated_ && !m_IsEvasGLInit) {
+    // Surface was dropped under memory pressure while hidden.
+    gfx::Rect bounds = GetViewBoundsInPix();
+    if (!bounds.IsEmpty())
+      Init_EvasGL(bounds.width(), bounds.height());
+  }
   host_->WasShown(ui::LatencyInfo());
+  UpdateSensorSamplingRate();
 }
 
 void RenderWidgetHostViewEfl::WasHidden() {
   host_->WasHidden();
+  UpdateSensorSamplingRate();
+}
+
+void RenderWidgetHostViewEfl::UpdateSensorSamplingRate() {
+#if defined(OS_TIZEN)
+  // Hidden pages get no device events, those of the focused view are the
+  // ones the user interacts with.
+  DataFetcherImplTizen::SamplingRate rate =
+      DataFetcherImplTizen::SAMPLING_RATE_NONE;
+  if (!host_->is_hidden()) {
+    rate = HasFocus() ? DataFetcherImplTizen::SAMPLING_RATE_FULL
+                      : DataFetcherImplTizen::SAMPLING_RATE_REDUCED;
+  }
+  DataFetcherImplTizen::GetInstance()->SetSamplingRate(this, rate);
+#endif
 }
 
 void RenderWidgetHostViewEfl::Focus() {
@@ -737,6 +850,9 @@ void RenderWidgetHostViewEfl::SelectionChanged(const base::string16& text,
   const gfx::Range& range) {
   RenderWidgetHostViewBase::SelectionChanged(text, offset, range);
 
+  if (im_context_)
+    im_context_->UpdateSurroundingText(text, offset, range);
+
   if (!web_view_)
     return;
 
@@ -806,6 +922,40 @@ void RenderWidgetHostViewEfl::DispatchGestureEvent(ui::GestureEvent* event) {
   HandleGesture(event);
 }
 
+// Texture coordinates of a point of the view, given as a fraction of its
+// size, for the orientations handled in PaintTextureToSurface().
+static void TexCoordForViewPoint(int orientation, GLfloat x, GLfloat y,
+                                 GLfloat* tex_coord) {
+  switch (orientation) {
+    case 270:
+      tex_coord[0] = y;
+      tex_coord[1] = x;
+      break;
+    case 90:
+      tex_coord[0] = 1.0f - y;
+      tex_coord[1] = 1.0f - x;
+      break;
+    default:
+      tex_coord[0] = x;
+      tex_coord[1] = 1.0f - y;
+  }
+}
+
+// GL reads pixels bottom-up, SkBitmap rows go top-down.
+static void FlipRows(SkBitmap* bitmap) {
+  size_t row_bytes = bitmap->rowBytes();
+  scoped_ptr<uint8_t[]> row(new uint8_t[row_bytes]);
+  uint8_t* pixels = static_cast<uint8_t*>(bitmap->getPixels());
+  for (int top = 0, bottom = bitmap->height() - 1; top < bottom;
+       ++top, --bottom) {
+    uint8_t* top_row = pixels + top * row_bytes;
+    uint8_t* bottom_row = pixels + bottom * row_bytes;
+    memcpy(row.get(), top_row, row_bytes);
+    memcpy(top_row, bottom_row, row_bytes);
+    memcpy(bottom_row, row.get(), row_bytes);
+  }
+}
+
 #if defined(OS_TIZEN)
 void RenderWidgetHostViewEfl::SetRectSnapshot(const SkBitmap& bitmap) {
   if (web_view_)
@@ -820,14 +970,347 @@ void RenderWidgetHostViewEfl::GetSnapshotForRect(gfx::Rect& rect) {
     new GpuMsg_GetPixelRegion(surface_id_, rect));
 #endif
 }
+
+bool RenderWidgetHostViewEfl::AttachMagnifier(Evas_Object* image,
+                                              const gfx::Size& size) {
+  if (!m_IsEvasGLInit || size.IsEmpty())
+    return false;
+  if (magnifier_image_ == image && magnifier_size_ == size &&
+      evas_object_data_get(image, kMagnifierOwnerKey) == this)
+    return true;
+
+  DetachMagnifier();
+
+  // Same config and context as the view, only the surface is the
+  // magnifier's, so the page texture can be sampled as is.
+  magnifier_surface_ = evas_gl_surface_create(
+      evas_gl_, evas_gl_config_, size.width(), size.height());
+  Evas_Native_Surface native_surface;
+  if (!magnifier_surface_ ||
+      !evas_gl_native_surface_get(evas_gl_, magnifier_surface_,
+                                  &native_surface)) {
+    LOG(ERROR) << "Could not create the magnifier surface";
+    if (magnifier_surface_)
+      evas_gl_surface_destroy(evas_gl_, magnifier_surface_);
+    magnifier_surface_ = NULL;
+    return false;
+  }
+
+  evas_gl_make_current(evas_gl_, magnifier_surface_, evas_gl_context_);
+  GL_CHECK(evas_gl_api_->glGenBuffers(1, &magnifier_vertex_buffer_obj_));
+  GL_CHECK(evas_gl_api_->glBindBuffer(GL_ARRAY_BUFFER,
+                                      magnifier_vertex_buffer_obj_));
+  GL_CHECK(evas_gl_api_->glBufferData(GL_ARRAY_BUFFER,
+                                      20 * sizeof(GLfloat), NULL,
+                                      GL_DYNAMIC_DRAW));
+  evas_gl_make_current(evas_gl_, NULL, NULL);
+
+  magnifier_image_ = image;
+  magnifier_size_ = size;
+  magnifier_source_rect_ = gfx::Rect();
+  evas_object_image_size_set(image, size.width(), size.height());
+  evas_object_image_native_surface_set(image, &native_surface);
+  evas_object_image_pixels_get_callback_set(
+      image, EvasObjectMagnifierPixelsGetCallback, this);
+  evas_object_data_set(image, kMagnifierOwnerKey, this);
+  evas_object_event_callback_add(image, EVAS_CALLBACK_DEL,
+                                 OnMagnifierImageDel, this);
+  return true;
+}
+
+bool RenderWidgetHostViewEfl::SetMagnifierSourceRect(const gfx::Rect& rect) {
+  if (!magnifier_image_)
+    return false;
+
+  if (rect != magnifier_source_rect_) {
+    magnifier_source_rect_ = rect;
+    evas_object_image_pixels_dirty_set(magnifier_image_, true);
+  }
+  return true;
+}
+
+void RenderWidgetHostViewEfl::DetachMagnifier() {
+  if (!magnifier_image_)
+    return;
+
+  evas_object_event_callback_del_full(magnifier_image_, EVAS_CALLBACK_DEL,
+                                      OnMagnifierImageDel, this);
+  // A view that replaced this one may have attached the image since, it
+  // keeps its surface then.
+  if (evas_object_data_get(magnifier_image_, kMagnifierOwnerKey) == this) {
+    evas_object_data_del(magnifier_image_, kMagnifierOwnerKey);
+    evas_object_image_pixels_get_callback_set(magnifier_image_, NULL, NULL);
+    evas_object_image_native_surface_set(magnifier_image_, NULL);
+  }
+
+  evas_gl_make_current(evas_gl_, magnifier_surface_, evas_gl_context_);
+  evas_gl_api_->glDeleteBuffers(1, &magnifier_vertex_buffer_obj_);
+  evas_gl_make_current(evas_gl_, NULL, NULL);
+  evas_gl_surface_destroy(evas_gl_, magnifier_surface_);
+
+  magnifier_vertex_buffer_obj_ = 0;
+  magnifier_surface_ = NULL;
+  magnifier_image_ = NULL;
+}
+
+void RenderWidgetHostViewEfl::PaintMagnifier() {
+  gfx::Rect bounds = GetViewBoundsInPix();
+  if (!texture_id_ || bounds.IsEmpty() || magnifier_source_rect_.IsEmpty())
+    return;
+
+  Evas_GL_API* gl_api = evasGlApi();
+  evas_gl_make_current(evas_gl_, magnifier_surface_, evas_gl_context_);
+
+  GLfloat left = static_cast<GLfloat>(magnifier_source_rect_.x()) / bounds.width();
+  GLfloat right = static_cast<GLfloat>(magnifier_source_rect_.right()) / bounds.width();
+  GLfloat top = static_cast<GLfloat>(magnifier_source_rect_.y()) / bounds.height();
+  GLfloat bottom = static_cast<GLfloat>(magnifier_source_rect_.bottom()) / bounds.height();
+
+  // Same quad as vertex_buffer_obj_, only sampling the source rect.
+  GLfloat vertex_attributes[] = {
+      -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+      -1.0f,  1.0f, 0.0f, 0.0f, 0.0f,
+       1.0f,  1.0f, 0.0f, 0.0f, 0.0f,
+       1.0f, -1.0f, 0.0f, 0.0f, 0.0f};
+  TexCoordForViewPoint(current_orientation_, left, bottom, &vertex_attributes[3]);
+  TexCoordForViewPoint(current_orientation_, left, top, &vertex_attributes[8]);
+  TexCoordForViewPoint(current_orientation_, right, top, &vertex_attributes[13]);
+  TexCoordForViewPoint(current_orientation_, right, bottom, &vertex_attributes[18]);
+
+  GL_CHECK(gl_api->glBindBuffer(GL_ARRAY_BUFFER, magnifier_vertex_buffer_obj_));
+  GL_CHECK(gl_api->glBufferSubData(GL_ARRAY_BUFFER, 0,
+                                   sizeof(vertex_attributes),
+                                   vertex_attributes));
+  GL_CHECK(gl_api->glViewport(0, 0, magnifier_size_.width(),
+                              magnifier_size_.height()));
+  GL_CHECK(gl_api->glUseProgram(program_id_));
+  DrawTexture(magnifier_vertex_buffer_obj_, texture_id_);
+
+  evas_gl_make_current(evas_gl_, 0, 0);
+}
+
+void RenderWidgetHostViewEfl::EvasObjectMagnifierPixelsGetCallback(
+    void* data, Evas_Object* obj) {
+  static_cast<RenderWidgetHostViewEfl*>(data)->PaintMagnifier();
+}
+
+void RenderWidgetHostViewEfl::OnMagnifierImageDel(
+    void* data, Evas*, Evas_Object*, void*) {
+  static_cast<RenderWidgetHostViewEfl*>(data)->DetachMagnifier();
+}
 #endif
 
 void RenderWidgetHostViewEfl::CopyFromCompositingSurface(
   const gfx::Rect& src_subrect,
-  const gfx::Size& /* dst_size */,
+  const gfx::Size& dst_size,
   const base::Callback<void(bool, const SkBitmap&)>& callback,
   const SkColorType color_type) {
+  if (!IsSurfaceAvailableForCopy()) {
+    callback.Run(false, SkBitmap());
+    return;
+  }
+
+  // |src_subrect| is in DIP, the page texture in view pixels.
+  gfx::Rect view_rect(GetViewBoundsInPix().size());
+  gfx::Rect src_rect = src_subrect.IsEmpty() ? view_rect :
+      gfx::ToEnclosingRect(gfx::ScaleRect(src_subrect, device_scale_factor_));
+  src_rect.Intersect(view_rect);
+  gfx::Size output_size = dst_size.IsEmpty() ? src_rect.size() : dst_size;
+  if (src_rect.IsEmpty() || output_size.IsEmpty()) {
+    callback.Run(false, SkBitmap());
+    return;
+  }
+
+  PendingReadback readback;
+  if (!DrawScaledCopy(src_rect, output_size, &readback)) {
+    callback.Run(false, SkBitmap());
+    return;
+  }
+  readback.color_type = color_type;
+  readback.callback = callback;
+
+  // glReadPixels() blocks until the GPU is done with the copy, so it is left
+  // for a later iteration of the main loop. Copies requested meanwhile, e.g.
+  // thumbnails of several tabs, are read back together.
+  pending_readbacks_.push_back(readback);
+  if (pending_readbacks_.size() == 1) {
+    base::MessageLoop::current()->PostTask(FROM_HERE,
+        base::Bind(&RenderWidgetHostViewEfl::ProcessPendingReadbacks,
+                   AsWeakPtr()));
+  }
+}
+
+bool RenderWidgetHostViewEfl::DrawScaledCopy(const gfx::Rect& src_rect,
+                                             const gfx::Size& dst_size,
+                                             PendingReadback* readback) {
+  Evas_GL_API* gl_api = evasGlApi();
+  gfx::Rect bounds = GetViewBoundsInPix();
+  evas_gl_make_current(evas_gl_, evas_gl_surface_, evas_gl_context_);
+
+  if (!copy_vertex_buffer_obj_) {
+    GL_CHECK(gl_api->glGenBuffers(1, &copy_vertex_buffer_obj_));
+    GL_CHECK(gl_api->glBindBuffer(GL_ARRAY_BUFFER, copy_vertex_buffer_obj_));
+    GL_CHECK(gl_api->glBufferData(GL_ARRAY_BUFFER, 20 * sizeof(GLfloat),
+                                  NULL, GL_DYNAMIC_DRAW));
+  }
+
+  GLuint framebuffer = 0;
+  GL_CHECK(gl_api->glGenFramebuffers(1, &framebuffer));
+  GL_CHECK(gl_api->glBindFramebuffer(GL_FRAMEBUFFER, framebuffer));
+  GL_CHECK(gl_api->glUseProgram(program_id_));
+
+  // Bilinear sampling only looks at 2x2 texels, so reductions of more than
+  // half are done in halving passes to keep thumbnails from aliasing. The
+  // first pass also picks |src_rect| out of the page texture and undoes the
+  // rotation of the view.
+  GLuint source = texture_id_;
+  GLuint target = 0;
+  gfx::Size size = src_rect.size();
+  bool is_first_pass = true;
+  bool succeeded = true;
+  do {
+    gfx::Size target_size = dst_size;
+    if (size.width() > 2 * dst_size.width() ||
+        size.height() > 2 * dst_size.height()) {
+      target_size.SetSize(std::max(size.width() / 2, dst_size.width()),
+                          std::max(size.height() / 2, dst_size.height()));
+    }
+
+    GL_CHECK(gl_api->glGenTextures(1, &target));
+    GL_CHECK(gl_api->glBindTexture(GL_TEXTURE_2D, target));
+    GL_CHECK(gl_api->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                                     GL_LINEAR));
+    GL_CHECK(gl_api->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+                                     GL_LINEAR));
+    GL_CHECK(gl_api->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,
+                                     GL_CLAMP_TO_EDGE));
+    GL_CHECK(gl_api->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,
+                                     GL_CLAMP_TO_EDGE));
+    GL_CHECK(gl_api->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+                                  target_size.width(), target_size.height(),
+                                  0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    GL_CHECK(gl_api->glFramebufferTexture2D(GL_FRAMEBUFFER,
+                                            GL_COLOR_ATTACHMENT0,
+                                            GL_TEXTURE_2D, target, 0));
+    if (gl_api->glCheckFramebufferStatus(GL_FRAMEBUFFER) !=
+        GL_FRAMEBUFFER_COMPLETE) {
+      LOG(ERROR) << "Incomplete framebuffer for a copy of "
+                 << target_size.ToString();
+      succeeded = false;
+      break;
+    }
+
+    // Same quad as vertex_buffer_obj_, sampling either |src_rect| of the
+    // view or the whole texture of the previous pass.
+    GLfloat vertex_attributes[] = {
+        -1.0f, -1.0f, 0.0f, 0.0f, 0.0f,
+        -1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
+         1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
+         1.0f, -1.0f, 0.0f, 1.0f, 0.0f};
+    if (is_first_pass) {
+      GLfloat left = static_cast<GLfloat>(src_rect.x()) / bounds.width();
+      GLfloat right = static_cast<GLfloat>(src_rect.right()) / bounds.width();
+      GLfloat top = static_cast<GLfloat>(src_rect.y()) / bounds.height();
+      GLfloat bottom = static_cast<GLfloat>(src_rect.bottom()) / bounds.height();
+      TexCoordForViewPoint(current_orientation_, left, bottom, &vertex_attributes[3]);
+      TexCoordForViewPoint(current_orientation_, left, top, &vertex_attributes[8]);
+      TexCoordForViewPoint(current_orientation_, right, top, &vertex_attributes[13]);
+      TexCoordForViewPoint(current_orientation_, right, bottom, &vertex_attributes[18]);
+    }
+    GL_CHECK(gl_api->glBindBuffer(GL_ARRAY_BUFFER, copy_vertex_buffer_obj_));
+    GL_CHECK(gl_api->glBufferSubData(GL_ARRAY_BUFFER, 0,
+                                     sizeof(vertex_attributes),
+                                     vertex_attributes));
+    GL_CHECK(gl_api->glViewport(0, 0, target_size.width(),
+                                target_size.height()));
+    DrawTexture(copy_vertex_buffer_obj_, source);
+
+    if (!is_first_pass)
+      GL_CHECK(gl_api->glDeleteTextures(1, &source));
+    source = target;
+    target = 0;
+    size = target_size;
+    is_first_pass = false;
+  } while (size != dst_size);
+
+  GL_CHECK(gl_api->glBindFramebuffer(GL_FRAMEBUFFER, 0));
+  if (!succeeded) {
+    if (target)
+      GL_CHECK(gl_api->glDeleteTextures(1, &target));
+    if (!is_first_pass)
+      GL_CHECK(gl_api->glDeleteTextures(1, &source));
+    GL_CHECK(gl_api->glDeleteFramebuffers(1, &framebuffer));
+    evas_gl_make_current(evas_gl_, 0, 0);
+    return false;
+  }
+
+  GL_CHECK(gl_api->glFlush());
+  evas_gl_make_current(evas_gl_, 0, 0);
+
+  readback->framebuffer = framebuffer;
+  readback->texture = source;
+  readback->size = dst_size;
+  return true;
+}
 
+void RenderWidgetHostViewEfl::ProcessPendingReadbacks() {
+  if (pending_readbacks_.empty())
+    return;
+
+  std::deque<PendingReadback> readbacks;
+  readbacks.swap(pending_readbacks_);
+  std::vector<SkBitmap> bitmaps(readbacks.size());
+
+  Evas_GL_API* gl_api = evasGlApi();
+  evas_gl_make_current(evas_gl_, evas_gl_surface_, evas_gl_context_);
+  for (size_t i = 0; i < readbacks.size(); ++i) {
+    const PendingReadback& readback = readbacks[i];
+    SkBitmap& bitmap = bitmaps[i];
+    if (bitmap.tryAllocN32Pixels(readback.size.width(),
+                                 readback.size.height())) {
+      SkAutoLockPixels lock(bitmap);
+      GL_CHECK(gl_api->glBindFramebuffer(GL_FRAMEBUFFER, readback.framebuffer));
+      GL_CHECK(gl_api->glReadPixels(0, 0, bitmap.width(), bitmap.height(),
+                                    kN32ReadbackFormat, GL_UNSIGNED_BYTE,
+                                    bitmap.getPixels()));
+      FlipRows(&bitmap);
+    }
+    GL_CHECK(gl_api->glDeleteTextures(1, &readback.texture));
+    GL_CHECK(gl_api->glDeleteFramebuffers(1, &readback.framebuffer));
+  }
+  GL_CHECK(gl_api->glBindFramebuffer(GL_FRAMEBUFFER, 0));
+  evas_gl_make_current(evas_gl_, 0, 0);
+
+  // Callbacks run last, they may well ask for another copy.
+  for (size_t i = 0; i < readbacks.size(); ++i) {
+    const PendingReadback& readback = readbacks[i];
+    SkBitmap bitmap;
+    bool succeeded = !bitmaps[i].isNull();
+    if (succeeded && readback.color_type != kN32_SkColorType)
+      succeeded = bitmaps[i].copyTo(&bitmap, readback.color_type);
+    else
+      bitmap = bitmaps[i];
+    readback.callback.Run(succeeded, succeeded ? bitmap : SkBitmap());
+  }
+}
+
+void RenderWidgetHostViewEfl::CancelPendingReadbacks() {
+  if (pending_readbacks_.empty())
+    return;
+
+  std::deque<PendingReadback> readbacks;
+  readbacks.swap(pending_readbacks_);
+
+  Evas_GL_API* gl_api = evasGlApi();
+  evas_gl_make_current(evas_gl_, evas_gl_surface_, evas_gl_context_);
+  for (size_t i = 0; i < readbacks.size(); ++i) {
+    GL_CHECK(gl_api->glDeleteTextures(1, &readbacks[i].texture));
+    GL_CHECK(gl_api->glDeleteFramebuffers(1, &readbacks[i].framebuffer));
+  }
+  evas_gl_make_current(evas_gl_, 0, 0);
+
+  for (size_t i = 0; i < readbacks.size(); ++i)
+    readbacks[i].callback.Run(false, SkBitmap());
 }
 
 #if defined(OS_TIZEN)
@@ -1107,10 +1590,12 @@ void RenderWidgetHostViewEfl::RenderProcessGone(base::TerminationStatus, int err
 
 void RenderWidgetHostViewEfl::HandleShow() {
   host_->WasShown(ui::LatencyInfo());
+  UpdateSensorSamplingRate();
 }
 
 void RenderWidgetHostViewEfl::HandleHide() {
   host_->WasHidden();
+  UpdateSensorSamplingRate();
 }
 
 void RenderWidgetHostViewEfl::HandleResize(int width, int height) {
@@ -1128,6 +1613,7 @@ void RenderWidgetHostViewEfl::HandleFocusIn() {
   //Will resume the videos playbacks if any were paused when Application was
   // hidden
   host_->WasShown(ui::LatencyInfo());
+  UpdateSensorSamplingRate();
 }
 
 void RenderWidgetHostViewEfl::HandleFocusOut() {
@@ -1146,6 +1632,7 @@ void RenderWidgetHostViewEfl::HandleFocusOut() {
   host_->SetActive(false);
   host_->LostCapture();
   Blur();
+  UpdateSensorSamplingRate();
 }
 
 void RenderWidgetHostViewEfl::set_magnifier(bool status) {
@@ -1201,6 +1688,8 @@ void RenderWidgetHostViewEfl::HandleEvasEvent(const Evas_Event_Key_Down* event)
   }
 
   if (im_context_) {
+    // Keys act on the composition the user sees, do not let them overtake it.
+    FlushPendingComposition();
     if (!strcmp(event->key, "Return")) {
       im_context_->CancelComposition();
     }
@@ -1560,6 +2049,15 @@ void RenderWidgetHostViewEfl::OnPlainTextGetContents(const std::string& content_
   eweb_view()->InvokePlainTextGetCallback(content_text, plain_text_get_callback_id);
 }
 
+void RenderWidgetHostViewEfl::OnRegisteredScriptExecuted(
+    int callback_id, const std::string& result,
+    base::TimeDelta compile_time, base::TimeDelta compile_time_saved,
+    const std::vector<uint8>& code_cache) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  eweb_view()->InvokeRegisteredScriptCallback(callback_id, result, compile_time,
+                                              compile_time_saved, code_cache);
+}
+
 void RenderWidgetHostViewEfl::OnWebAppCapableGet(bool capable, int callback_id) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
   eweb_view()->InvokeWebAppCapableGetCallback(capable, callback_id);
@@ -1585,6 +2083,14 @@ void RenderWidgetHostViewEfl::OnDidChangeContentsSize(int width, int height) {
     Init_EvasGL(width, height);
 }
 
+void RenderWidgetHostViewEfl::OnDisplayMetricsChanged(
+    const gfx::Display& display, uint32_t changed_metrics) {
+  device_scale_factor_ = display.device_scale_factor();
+  // Sends the new screen info to the renderer if it differs from the one it
+  // has, instead of the renderer asking for it.
+  UpdateScreenInfo(GetNativeView());
+}
+
 void RenderWidgetHostViewEfl::OnOrientationChangeEvent(int orientation) {
   current_orientation_ = orientation;
 }
@@ -1630,16 +2136,47 @@ SelectionControllerEfl* RenderWidgetHostViewEfl::GetSelectionController() {
 }
 
 void RenderWidgetHostViewEfl::SetComposition(const ui::CompositionText& composition_text) {
+  pending_composition_.reset(new ui::CompositionText(composition_text));
+  if (!composition_animator_)
+    composition_animator_ = ecore_animator_add(&CompositionAnimatorCallback, this);
+}
+
+Eina_Bool RenderWidgetHostViewEfl::CompositionAnimatorCallback(void* data) {
+  RenderWidgetHostViewEfl* view = static_cast<RenderWidgetHostViewEfl*>(data);
+  view->composition_animator_ = NULL;
+  view->FlushPendingComposition();
+  return ECORE_CALLBACK_CANCEL;
+}
+
+void RenderWidgetHostViewEfl::FlushPendingComposition() {
+  if (composition_animator_) {
+    ecore_animator_del(composition_animator_);
+    composition_animator_ = NULL;
+  }
+  if (!pending_composition_)
+    return;
+
+  scoped_ptr<ui::CompositionText> composition_text(pending_composition_.Pass());
   const std::vector<blink::WebCompositionUnderline>& underlines =
       reinterpret_cast<const std::vector<blink::WebCompositionUnderline>&>(
-      composition_text.underlines);
+      composition_text->underlines);
 
   host_->ImeSetComposition(
-      composition_text.text, underlines, composition_text.selection.start(),
-      composition_text.selection.end());
+      composition_text->text, underlines, composition_text->selection.start(),
+      composition_text->selection.end());
+}
+
+void RenderWidgetHostViewEfl::CancelPendingComposition() {
+  if (composition_animator_) {
+    ecore_animator_del(composition_animator_);
+    composition_animator_ = NULL;
+  }
+  pending_composition_.reset();
 }
 
 void RenderWidgetHostViewEfl::ClearQueues() {
+  CancelPendingComposition();
+
   while (!keyupev_queue_.empty()) {
     keyupev_queue_.pop();
   }
@@ -1650,7 +2187,9 @@ void RenderWidgetHostViewEfl::ClearQueues() {
   }
 }
 
-void RenderWidgetHostViewEfl::ConfirmComposition(base::string16& text) {
+void RenderWidgetHostViewEfl::ConfirmComposition(const base::string16& text) {
+  // The committed text replaces whatever composition is still pending.
+  CancelPendingComposition();
   host_->ImeConfirmComposition(text, gfx::Range::InvalidRange(), false);
 }
 
@@ -1735,6 +2274,11 @@ void RenderWidgetHostViewEfl::OnSwapCompositorFrame(
       if (texture != NULL) {
         texture_id_ = GetTextureIdFromTexture(texture);
         evas_object_image_pixels_dirty_set(content_image_, true);
+#if defined(OS_TIZEN)
+        // The page changed under the magnifier as well.
+        if (magnifier_image_)
+          evas_object_image_pixels_dirty_set(magnifier_image_, true);
+#endif
       } else {
         LOG(ERROR) << "Frame produced without texture.";
       }
@@ -24,6 +24,7 @@
 #include "gpu/command_buffer/common/mailbox.h"
 #include "ui/base/ime/composition_text.h"
 #include "ui/base/ime/text_input_client.h"
+#include "ui/gfx/display_observer.h"
 #include "eweb_view.h"
 #include "browser/renderer_host/im_context_efl.h"
 #include "third_party/WebKit/public/web/WebInputEvent.h"
@@ -64,7 +65,8 @@ class RenderWidgetHostViewEfl
     public ui::GestureConsumer,
     public ui::GestureEventHelper,
     public base::SupportsWeakPtr<RenderWidgetHostViewEfl>,
-    public IPC::Sender {
+    public IPC::Sender,
+    public gfx::DisplayObserver {
  public:
   explicit RenderWidgetHostViewEfl(RenderWidgetHost*, EWebView*);
 
@@ -166,6 +168,12 @@ class RenderWidgetHostViewEfl
   // IPC::Sender implementation:
   virtual bool Send(IPC::Message*) override;
 
+  // gfx::DisplayObserver implementation.
+  virtual void OnDisplayAdded(const gfx::Display&) override {}
+  virtual void OnDisplayRemoved(const gfx::Display&) override {}
+  virtual void OnDisplayMetricsChanged(const gfx::Display& display,
+                                       uint32_t changed_metrics) override;
+
   void OnSelectionTextStyleState(const SelectionStylePrams& params);
   void OnDidChangeMaxScrollOffset(int maxScrollX, int maxScrollY);
   void OnDidChangeScrollOffset(int scrollX, int scrollY);
@@ -177,6 +185,15 @@ class RenderWidgetHostViewEfl
   void GetSnapshotForRect(gfx::Rect& rect);
   void SetRectSnapshot(const SkBitmap& bitmap);
   void GetSnapshotAsync(const gfx::Rect& snapshot_area, int request_id);
+
+  // Makes |image| show a part of the composited page, drawn from the page
+  // texture into a persistent Evas GL surface of |size|. The image is
+  // detached when deleted. Returns false when the view is not GPU
+  // composited, GetSnapshotForRect() is the way to go then.
+  bool AttachMagnifier(Evas_Object* image, const gfx::Size& size);
+  // Sets the part of the view, in view pixels, shown by the magnifier. It is
+  // redrawn with the next frame of the canvas.
+  bool SetMagnifierSourceRect(const gfx::Rect& rect);
 #endif
 
   Evas* evas() const {
@@ -189,6 +206,9 @@ class RenderWidgetHostViewEfl
 
   void Init_EvasGL(int width, int height);
   void Init(Evas_Object* view, const gfx::Size& size);
+  // Destroys the Evas GL surface of a hidden view, it is recreated in
+  // WasShown(). Returns an estimate of the bytes released.
+  int64 ReleaseGpuResourcesIfHidden();
 
   void set_eweb_view(EWebView* webview) { web_view_ = webview; }
   EWebView* eweb_view() const { return web_view_; }
@@ -217,6 +237,10 @@ class RenderWidgetHostViewEfl
   void HandleGesture(blink::WebGestureEvent&);
   void HandleTouchEvent(ui::TouchEvent*);
   void OnPlainTextGetContents(const std::string&, int);
+  void OnRegisteredScriptExecuted(int callback_id, const std::string& result,
+                                  base::TimeDelta compile_time,
+                                  base::TimeDelta compile_time_saved,
+                                  const std::vector<uint8>& code_cache);
   void OnWebAppCapableGet(bool capable, int callback_id);
   void OnWebAppIconUrlGet(const std::string &icon_url, int callback_id);
   void OnWebAppIconUrlsGet(const std::map<std::string, std::string> &icon_urls, int callback_id);
@@ -235,8 +259,10 @@ class RenderWidgetHostViewEfl
   // This function sets CSS "view-mode" media feature value.
   void SetViewMode(tizen_webview::View_Mode view_mode);
 
+  // Compositions are sent at most once per frame, only the latest one of a
+  // frame is visible anyway.
   void SetComposition(const ui::CompositionText& composition_text);
-  void ConfirmComposition(base::string16& text);
+  void ConfirmComposition(const base::string16& text);
   void SendGestureEvent(blink::WebGestureEvent& event);
 
   bool IsScrollOffsetChanged() const { return scroll_offset_changed_; }
@@ -246,6 +272,16 @@ class RenderWidgetHostViewEfl
   friend class RenderWidgetHostView;
 
  private:
+  // A downscaled copy of the page rendered by CopyFromCompositingSurface()
+  // and waiting for its pixels to be read back.
+  struct PendingReadback {
+    GLuint framebuffer;
+    GLuint texture;
+    gfx::Size size;
+    SkColorType color_type;
+    base::Callback<void(bool, const SkBitmap&)> callback;
+  };
+
   virtual ~RenderWidgetHostViewEfl();
 
   void OnDidChangeContentsSize(int, int);
@@ -277,16 +313,37 @@ class RenderWidgetHostViewEfl
 
   static void EvasObjectImagePixelsGetCallback(void*, Evas_Object*);
   void initializeProgram();
+  void Release_EvasGL();
+
+  bool DrawScaledCopy(const gfx::Rect& src_rect, const gfx::Size& dst_size,
+                      PendingReadback* readback);
+  void ProcessPendingReadbacks();
+  void CancelPendingReadbacks();
 
   Ecore_X_Window GetEcoreXWindow() const;
 
+  static Eina_Bool CompositionAnimatorCallback(void* data);
+  void FlushPendingComposition();
+  void CancelPendingComposition();
+
   void HandleCommitQueue(bool processed);
   void HandlePreeditQueue(bool processed);
   void HandleKeyUpQueue();
   void HandleKeyDownQueue();
   void SendCompositionKeyUpEvent(char c);
 
+  // Tells the device sensors how often this view needs samples.
+  void UpdateSensorSamplingRate();
+
   void PaintTextureToSurface(GLuint texture_id);
+  // Draws |texture_id| with the quad in |vertex_buffer| to the current surface.
+  void DrawTexture(GLuint vertex_buffer, GLuint texture_id);
+#if defined(OS_TIZEN)
+  void PaintMagnifier();
+  void DetachMagnifier();
+  static void EvasObjectMagnifierPixelsGetCallback(void* data, Evas_Object* obj);
+  static void OnMagnifierImageDel(void* data, Evas*, Evas_Object*, void*);
+#endif
 
   RenderWidgetHostImpl* host_;
   EWebView* web_view_;
@@ -296,6 +353,7 @@ class RenderWidgetHostViewEfl
   Evas_Object* content_image_;
   scoped_ptr<EflWebview::ScrollDetector> scroll_detector_;
   int m_IsEvasGLInit;
+  gfx::Size evas_gl_surface_size_;
   float device_scale_factor_;
 
   typedef std::map<gfx::PluginWindowHandle, Ecore_X_Window> PluginWindowToWidgetMap;
@@ -349,12 +407,26 @@ class RenderWidgetHostViewEfl
   GLuint vertex_buffer_obj_270_;
   GLuint vertex_buffer_obj_90_;
   GLuint index_buffer_obj_;
+  // Quad sampling the source of the current copy pass.
+  GLuint copy_vertex_buffer_obj_;
+  std::deque<PendingReadback> pending_readbacks_;
+#if defined(OS_TIZEN)
+  Evas_Object* magnifier_image_;
+  Evas_GL_Surface* magnifier_surface_;
+  gfx::Size magnifier_size_;
+  gfx::Rect magnifier_source_rect_;
+  // Quad sampling |magnifier_source_rect_|, rewritten when it moves.
+  GLuint magnifier_vertex_buffer_obj_;
+#endif
   typedef std::queue<int> KeyUpEventQueue;
   KeyUpEventQueue keyupev_queue_;
 
   typedef std::queue<NativeWebKeyboardEvent*> KeyDownEventQueue;
   KeyDownEventQueue keydownev_queue_;
 
+  scoped_ptr<ui::CompositionText> pending_composition_;
+  Ecore_Animator* composition_animator_;
+
   bool should_restore_selection_menu_;
   bool selection_acked_on_tap_;
   // Used only to indicate that user scrolled view
@@ -4,26 +4,78 @@
 
 #include "browser/renderer_host/web_cache_manager_efl.h"
 #include "common/render_messages_efl.h"
-#include "cache_params_efl.h"
 
+#include <algorithm>
+
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/message_loop/message_loop.h"
 #include "base/sys_info.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/notification_service.h"
 #include "content/public/browser/notification_source.h"
 #include "content/public/browser/notification_types.h"
 #include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
+#include "content/public/browser/render_widget_host_view.h"
 
 using namespace tizen_webview;
 
+namespace {
+
+// Delay used to coalesce bursts of stats/activity reports into one revision.
+const int kReviseAllocationDelayMS = 2000;
+
+// Allocations are also revised periodically so that renderers which stopped
+// being used lose their share even when nothing else happens.
+const int kReviseAllocationIntervalSeconds = 30;
+
+// A hidden renderer without activity for this long is shrunk to its live size.
+const int kRendererInactiveThresholdMinutes = 5;
+
+// Relative share of the spare budget given to visible and hidden-but-recently
+// used renderers.
+const int kVisibleRendererWeight = 3;
+const int kActiveRendererWeight = 1;
+
+// An inactive renderer never keeps more than this fraction of the budget.
+const int kInactiveRendererBudgetDivisor = 8;
+
+const int64 kMegabyte = 1024 * 1024;
+
+bool CacheParamsEqual(const CacheParamsEfl& a, const CacheParamsEfl& b) {
+  return a.cache_total_capacity == b.cache_total_capacity &&
+      a.cache_min_dead_capacity == b.cache_min_dead_capacity &&
+      a.cache_max_dead_capacity == b.cache_max_dead_capacity;
+}
+
+} // namespace
+
+WebCacheManagerEfl::RendererInfo::RendererInfo()
+    : last_activity(base::Time::Now()),
+      visible(false) {
+  stats.capacity = 0;
+  stats.live_size = 0;
+  stats.dead_size = 0;
+  params.cache_total_capacity = -1;
+  params.cache_min_dead_capacity = -1;
+  params.cache_max_dead_capacity = -1;
+}
+
 WebCacheManagerEfl::WebCacheManagerEfl(content::BrowserContext* browser_context)
     : browser_context_(browser_context),
-      cache_model_(TW_CACHE_MODEL_DOCUMENT_VIEWER)
+      cache_model_(TW_CACHE_MODEL_DOCUMENT_VIEWER),
+      revise_pending_(false),
+      weak_factory_(this)
 {
   registrar_.Add(this, content::NOTIFICATION_RENDERER_PROCESS_CREATED,
                  content::NotificationService::AllBrowserContextsAndSources());
   registrar_.Add(this, content::NOTIFICATION_RENDERER_PROCESS_TERMINATED,
                  content::NotificationService::AllBrowserContextsAndSources());
+  registrar_.Add(this, content::NOTIFICATION_RENDER_WIDGET_VISIBILITY_CHANGED,
+                 content::NotificationService::AllBrowserContextsAndSources());
+  global_params_ = GetCacheParamsFromModel(cache_model_);
 }
 
 WebCacheManagerEfl::~WebCacheManagerEfl() { }
@@ -32,8 +84,11 @@ void WebCacheManagerEfl::Observe(int type,
                               const content::NotificationSource& source,
                               const content::NotificationDetails& details)
 {
-  content::RenderProcessHost* process =
-            content::Source<content::RenderProcessHost>(source).ptr();
+  content::RenderProcessHost* process = NULL;
+  if (type == content::NOTIFICATION_RENDER_WIDGET_VISIBILITY_CHANGED)
+    process = content::Source<content::RenderWidgetHost>(source)->GetProcess();
+  else
+    process = content::Source<content::RenderProcessHost>(source).ptr();
   DCHECK(process);
   if (process->GetBrowserContext() != browser_context_)
     return;
@@ -41,12 +96,29 @@ void WebCacheManagerEfl::Observe(int type,
   int renderer_id = process->GetID();
   switch (type) {
     case content::NOTIFICATION_RENDERER_PROCESS_CREATED: {
-      renderers_.insert(renderer_id);
-      SetRenderProcessCacheModel(cache_model_, renderer_id);
+      RendererInfo& info = renderers_[renderer_id];
+      // Give the new renderer an even share until the next revision
+      // accounts for its real usage.
+      SendCacheParams(renderer_id, &info, MakeCacheParams(
+          global_params_.cache_total_capacity / renderers_.size()));
+      if (!revise_timer_.IsRunning()) {
+        revise_timer_.Start(FROM_HERE,
+            base::TimeDelta::FromSeconds(kReviseAllocationIntervalSeconds),
+            this, &WebCacheManagerEfl::ReviseAllocationStrategy);
+      }
+      ReviseAllocationStrategyLater();
       break;
     }
     case content::NOTIFICATION_RENDERER_PROCESS_TERMINATED: {
       renderers_.erase(renderer_id);
+      if (renderers_.empty())
+        revise_timer_.Stop();
+      else
+        ReviseAllocationStrategyLater();
+      break;
+    }
+    case content::NOTIFICATION_RENDER_WIDGET_VISIBILITY_CHANGED: {
+      ObserveActivity(renderer_id);
       break;
     }
     default:
@@ -57,45 +129,205 @@ void WebCacheManagerEfl::Observe(int type,
 
 void WebCacheManagerEfl::ClearCache()
 {
-  for (std::set<int>::const_iterator iter = renderers_.begin();
+  for (RendererMap::const_iterator iter = renderers_.begin();
       iter != renderers_.end(); ++iter) {
-    content::RenderProcessHost* host = content::RenderProcessHost::FromID(*iter);
+    content::RenderProcessHost* host = content::RenderProcessHost::FromID(iter->first);
     if (host)
       host->Send(new EflViewMsg_ClearCache());
   }
 }
 
-void WebCacheManagerEfl::SetRenderProcessCacheModel(Cache_Model model, int render_process_id)
+void WebCacheManagerEfl::SetCacheModel(Cache_Model model)
 {
-  DCHECK(render_process_id);
-  DCHECK(renderers_.find(render_process_id) != renderers_.end());
-  content::RenderProcessHost* host = content::RenderProcessHost::FromID(render_process_id);
-  if (host)
-    host->Send(new EflViewMsg_SetCache(GetCacheParamsFromModel(model)));
+  cache_model_ = model;
+  global_params_ = GetCacheParamsFromModel(model);
+  ReviseAllocationStrategy();
 }
 
-void WebCacheManagerEfl::SetCacheModel(Cache_Model model)
+void WebCacheManagerEfl::ObserveStats(int renderer_id, const CacheStatsEfl& stats)
 {
-  cache_model_ = model;
-  CacheParamsEfl cache_params = GetCacheParamsFromModel(model);
-  for (std::set<int>::const_iterator iter = renderers_.begin();
-          iter != renderers_.end(); ++iter) {
-    content::RenderProcessHost* host = content::RenderProcessHost::FromID(*iter);
-    if (host)
-      host->Send(new EflViewMsg_SetCache(cache_params));
+  RendererMap::iterator iter = renderers_.find(renderer_id);
+  if (iter == renderers_.end())
+    return;
+
+  iter->second.stats = stats;
+  // Stats are reported on navigation, which counts as activity as well.
+  ObserveActivity(renderer_id);
+}
+
+void WebCacheManagerEfl::ObserveActivity(int renderer_id)
+{
+  RendererMap::iterator iter = renderers_.find(renderer_id);
+  if (iter == renderers_.end())
+    return;
+
+  iter->second.last_activity = base::Time::Now();
+  ReviseAllocationStrategyLater();
+}
+
+int64 WebCacheManagerEfl::GetGlobalSizeLimit() const
+{
+  return global_params_.cache_total_capacity;
+}
+
+void WebCacheManagerEfl::GetAllocations(std::vector<Allocation>* allocations) const
+{
+  DCHECK(allocations);
+  base::Time now = base::Time::Now();
+  allocations->clear();
+  for (RendererMap::const_iterator iter = renderers_.begin();
+      iter != renderers_.end(); ++iter) {
+    Allocation allocation;
+    allocation.renderer_id = iter->first;
+    allocation.visible = iter->second.visible;
+    allocation.active = IsRendererActive(iter->second, now);
+    allocation.stats = iter->second.stats;
+    allocation.params = iter->second.params;
+    allocations->push_back(allocation);
+  }
+}
+
+CacheParamsEfl WebCacheManagerEfl::MakeCacheParams(int64 capacity) const
+{
+  CacheParamsEfl params;
+  params.cache_total_capacity = capacity;
+  if (global_params_.cache_total_capacity > 0) {
+    // Keep the dead/total ratios the cache model asked for.
+    params.cache_min_dead_capacity = capacity *
+        global_params_.cache_min_dead_capacity / global_params_.cache_total_capacity;
+    params.cache_max_dead_capacity = capacity *
+        global_params_.cache_max_dead_capacity / global_params_.cache_total_capacity;
+  } else {
+    params.cache_min_dead_capacity = 0;
+    params.cache_max_dead_capacity = 0;
+  }
+  params.cache_max_dead_capacity =
+      std::min(params.cache_max_dead_capacity, params.cache_total_capacity);
+  return params;
+}
+
+bool WebCacheManagerEfl::IsRendererActive(const RendererInfo& info,
+                                          base::Time now) const
+{
+  return info.visible || (now - info.last_activity) <
+      base::TimeDelta::FromMinutes(kRendererInactiveThresholdMinutes);
+}
+
+void WebCacheManagerEfl::UpdateVisibility()
+{
+  for (RendererMap::iterator iter = renderers_.begin();
+      iter != renderers_.end(); ++iter)
+    iter->second.visible = false;
+
+  scoped_ptr<content::RenderWidgetHostIterator> widgets(
+      content::RenderWidgetHost::GetRenderWidgetHosts());
+  while (content::RenderWidgetHost* widget = widgets->GetNextHost()) {
+    RendererMap::iterator iter = renderers_.find(widget->GetProcess()->GetID());
+    if (iter == renderers_.end())
+      continue;
+    content::RenderWidgetHostView* view = widget->GetView();
+    if (view && view->IsShowing())
+      iter->second.visible = true;
+  }
+}
+
+void WebCacheManagerEfl::ReviseAllocationStrategyLater()
+{
+  if (revise_pending_)
+    return;
+
+  revise_pending_ = true;
+  base::MessageLoop::current()->PostDelayedTask(FROM_HERE,
+      base::Bind(&WebCacheManagerEfl::ReviseAllocationStrategy,
+                 weak_factory_.GetWeakPtr()),
+      base::TimeDelta::FromMilliseconds(kReviseAllocationDelayMS));
+}
+
+void WebCacheManagerEfl::ReviseAllocationStrategy()
+{
+  revise_pending_ = false;
+  if (renderers_.empty())
+    return;
+
+  UpdateVisibility();
+  base::Time now = base::Time::Now();
+  int64 budget = global_params_.cache_total_capacity;
+
+  // Background renderers nobody used for a while keep at most their live
+  // objects and no dead resources at all.
+  int total_weight = 0;
+  int64 active_live_size = 0;
+  for (RendererMap::iterator iter = renderers_.begin();
+      iter != renderers_.end(); ++iter) {
+    RendererInfo& info = iter->second;
+    if (IsRendererActive(info, now)) {
+      total_weight += info.visible ? kVisibleRendererWeight
+                                   : kActiveRendererWeight;
+      active_live_size += info.stats.live_size;
+      continue;
+    }
+    CacheParamsEfl params;
+    params.cache_total_capacity = std::min(info.stats.live_size,
+        global_params_.cache_total_capacity / kInactiveRendererBudgetDivisor);
+    params.cache_min_dead_capacity = 0;
+    params.cache_max_dead_capacity = 0;
+    budget -= params.cache_total_capacity;
+    SendCacheParams(iter->first, &info, params);
+  }
+
+  if (!total_weight)
+    return;
+
+  // Active renderers get room for what they already hold when the budget
+  // allows it, and the remainder is split by visibility.
+  budget = std::max(budget, static_cast<int64>(0));
+  bool live_fits = active_live_size <= budget;
+  int64 spare = live_fits ? budget - active_live_size : budget;
+  for (RendererMap::iterator iter = renderers_.begin();
+      iter != renderers_.end(); ++iter) {
+    RendererInfo& info = iter->second;
+    if (!IsRendererActive(info, now))
+      continue;
+    int weight = info.visible ? kVisibleRendererWeight : kActiveRendererWeight;
+    int64 capacity = spare * weight / total_weight;
+    if (live_fits)
+      capacity += info.stats.live_size;
+    SendCacheParams(iter->first, &info, MakeCacheParams(capacity));
   }
 }
 
+void WebCacheManagerEfl::SendCacheParams(int renderer_id, RendererInfo* info,
+                                         const CacheParamsEfl& params)
+{
+  if (CacheParamsEqual(info->params, params))
+    return;
+
+  VLOG(1) << "Memory cache allocation for renderer " << renderer_id
+          << (info->visible ? " (visible)" : "")
+          << ": live=" << info->stats.live_size
+          << " dead=" << info->stats.dead_size
+          << " -> capacity=" << params.cache_total_capacity
+          << " dead=[" << params.cache_min_dead_capacity
+          << ", " << params.cache_max_dead_capacity << "]";
+
+  info->params = params;
+  content::RenderProcessHost* host = content::RenderProcessHost::FromID(renderer_id);
+  if (host)
+    host->Send(new EflViewMsg_SetCache(params));
+}
+
 CacheParamsEfl WebCacheManagerEfl::GetCacheParamsFromModel(Cache_Model cache_model)
 {
-  int64 mem_size = base::SysInfo::AmountOfPhysicalMemory();
+  // WK2 thresholds below are expressed in megabytes.
+  int64 mem_size = base::SysInfo::AmountOfPhysicalMemory() / kMegabyte;
   // in chromium the limiting parameter is max file size of network cache
   // which is set at the time of creation of backend.
   // backend could be completely in-memory as well.
   // in WK2/Tizen, it is free space on disk
   // So, we are using free space available on browser_context path
   // we dont set it on renderer side anyway.
-  int64 disk_free_size = base::SysInfo::AmountOfFreeDiskSpace(browser_context_->GetPath());
+  int64 disk_free_size = browser_context_ ?
+      base::SysInfo::AmountOfFreeDiskSpace(browser_context_->GetPath()) / kMegabyte : 0;
   int64 cache_min_dead_capacity = 0;
   int64 cache_max_dead_capacity = 0;
   int64 cache_total_capacity = 0;
@@ -115,8 +347,8 @@ CacheParamsEfl WebCacheManagerEfl::GetCacheParamsFromModel(Cache_Model cache_mod
   // m_deadDecodedDataDeletionInterval is unused variable in MemoryCache.cpp in
   // WK2 CachedResource uses this to start timer.
   // So, We are using only cache_total_capacity, cache_min_dead_capacity, and
-  // cache_max_dead_capacity. This is same as Chromium cache manager implementation
-  // But we are using following calculation instead of dynamic strategy used in Chromium.
+  // cache_max_dead_capacity. The result is the budget for all renderers
+  // together; ReviseAllocationStrategy() splits it between them.
   CalculateCacheSizes(cache_model, mem_size, disk_free_size,
                       &cache_total_capacity, &cache_min_dead_capacity, &cache_max_dead_capacity,
                       &dead_decoded_data_deletion_interval, &page_cache_capacity,
@@ -147,6 +379,8 @@ void WebCacheManagerEfl::CalculateCacheSizes(Cache_Model cache_model, int64 memo
         *cache_total_capacity = 32 * 1024 * 1024;
       else if (memory_size >= 512)
         *cache_total_capacity = 16 * 1024 * 1024;
+      else
+        *cache_total_capacity = 8 * 1024 * 1024;
 
       *cache_min_dead_capacity = 0;
       *cache_max_dead_capacity = 0;
@@ -179,6 +413,8 @@ void WebCacheManagerEfl::CalculateCacheSizes(Cache_Model cache_model, int64 memo
         *cache_total_capacity = 32 * 1024 * 1024;
       else if (memory_size >= 512)
         *cache_total_capacity = 16 * 1024 * 1024;
+      else
+        *cache_total_capacity = 8 * 1024 * 1024;
 
       *cache_min_dead_capacity = *cache_total_capacity / 8;
       *cache_max_dead_capacity = *cache_total_capacity / 4;
@@ -231,6 +467,8 @@ void WebCacheManagerEfl::CalculateCacheSizes(Cache_Model cache_model, int64 memo
         *cache_total_capacity = 64 * 1024 * 1024;
       else if (memory_size >= 512)
         *cache_total_capacity = 32 * 1024 * 1024;
+      else
+        *cache_total_capacity = 16 * 1024 * 1024;
 
       *cache_min_dead_capacity = *cache_total_capacity / 4;
       *cache_max_dead_capacity = *cache_total_capacity / 2;
@@ -273,6 +511,7 @@ void WebCacheManagerEfl::CalculateCacheSizes(Cache_Model cache_model, int64 memo
        break;
   };
 }
+
 void WebCacheManagerEfl::SetBrowserContext(content::BrowserContext* browser_context) {
   DCHECK(!browser_context_);
   browser_context_ = browser_context;
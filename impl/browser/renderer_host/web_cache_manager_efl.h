@@ -5,10 +5,15 @@
 #ifndef WEB_CACHE_MANAGER_EFL_H
 #define WEB_CACHE_MANAGER_EFL_H
 
-#include <set>
+#include <map>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/memory/singleton.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "cache_params_efl.h"
 #include "content/public/browser/notification_observer.h"
 #include "content/public/browser/notification_registrar.h"
 #include "tizen_webview/public/tw_cache_model.h"
@@ -16,10 +21,22 @@
 namespace content {
 class BrowserContext;
 }
-struct CacheParamsEfl;
 
+// Distributes one global Blink memory cache budget between all renderers of
+// a browser context. Renderers report their usage with every navigation, and
+// the budget is periodically re-split by visibility and recency of use, in
+// the spirit of chrome's WebCacheManager.
 class WebCacheManagerEfl : public content::NotificationObserver {
  public:
+  // Snapshot of the decision taken for one renderer, for inspection.
+  struct Allocation {
+    int renderer_id;
+    bool visible;
+    bool active;
+    CacheStatsEfl stats;
+    CacheParamsEfl params;
+  };
+
   explicit WebCacheManagerEfl(content::BrowserContext* browser_context);
   virtual ~WebCacheManagerEfl();
 
@@ -32,7 +49,27 @@ class WebCacheManagerEfl : public content::NotificationObserver {
   tizen_webview::Cache_Model GetCacheModel() const { return cache_model_; }
   void SetBrowserContext(content::BrowserContext* browser_context);
 
+  // Called when a renderer reports its current memory cache usage.
+  void ObserveStats(int renderer_id, const CacheStatsEfl& stats);
+  // Called when a renderer did something user visible (navigation, shown).
+  void ObserveActivity(int renderer_id);
+
+  // Budget shared by all renderers of this context, in bytes.
+  int64 GetGlobalSizeLimit() const;
+  // Returns the allocation last sent to every known renderer.
+  void GetAllocations(std::vector<Allocation>* allocations) const;
+
  private:
+  struct RendererInfo {
+    RendererInfo();
+
+    base::Time last_activity;
+    CacheStatsEfl stats;
+    CacheParamsEfl params;
+    bool visible;
+  };
+  typedef std::map<int, RendererInfo> RendererMap;
+
   static void CalculateCacheSizes(tizen_webview::Cache_Model cache_model, int64 memory_size, int64 disk_free_size,
       int64* cache_total_capacity, int64* cache_min_dead_capacity,
       int64* cache_max_dead_capacity, double* dead_decoded_data_deletion_interval,
@@ -40,14 +77,24 @@ class WebCacheManagerEfl : public content::NotificationObserver {
       int64* url_cache_disk_capacity);
 
   CacheParamsEfl GetCacheParamsFromModel(tizen_webview::Cache_Model);
-  void SetRenderProcessCacheModel(tizen_webview::Cache_Model model, int render_process_id);
+  // Derives min/max dead capacities for |capacity| from the cache model.
+  CacheParamsEfl MakeCacheParams(int64 capacity) const;
+  bool IsRendererActive(const RendererInfo& info, base::Time now) const;
+  void UpdateVisibility();
+  void ReviseAllocationStrategy();
+  void ReviseAllocationStrategyLater();
+  void SendCacheParams(int renderer_id, RendererInfo* info,
+                       const CacheParamsEfl& params);
 
   content::NotificationRegistrar registrar_;
-  std::set<int> renderers_;
+  RendererMap renderers_;
   content::BrowserContext* browser_context_;
   tizen_webview::Cache_Model cache_model_;
+  CacheParamsEfl global_params_;
+  bool revise_pending_;
+  base::RepeatingTimer<WebCacheManagerEfl> revise_timer_;
+  base::WeakPtrFactory<WebCacheManagerEfl> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(WebCacheManagerEfl);
 };
 
 #endif
-
@@ -10,6 +10,7 @@
 #include "content/public/browser/resource_request_info.h"
 #include "net/url_request/url_request.h"
 #include "net/http/http_response_headers.h"
+#include "browser/favicon/favicon_downloader.h"
 #include "browser/login_delegate_efl.h"
 #include "browser_context_efl.h"
 #include "common/web_contents_utils.h"
@@ -75,6 +76,16 @@ void ResourceDispatcherHostDelegateEfl::RequestBeginning(
   }
 }
 
+void ResourceDispatcherHostDelegateEfl::OnResponseStarted(
+    net::URLRequest* request,
+    ResourceContext* resource_context,
+    ResourceResponse* response,
+    IPC::Sender* sender) {
+  const ResourceRequestInfo* info = ResourceRequestInfo::ForRequest(request);
+  if (info && info->GetResourceType() == RESOURCE_TYPE_FAVICON)
+    FaviconDownloader::ResponseStarted(request);
+}
+
 ResourceDispatcherHostLoginDelegate*
 ResourceDispatcherHostDelegateEfl::CreateLoginDelegate(
     net::AuthChallengeInfo* auth_info,
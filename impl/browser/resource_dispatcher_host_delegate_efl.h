@@ -47,6 +47,13 @@ class ResourceDispatcherHostDelegateEfl
       bool must_download,
       ScopedVector<content::ResourceThrottle>* throttles) override;
 
+  // Called when the response headers of a request arrived.
+  virtual void OnResponseStarted(
+      net::URLRequest* request,
+      ResourceContext* resource_context,
+      ResourceResponse* response,
+      IPC::Sender* sender) override;
+
 #if !defined(EWK_BRINGUP)
   // Return true if it should override mime type, otherwise, return false.
   virtual bool ShouldOverrideMimeType(
@@ -0,0 +1,147 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/selectpicker/popup_menu_model.h"
+
+#include <algorithm>
+
+#include <Eina.h>
+
+#include "base/strings/string_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "content/public/common/menu_item.h"
+
+namespace {
+
+const char* InternUTF16(const base::string16& text) {
+  std::string utf8 = base::UTF16ToUTF8(text);
+  return eina_stringshare_add_length(utf8.data(), utf8.length());
+}
+
+} // namespace
+
+PopupMenuModel::PopupMenuModel(const std::vector<content::MenuItem>& items)
+    : search_index_valid_(false) {
+  items_.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i)
+    items_.push_back(MakeItem(items[i]));
+}
+
+PopupMenuModel::~PopupMenuModel() {
+  ReleaseItems(0, items_.size());
+}
+
+void PopupMenuModel::Update(const std::vector<content::MenuItem>& items,
+                            Diff* diff) {
+  std::vector<Item> new_items;
+  new_items.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i)
+    new_items.push_back(MakeItem(items[i]));
+
+  // Options are mostly added, removed or toggled in place, a common head
+  // and tail with one replaced range in between describes that well enough.
+  size_t old_size = items_.size();
+  size_t new_size = new_items.size();
+  size_t head = 0;
+  while (head < old_size && head < new_size &&
+         HasSameContent(items_[head], new_items[head])) {
+    if (!HasSameState(items_[head], new_items[head]))
+      diff->changed.push_back(head);
+    ++head;
+  }
+  size_t tail = 0;
+  while (tail < old_size - head && tail < new_size - head &&
+         HasSameContent(items_[old_size - tail - 1],
+                        new_items[new_size - tail - 1])) {
+    if (!HasSameState(items_[old_size - tail - 1],
+                      new_items[new_size - tail - 1]))
+      diff->changed.push_back(new_size - tail - 1);
+    ++tail;
+  }
+
+  diff->start = head;
+  diff->removed = old_size - head - tail;
+  diff->inserted = new_size - head - tail;
+
+  ReleaseItems(0, old_size);
+  items_.swap(new_items);
+  search_index_valid_ = false;
+}
+
+int PopupMenuModel::FindByPrefix(const std::string& prefix, int start) const {
+  if (prefix.empty())
+    return -1;
+  if (!search_index_valid_)
+    BuildSearchIndex();
+
+  std::string key = base::StringToLowerASCII(prefix);
+  SearchIndex::const_iterator it = std::lower_bound(
+      search_index_.begin(), search_index_.end(), std::make_pair(key, -1));
+
+  int first_match = -1;
+  int next_match = -1;
+  for (; it != search_index_.end() &&
+         it->first.compare(0, key.length(), key) == 0; ++it) {
+    int index = it->second;
+    if (first_match == -1 || index < first_match)
+      first_match = index;
+    if (index > start && (next_match == -1 || index < next_match))
+      next_match = index;
+  }
+  return next_match != -1 ? next_match : first_match;
+}
+
+// static
+PopupMenuModel::Item PopupMenuModel::MakeItem(
+    const content::MenuItem& menu_item) {
+  Item item;
+  item.label = InternUTF16(menu_item.label);
+  item.tool_tip =
+      menu_item.tool_tip.empty() ? NULL : InternUTF16(menu_item.tool_tip);
+  item.type = static_cast<uint8>(menu_item.type);
+  item.enabled = menu_item.enabled;
+  item.checked = menu_item.checked;
+  item.rtl = menu_item.rtl;
+  item.has_directional_override = menu_item.has_directional_override;
+  return item;
+}
+
+// static
+void PopupMenuModel::ReleaseItem(const Item& item) {
+  eina_stringshare_del(item.label);
+  if (item.tool_tip)
+    eina_stringshare_del(item.tool_tip);
+}
+
+// static
+bool PopupMenuModel::HasSameContent(const Item& a, const Item& b) {
+  // Interned, equal strings share their pointer.
+  return a.label == b.label && a.tool_tip == b.tool_tip &&
+      a.type == b.type && a.rtl == b.rtl &&
+      a.has_directional_override == b.has_directional_override;
+}
+
+// static
+bool PopupMenuModel::HasSameState(const Item& a, const Item& b) {
+  return a.enabled == b.enabled && a.checked == b.checked;
+}
+
+void PopupMenuModel::ReleaseItems(size_t start, size_t end) {
+  for (size_t i = start; i < end; ++i)
+    ReleaseItem(items_[i]);
+}
+
+void PopupMenuModel::BuildSearchIndex() const {
+  search_index_.clear();
+  search_index_.reserve(items_.size());
+  for (size_t i = 0; i < items_.size(); ++i) {
+    if (items_[i].type != content::MenuItem::OPTION || !items_[i].enabled)
+      continue;
+    search_index_.push_back(std::make_pair(
+        base::StringToLowerASCII(std::string(items_[i].label)),
+        static_cast<int>(i)));
+  }
+  std::sort(search_index_.begin(), search_index_.end());
+  search_index_valid_ = true;
+}
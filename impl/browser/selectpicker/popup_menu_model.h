@@ -0,0 +1,83 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef POPUP_MENU_MODEL_H_
+#define POPUP_MENU_MODEL_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+
+namespace content {
+struct MenuItem;
+}
+
+// Items of the <select> element shown in the picker. Kept in one flat array
+// with labels interned in eina_stringshare, so that lists of thousands of
+// options cost one allocation per distinct label and one UTF-8 conversion
+// per item, and so that updates of an open picker can be diffed by pointer.
+class PopupMenuModel {
+ public:
+  struct Item {
+    // eina_stringshare, never NULL.
+    const char* label;
+    // eina_stringshare, NULL when the option has no title.
+    const char* tool_tip;
+    // content::MenuItem::Type.
+    uint8 type;
+    bool enabled : 1;
+    bool checked : 1;
+    bool rtl : 1;
+    bool has_directional_override : 1;
+  };
+
+  // What Update() changed, in terms of the new item indices.
+  struct Diff {
+    Diff() : start(0), removed(0), inserted(0) {}
+
+    // Items [start, start + removed) of the old model were replaced by items
+    // [start, start + inserted) of the new one.
+    size_t start;
+    size_t removed;
+    size_t inserted;
+    // Items outside of the replaced range whose state changed.
+    std::vector<size_t> changed;
+  };
+
+  explicit PopupMenuModel(const std::vector<content::MenuItem>& items);
+  ~PopupMenuModel();
+
+  size_t size() const { return items_.size(); }
+  const Item& item(size_t index) const { return items_[index]; }
+
+  // Replaces the items by |items|, keeping the ones common to both.
+  void Update(const std::vector<content::MenuItem>& items, Diff* diff);
+
+  // Returns the index of the first enabled option after |start|, wrapping
+  // around, whose label begins with |prefix|, or -1. Matching ignores ASCII
+  // case only.
+  int FindByPrefix(const std::string& prefix, int start) const;
+
+ private:
+  typedef std::vector<std::pair<std::string, int> > SearchIndex;
+
+  static Item MakeItem(const content::MenuItem& menu_item);
+  static void ReleaseItem(const Item& item);
+  static bool HasSameContent(const Item& a, const Item& b);
+  static bool HasSameState(const Item& a, const Item& b);
+  void ReleaseItems(size_t start, size_t end);
+  void BuildSearchIndex() const;
+
+  std::vector<Item> items_;
+  // Lower cased labels of the enabled options with their index, sorted.
+  // Built on first search, as most pickers are closed without typing.
+  mutable SearchIndex search_index_;
+  mutable bool search_index_valid_;
+
+  DISALLOW_COPY_AND_ASSIGN(PopupMenuModel);
+};
+
+#endif  // POPUP_MENU_MODEL_H_
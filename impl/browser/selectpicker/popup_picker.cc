@@ -4,7 +4,9 @@
 
 #include "config.h"
 #include "popup_picker.h"
-#include "popup_menu_item.h"
+
+#include <stdint.h>
+#include <algorithm>
 
 // DJKim : FIXME
 //#include "WebPopupMenuProxyEfl.h"
@@ -23,40 +25,64 @@
 extern void* EflAssistHandle;
 #endif
 
+namespace {
+
+// Options realized around the selected one when the picker opens.
+const size_t kInitialWindow = 50;
+// Options added per idler run until the whole list is in the genlist.
+const size_t kFillBatch = 200;
+// Pause after which typed characters start a new search.
+const double kTypeAheadTimeout = 1.0;
+
+const char kPickerDataKey[] = "popup_picker";
+
+} // namespace
+
 int compareChangedItems(const void* a, const void* b) {
   const int* left = static_cast<const int*>(a);
   const int* right = static_cast<const int*>(b);
   return (*left - *right);
 }
 
+// Genlist items only carry the model index, the model owns the rest.
+static void* indexToItemData(size_t index) {
+  return reinterpret_cast<void*>(static_cast<intptr_t>(index));
+}
+
+static int itemDataToIndex(const void* data) {
+  return static_cast<int>(reinterpret_cast<intptr_t>(data));
+}
+
+static Popup_Picker* pickerFromList(Evas_Object* list) {
+  return static_cast<Popup_Picker*>(evas_object_data_get(list, kPickerDataKey));
+}
+
 static void __picker_radio_icon_changed_cb(void* data, Evas_Object* obj, void* event_info) {
-  genlist_callback_data *callback_data = static_cast<genlist_callback_data*>(data);
-  Popup_Picker* picker = static_cast<Popup_Picker*>(callback_data->user_data);
+  Popup_Picker* picker = static_cast<Popup_Picker*>(data);
 
   int index = elm_radio_value_get(picker->radioMain);
-  elm_genlist_item_selected_set(callback_data->it, true);
+  if (index >= 0 && static_cast<size_t>(index) < picker->items.size() && picker->items[index])
+    elm_genlist_item_selected_set(picker->items[index], true);
   picker->selectedIndex = index;
   view_popup_menu_select(picker->web_view_, index);
 }
 
 static char* __picker_label_get_cb(void* data, Evas_Object* obj, const char* part) {
-  genlist_callback_data *callback_data = static_cast<genlist_callback_data*>(data);
-  Popup_Menu_Item* menuItem = static_cast<Popup_Menu_Item*>(callback_data->menuItem);
+  Popup_Picker* picker = pickerFromList(obj);
 
   if (!strncmp(part, "elm.text", strlen("elm.text")))
-    return elm_entry_utf8_to_markup(popup_menu_item_text_get(menuItem));
+    return elm_entry_utf8_to_markup(picker->model->item(itemDataToIndex(data)).label);
 
   return 0;
 }
 
 static Evas_Object* __picker_icon_get_cb(void* data, Evas_Object* obj, const char* part) {
-  genlist_callback_data *callback_data = static_cast<genlist_callback_data*>(data);
-  Popup_Picker* picker = static_cast<Popup_Picker*>(callback_data->user_data);
+  Popup_Picker* picker = pickerFromList(obj);
+  int index = itemDataToIndex(data);
 
-  if (!strcmp(part, "elm.swallow.end") &&
-      popup_menu_item_enabled_get(callback_data->menuItem) == EINA_TRUE) {
+  if (!strcmp(part, "elm.swallow.end") && picker->model->item(index).enabled) {
     Evas_Object *radio = elm_radio_add(obj);
-    elm_radio_state_value_set(radio, callback_data->index);
+    elm_radio_state_value_set(radio, index);
     elm_radio_group_add(radio, picker->radioMain);
 
     evas_object_size_hint_weight_set(radio, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
@@ -64,76 +90,204 @@ static Evas_Object* __picker_icon_get_cb(void* data, Evas_Object* obj, const cha
     evas_object_propagate_events_set(radio, EINA_FALSE);
 
     elm_radio_value_set(picker->radioMain, picker->selectedIndex);
-    evas_object_smart_callback_add(radio, "changed", __picker_radio_icon_changed_cb, (void *)data);
+    evas_object_smart_callback_add(radio, "changed", __picker_radio_icon_changed_cb, picker);
     return radio;
   }
   return 0;
 }
 
 static void __picker_item_selected_cb(void* data, Evas_Object* obj, void* event_info) {
-  genlist_callback_data *callback_data = static_cast<genlist_callback_data*>(data);
-  Popup_Picker* picker = static_cast<Popup_Picker*>(callback_data->user_data);
-  Evas_Object* radio_icon = elm_object_item_part_content_get((Elm_Object_Item *)event_info, "elm.swallow.end");
+  Popup_Picker* picker = static_cast<Popup_Picker*>(data);
+  Elm_Object_Item* item = static_cast<Elm_Object_Item*>(event_info);
+  Evas_Object* radio_icon = elm_object_item_part_content_get(item, "elm.swallow.end");
 
-  int index = callback_data->index;
-  elm_genlist_item_selected_set(callback_data->it, false);
+  int index = itemDataToIndex(elm_object_item_data_get(item));
+  elm_genlist_item_selected_set(item, false);
 
-  if (popup_menu_item_enabled_get(callback_data->menuItem) == EINA_TRUE) {
-    elm_radio_value_set(radio_icon, callback_data->index);
+  if (picker->model->item(index).enabled) {
+    elm_radio_value_set(radio_icon, index);
     picker->selectedIndex = index;
     view_popup_menu_select(picker->web_view_, index);
   }
 }
 
-void clear_genlist_callback_data(Popup_Picker* picker) {
-  if (picker && picker->m_genlist_callback_data_list) {
-    Eina_List* list;
-    void* data;
-
-    EINA_LIST_FOREACH(picker->m_genlist_callback_data_list, list, data) {
-      if (data)
-        free ((genlist_callback_data *)data);
-    }
-    eina_list_free(picker->m_genlist_callback_data_list);
-    picker->m_genlist_callback_data_list = NULL;
-  }
+static void toggleChangedItem(Popup_Picker* picker, int index) {
+  int pos = eina_inarray_search(picker->changedList, &index, compareChangedItems);
+  if (pos == -1)
+    eina_inarray_push(picker->changedList, &index);
+  else
+    eina_inarray_remove(picker->changedList, &index);
 }
 
 void menuItemActivated(void* data, Evas_Object* obj, void* event_info) {
   Popup_Picker* picker = static_cast<Popup_Picker*>(data);
+  if (picker->filling)
+    return;
+
   Elm_Object_Item* selected = static_cast<Elm_Object_Item*>(event_info);
-  int index = elm_genlist_item_index_get(selected);
-  // elm_genlist_item_index_get iterrate starting from 1
-  if (index > 0)
-    index--;
+  int index = itemDataToIndex(elm_object_item_data_get(selected));
 
-  if (picker->multiSelect) {
-    int pos = eina_inarray_search(picker->changedList, &index, compareChangedItems);
-    if (pos == -1)
-      eina_inarray_push(picker->changedList, &index);
-    else
-      eina_inarray_remove(picker->changedList, &index);
-  }
+  if (picker->multiSelect)
+    toggleChangedItem(picker, index);
 
   view_popup_menu_multiple_select(picker->web_view_, picker->changedList);
 }
 
 void menuItemDeactivated(void* data, Evas_Object* obj, void* event_info) {
   Popup_Picker* picker = static_cast<Popup_Picker*>(data);
+  if (picker->filling)
+    return;
+
   Elm_Object_Item* deselectedItem = static_cast<Elm_Object_Item*>(event_info);
+  toggleChangedItem(picker, itemDataToIndex(elm_object_item_data_get(deselectedItem)));
 
-  int deselectedIndex = elm_genlist_item_index_get(deselectedItem);
-  // elm_genlist_item_index_get iterrate starting from 1
-  if (deselectedIndex > 0)
-    deselectedIndex--;
-  int pos = eina_inarray_search(picker->changedList, &deselectedIndex, compareChangedItems);
+  view_popup_menu_multiple_select(picker->web_view_, picker->changedList);
+}
 
-  if (pos == -1)
-    eina_inarray_push(picker->changedList, &deselectedIndex);
-  else
-    eina_inarray_remove(picker->changedList, &deselectedIndex);
+static char* _listLabelGet(void* data, Evas_Object* obj, const char* part)
+{
+  Popup_Picker* picker = pickerFromList(obj);
 
-  view_popup_menu_multiple_select(picker->web_view_, picker->changedList);
+  if (!strncmp(part, "elm.text", strlen("elm.text")))
+    return elm_entry_utf8_to_markup(picker->model->item(itemDataToIndex(data)).label);
+  return 0;
+}
+
+static Elm_Genlist_Item_Class* itemClassFor(Popup_Picker* picker) {
+  static Elm_Genlist_Item_Class radioItemClass;
+  static Elm_Genlist_Item_Class multiItemClass;
+
+  // If it is multiselect, use the old implementation.
+  //FIXME: remove this check, once picker with buttons is implemented for multiselect.
+  Elm_Genlist_Item_Class* itemClass = picker->multiSelect ? &multiItemClass : &radioItemClass;
+  itemClass->item_style = "default";
+  itemClass->func.text_get = picker->multiSelect ? _listLabelGet : __picker_label_get_cb;
+  itemClass->func.content_get = picker->multiSelect ? 0 : __picker_icon_get_cb;
+  itemClass->func.state_get = 0;
+  itemClass->func.del = 0;
+  return itemClass;
+}
+
+// Adds model item |index| before |before|, or at the end when it is NULL.
+static void insertItem(Popup_Picker* picker, size_t index, Elm_Object_Item* before) {
+  Elm_Genlist_Item_Class* itemClass = itemClassFor(picker);
+  Evas_Smart_Cb selectedCallback = picker->multiSelect ? 0 : __picker_item_selected_cb;
+  Elm_Object_Item* itemObject = before ?
+      elm_genlist_item_insert_before(picker->popupList, itemClass, indexToItemData(index), 0, before, ELM_GENLIST_ITEM_NONE, selectedCallback, picker) :
+      elm_genlist_item_append(picker->popupList, itemClass, indexToItemData(index), 0, ELM_GENLIST_ITEM_NONE, selectedCallback, picker);
+  picker->items[index] = itemObject;
+  if (!index)
+    picker->firstItem = itemObject;
+
+  if (!picker->multiSelect)
+    return;
+
+  const PopupMenuModel::Item& menuItem = picker->model->item(index);
+  if (menuItem.checked) {
+    picker->filling = true;
+    elm_genlist_item_selected_set(itemObject, EINA_TRUE);
+    picker->filling = false;
+  }
+  if (!menuItem.enabled)
+    elm_object_item_disabled_set(itemObject, EINA_TRUE);
+}
+
+static void appendItems(Popup_Picker* picker, size_t end) {
+  for (size_t i = picker->fillEnd; i < end; ++i)
+    insertItem(picker, i, 0);
+  picker->fillEnd = std::max(picker->fillEnd, end);
+}
+
+static void prependItems(Popup_Picker* picker, size_t begin) {
+  for (size_t i = picker->fillBegin; i > begin; --i)
+    insertItem(picker, i - 1, picker->items[i]);
+  picker->fillBegin = std::min(picker->fillBegin, begin);
+}
+
+// Makes sure model item |index| and its neighbours are in the genlist.
+static void ensureItem(Popup_Picker* picker, size_t index) {
+  if (index >= picker->fillEnd)
+    appendItems(picker, std::min(picker->model->size(), index + kInitialWindow));
+  if (index < picker->fillBegin)
+    prependItems(picker, index > kInitialWindow ? index - kInitialWindow : 0);
+}
+
+static void stopFilling(Popup_Picker* picker) {
+  if (picker->fillIdler) {
+    ecore_idler_del(picker->fillIdler);
+    picker->fillIdler = 0;
+  }
+}
+
+static Eina_Bool fillListIdler(void* data) {
+  Popup_Picker* picker = static_cast<Popup_Picker*>(data);
+  size_t count = picker->model->size();
+
+  if (picker->fillEnd < count) {
+    appendItems(picker, std::min(count, picker->fillEnd + kFillBatch));
+    return ECORE_CALLBACK_RENEW;
+  }
+
+  if (picker->fillBegin > 0) {
+    prependItems(picker, picker->fillBegin > kFillBatch ? picker->fillBegin - kFillBatch : 0);
+    // Items added above push the selected one down, keep it in sight until
+    // the user scrolls on their own.
+    if (!picker->userScrolled && picker->selectedIndex >= 0 &&
+        static_cast<size_t>(picker->selectedIndex) < count)
+      elm_genlist_item_show(picker->items[picker->selectedIndex], ELM_GENLIST_ITEM_SCROLLTO_MIDDLE);
+    if (picker->fillBegin > 0)
+      return ECORE_CALLBACK_RENEW;
+  }
+
+  picker->fillIdler = 0;
+  return ECORE_CALLBACK_CANCEL;
+}
+
+static void clearPopupList(Popup_Picker* picker) {
+  stopFilling(picker);
+  elm_genlist_clear(picker->popupList);
+  picker->items.clear();
+  picker->fillBegin = 0;
+  picker->fillEnd = 0;
+  picker->firstItem = 0;
+}
+
+static void listScrollStarted(void* data, Evas_Object* obj, void* event_info) {
+  static_cast<Popup_Picker*>(data)->userScrolled = true;
+}
+
+static void typeAheadKeyDown(void* data, Evas* e, Evas_Object* obj, void* event_info) {
+  Popup_Picker* picker = static_cast<Popup_Picker*>(data);
+  Evas_Event_Key_Down* event = static_cast<Evas_Event_Key_Down*>(event_info);
+  if (!event->string || static_cast<unsigned char>(event->string[0]) < 0x20)
+    return;
+
+  double now = ecore_time_get();
+  if (now - picker->typeAheadTime > kTypeAheadTimeout)
+    picker->typeAhead.clear();
+  picker->typeAheadTime = now;
+  picker->typeAhead.append(event->string);
+
+  // Typing one character again and again cycles through the options that
+  // begin with it, otherwise the current match is kept while it matches.
+  std::string prefix = picker->typeAhead;
+  bool cycle = prefix.find_first_not_of(prefix[0]) == std::string::npos;
+  if (cycle)
+    prefix = prefix.substr(0, 1);
+  int start = cycle ? picker->typeAheadIndex : picker->typeAheadIndex - 1;
+
+  int index = picker->model->FindByPrefix(prefix, start);
+  if (index < 0)
+    return;
+
+  picker->typeAheadIndex = index;
+  ensureItem(picker, index);
+  picker->userScrolled = true;
+  elm_genlist_item_show(picker->items[index], ELM_GENLIST_ITEM_SCROLLTO_MIDDLE);
+  if (!picker->multiSelect) {
+    picker->selectedIndex = index;
+    elm_radio_value_set(picker->radioMain, index);
+  }
 }
 
 void listClosed(void* data, Evas_Object* obj, const char* emission, const char* source) {
@@ -149,9 +303,7 @@ void listClosed(void* data, Evas_Object* obj, const char* emission, const char*
     picker->changedList = 0;
   }
 
-  // FIXME: remove this check
-  if (!picker->multiSelect)
-    clear_genlist_callback_data(picker);
+  stopFilling(picker);
 
   view_popup_menu_close(picker->web_view_);
 }
@@ -159,53 +311,41 @@ void listClosed(void* data, Evas_Object* obj, const char* emission, const char*
 void navigateToNext(void *data, Evas_Object *obj, const char *emission, const char *source)
 {
   Popup_Picker* picker = static_cast<Popup_Picker*>(data);
-  elm_genlist_clear(picker->popupList);
+  clearPopupList(picker);
   picker->web_view_->FormNavigate(true);
 }
 
 void navigateToPrev(void *data, Evas_Object *obj, const char *emission, const char *source)
 {
   Popup_Picker* picker = static_cast<Popup_Picker*>(data);
-  elm_genlist_clear(picker->popupList);
+  clearPopupList(picker);
   picker->web_view_->FormNavigate(false);
 }
 
-static char* _listLabelGet(void* data, Evas_Object* obj, const char* part)
-{
-  Popup_Menu_Item* menuItem = static_cast<Popup_Menu_Item*>(data);
-
-  if (!strncmp(part, "elm.text", strlen("elm.text")) && popup_menu_item_text_get(menuItem))
-    return elm_entry_utf8_to_markup(popup_menu_item_text_get(menuItem));
-  return 0;
-}
-
 #ifdef OS_TIZEN_MOBILE
 static void popupMenuHwBackKeyCallback(void* data, Evas_Object* obj, void* eventInfo) {
   listClosed(data, obj, 0, 0);
 }
 #endif
 
-static void createAndShowPopupList(Evas_Object* win, Popup_Picker* picker, Eina_List* items, int selectedIndex) {
+static void createAndShowPopupList(Evas_Object* win, Popup_Picker* picker, int selectedIndex) {
   picker->selectedIndex = selectedIndex;
+  picker->typeAheadIndex = selectedIndex;
+  picker->userScrolled = false;
   picker->popupList = elm_genlist_add(win);
   evas_object_size_hint_weight_set(picker->popupList, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
   evas_object_size_hint_align_set(picker->popupList, EVAS_HINT_FILL, EVAS_HINT_FILL);
+  evas_object_data_set(picker->popupList, kPickerDataKey, picker);
+  // All options have the same height, which spares the genlist realizing
+  // items to lay out the ones that are not visible.
+  elm_genlist_homogeneous_set(picker->popupList, EINA_TRUE);
+  elm_genlist_mode_set(picker->popupList, ELM_LIST_COMPRESS);
 
   if (picker->multiSelect)
   {
     eina_inarray_flush(picker->changedList);
     elm_genlist_multi_select_set(picker->popupList, true);
-  }
-  static Elm_Genlist_Item_Class itemClass;
-  void* itemv;
-  const Eina_List* l;
-  picker->firstItem = 0;
-
-  picker->m_genlist_callback_data_list = NULL;
-
-  // If it is multiselect, use the old implementation.
-  //FIXME: remove this check, once picker with buttons is implemented for multiselect.
-  if (!picker->multiSelect) {
+  } else {
     picker->radioMain = elm_radio_add(picker->popupList);
     if (!picker->radioMain) {
       LOG(ERROR) << "elm_radio_add failed. ";
@@ -214,76 +354,37 @@ static void createAndShowPopupList(Evas_Object* win, Popup_Picker* picker, Eina_
 
     elm_radio_state_value_set(picker->radioMain, 0);
     elm_radio_value_set(picker->radioMain, 0);
+  }
 
-    itemClass.item_style = "default";
-    itemClass.func.text_get = __picker_label_get_cb;
-    itemClass.func.content_get = __picker_icon_get_cb;
-    itemClass.func.state_get = 0;
-    itemClass.func.del = 0;
-
-    int index = 0;
-    Eina_Bool has_problem = EINA_FALSE;
-    EINA_LIST_FOREACH(items, l, itemv) {
-      genlist_callback_data *data = (genlist_callback_data *)malloc(sizeof(genlist_callback_data));
-      if (!data) {
-        has_problem = EINA_TRUE;
-        break;
-      }
-
-      memset(data, 0x00, sizeof(genlist_callback_data));
-      data->index = index;
-      data->user_data = picker;
-      data->menuItem = static_cast<Popup_Menu_Item*>(itemv);
-      data->it =  elm_genlist_item_append(picker->popupList, &itemClass, data, NULL, ELM_GENLIST_ITEM_NONE, __picker_item_selected_cb, data);
-      picker->m_genlist_callback_data_list = eina_list_append(picker->m_genlist_callback_data_list, data);
-
-      if (!index)
-        picker->firstItem = data->it;
-
-      if (selectedIndex == index) {
-        elm_radio_value_set(picker->radioMain, index);
-        elm_genlist_item_bring_in(data->it, ELM_GENLIST_ITEM_SCROLLTO_IN);
-      }
-      index++;
-    }
+  size_t count = picker->model->size();
+  size_t anchor = selectedIndex > 0 && static_cast<size_t>(selectedIndex) < count ? selectedIndex : 0;
+  picker->items.assign(count, static_cast<Elm_Object_Item*>(0));
+  picker->firstItem = 0;
+  picker->fillBegin = anchor > kInitialWindow ? anchor - kInitialWindow : 0;
+  picker->fillEnd = picker->fillBegin;
+  appendItems(picker, std::min(count, anchor + kInitialWindow));
 
-    if (has_problem == EINA_TRUE) {
-      clear_genlist_callback_data(picker);
-      return;
+  if (!picker->multiSelect) {
+    if (selectedIndex >= 0 && static_cast<size_t>(selectedIndex) < count) {
+      elm_radio_value_set(picker->radioMain, selectedIndex);
+      elm_genlist_item_bring_in(picker->items[selectedIndex], ELM_GENLIST_ITEM_SCROLLTO_IN);
     }
     evas_object_smart_callback_add(picker->popupList, "changed", __picker_radio_icon_changed_cb, picker);
   } else {
-    itemClass.item_style = "default";
-    itemClass.func.text_get = _listLabelGet;
-    itemClass.func.content_get = 0;
-    itemClass.func.state_get = 0;
-    itemClass.func.del = 0;
-
-    void* itemv;
-    const Eina_List* l;
-
-    picker->firstItem = 0;
-    int index = 0;
-    EINA_LIST_FOREACH(items, l, itemv) {
-      Popup_Menu_Item* menuItem = static_cast<Popup_Menu_Item*>(itemv);
-      Elm_Object_Item* itemObject = elm_genlist_item_append(picker->popupList, &itemClass, menuItem, 0, ELM_GENLIST_ITEM_NONE, 0, 0);
-      if (!index)
-        picker->firstItem = itemObject;
-
-      if (popup_menu_item_selected_get(menuItem)) {
+    for (size_t i = 0; i < count; ++i) {
+      if (picker->model->item(i).checked) {
+        int index = i;
         eina_inarray_push(picker->changedList, &index);
-        elm_genlist_item_selected_set(itemObject, EINA_TRUE);
       }
-      if (!(popup_menu_item_enabled_get(menuItem)))
-        elm_object_item_disabled_set(itemObject, EINA_TRUE);
-      index++;
     }
 
     evas_object_smart_callback_add(picker->popupList, "selected", menuItemActivated, picker);
-
-    if (picker->multiSelect)
-      evas_object_smart_callback_add(picker->popupList, "unselected", menuItemDeactivated, picker);
+    evas_object_smart_callback_add(picker->popupList, "unselected", menuItemDeactivated, picker);
   }
+  evas_object_smart_callback_add(picker->popupList, "scroll,drag,start", listScrollStarted, picker);
+
+  if (picker->fillBegin > 0 || picker->fillEnd < count)
+    picker->fillIdler = ecore_idler_add(fillListIdler, picker);
 
   elm_object_focus_allow_set(picker->popupList, false);
   evas_object_show(picker->popupList);
@@ -307,10 +408,11 @@ static void resizeAndShowPicker(Popup_Picker* picker) {
   evas_object_show(picker->container);
 }
 
-Popup_Picker* popup_picker_new(EWebView* web_view, Evas_Object* parent, Eina_List* items, int selectedIndex, Eina_Bool multiple) {
+Popup_Picker* popup_picker_new(EWebView* web_view, Evas_Object* parent, const PopupMenuModel* model, int selectedIndex, Eina_Bool multiple) {
   Popup_Picker* picker = new Popup_Picker;
   picker->parent = parent;
   picker->web_view_ = web_view;
+  picker->model = model;
   picker->multiSelect = multiple;
   picker->changedList = eina_inarray_new(sizeof(int), 0);
 
@@ -365,8 +467,10 @@ Popup_Picker* popup_picker_new(EWebView* web_view, Evas_Object* parent, Eina_Lis
   }
 #endif
 
-  createAndShowPopupList(picker->win, picker, items, selectedIndex);
+  createAndShowPopupList(picker->win, picker, selectedIndex);
   evas_object_propagate_events_set(picker->container, false);
+  evas_object_event_callback_add(picker->container, EVAS_CALLBACK_KEY_DOWN, typeAheadKeyDown, picker);
+  evas_object_focus_set(picker->container, EINA_TRUE);
 
   resizeAndShowPicker(picker);
   edje_object_signal_emit(elm_layout_edje_get(picker->container), "show,picker,signal", "");
@@ -381,14 +485,16 @@ void popup_picker_resize(Popup_Picker* picker) {
 }
 
 void popup_picker_del(Popup_Picker* picker) {
-  if (!picker->multiSelect) {
+  stopFilling(picker);
+  if (!picker->multiSelect)
     evas_object_smart_callback_del(picker->popupList, "changed", __picker_radio_icon_changed_cb);
-    clear_genlist_callback_data(picker);
-  }
   evas_object_smart_callback_del(picker->popupList, "selected", menuItemActivated);
+  evas_object_event_callback_del(picker->container, EVAS_CALLBACK_KEY_DOWN, typeAheadKeyDown);
   evas_object_del(picker->popupList);
   evas_object_del(picker->container);
   evas_object_del(picker->win);
+  if (picker->changedList)
+    eina_inarray_free(picker->changedList);
 
   picker->popupList = 0;
   picker->firstItem = 0;
@@ -397,14 +503,69 @@ void popup_picker_del(Popup_Picker* picker) {
   delete picker;
 }
 
-void popup_picker_update(Evas_Object* parent, Popup_Picker* picker, Eina_List* items, int selectedIndex) {
-  // FIXME: A check should be made if the items are changed instead of directly changing them.
-  // Another issue is that if the list is scrolled, the old scroll position is not retained as
-  // the list is replaced directly.
-  evas_object_del(picker->popupList);
+void popup_picker_update(Popup_Picker* picker, const PopupMenuModel::Diff& diff, int selectedIndex, Eina_Bool multiple) {
+  if (!picker->changedList)
+    picker->changedList = eina_inarray_new(sizeof(int), 0);
+
+  // Another kind of list, mostly other options as when moving to the next
+  // <select>, or a list still being filled, whose missing items the model
+  // can no longer tell: start over, lazily.
+  size_t count = picker->model->size();
+  bool filled = !picker->fillBegin && picker->fillEnd == picker->items.size();
+  if (!filled || multiple != picker->multiSelect || (diff.removed + diff.inserted) > count / 2) {
+    stopFilling(picker);
+    evas_object_del(picker->popupList);
+    picker->multiSelect = multiple;
+    createAndShowPopupList(picker->win, picker, selectedIndex);
+    return;
+  }
 
-  picker->changedList = eina_inarray_new(sizeof(int), 0);
-  createAndShowPopupList(picker->win, picker, items, selectedIndex);
+  // Edits keep the scroll position and every item that did not change.
+  std::vector<Elm_Object_Item*>& items = picker->items;
+  for (size_t i = diff.start; i < diff.start + diff.removed; ++i)
+    elm_object_item_del(items[i]);
+  items.erase(items.begin() + diff.start, items.begin() + diff.start + diff.removed);
+  items.insert(items.begin() + diff.start, diff.inserted, static_cast<Elm_Object_Item*>(0));
+
+  Elm_Object_Item* before = diff.start + diff.inserted < count ? items[diff.start + diff.inserted] : 0;
+  for (size_t i = diff.start; i < diff.start + diff.inserted; ++i)
+    insertItem(picker, i, before);
+  picker->fillBegin = 0;
+  picker->fillEnd = count;
+
+  if (diff.inserted != diff.removed) {
+    for (size_t i = diff.start + diff.inserted; i < count; ++i)
+      elm_object_item_data_set(items[i], indexToItemData(i));
+  }
+
+  for (size_t i = 0; i < diff.changed.size(); ++i) {
+    Elm_Object_Item* itemObject = items[diff.changed[i]];
+    const PopupMenuModel::Item& menuItem = picker->model->item(diff.changed[i]);
+    if (picker->multiSelect) {
+      picker->filling = true;
+      elm_genlist_item_selected_set(itemObject, menuItem.checked);
+      picker->filling = false;
+      elm_object_item_disabled_set(itemObject, !menuItem.enabled);
+    }
+    elm_genlist_item_update(itemObject);
+  }
+
+  if (picker->multiSelect) {
+    eina_inarray_flush(picker->changedList);
+    for (size_t i = 0; i < count; ++i) {
+      if (picker->model->item(i).checked) {
+        int index = i;
+        eina_inarray_push(picker->changedList, &index);
+      }
+    }
+  } else {
+    picker->selectedIndex = selectedIndex;
+    elm_radio_value_set(picker->radioMain, selectedIndex);
+  }
+  picker->typeAheadIndex = selectedIndex;
+
+  // Radios and labels of realized items refer to indices which may have moved.
+  elm_genlist_realized_items_update(picker->popupList);
 }
 
 void popup_picker_buttons_update(Popup_Picker* picker, int position, int count, bool enable) {
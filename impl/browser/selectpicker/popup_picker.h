@@ -6,13 +6,13 @@
 #define popup_picker_h
 
 #include <Evas.h>
+#include <string>
+#include <vector>
 
-typedef struct _Elm_Object_Item Elm_Object_Item;
-typedef struct Popup_Menu_Item Popup_Menu_Item;
+#include "browser/selectpicker/popup_menu_model.h"
 
-namespace WebKit {
-class WebPopupMenuProxyEfl;
-}
+typedef struct _Elm_Object_Item Elm_Object_Item;
+typedef struct _Ecore_Idler Ecore_Idler;
 
 class EWebView;
 
@@ -23,36 +23,53 @@ struct _Popup_Picker {
         , popupList(NULL)
         , win(NULL)
         , web_view_(NULL)
+        , model(NULL)
         , radioMain(NULL)
-        , m_genlist_callback_data_list(NULL)
         , firstItem(NULL)
-        , changedList(NULL) {}
+        , selectedIndex(0)
+        , multiSelect(EINA_FALSE)
+        , changedList(NULL)
+        , fillBegin(0)
+        , fillEnd(0)
+        , fillIdler(NULL)
+        , userScrolled(false)
+        , filling(false)
+        , typeAheadIndex(-1)
+        , typeAheadTime(0) {}
     Evas_Object* container;
     Evas_Object* parent;
     Evas_Object* popupList;
     Evas_Object* win;
     EWebView* web_view_;
+    // Owned by the view, outlives the picker.
+    const PopupMenuModel* model;
     Evas_Object* radioMain;
-    Eina_List* m_genlist_callback_data_list;
     Elm_Object_Item* firstItem;
     int selectedIndex;
     Eina_Bool multiSelect;
     Eina_Inarray* changedList;
+    // Genlist item of every model item, NULL until appended. Model items
+    // [fillBegin, fillEnd) are in the genlist, the rest is added from an
+    // idler so that opening a huge list only pays for the visible window.
+    std::vector<Elm_Object_Item*> items;
+    size_t fillBegin;
+    size_t fillEnd;
+    Ecore_Idler* fillIdler;
+    bool userScrolled;
+    // Set while items are added, their initial selection is not a user one.
+    bool filling;
+    // Characters typed recently, searched as a label prefix.
+    std::string typeAhead;
+    int typeAheadIndex;
+    double typeAheadTime;
 };
 typedef struct _Popup_Picker Popup_Picker;
 
-typedef struct _genlist_callback_data {
-    _genlist_callback_data() : user_data(NULL), it(NULL), menuItem(NULL) {}
-    int index;
-    void* user_data;
-    Elm_Object_Item* it;
-    Popup_Menu_Item* menuItem;
-} genlist_callback_data;
-
-Popup_Picker* popup_picker_new(EWebView* web_view, Evas_Object* parent, Eina_List* items, int selectedIndex, Eina_Bool multiple);
+Popup_Picker* popup_picker_new(EWebView* web_view, Evas_Object* parent, const PopupMenuModel* model, int selectedIndex, Eina_Bool multiple);
 void popup_picker_resize(Popup_Picker* picker);
 void popup_picker_del(Popup_Picker* picker);
-void popup_picker_update(Evas_Object* parent, Popup_Picker* picker, Eina_List* items, int selectedIndex);
+// Applies |diff|, the last change of the model, to the shown list.
+void popup_picker_update(Popup_Picker* picker, const PopupMenuModel::Diff& diff, int selectedIndex, Eina_Bool multiple);
 void listClosed(void *data, Evas_Object *obj, const char *emission, const char *source);
 void popup_picker_buttons_update(Popup_Picker* picker, int position, int count, bool enable);
 void view_popup_menu_select(EWebView* web_view, int selectedIndex);
@@ -0,0 +1,545 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/session_store_efl.h"
+
+#include <limits>
+#include <string.h>
+#include <unistd.h>
+
+#include "base/debug/trace_event.h"
+#include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/pickle.h"
+#include "base/posix/eintr_wrapper.h"
+#include "components/sessions/content/content_serialized_navigation_builder.h"
+#include "components/sessions/serialized_navigation_entry.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/navigation_details.h"
+#include "content/public/browser/navigation_entry.h"
+#include "content/public/browser/notification_details.h"
+#include "content/public/browser/notification_source.h"
+#include "content/public/browser/notification_types.h"
+#include "content/public/browser/web_contents.h"
+#include "third_party/zlib/zlib.h"
+
+using content::BrowserThread;
+using content::NavigationController;
+using content::NavigationEntry;
+using sessions::ContentSerializedNavigationBuilder;
+using sessions::SerializedNavigationEntry;
+
+namespace {
+
+const int kMaxEntrySize = std::numeric_limits<int>::max();
+
+// A Pickle starts with the size of its payload.
+const size_t kPickleHeaderSize = sizeof(uint32);
+
+// Records, all integers in host byte order:
+//   uint32 magic, uint32 version, uint32 WriteFlags, uint32 payload size,
+//   then the payload, as a zlib stream with WRITE_COMPRESSED.
+// Payload:
+//   int32 entry count, int32 current index, and for every entry its int32
+//   key, int32 size and the |size| bytes of its pickle. Deltas leave the
+//   size of entries written by a previous record 0.
+const uint32 kRecordMagic = 0x45574b53;  // "EWKS"
+const uint32 kRecordVersion = 1;
+const size_t kRecordHeaderSize = 4 * sizeof(uint32);
+
+// Deflate expands by at most this much, a record claiming more is corrupt
+// and must not get to allocate the size it claims.
+const size_t kMaxCompressionRatio = 1032;
+
+bool WriteFully(int fd, const void* data, size_t size) {
+  const char* bytes = static_cast<const char*>(data);
+  while (size) {
+    ssize_t written = HANDLE_EINTR(write(fd, bytes, size));
+    if (written <= 0)
+      return false;
+    bytes += written;
+    size -= written;
+  }
+  return true;
+}
+
+// Streams the payload of a record to a file descriptor, deflating it on
+// the way if asked to.
+class PayloadWriter {
+ public:
+  PayloadWriter(int fd, bool compress)
+      : fd_(fd),
+        compress_(compress),
+        failed_(false) {
+    memset(&stream_, 0, sizeof(stream_));
+    // Snapshots are taken after every navigation, favor speed.
+    if (compress_)
+      failed_ = deflateInit(&stream_, Z_BEST_SPEED) != Z_OK;
+  }
+
+  ~PayloadWriter() {
+    if (compress_)
+      deflateEnd(&stream_);
+  }
+
+  bool Write(const void* data, size_t size) {
+    if (failed_)
+      return false;
+    if (!compress_) {
+      failed_ = !WriteFully(fd_, data, size);
+      return !failed_;
+    }
+    stream_.next_in = static_cast<Bytef*>(const_cast<void*>(data));
+    stream_.avail_in = size;
+    return Deflate(Z_NO_FLUSH);
+  }
+
+  bool Finish() {
+    if (failed_ || !compress_)
+      return !failed_;
+    stream_.next_in = NULL;
+    stream_.avail_in = 0;
+    return Deflate(Z_FINISH);
+  }
+
+ private:
+  bool Deflate(int flush) {
+    do {
+      stream_.next_out = buffer_;
+      stream_.avail_out = sizeof(buffer_);
+      if (deflate(&stream_, flush) == Z_STREAM_ERROR) {
+        failed_ = true;
+        return false;
+      }
+      size_t produced = sizeof(buffer_) - stream_.avail_out;
+      if (produced && !WriteFully(fd_, buffer_, produced)) {
+        failed_ = true;
+        return false;
+      }
+    } while (!stream_.avail_out);
+    return true;
+  }
+
+  int fd_;
+  bool compress_;
+  bool failed_;
+  z_stream stream_;
+  Bytef buffer_[16 * 1024];
+
+  DISALLOW_COPY_AND_ASSIGN(PayloadWriter);
+};
+
+// Inflates the zlib stream at the start of |data| to |size| bytes and
+// returns in |consumed| where the stream ended.
+bool Inflate(const char* data, size_t length, size_t size,
+             std::string* output, size_t* consumed) {
+  if (size / kMaxCompressionRatio > length)
+    return false;
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (inflateInit(&stream) != Z_OK)
+    return false;
+
+  output->resize(size);
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  stream.avail_in = length;
+  stream.next_out = reinterpret_cast<Bytef*>(size ? &(*output)[0] : NULL);
+  stream.avail_out = size;
+  int result = inflate(&stream, Z_FINISH);
+  bool complete = result == Z_STREAM_END && stream.total_out == size;
+  *consumed = stream.total_in;
+  inflateEnd(&stream);
+  return complete;
+}
+
+bool ReadBytes(const char** data, const char* end, void* out, size_t size) {
+  if (static_cast<size_t>(end - *data) < size)
+    return false;
+  memcpy(out, *data, size);
+  *data += size;
+  return true;
+}
+
+// Reads a record payload over the entries of the previous records, which
+// deltas refer to.
+bool ReadPayload(const char* payload, size_t size,
+                 std::map<int, std::string>* entries,
+                 std::vector<int>* keys,
+                 int* current_index) {
+  const char* end = payload + size;
+  int32 counts[2];
+  if (!ReadBytes(&payload, end, counts, sizeof(counts)) || counts[0] < 0)
+    return false;
+
+  std::map<int, std::string> record_entries;
+  std::vector<int> record_keys;
+  for (int i = 0; i < counts[0]; ++i) {
+    int32 entry_header[2];
+    if (!ReadBytes(&payload, end, entry_header, sizeof(entry_header)))
+      return false;
+    const int key = entry_header[0];
+    const int entry_size = entry_header[1];
+    if (entry_size < 0 || end - payload < entry_size ||
+        record_entries.count(key))
+      return false;
+
+    std::string& data = record_entries[key];
+    if (entry_size) {
+      data.assign(payload, entry_size);
+      payload += entry_size;
+    } else {
+      std::map<int, std::string>::iterator previous = entries->find(key);
+      if (previous == entries->end())
+        return false;
+      data.swap(previous->second);
+    }
+    record_keys.push_back(key);
+  }
+  if (payload != end)
+    return false;
+
+  entries->swap(record_entries);
+  keys->swap(record_keys);
+  *current_index = counts[1];
+  return true;
+}
+
+bool ReadEntry(const std::string& data, SerializedNavigationEntry* entry) {
+  Pickle pickle(data.data(), data.size());
+  PickleIterator iterator(pickle);
+  return entry->ReadFromPickle(&iterator);
+}
+
+} // namespace
+
+SessionStoreEfl::SessionStoreEfl(content::WebContents* web_contents)
+    : web_contents_(web_contents),
+      current_index_(-1),
+      sync_stamp_(0),
+      has_written_record_(false),
+      pending_restore_(false) {
+  NavigationController* controller = &web_contents_->GetController();
+  registrar_.Add(this, content::NOTIFICATION_NAV_ENTRY_COMMITTED,
+      content::Source<NavigationController>(controller));
+  registrar_.Add(this, content::NOTIFICATION_NAV_ENTRY_CHANGED,
+      content::Source<NavigationController>(controller));
+  registrar_.Add(this, content::NOTIFICATION_WEB_CONTENTS_TITLE_UPDATED,
+      content::Source<content::WebContents>(web_contents_));
+}
+
+SessionStoreEfl::~SessionStoreEfl() {
+}
+
+void SessionStoreEfl::GetSessionData(const char** data, unsigned* length) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  Sync();
+
+  // The pickle of the entry count, the current index and the payloads of
+  // the entries' pickles, put together without serializing them again.
+  size_t payload_size = 2 * sizeof(int32);
+  for (size_t i = 0; i < keys_.size(); ++i)
+    payload_size += entries_[keys_[i]].data.size() - kPickleHeaderSize;
+
+  char* buffer = static_cast<char*>(malloc(kPickleHeaderSize + payload_size));
+  uint32 header = payload_size;
+  int32 counts[] = { static_cast<int32>(keys_.size()), current_index_ };
+  char* out = buffer;
+  memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  memcpy(out, counts, sizeof(counts));
+  out += sizeof(counts);
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    const std::string& entry_data = entries_[keys_[i]].data;
+    memcpy(out, entry_data.data() + kPickleHeaderSize,
+           entry_data.size() - kPickleHeaderSize);
+    out += entry_data.size() - kPickleHeaderSize;
+  }
+
+  *data = buffer;
+  *length = kPickleHeaderSize + payload_size;
+}
+
+bool SessionStoreEfl::WriteSnapshot(int fd, int flags) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  TRACE_EVENT0("browser", "SessionStoreEfl::WriteSnapshot");
+  Sync();
+
+  const bool delta = (flags & WRITE_DELTA) && has_written_record_;
+  const bool compress = flags & WRITE_COMPRESSED;
+  size_t payload_size = 2 * sizeof(int32);
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    const Entry& entry = entries_[keys_[i]];
+    payload_size += 2 * sizeof(int32);
+    if (!delta || !entry.written)
+      payload_size += entry.data.size();
+  }
+
+  // A failed record may be partially written, only a full one can follow.
+  has_written_record_ = false;
+
+  uint32 header[] = {
+    kRecordMagic,
+    kRecordVersion,
+    static_cast<uint32>((delta ? WRITE_DELTA : 0) |
+                        (compress ? WRITE_COMPRESSED : 0)),
+    static_cast<uint32>(payload_size),
+  };
+  COMPILE_ASSERT(sizeof(header) == kRecordHeaderSize, record_header_size);
+  if (!WriteFully(fd, header, sizeof(header)))
+    return false;
+
+  PayloadWriter writer(fd, compress);
+  int32 counts[] = { static_cast<int32>(keys_.size()), current_index_ };
+  if (!writer.Write(counts, sizeof(counts)))
+    return false;
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    const Entry& entry = entries_[keys_[i]];
+    const bool unchanged = delta && entry.written;
+    int32 entry_header[] = {
+      keys_[i],
+      unchanged ? 0 : static_cast<int32>(entry.data.size()),
+    };
+    if (!writer.Write(entry_header, sizeof(entry_header)))
+      return false;
+    if (!unchanged && !writer.Write(entry.data.data(), entry.data.size()))
+      return false;
+  }
+  if (!writer.Finish())
+    return false;
+
+  for (size_t i = 0; i < keys_.size(); ++i)
+    entries_[keys_[i]].written = true;
+  has_written_record_ = true;
+  return true;
+}
+
+bool SessionStoreEfl::Restore(const char* data, unsigned length) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  uint32 magic = 0;
+  if (length >= kRecordHeaderSize)
+    memcpy(&magic, data, sizeof(magic));
+
+  if (magic == kRecordMagic)
+    return ReadRecords(data, length);
+  return ReadLegacyData(data, length);
+}
+
+void SessionStoreEfl::RestoreIfPending() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (!pending_restore_)
+    return;
+
+  TRACE_EVENT1("browser", "SessionStoreEfl::RestoreIfPending",
+               "entries", static_cast<int>(keys_.size()));
+  pending_restore_ = false;
+  pending_url_ = GURL();
+  pending_title_.clear();
+
+  std::vector<SerializedNavigationEntry> navigations(keys_.size());
+  std::vector<int> restored_keys;
+  size_t restored = 0;
+  int current_index = current_index_;
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    if (ReadEntry(entries_[keys_[i]].data, &navigations[restored])) {
+      restored_keys.push_back(keys_[i]);
+      ++restored;
+    } else {
+      LOG(ERROR) << "Dropping unreadable session entry " << i;
+      if (static_cast<int>(i) < current_index_)
+        --current_index;
+    }
+  }
+  navigations.resize(restored);
+
+  ScopedVector<NavigationEntry> scoped_entries =
+      ContentSerializedNavigationBuilder::ToNavigationEntries(
+          navigations, web_contents_->GetBrowserContext());
+  std::vector<NavigationEntry*> navigation_entries;
+  scoped_entries.release(&navigation_entries);
+
+  NavigationController& controller = web_contents_->GetController();
+  controller.Restore(current_index,
+                     NavigationController::RESTORE_LAST_SESSION_EXITED_CLEANLY,
+                     &navigation_entries);
+
+  // The restored data stays the cache of the new entries.
+  EntryMap entries;
+  for (size_t i = 0; i < restored; ++i) {
+    Entry& entry = entries[controller.GetEntryAtIndex(i)->GetUniqueID()];
+    entry.data.swap(entries_[restored_keys[i]].data);
+    entry.dirty = false;
+  }
+  entries_.swap(entries);
+  keys_.clear();
+  // Keys changed, the next record cannot be a delta of the previous ones.
+  has_written_record_ = false;
+  Sync();
+}
+
+void SessionStoreEfl::Observe(int type,
+                              const content::NotificationSource& source,
+                              const content::NotificationDetails& details) {
+  switch (type) {
+    case content::NOTIFICATION_NAV_ENTRY_COMMITTED:
+      MarkDirty(content::Details<content::LoadCommittedDetails>(details)->entry);
+      break;
+    case content::NOTIFICATION_NAV_ENTRY_CHANGED:
+      MarkDirty(content::Details<content::EntryChangedDetails>(
+          details)->changed_entry);
+      break;
+    case content::NOTIFICATION_WEB_CONTENTS_TITLE_UPDATED:
+      MarkDirty(content::Details<std::pair<NavigationEntry*, bool> >(
+          details)->first);
+      break;
+    default:
+      NOTREACHED();
+  }
+}
+
+void SessionStoreEfl::Sync() {
+  if (pending_restore_)
+    return;
+
+  NavigationController& controller = web_contents_->GetController();
+  const int count = controller.GetEntryCount();
+  ++sync_stamp_;
+  keys_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    NavigationEntry* navigation_entry = controller.GetEntryAtIndex(i);
+    const int key = navigation_entry->GetUniqueID();
+    Entry& entry = entries_[key];
+    if (entry.dirty) {
+      Pickle pickle;
+      ContentSerializedNavigationBuilder::FromNavigationEntry(
+          i, *navigation_entry).WriteToPickle(kMaxEntrySize, &pickle);
+      entry.data.assign(static_cast<const char*>(pickle.data()),
+                        pickle.size());
+      entry.dirty = false;
+      entry.written = false;
+    }
+    entry.sync_stamp = sync_stamp_;
+    keys_[i] = key;
+  }
+
+  // Entries pruned from the history.
+  for (EntryMap::iterator it = entries_.begin(); it != entries_.end();) {
+    if (it->second.sync_stamp != sync_stamp_)
+      entries_.erase(it++);
+    else
+      ++it;
+  }
+  current_index_ = controller.GetCurrentEntryIndex();
+}
+
+void SessionStoreEfl::MarkDirty(const NavigationEntry* navigation_entry) {
+  if (!navigation_entry || pending_restore_)
+    return;
+
+  EntryMap::iterator it = entries_.find(navigation_entry->GetUniqueID());
+  if (it != entries_.end())
+    it->second.dirty = true;
+}
+
+bool SessionStoreEfl::ReadLegacyData(const char* data, unsigned length) {
+  Pickle pickle(data, length);
+  PickleIterator iterator(pickle);
+  int entry_count;
+  int current_index;
+  if (!iterator.ReadInt(&entry_count) || entry_count < 0)
+    return false;
+  if (!iterator.ReadInt(&current_index))
+    return false;
+
+  // Entries of this format are not delimited, they are cached as new
+  // pickles.
+  SerializedEntryMap entries;
+  std::vector<int> keys;
+  for (int i = 0; i < entry_count; ++i) {
+    SerializedNavigationEntry navigation;
+    if (!navigation.ReadFromPickle(&iterator))
+      return false;
+
+    Pickle entry_pickle;
+    navigation.WriteToPickle(kMaxEntrySize, &entry_pickle);
+    entries[i].assign(static_cast<const char*>(entry_pickle.data()),
+                      entry_pickle.size());
+    keys.push_back(i);
+  }
+  return SetPending(keys, &entries, current_index);
+}
+
+bool SessionStoreEfl::ReadRecords(const char* data, unsigned length) {
+  SerializedEntryMap entries;
+  std::vector<int> keys;
+  int current_index = -1;
+  bool first = true;
+  while (length) {
+    uint32 header[4];
+    if (length < kRecordHeaderSize)
+      return false;
+    memcpy(header, data, kRecordHeaderSize);
+    data += kRecordHeaderSize;
+    length -= kRecordHeaderSize;
+
+    const uint32 flags = header[2];
+    const uint32 payload_size = header[3];
+    if (header[0] != kRecordMagic || header[1] != kRecordVersion)
+      return false;
+    if (first && (flags & WRITE_DELTA))
+      return false;
+
+    std::string inflated;
+    const char* payload = data;
+    size_t record_size = payload_size;
+    if (flags & WRITE_COMPRESSED) {
+      if (!Inflate(data, length, payload_size, &inflated, &record_size))
+        return false;
+      payload = inflated.data();
+    } else if (length < payload_size) {
+      return false;
+    }
+    if (!ReadPayload(payload, payload_size, &entries, &keys, &current_index))
+      return false;
+
+    data += record_size;
+    length -= record_size;
+    first = false;
+  }
+  return SetPending(keys, &entries, current_index);
+}
+
+bool SessionStoreEfl::SetPending(const std::vector<int>& keys,
+                                 SerializedEntryMap* entries,
+                                 int current_index) {
+  DCHECK(!web_contents_->GetController().GetEntryCount());
+  if (keys.empty())
+    return true;
+
+  if (current_index < 0)
+    current_index = 0;
+  if (current_index >= static_cast<int>(keys.size()))
+    current_index = keys.size() - 1;
+
+  // The current entry is what the view shows meanwhile.
+  SerializedNavigationEntry current;
+  if (!ReadEntry((*entries)[keys[current_index]], &current))
+    return false;
+
+  entries_.clear();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    Entry& entry = entries_[keys[i]];
+    entry.data.swap((*entries)[keys[i]]);
+    entry.dirty = false;
+  }
+  keys_ = keys;
+  current_index_ = current_index;
+  has_written_record_ = false;
+
+  pending_restore_ = true;
+  pending_url_ = current.virtual_url();
+  pending_title_ = current.title();
+  return true;
+}
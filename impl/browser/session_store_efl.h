@@ -0,0 +1,134 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SESSION_STORE_EFL_H
+#define SESSION_STORE_EFL_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/strings/string16.h"
+#include "content/public/browser/notification_observer.h"
+#include "content/public/browser/notification_registrar.h"
+#include "url/gurl.h"
+
+namespace content {
+class NavigationEntry;
+class WebContents;
+}
+
+// Session history of a view, kept serialized entry by entry.
+//
+// Every navigation entry is serialized once and again only after it
+// changed, so that snapshots taken after every navigation cost a copy of
+// the cached entries instead of serializing the whole history again.
+//
+// Snapshots are either the flat pickle of GetSessionData(), or records
+// streamed to a file descriptor by WriteSnapshot(). A record is a full
+// snapshot or, with WRITE_DELTA, only the entries that changed since the
+// previous record the view wrote, so that a session file can be kept up
+// to date by appending to it. Records may be deflated.
+//
+// A restored session stays serialized until the history is needed, i.e.
+// until the view is shown or navigated, see RestoreIfPending().
+//
+// Lives on the UI thread.
+class SessionStoreEfl : public content::NotificationObserver {
+ public:
+  enum WriteFlags {
+    WRITE_FULL = 0,
+    // Only the entries changed since the previous record, falls back to a
+    // full record if there is none.
+    WRITE_DELTA = 1 << 0,
+    WRITE_COMPRESSED = 1 << 1,
+  };
+
+  explicit SessionStoreEfl(content::WebContents* web_contents);
+  virtual ~SessionStoreEfl();
+
+  // Returns the session as a flat pickle in a buffer allocated with
+  // malloc(), which the caller frees.
+  void GetSessionData(const char** data, unsigned* length);
+
+  // Writes a record of the session to |fd|. Returns false on I/O errors,
+  // in which case the next delta is a full record again.
+  bool WriteSnapshot(int fd, int flags);
+
+  // Accepts data of GetSessionData() or a sequence of records, the first
+  // of them being a full one. Only checks the data, the history itself is
+  // restored by RestoreIfPending().
+  bool Restore(const char* data, unsigned length);
+
+  // Restores the history of a pending Restore() to the navigation
+  // controller. Does nothing if there is none.
+  void RestoreIfPending();
+
+  bool HasPendingRestore() const { return pending_restore_; }
+
+  // The current entry of a pending restore, what the view shows once the
+  // history is restored.
+  const GURL& GetPendingURL() const { return pending_url_; }
+  const base::string16& GetPendingTitle() const { return pending_title_; }
+
+  // content::NotificationObserver implementation.
+  virtual void Observe(int type,
+                       const content::NotificationSource& source,
+                       const content::NotificationDetails& details) override;
+
+ private:
+  struct Entry {
+    Entry() : dirty(true), written(false), sync_stamp(0) {}
+
+    // Pickle of the sessions::SerializedNavigationEntry. Its index is where
+    // the entry was when it was serialized, restores go by the order of
+    // |keys_| instead, so entries moved by pruning are not serialized again.
+    std::string data;
+    // Changed since |data| was serialized.
+    bool dirty;
+    // |data| is part of the records written so far.
+    bool written;
+    int sync_stamp;
+  };
+  typedef std::map<int, Entry> EntryMap;
+  typedef std::map<int, std::string> SerializedEntryMap;
+
+  // Brings the cached entries in line with the navigation controller,
+  // serializing the entries that are new or changed.
+  void Sync();
+
+  void MarkDirty(const content::NavigationEntry* entry);
+
+  bool ReadLegacyData(const char* data, unsigned length);
+  bool ReadRecords(const char* data, unsigned length);
+
+  // Takes the entries of a restored session, in the order of |keys|.
+  // Returns false if its current entry cannot be read.
+  bool SetPending(const std::vector<int>& keys,
+                  SerializedEntryMap* entries,
+                  int current_index);
+
+  content::WebContents* web_contents_;
+  content::NotificationRegistrar registrar_;
+
+  // Cached entries, keyed by the unique id of their navigation entry or,
+  // while a restore is pending, by their key in the restored data.
+  EntryMap entries_;
+  // Keys of the entries in history order, and the current entry.
+  std::vector<int> keys_;
+  int current_index_;
+  int sync_stamp_;
+
+  // Records were written and later ones may be deltas.
+  bool has_written_record_;
+
+  bool pending_restore_;
+  GURL pending_url_;
+  base::string16 pending_title_;
+
+  DISALLOW_COPY_AND_ASSIGN(SessionStoreEfl);
+};
+
+#endif // SESSION_STORE_EFL_H
@@ -0,0 +1,83 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/spare_renderer_efl.h"
+
+#include "base/bind.h"
+#include "base/time/time.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
+
+#include "common/render_messages_efl.h"
+
+using content::BrowserThread;
+using content::RenderProcessHost;
+using content::SiteInstance;
+
+namespace {
+
+// Delay before a claimed spare is replaced, so that launching the next one
+// does not compete with the first page load of the view that claimed it.
+const int kRelaunchDelaySeconds = 5;
+
+} // namespace
+
+SpareRendererEfl::SpareRendererEfl(content::BrowserContext* browser_context)
+    : browser_context_(browser_context),
+      weak_factory_(this) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  // Not from the constructor itself, which usually runs on behalf of an
+  // application call.
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&SpareRendererEfl::Launch, weak_factory_.GetWeakPtr()));
+}
+
+SpareRendererEfl::~SpareRendererEfl() {
+  Drop();
+}
+
+scoped_refptr<SiteInstance> SpareRendererEfl::Claim() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (!site_instance_.get())
+    return NULL;
+
+  scoped_refptr<SiteInstance> spare;
+  if (site_instance_->HasProcess() &&
+      site_instance_->GetProcess()->HasConnection())
+    spare.swap(site_instance_);
+  else
+    Drop();
+
+  BrowserThread::PostDelayedTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&SpareRendererEfl::Launch, weak_factory_.GetWeakPtr()),
+      base::TimeDelta::FromSeconds(kRelaunchDelaySeconds));
+  return spare;
+}
+
+void SpareRendererEfl::Launch() {
+  // In single process mode there is only one renderer, nothing to spare.
+  if (site_instance_.get() || RenderProcessHost::run_renderer_in_process())
+    return;
+
+  site_instance_ = SiteInstance::Create(browser_context_);
+  RenderProcessHost* host = site_instance_->GetProcess();
+  if (!host->Init()) {
+    LOG(WARNING) << "Cannot launch a spare renderer";
+    Drop();
+    return;
+  }
+  // Queued until the process is connected.
+  host->Send(new EwkViewMsg_Prewarm());
+}
+
+void SpareRendererEfl::Drop() {
+  if (!site_instance_.get())
+    return;
+
+  // Nothing else uses the process of an unclaimed spare.
+  if (site_instance_->HasProcess())
+    site_instance_->GetProcess()->Cleanup();
+  site_instance_ = NULL;
+}
@@ -0,0 +1,45 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SPARE_RENDERER_EFL_H
+#define SPARE_RENDERER_EFL_H
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+
+namespace content {
+class BrowserContext;
+class SiteInstance;
+}
+
+// Keeps one renderer process of a browser context launched, with Blink
+// initialized, for the next view of that context to claim. Launching a
+// renderer and initializing Blink in it otherwise delay the first paint
+// of every view that needs a new process.
+//
+// The spare is bound to a SiteInstance without a site yet, which the
+// claiming view creates its WebContents in, so the first navigation of
+// that view assigns the site and reuses the process.
+class SpareRendererEfl {
+ public:
+  explicit SpareRendererEfl(content::BrowserContext* browser_context);
+  ~SpareRendererEfl();
+
+  // Returns the site instance of the spare renderer, or NULL if none is
+  // ready, e.g. it crashed or was just claimed. A new spare is launched
+  // once the view claiming this one had time to load its first page.
+  scoped_refptr<content::SiteInstance> Claim();
+
+ private:
+  void Launch();
+  void Drop();
+
+  content::BrowserContext* browser_context_;
+  scoped_refptr<content::SiteInstance> site_instance_;
+  base::WeakPtrFactory<SpareRendererEfl> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpareRendererEfl);
+};
+
+#endif // SPARE_RENDERER_EFL_H
@@ -9,6 +9,8 @@
 
 #include "base/base_switches.h"
 #include "base/command_line.h"
+#include "browser/in_memory_data_efl.h"
+#include "content/public/browser/child_process_security_policy.h"
 #include "content/public/common/content_switches.h"
 
 
@@ -27,6 +29,11 @@ void BrowserMainPartsEfl::PreMainMessageLoopRun() {
   const CommandLine& command_line = *CommandLine::ForCurrentProcess();
   if (command_line.HasSwitch(switches::kRemoteDebuggingPort))
     devtools_delegate_ = new DevToolsDelegateEfl();
+
+  // Any renderer may request in-memory data, the store only serves it to the
+  // render views of the view that loaded it.
+  ChildProcessSecurityPolicy::GetInstance()->RegisterWebSafeScheme(
+      kInMemoryDataScheme);
 }
 
 void BrowserMainPartsEfl::PostMainMessageLoopRun() {
@@ -17,4 +17,11 @@ struct CacheParamsEfl {
 #endif
 };
 
+// Memory cache usage of a single renderer, as reported by blink::WebCache.
+struct CacheStatsEfl {
+  int64 capacity;
+  int64 live_size;
+  int64 dead_size;
+};
+
 #endif /* CACHE_PARAMS_EFL_H_ */
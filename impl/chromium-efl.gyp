@@ -57,6 +57,7 @@
       '<(chrome_src_dir)/components/components.gyp:visitedlink_browser',
       '<(chrome_src_dir)/components/components.gyp:visitedlink_renderer',
       '<(chrome_src_dir)/third_party/icu/icu.gyp:icuuc',
+      '<(chrome_src_dir)/third_party/zlib/zlib.gyp:zlib',
       '<(chrome_src_dir)/components/components.gyp:sessions_content',
 # [M37] TODO:Autofill related code chagned. Need to enable after Fixing.
       #'<(chrome_src_dir)/components/components.gyp:autofill_content_renderer',
@@ -124,6 +125,10 @@
       'browser/device_sensors/data_fetcher_impl_tizen.cc',
       'browser/device_sensors/data_fetcher_impl_tizen.h',
       'browser/device_sensors/data_fetcher_shared_memory_tizen.cc',
+      'browser/device_sensors/fake_sensor_backend_tizen.cc',
+      'browser/device_sensors/fake_sensor_backend_tizen.h',
+      'browser/device_sensors/sensor_backend_tizen.cc',
+      'browser/device_sensors/sensor_backend_tizen.h',
       'browser/disambiguation_popup_efl.cc',
       'browser/disambiguation_popup_efl.h',
       'browser/download_manager_delegate_efl.cc',
@@ -148,6 +153,10 @@
       'browser/inputpicker/InputPicker.h',
       'browser/inputpicker/color_chooser_efl.cc',
       'browser/inputpicker/color_chooser_efl.h',
+      'browser/in_memory_data_efl.cc',
+      'browser/in_memory_data_efl.h',
+      'browser/ipc_message_counter_efl.cc',
+      'browser/ipc_message_counter_efl.h',
       'browser/javascript_dialog_manager_efl.cc',
       'browser/javascript_dialog_manager_efl.h',
       'browser/javascript_modal_dialog_efl.cc',
@@ -164,6 +173,8 @@
       'browser/password_manager/password_manager_client_efl.h',
       'browser/password_manager/content_password_manager_driver.cc',
       'browser/password_manager/content_password_manager_driver.h',
+      'browser/password_manager/password_form_cache.cc',
+      'browser/password_manager/password_form_cache.h',
       'browser/password_manager/password_form_manager.cc',
       'browser/password_manager/password_form_manager.h',
       'browser/password_manager/password_generation_manager.cc',
@@ -179,6 +190,8 @@
       'browser/password_manager/password_store_factory.h',
       'browser/policy_response_delegate_efl.cc',
       'browser/policy_response_delegate_efl.h',
+      'browser/registered_scripts_efl.cc',
+      'browser/registered_scripts_efl.h',
       'browser/renderer_host/browsing_data_remover_efl.cc',
       'browser/renderer_host/browsing_data_remover_efl.h',
       'browser/renderer_host/im_context_efl.cc',
@@ -201,16 +214,17 @@
       'browser/resource_throttle_efl.cc',
       'browser/resource_throttle_efl.h',
       'browser/scoped_wait_for_ewk.h',
-      'browser/selectpicker/WebPopupItem.cc',
-      'browser/selectpicker/WebPopupItem.h',
-      'browser/selectpicker/popup_menu_item.cc',
-      'browser/selectpicker/popup_menu_item.h',
-      'browser/selectpicker/popup_menu_item_private.h',
+      'browser/selectpicker/popup_menu_model.cc',
+      'browser/selectpicker/popup_menu_model.h',
       'browser/selectpicker/popup_picker.cc',
       'browser/selectpicker/popup_picker.h',
+      'browser/session_store_efl.cc',
+      'browser/session_store_efl.h',
       'browser/sound_effect.h',
       'browser/sound_effect.cc',
       'browser/sound_effect_tizen.cc',
+      'browser/spare_renderer_efl.cc',
+      'browser/spare_renderer_efl.h',
       'browser/vibration/vibration_message_filter.cc',
       'browser/vibration/vibration_message_filter.h',
       'browser/vibration/vibration_provider_client.cc',
@@ -237,6 +251,8 @@
       'common/content_client_efl.h',
       'common/content_switches_efl.cc',
       'common/content_switches_efl.h',
+      'common/memory_purge_stats_efl.cc',
+      'common/memory_purge_stats_efl.h',
       'common/message_generator_efl.cc',
       'common/message_generator_efl.h',
       'common/render_messages_efl.h',
@@ -245,6 +261,8 @@
       'common/version_info_efl.h',
       'common/web_contents_utils.cc',
       'common/web_contents_utils.h',
+      'common/wrt_message_value_efl.cc',
+      'common/wrt_message_value_efl.h',
       'common/cursors/webcursor_efl.cc',
       'common/cursors/webcursor_efl.h',
       'components/clipboard/clipboard_efl.cc',
@@ -289,6 +307,8 @@
       'gl/gl_shared_context_efl.h',
       'gpu/gpu_thread_override_efl.cc',
       'gpu/gpu_thread_override_efl.h',
+      'http_cache_config_efl.cc',
+      'http_cache_config_efl.h',
       'http_user_agent_settings_efl.cc',
       'http_user_agent_settings_efl.h',
       'memory_purger.cc',
@@ -308,6 +328,8 @@
       'renderer/print_pages_params.h',
       'renderer/print_web_view_helper_efl.cc',
       'renderer/print_web_view_helper_efl.h',
+      'renderer/registered_script_runner_efl.cc',
+      'renderer/registered_script_runner_efl.h',
       'renderer/render_frame_observer_efl.cc',
       'renderer/render_frame_observer_efl.h',
       'renderer/render_process_observer_efl.cc',
@@ -387,6 +409,8 @@
       'web_process_content_main_delegate_efl.h',
       'wrt/dynamicplugin.cc',
       'wrt/dynamicplugin.h',
+      'wrt/wrt_async_message_channel.cc',
+      'wrt/wrt_async_message_channel.h',
       'wrt/wrtwidget.cc',
       'wrt/wrtwidget.h',
 
@@ -12,6 +12,24 @@ namespace switches {
 // different modes using CSS Media Queries.
 const char kEnableViewMode[]    = "enable-view-mode";
 
+// Counts the IPC messages renderers send to the browser, for benchmarks.
+const char kCountIpcMessages[]  = "count-ipc-messages";
+
+// Number of video streams media players may decode in hardware at once.
+const char kMaxHardwareVideoDecoders[] = "max-hardware-video-decoders";
+
+// Generates device motion and orientation samples instead of reading the
+// sensors, for tests on devices or emulators without them.
+const char kUseFakeDeviceSensors[] = "use-fake-device-sensors";
+
+// Disk cache backend of the HTTP cache: "blockfile" (default), "simple" or
+// "memory".
+const char kHttpCacheBackend[] = "http-cache-backend";
+
+// Size of the HTTP cache in bytes, instead of the one derived from the
+// device class and free disk space.
+const char kHttpCacheSize[] = "http-cache-size";
+
 // Don't dump stuff here, follow the same order as the header.
 
 }  // namespace switches
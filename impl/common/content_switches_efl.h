@@ -18,6 +18,24 @@ namespace switches {
 // different modes using CSS Media Queries.
 CONTENT_EXPORT extern const char kEnableViewMode[];
 
+// Counts the IPC messages renderers send to the browser, for benchmarks.
+CONTENT_EXPORT extern const char kCountIpcMessages[];
+
+// Number of video streams media players may decode in hardware at once.
+CONTENT_EXPORT extern const char kMaxHardwareVideoDecoders[];
+
+// Generates device motion and orientation samples instead of reading the
+// sensors, for tests on devices or emulators without them.
+CONTENT_EXPORT extern const char kUseFakeDeviceSensors[];
+
+// Disk cache backend of the HTTP cache: "blockfile" (default), "simple" or
+// "memory".
+CONTENT_EXPORT extern const char kHttpCacheBackend[];
+
+// Size of the HTTP cache in bytes, instead of the one derived from the
+// device class and free disk space.
+CONTENT_EXPORT extern const char kHttpCacheSize[];
+
 // DON'T ADD RANDOM STUFF HERE. Put it in the main section above in
 // alphabetical order, or in one of the ifdefs (also in order in each section).
 
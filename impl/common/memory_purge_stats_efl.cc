@@ -0,0 +1,69 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "common/memory_purge_stats_efl.h"
+
+#include "base/logging.h"
+#include "base/metrics/histogram.h"
+
+namespace memory_purge_stats {
+
+namespace {
+
+const char* StageName(Stage stage) {
+  switch (stage) {
+    case DECODED_IMAGE_CACHE:
+      return "DecodedImageCache";
+    case BLINK_MEMORY_CACHE:
+      return "BlinkMemoryCache";
+    case V8_HEAP:
+      return "V8Heap";
+    case FAVICON_DATABASE:
+      return "FaviconDatabase";
+    case MEDIA_PIPELINES:
+      return "MediaPipelines";
+    case HIDDEN_VIEW_GPU_SURFACES:
+      return "HiddenViewGpuSurfaces";
+  }
+  NOTREACHED();
+  return "Unknown";
+}
+
+} // namespace
+
+void RecordReclaimedBytes(Stage stage, int64 bytes) {
+  // Measurements are taken before and after a stage, allocations made in
+  // between can make the difference negative.
+  if (bytes < 0)
+    bytes = 0;
+
+  VLOG(1) << "Memory purge stage " << StageName(stage)
+          << " reclaimed " << bytes << " bytes";
+
+  int kilobytes = static_cast<int>(bytes / 1024);
+  // Histogram macros cache the histogram per call site, so every stage needs
+  // its own one.
+  switch (stage) {
+    case DECODED_IMAGE_CACHE:
+      UMA_HISTOGRAM_MEMORY_KB("Memory.Purge.DecodedImageCache", kilobytes);
+      break;
+    case BLINK_MEMORY_CACHE:
+      UMA_HISTOGRAM_MEMORY_KB("Memory.Purge.BlinkMemoryCache", kilobytes);
+      break;
+    case V8_HEAP:
+      UMA_HISTOGRAM_MEMORY_KB("Memory.Purge.V8Heap", kilobytes);
+      break;
+    case FAVICON_DATABASE:
+      UMA_HISTOGRAM_MEMORY_KB("Memory.Purge.FaviconDatabase", kilobytes);
+      break;
+    case MEDIA_PIPELINES:
+      UMA_HISTOGRAM_MEMORY_KB("Memory.Purge.MediaPipelines", kilobytes);
+      break;
+    case HIDDEN_VIEW_GPU_SURFACES:
+      UMA_HISTOGRAM_MEMORY_KB("Memory.Purge.HiddenViewGpuSurfaces", kilobytes);
+      break;
+  }
+}
+
+} // namespace memory_purge_stats
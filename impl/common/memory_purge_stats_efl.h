@@ -0,0 +1,29 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEMORY_PURGE_STATS_EFL_H
+#define MEMORY_PURGE_STATS_EFL_H
+
+#include "base/basictypes.h"
+
+namespace memory_purge_stats {
+
+// Stages of the memory purge pipeline. Browser stages run in the browser
+// process, the others in every renderer.
+enum Stage {
+  DECODED_IMAGE_CACHE,
+  BLINK_MEMORY_CACHE,
+  V8_HEAP,
+  FAVICON_DATABASE,
+  MEDIA_PIPELINES,
+  HIDDEN_VIEW_GPU_SURFACES,
+};
+
+// Records how many bytes a stage reclaimed, both in the log and in the
+// Memory.Purge.* histograms so that the pipeline can be tuned from the field.
+void RecordReclaimedBytes(Stage stage, int64 bytes);
+
+} // namespace memory_purge_stats
+
+#endif // MEMORY_PURGE_STATS_EFL_H
@@ -4,9 +4,12 @@
 
 // Multiply-included file, no traditional include guard.
 
+#include "base/memory/shared_memory.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "ipc/ipc_message_macros.h"
 #include "ipc/ipc_channel_handle.h"
+#include "ipc/ipc_platform_file.h"
 #include "content/public/common/common_param_traits.h"
 #include "content/public/common/referrer.h"
 #include "ui/gfx/ipc/gfx_param_traits.h"
@@ -15,6 +18,7 @@
 #include "cache_params_efl.h"
 #include "navigation_policy_params.h"
 #include "renderer/print_pages_params.h"
+#include "common/wrt_message_value_efl.h"
 #include "third_party/WebKit/public/web/WebNavigationPolicy.h"
 #include "third_party/WebKit/public/web/WebNavigationType.h"
 #include "third_party/WebKit/public/web/WebViewModeEnums.h"
@@ -24,16 +28,18 @@
 #include "tizen_webview/public/tw_content_security_policy.h"
 #include "tizen_webview/public/tw_error.h"
 #include "tizen_webview/public/tw_hit_test.h"
+#include "tizen_webview/public/tw_memory_pressure_level.h"
+#include "tizen_webview/public/tw_pdf_export_status.h"
 #include "tizen_webview/public/tw_settings.h"
 #include "tizen_webview/public/tw_view_mode.h"
 #include "tizen_webview/public/tw_wrt.h"
 
 #include <string>
 #include <map>
+#include <vector>
 
 #if defined(TIZEN_MULTIMEDIA_SUPPORT)
 #include "base/file_descriptor_posix.h"
-#include "base/memory/shared_memory.h"
 #endif
 
 typedef std::map<std::string, std::string> StringMap;
@@ -54,7 +60,14 @@ IPC_STRUCT_TRAITS_BEGIN(CacheParamsEfl)
   IPC_STRUCT_TRAITS_MEMBER(cache_max_dead_capacity)
 IPC_STRUCT_TRAITS_END()
 
+IPC_STRUCT_TRAITS_BEGIN(CacheStatsEfl)
+  IPC_STRUCT_TRAITS_MEMBER(capacity)
+  IPC_STRUCT_TRAITS_MEMBER(live_size)
+  IPC_STRUCT_TRAITS_MEMBER(dead_size)
+IPC_STRUCT_TRAITS_END()
+
 IPC_ENUM_TRAITS(tizen_webview::ContentSecurityPolicyType)
+IPC_ENUM_TRAITS(tizen_webview::Memory_Pressure_Level)
 
 IPC_ENUM_TRAITS(blink::WebNavigationPolicy)
 IPC_ENUM_TRAITS(blink::WebNavigationType)
@@ -124,11 +137,13 @@ IPC_STRUCT_TRAITS_BEGIN(_Ewk_Hit_Test)
 #endif
 IPC_STRUCT_TRAITS_END()
 
-IPC_STRUCT_TRAITS_BEGIN(DidPrintPagesParams)
-  IPC_STRUCT_TRAITS_MEMBER(metafile_data_handle)
-  IPC_STRUCT_TRAITS_MEMBER(data_size)
-  IPC_STRUCT_TRAITS_MEMBER(document_cookie)
-  IPC_STRUCT_TRAITS_MEMBER(filename)
+IPC_ENUM_TRAITS(tizen_webview::Pdf_Export_Status)
+
+IPC_STRUCT_TRAITS_BEGIN(PdfExportParams)
+  IPC_STRUCT_TRAITS_MEMBER(job_id)
+  IPC_STRUCT_TRAITS_MEMBER(page_size)
+  IPC_STRUCT_TRAITS_MEMBER(first_page)
+  IPC_STRUCT_TRAITS_MEMBER(last_page)
 IPC_STRUCT_TRAITS_END()
 
 IPC_STRUCT_TRAITS_BEGIN(tizen_webview::WrtIpcMessageData)
@@ -138,6 +153,12 @@ IPC_STRUCT_TRAITS_BEGIN(tizen_webview::WrtIpcMessageData)
   IPC_STRUCT_TRAITS_MEMBER(reference_id)
 IPC_STRUCT_TRAITS_END()
 
+IPC_STRUCT_TRAITS_BEGIN(WrtMessageValueEfl)
+  IPC_STRUCT_TRAITS_MEMBER(inline_value)
+  IPC_STRUCT_TRAITS_MEMBER(handle)
+  IPC_STRUCT_TRAITS_MEMBER(shared_size)
+IPC_STRUCT_TRAITS_END()
+
 IPC_ENUM_TRAITS(blink::WebViewMode)
 
 IPC_STRUCT_TRAITS_BEGIN(tizen_webview::Settings)
@@ -165,8 +186,28 @@ IPC_MESSAGE_CONTROL1(EflViewMsg_SetCache,
 // Tells the renderer to dump as much memory as it can, perhaps because we
 // have memory pressure or the renderer is (or will be) paged out.  This
 // should only result in purging objects we can recalculate, e.g. caches or
-// JS garbage, not in purging irreplaceable objects.
-IPC_MESSAGE_CONTROL0(EwkViewMsg_PurgeMemory)
+// JS garbage, not in purging irreplaceable objects. Moderate pressure only
+// drops what is cheap to rebuild.
+IPC_MESSAGE_CONTROL1(EwkViewMsg_PurgeMemory,
+                     tizen_webview::Memory_Pressure_Level /* level */)
+
+// Tells a spare renderer, launched before any view needs it, to initialize
+// Blink so that the view claiming it does not wait for that.
+IPC_MESSAGE_CONTROL0(EwkViewMsg_Prewarm)
+
+// Scripts registered with the context, see RegisteredScriptsEfl. Sources are
+// UTF-8 and, like code caches, in read-only shared memory.
+IPC_MESSAGE_CONTROL3(EwkViewMsg_RegisterScript,
+                     int /* script id */,
+                     base::SharedMemoryHandle /* source */,
+                     uint32 /* source size */)
+IPC_MESSAGE_CONTROL4(EwkViewMsg_SetScriptCodeCache,
+                     int /* script id */,
+                     base::SharedMemoryHandle /* code cache */,
+                     uint32 /* code cache size */,
+                     base::TimeDelta /* compile time without the cache */)
+IPC_MESSAGE_CONTROL1(EwkViewMsg_UnregisterScript,
+                     int /* script id */)
 
 IPC_MESSAGE_CONTROL4(EwkViewMsg_SetWidgetInfo,
                      int,            // result: widgetHandle
@@ -201,17 +242,33 @@ IPC_MESSAGE_ROUTED4(EwkViewMsg_DoHitTestAsync,
                     tizen_webview::Hit_Test_Mode, /* mode */
                     int64_t /* request id */)
 
-IPC_MESSAGE_ROUTED3(EwkViewMsg_PrintToPdf,
-                    int, /* width */
-                    int, /* height */
-                    base::FilePath /* file name to save pdf*/)
+// Prints the requested pages into |file|, which the browser has opened for
+// writing. The renderer prints a few pages per task, reports progress with
+// EwkHostMsg_PdfExportProgress and writes |file| after the last page.
+IPC_MESSAGE_ROUTED2(EwkViewMsg_PrintToPdf,
+                    PdfExportParams, /* params */
+                    IPC::PlatformFileForTransit /* file */)
+
+IPC_MESSAGE_ROUTED1(EwkViewMsg_CancelPdfExport,
+                    int /* job id */)
 
 IPC_MESSAGE_ROUTED1(EflViewMsg_UpdateSettings, tizen_webview::Settings)
 
 // from renderer to browser
 
-IPC_MESSAGE_ROUTED1(EwkHostMsg_DidPrintPagesToPdf,
-                    DidPrintPagesParams /* pdf document parameters */)
+// Reports the renderer's memory cache usage so that the browser can revise
+// how the global cache budget is split between renderers.
+IPC_MESSAGE_CONTROL1(EflViewHostMsg_CacheStats,
+                     CacheStatsEfl /* stats */)
+
+IPC_MESSAGE_ROUTED3(EwkHostMsg_PdfExportProgress,
+                    int, /* job id */
+                    int, /* pages printed */
+                    int /* page count */)
+
+IPC_MESSAGE_ROUTED2(EwkHostMsg_PdfExportFinished,
+                    int, /* job id */
+                    tizen_webview::Pdf_Export_Status /* status */)
 
 IPC_SYNC_MESSAGE_CONTROL1_1(EwkHostMsg_DecideNavigationPolicy,
                            NavigationPolicyParams,
@@ -230,6 +287,19 @@ IPC_MESSAGE_ROUTED3(EwkViewMsg_Scale,
                     int, /* center x */
                     int /* center y */)
 
+IPC_MESSAGE_ROUTED2(EwkViewMsg_ExecuteRegisteredScript,
+                    int /* script id */,
+                    int /* callback id */)
+
+// The code cache is only set by the first execution in a renderer that was
+// not sent one, compile times are zero once the renderer compiled it.
+IPC_MESSAGE_ROUTED5(EwkHostMsg_RegisteredScriptExecuted,
+                    int /* callback id */,
+                    std::string /* result */,
+                    base::TimeDelta /* compile time */,
+                    base::TimeDelta /* compile time saved */,
+                    std::vector<uint8> /* produced code cache */)
+
 IPC_MESSAGE_ROUTED1(EwkViewMsg_PlainTextGet,
                     int /* callback id */)
 
@@ -240,6 +310,21 @@ IPC_MESSAGE_ROUTED2(EwkHostMsg_PlainTextGetContents,
 IPC_MESSAGE_ROUTED1(EwkHostMsg_WrtMessage,
                     tizen_webview::WrtIpcMessageData /* data */);
 
+// Asynchronous counterpart of EwkHostMsg_WrtSyncMessage, the value of
+// |data| is carried by |value|. Answered with EwkViewMsg_WrtAsyncMessageReply
+// for the same request id.
+IPC_MESSAGE_ROUTED3(EwkHostMsg_WrtAsyncMessage,
+                    int /* request id */,
+                    tizen_webview::WrtIpcMessageData /* data */,
+                    WrtMessageValueEfl /* value */)
+
+// |success| is false when the browser could not read the value of the
+// request, |value| is empty then.
+IPC_MESSAGE_ROUTED3(EwkViewMsg_WrtAsyncMessageReply,
+                    int /* request id */,
+                    bool /* success */,
+                    WrtMessageValueEfl /* value */)
+
 IPC_MESSAGE_ROUTED2(EwkHostMsg_DidChangeContentsSize,
                     int, /* width */
                     int /* height */)
@@ -273,6 +358,20 @@ IPC_MESSAGE_CONTROL4(EwkViewHostMsg_HitTestAsyncReply,
 IPC_MESSAGE_ROUTED1(EwkViewMsg_GetMHTMLData,
                     int /* callback id */)
 
+// Asks for the decoded pixels of the image at the given view position,
+// provided it is still the image of the given URL.
+IPC_MESSAGE_ROUTED3(EwkViewMsg_GetImageContentsAt,
+                    int, /* x */
+                    int, /* y */
+                    GURL /* image url */)
+
+// N32 pixels, width * 4 bytes per row. The handle is not valid when there
+// is no decoded image of the URL at the requested position.
+IPC_MESSAGE_ROUTED3(EwkHostMsg_ImageContents,
+                    base::SharedMemoryHandle, /* pixels */
+                    uint32, /* size of the pixels in bytes */
+                    gfx::Size /* image size */)
+
 IPC_MESSAGE_ROUTED2(EwkHostMsg_ReadMHTMLData,
                     std::string, /* Mhtml text */
                     int /* callback id */)
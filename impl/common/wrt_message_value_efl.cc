@@ -0,0 +1,77 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "common/wrt_message_value_efl.h"
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include "base/logging.h"
+
+namespace {
+
+// Below this, the copies through the IPC channel cost less than creating
+// and mapping shared memory.
+const size_t kMinSharedValueSize = 64 * 1024;
+
+} // namespace
+
+WrtMessageValueEfl::WrtMessageValueEfl()
+    : handle(base::SharedMemory::NULLHandle()),
+      shared_size(0) {
+}
+
+WrtMessageValueEfl::~WrtMessageValueEfl() {
+}
+
+// static
+bool WrtMessageValueEfl::ShouldShare(size_t size) {
+  return size >= kMinSharedValueSize;
+}
+
+void WrtMessageValueEfl::SetInline(const std::string& value) {
+  inline_value = value;
+  handle = base::SharedMemory::NULLHandle();
+  shared_size = 0;
+}
+
+bool WrtMessageValueEfl::SetShared(const std::string& value,
+                                   base::SharedMemory* memory,
+                                   base::ProcessHandle process) {
+  DCHECK(memory->memory());
+  DCHECK_GE(memory->mapped_size(), value.size());
+  memcpy(memory->memory(), value.data(), value.size());
+  if (!memory->ShareToProcess(process, &handle))
+    return false;
+
+  inline_value.clear();
+  shared_size = value.size();
+  return true;
+}
+
+bool WrtMessageValueEfl::Read(std::string* value) const {
+  if (!shared_size) {
+    *value = inline_value;
+    return true;
+  }
+
+  // Takes ownership of the handle, which is closed with |memory|.
+  base::SharedMemory memory(handle, true);
+
+  // Mapping past the end of the segment would fault on access.
+  struct stat segment;
+  if (fstat(handle.fd, &segment) || segment.st_size < 0 ||
+      static_cast<uint64>(segment.st_size) < shared_size) {
+    LOG(ERROR) << "WRT message value of " << shared_size
+               << " bytes in a smaller or invalid segment";
+    return false;
+  }
+  if (!memory.Map(shared_size)) {
+    LOG(ERROR) << "Cannot map a WRT message value of " << shared_size
+               << " bytes";
+    return false;
+  }
+  value->assign(static_cast<const char*>(memory.memory()), shared_size);
+  return true;
+}
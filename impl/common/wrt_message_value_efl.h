@@ -0,0 +1,49 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef WRT_MESSAGE_VALUE_EFL_H
+#define WRT_MESSAGE_VALUE_EFL_H
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/shared_memory.h"
+#include "base/process/process_handle.h"
+
+// Value of an asynchronous WRT plugin message or of its reply on its way
+// through IPC. Small values travel inline, larger ones in shared memory so
+// that they are neither copied into the IPC channel nor through its
+// reader.
+struct WrtMessageValueEfl {
+  WrtMessageValueEfl();
+  ~WrtMessageValueEfl();
+
+  // Whether a value of |size| bytes goes through shared memory.
+  static bool ShouldShare(size_t size);
+
+  // Makes this the inline |value|.
+  void SetInline(const std::string& value);
+
+  // Copies |value| to |memory|, mapped and at least as big, and makes this
+  // a handle to it for |process|. Returns false if it cannot be shared.
+  bool SetShared(const std::string& value,
+                 base::SharedMemory* memory,
+                 base::ProcessHandle process);
+
+  // Reads the value, mapping the shared memory it is in. Returns false if
+  // it cannot be mapped or is smaller than |shared_size|, as the sender is
+  // not trusted.
+  //
+  // Single use: const because values arrive as const IPC parameters, but a
+  // shared value takes ownership of |handle| and closes it, so a second
+  // Read() of the same value fails.
+  bool Read(std::string* value) const;
+
+  std::string inline_value;
+  base::SharedMemoryHandle handle;
+  // Size of the value in shared memory, 0 for inline values.
+  uint32 shared_size;
+};
+
+#endif // WRT_MESSAGE_VALUE_EFL_H
@@ -27,6 +27,19 @@ void MediaWebContentsObserverTizen::RenderFrameDeleted(
   media_player_managers_.erase(key);
 }
 
+void MediaWebContentsObserverTizen::WasShown() {
+  for (MediaPlayerManagerMap::iterator it = media_player_managers_.begin();
+      it != media_player_managers_.end(); ++it) {
+    it->second->WasShown();
+  }
+}
+
+void MediaWebContentsObserverTizen::WasHidden() {
+  for (MediaPlayerManagerMap::iterator it = media_player_managers_.begin();
+      it != media_player_managers_.end(); ++it) {
+    it->second->WasHidden();
+  }
+}
 
 bool MediaWebContentsObserverTizen::OnMessageReceived(const IPC::Message& msg,
                                                       RenderFrameHost* render_frame_host) {
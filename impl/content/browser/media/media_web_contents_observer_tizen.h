@@ -27,6 +27,8 @@ class CONTENT_EXPORT MediaWebContentsObserverTizen
 
   // WebContentsObserver implementations.
   virtual void RenderFrameDeleted(RenderFrameHost* render_frame_host) override;
+  virtual void WasShown() override;
+  virtual void WasHidden() override;
   virtual bool OnMessageReceived(const IPC::Message& message,
                                  RenderFrameHost* render_frame_host) override;
 
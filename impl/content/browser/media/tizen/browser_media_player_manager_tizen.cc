@@ -4,9 +4,15 @@
 
 #include "content/browser/media/tizen/browser_media_player_manager_tizen.h"
 
+#include <set>
+
+#include "base/lazy_instance.h"
 #include "base/memory/shared_memory.h"
+#include "base/process/process.h"
 #include "content/browser/media/tizen/browser_demuxer_tizen.h"
+#include "content/browser/media/tizen/media_resource_manager_tizen.h"
 #include "content/browser/renderer_host/render_process_host_impl.h"
+#include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "content/common/media/tizen/media_player_messages_tizen.h"
 #include "content/public/browser/web_contents.h"
 #include "ipc/ipc_channel_proxy.h"
@@ -21,6 +27,13 @@
 
 namespace content {
 
+namespace {
+
+typedef std::set<BrowserMediaPlayerManagerTizen*> ManagerSet;
+base::LazyInstance<ManagerSet> g_managers = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 BrowserMediaPlayerManagerTizen* BrowserMediaPlayerManagerTizen::Create(
     RenderFrameHost* rfh) {
   return new BrowserMediaPlayerManagerTizen(rfh);
@@ -31,9 +44,12 @@ BrowserMediaPlayerManagerTizen::BrowserMediaPlayerManagerTizen(
     : render_frame_host_(render_frame_host),
       web_contents_(WebContents::FromRenderFrameHost(render_frame_host)),
       weak_ptr_factory_(this) {
+  g_managers.Get().insert(this);
 }
 
 BrowserMediaPlayerManagerTizen::~BrowserMediaPlayerManagerTizen() {
+  g_managers.Get().erase(this);
+  MediaResourceManagerTizen::GetInstance()->RemoveManager(this);
   for (ScopedVector<media::MediaPlayerTizen>::iterator it = players_.begin();
       it != players_.end(); ++it) {
     (*it)->Destroy();
@@ -41,6 +57,22 @@ BrowserMediaPlayerManagerTizen::~BrowserMediaPlayerManagerTizen() {
   players_.weak_clear();
 }
 
+// static
+int64 BrowserMediaPlayerManagerTizen::ReleaseIdlePlayers() {
+  int64 released = 0;
+  ManagerSet& managers = g_managers.Get();
+  for (ManagerSet::iterator manager = managers.begin();
+      manager != managers.end(); ++manager) {
+    ScopedVector<media::MediaPlayerTizen>& players = (*manager)->players_;
+    for (ScopedVector<media::MediaPlayerTizen>::iterator it = players.begin();
+        it != players.end(); ++it) {
+      if (!(*it)->IsPlayerDestructing())
+        released += (*it)->ReleaseIdleResources();
+    }
+  }
+  return released;
+}
+
 media::MediaPlayerTizen* BrowserMediaPlayerManagerTizen::GetPlayer(
     int player_id) {
   for (ScopedVector<media::MediaPlayerTizen>::iterator it = players_.begin();
@@ -138,6 +170,13 @@ void BrowserMediaPlayerManagerTizen::OnMediaDataChange(
     int media) {
   Send(new MediaPlayerGstMsg_MediaDataChanged(
       GetRoutingID(), player_id, format, height, width, media));
+
+  // A player started in a hidden view before its video track was known.
+  media::MediaPlayerTizen* player = GetPlayer(player_id);
+  if (player && player->HasVideo() && IsHidden() && player->Suspend()) {
+    MediaResourceManagerTizen::GetInstance()->ReleaseDecoder(
+        this, player_id);
+  }
 }
 
 int BrowserMediaPlayerManagerTizen::GetRoutingID() {
@@ -180,7 +219,12 @@ void BrowserMediaPlayerManagerTizen::OnInitialize(
         this));
   } else {
     LOG(ERROR) << __FUNCTION__ << " Load type is wrong!";
+    return;
   }
+
+  media::MediaPlayerTizen* player = GetPlayer(player_id);
+  if (player)
+    ShareMediaClock(player);
 }
 
 void BrowserMediaPlayerManagerTizen::OnDestroy(int player_id) {
@@ -190,11 +234,26 @@ void BrowserMediaPlayerManagerTizen::OnDestroy(int player_id) {
 
 void BrowserMediaPlayerManagerTizen::OnPlay(int player_id) {
   media::MediaPlayerTizen* player = GetPlayer(player_id);
-  if (player)
-    player->Play();
+  if (!player)
+    return;
+  if (player->HasVideo()) {
+    if (IsHidden()) {
+      deferred_players_.insert(player_id);
+      return;
+    }
+    if (!MediaResourceManagerTizen::GetInstance()->AcquireDecoder(
+        this, player_id)) {
+      LOG(ERROR) << __FUNCTION__ << " no video decoder for player "
+                 << player_id;
+      Send(new MediaPlayerGstMsg_PauseRequest(GetRoutingID(), player_id));
+      return;
+    }
+  }
+  player->Play();
 }
 
 void BrowserMediaPlayerManagerTizen::OnPause(int player_id) {
+  deferred_players_.erase(player_id);
   media::MediaPlayerTizen* player = GetPlayer(player_id);
   if (player)
     player->Pause(false);
@@ -220,6 +279,56 @@ void BrowserMediaPlayerManagerTizen::OnSeek(int player_id, double time) {
     player->Seek(time);
 }
 
+void BrowserMediaPlayerManagerTizen::WasHidden() {
+  for (ScopedVector<media::MediaPlayerTizen>::iterator it = players_.begin();
+      it != players_.end(); ++it) {
+    media::MediaPlayerTizen* player = *it;
+    // Audio keeps playing in the background.
+    if (player->IsPlayerDestructing() || !player->HasVideo())
+      continue;
+    if (player->Suspend()) {
+      MediaResourceManagerTizen::GetInstance()->ReleaseDecoder(
+          this, player->GetPlayerId());
+    }
+  }
+}
+
+void BrowserMediaPlayerManagerTizen::WasShown() {
+  for (ScopedVector<media::MediaPlayerTizen>::iterator it = players_.begin();
+      it != players_.end(); ++it) {
+    media::MediaPlayerTizen* player = *it;
+    if (player->IsPlayerDestructing() || !player->HasVideo())
+      continue;
+    if (player->Resume() &&
+        !MediaResourceManagerTizen::GetInstance()->AcquireDecoder(
+            this, player->GetPlayerId())) {
+      EvictPlayer(player->GetPlayerId());
+    }
+  }
+
+  std::set<int> deferred_players;
+  deferred_players.swap(deferred_players_);
+  for (std::set<int>::iterator it = deferred_players.begin();
+      it != deferred_players.end(); ++it) {
+    OnPlay(*it);
+  }
+}
+
+bool BrowserMediaPlayerManagerTizen::EvictPlayer(int player_id) {
+  media::MediaPlayerTizen* player = GetPlayer(player_id);
+  if (!player || !player->Suspend())
+    return false;
+  // Pausing the element keeps it from expecting playback to go on.
+  Send(new MediaPlayerGstMsg_PauseRequest(GetRoutingID(), player_id));
+  return true;
+}
+
+bool BrowserMediaPlayerManagerTizen::IsHidden() {
+  RenderViewHost* render_view_host = web_contents()->GetRenderViewHost();
+  return render_view_host &&
+      RenderWidgetHostImpl::From(render_view_host)->is_hidden();
+}
+
 void BrowserMediaPlayerManagerTizen::AddPlayer(
     media::MediaPlayerTizen* player) {
   DCHECK(!GetPlayer(player->GetPlayerId()));
@@ -228,6 +337,16 @@ void BrowserMediaPlayerManagerTizen::AddPlayer(
   players_.push_back(player);
 }
 
+void BrowserMediaPlayerManagerTizen::ShareMediaClock(
+    media::MediaPlayerTizen* player) {
+  base::SharedMemoryHandle handle;
+  if (!player->media_clock()->ShareToProcess(
+      base::Process::Current().Handle(), &handle))
+    return;
+  Send(new MediaPlayerGstMsg_MediaClockCreated(
+      GetRoutingID(), player->GetPlayerId(), handle));
+}
+
 void BrowserMediaPlayerManagerTizen::RemovePlayer(int player_id) {
   for (ScopedVector<media::MediaPlayerTizen>::iterator it = players_.begin();
       it != players_.end(); ++it) {
@@ -236,6 +355,9 @@ void BrowserMediaPlayerManagerTizen::RemovePlayer(int player_id) {
       VLOG(1) << "BrowserMediaPlayerManagerTizen::" << __FUNCTION__
               << " Player-Id : " << player->GetPlayerId();
       players_.weak_erase(it);
+      deferred_players_.erase(player_id);
+      MediaResourceManagerTizen::GetInstance()->ReleaseDecoder(
+          this, player_id);
       player->Destroy();
       break;
     }
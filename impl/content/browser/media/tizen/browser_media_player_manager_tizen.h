@@ -5,6 +5,8 @@
 #ifndef CONTENT_BROWSER_MEDIA_TIZEN_BROWSER_MEDIA_PLAYER_MANAGER_TIZEN_H_
 #define CONTENT_BROWSER_MEDIA_TIZEN_BROWSER_MEDIA_PLAYER_MANAGER_TIZEN_H_
 
+#include <set>
+
 #include "base/memory/scoped_vector.h"
 #include "content/public/browser/browser_message_filter.h"
 #include "content/public/browser/render_frame_host.h"
@@ -25,6 +27,10 @@ class CONTENT_EXPORT BrowserMediaPlayerManagerTizen
   static BrowserMediaPlayerManagerTizen* Create( RenderFrameHost* efh);
   virtual ~BrowserMediaPlayerManagerTizen();
 
+  // Asks paused players of every live manager to drop their decoder state.
+  // Returns an estimate of the bytes released.
+  static int64 ReleaseIdlePlayers();
+
   // media::MediaPlayerManager implementation.
   virtual media::MediaPlayerTizen* GetPlayer(int player_id) override;
   virtual void OnTimeChanged(int player_id) override;
@@ -74,6 +80,17 @@ class CONTENT_EXPORT BrowserMediaPlayerManagerTizen
   virtual void OnDestroy(int player_id);
   virtual void OnSeek(int player_id, double time);
 
+  // Suspends the video players of a hidden view, and resumes the ones that
+  // were playing when it is shown again. Video players asked to play while
+  // the view is hidden only start then.
+  void WasHidden();
+  void WasShown();
+
+  // Suspends the player to free its hardware decoder for another one, and
+  // has the renderer pause the element. Returns false if the player cannot
+  // be suspended in its current state, it keeps its decoder then.
+  bool EvictPlayer(int player_id);
+
  protected:
   // Clients must use Create() or subclass constructor.
   explicit BrowserMediaPlayerManagerTizen(RenderFrameHost* render_frame_host);
@@ -81,6 +98,9 @@ class CONTENT_EXPORT BrowserMediaPlayerManagerTizen
   void AddPlayer(media::MediaPlayerTizen* player);
   void RemovePlayer(int player_id);
 
+  // Hands the player's media clock to the renderer, if it has one.
+  void ShareMediaClock(media::MediaPlayerTizen* player);
+
   // Helper function to send messages to RenderFrameObserver.
   bool Send(IPC::Message* msg);
 
@@ -88,8 +108,12 @@ class CONTENT_EXPORT BrowserMediaPlayerManagerTizen
   WebContents* web_contents() const { return web_contents_; }
 
  private:
+  bool IsHidden();
+
   // An array of managed players.
   ScopedVector<media::MediaPlayerTizen> players_;
+  // Video players that were asked to play while the view was hidden.
+  std::set<int> deferred_players_;
   RenderFrameHost* render_frame_host_;
   WebContents* const web_contents_;
   base::WeakPtrFactory<BrowserMediaPlayerManagerTizen> weak_ptr_factory_;
@@ -0,0 +1,103 @@
+// Copyright 2014 Samsung Electronics Inc. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/media/tizen/media_resource_manager_tizen.h"
+
+#include "base/command_line.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "common/content_switches_efl.h"
+#include "content/browser/media/tizen/browser_media_player_manager_tizen.h"
+
+namespace content {
+
+namespace {
+
+// Tizen devices decode at most two video streams in hardware.
+const size_t kDefaultMaxHardwareVideoDecoders = 2;
+
+}  // namespace
+
+// static
+MediaResourceManagerTizen* MediaResourceManagerTizen::GetInstance() {
+  return Singleton<MediaResourceManagerTizen>::get();
+}
+
+MediaResourceManagerTizen::MediaResourceManagerTizen()
+    : max_decoders_(kDefaultMaxHardwareVideoDecoders) {
+  const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+  if (command_line.HasSwitch(switches::kMaxHardwareVideoDecoders)) {
+    unsigned value;
+    if (base::StringToUint(command_line.GetSwitchValueASCII(
+        switches::kMaxHardwareVideoDecoders), &value) && value > 0)
+      max_decoders_ = value;
+  }
+}
+
+MediaResourceManagerTizen::~MediaResourceManagerTizen() {
+}
+
+bool MediaResourceManagerTizen::AcquireDecoder(
+    BrowserMediaPlayerManagerTizen* manager,
+    int player_id) {
+  HolderList::iterator it = Find(manager, player_id);
+  if (it != holders_.end()) {
+    holders_.splice(holders_.end(), holders_, it);
+    return true;
+  }
+
+  // Live streams and seeking players refuse to be suspended, they keep
+  // their decoder.
+  HolderList candidates(holders_);
+  for (HolderList::iterator candidate = candidates.begin();
+      candidate != candidates.end() && holders_.size() >= max_decoders_;
+      ++candidate) {
+    if (!candidate->manager->EvictPlayer(candidate->player_id))
+      continue;
+    VLOG(1) << "MediaResourceManagerTizen::" << __FUNCTION__
+            << " suspended player " << candidate->player_id
+            << " for player " << player_id;
+    ReleaseDecoder(candidate->manager, candidate->player_id);
+  }
+
+  if (holders_.size() >= max_decoders_) {
+    VLOG(1) << "MediaResourceManagerTizen::" << __FUNCTION__
+            << " no decoder for player " << player_id;
+    return false;
+  }
+
+  DecoderHolder holder = { manager, player_id };
+  holders_.push_back(holder);
+  return true;
+}
+
+void MediaResourceManagerTizen::ReleaseDecoder(
+    BrowserMediaPlayerManagerTizen* manager,
+    int player_id) {
+  HolderList::iterator it = Find(manager, player_id);
+  if (it != holders_.end())
+    holders_.erase(it);
+}
+
+void MediaResourceManagerTizen::RemoveManager(
+    BrowserMediaPlayerManagerTizen* manager) {
+  for (HolderList::iterator it = holders_.begin(); it != holders_.end();) {
+    if (it->manager == manager)
+      it = holders_.erase(it);
+    else
+      ++it;
+  }
+}
+
+MediaResourceManagerTizen::HolderList::iterator
+    MediaResourceManagerTizen::Find(BrowserMediaPlayerManagerTizen* manager,
+                                    int player_id) {
+  for (HolderList::iterator it = holders_.begin(); it != holders_.end(); ++it) {
+    if (it->manager == manager && it->player_id == player_id)
+      return it;
+  }
+  return holders_.end();
+}
+
+}  // namespace content
@@ -0,0 +1,58 @@
+// Copyright 2014 Samsung Electronics Inc. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_MEDIA_TIZEN_MEDIA_RESOURCE_MANAGER_TIZEN_H_
+#define CONTENT_BROWSER_MEDIA_TIZEN_MEDIA_RESOURCE_MANAGER_TIZEN_H_
+
+#include <list>
+
+#include "base/basictypes.h"
+#include "base/memory/singleton.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+class BrowserMediaPlayerManagerTizen;
+
+// Arbitrates the hardware video decoders between the players of every
+// WebContents. A video player holds a decoder from Play() until it is
+// suspended or destroyed. When all of them are taken, the least recently
+// played holder that can be suspended is, to make room.
+class CONTENT_EXPORT MediaResourceManagerTizen {
+ public:
+  static MediaResourceManagerTizen* GetInstance();
+
+  // Marks the player as the most recently used decoder holder. Returns false
+  // if all decoders are taken by players that cannot be suspended, the
+  // player must not play then.
+  bool AcquireDecoder(BrowserMediaPlayerManagerTizen* manager, int player_id);
+  void ReleaseDecoder(BrowserMediaPlayerManagerTizen* manager, int player_id);
+  // Forgets every player of |manager|, which is going away.
+  void RemoveManager(BrowserMediaPlayerManagerTizen* manager);
+
+ private:
+  friend struct DefaultSingletonTraits<MediaResourceManagerTizen>;
+
+  struct DecoderHolder {
+    BrowserMediaPlayerManagerTizen* manager;
+    int player_id;
+  };
+  // Least recently used first.
+  typedef std::list<DecoderHolder> HolderList;
+
+  MediaResourceManagerTizen();
+  ~MediaResourceManagerTizen();
+
+  HolderList::iterator Find(BrowserMediaPlayerManagerTizen* manager,
+                            int player_id);
+
+  HolderList holders_;
+  size_t max_decoders_;
+
+  DISALLOW_COPY_AND_ASSIGN(MediaResourceManagerTizen);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_MEDIA_TIZEN_MEDIA_RESOURCE_MANAGER_TIZEN_H_
@@ -93,6 +93,11 @@ IPC_MESSAGE_ROUTED2(MediaPlayerGstMsg_DurationChanged,
                     int /* player_id */,
                     double /* time */)
 
+// Shared memory the player publishes its playback position in.
+IPC_MESSAGE_ROUTED2(MediaPlayerGstMsg_MediaClockCreated,
+                    int /* player_id */,
+                    base::SharedMemoryHandle /* handle */)
+
 // Current  duration.
 IPC_MESSAGE_ROUTED2(MediaPlayerGstMsg_TimeUpdate,
                     int /* player_id */,
@@ -159,6 +164,10 @@ IPC_MESSAGE_ROUTED2(MediaPlayerGstMsg_SeekRequest,
                     int /* player_id */,
                     double /* time_to_seek */)
 
+// Asks the renderer to pause an element whose decoder was taken over.
+IPC_MESSAGE_ROUTED1(MediaPlayerGstMsg_PauseRequest,
+                    int /* player_id */)
+
 // Sent after the renderer demuxer has seeked.
 IPC_MESSAGE_CONTROL2(MediaPlayerGstHostMsg_DemuxerSeekDone,
                      int /* demuxer_client_id */,
@@ -41,6 +41,8 @@ bool RendererMediaPlayerManagerTizen::OnMessageReceived(
   IPC_BEGIN_MESSAGE_MAP(RendererMediaPlayerManagerTizen, message)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_MediaDataChanged, OnMediaDataChange)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_DurationChanged, OnDurationChange)
+    IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_MediaClockCreated,
+                        OnMediaClockCreated)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_TimeUpdate, OnTimeUpdate)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_BufferUpdate, OnBufferUpdate)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_ReadyStateChange, OnReadyStateChange)
@@ -51,6 +53,7 @@ bool RendererMediaPlayerManagerTizen::OnMessageReceived(
                         OnPauseStateChange)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_OnSeekStateChange, OnSeekStateChange)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_SeekRequest, OnRequestSeek)
+    IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_PauseRequest, OnRequestPause)
     IPC_MESSAGE_HANDLER(MediaPlayerGstMsg_NewFrameAvailable,
                         OnNewFrameAvailable)
 #if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
@@ -91,6 +94,16 @@ void RendererMediaPlayerManagerTizen::OnDurationChange(
     player->OnDurationChange(duration);
 }
 
+void RendererMediaPlayerManagerTizen::OnMediaClockCreated(
+    int player_id,
+    base::SharedMemoryHandle handle) {
+  media::WebMediaPlayerTizen* player = GetMediaPlayer(player_id);
+  if (player)
+    player->OnMediaClockCreated(handle);
+  else
+    base::SharedMemory::CloseHandle(handle);
+}
+
 void RendererMediaPlayerManagerTizen::OnTimeUpdate(
     int player_id,
     double current_time) {
@@ -155,6 +168,12 @@ void RendererMediaPlayerManagerTizen::OnRequestSeek(
     player->OnRequestSeek(seek_time);
 }
 
+void RendererMediaPlayerManagerTizen::OnRequestPause(int player_id) {
+  media::WebMediaPlayerTizen* player = GetMediaPlayer(player_id);
+  if (player)
+    player->RequestPause();
+}
+
 void RendererMediaPlayerManagerTizen::OnNewFrameAvailable(
     int player_id,
     base::SharedMemoryHandle foreign_memory_handle,
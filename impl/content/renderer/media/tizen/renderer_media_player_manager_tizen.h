@@ -83,6 +83,7 @@ class RendererMediaPlayerManagerTizen : public RenderFrameObserver {
       int width,
       int media);
   void OnDurationChange(int player_id, double duration);
+  void OnMediaClockCreated(int player_id, base::SharedMemoryHandle handle);
   void OnTimeUpdate(int player_id, double current_time);
   void OnBufferUpdate(
       int player_id,
@@ -91,6 +92,7 @@ class RendererMediaPlayerManagerTizen : public RenderFrameObserver {
   void OnPauseStateChange(int player_id, bool state);
   void OnSeekStateChange(int player_id, bool state);
   void OnRequestSeek(int player_id, double seek_time);
+  void OnRequestPause(int player_id);
   void OnReadyStateChange(
       int player_id,
       media::MediaPlayerTizen::ReadyState state );
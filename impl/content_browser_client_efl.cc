@@ -8,11 +8,15 @@
 #include "base/memory/scoped_ptr.h"
 #include "browser_main_parts_efl.h"
 #include "browser_context_efl.h"
+#include "eweb_context.h"
+#include "eweb_view.h"
 #include "web_contents_delegate_efl.h"
 #include "devtools_manager_delegate_efl.h"
 #include "browser/web_contents/web_contents_view_efl.h"
 #include "browser/geolocation/access_token_store_efl.h"
 #include "browser/geolocation/geolocation_permission_context_efl.h"
+#include "browser/in_memory_data_efl.h"
+#include "browser/ipc_message_counter_efl.h"
 #include "browser/renderer_host/render_message_filter_efl.h"
 #include "browser/resource_dispatcher_host_delegate_efl.h"
 #include "browser/vibration/vibration_message_filter.h"
@@ -22,6 +26,7 @@
 #include "content/public/browser/resource_dispatcher_host.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/show_desktop_notification_params.h"
+#include "common/content_switches_efl.h"
 #include "common/web_contents_utils.h"
 #include "components/editing/content/browser/editor_client_observer.h"
 
@@ -60,6 +65,10 @@ net::URLRequestContextGetter* ContentBrowserClientEfl::CreateRequestContext(
       CreateRequestContext(protocol_handlers, request_interceptors.Pass());
 }
 
+bool ContentBrowserClientEfl::IsHandledURL(const GURL& url) {
+  return url.SchemeIs(kInMemoryDataScheme);
+}
+
 AccessTokenStore* ContentBrowserClientEfl::CreateAccessTokenStore() {
   return new AccessTokenStoreEfl();
 }
@@ -219,6 +228,13 @@ void ContentBrowserClientEfl::OverrideWebkitPrefs(
     content::RenderViewHost* render_view_host,
     const GURL& url,
     content::WebPreferences* prefs) {
+  // Fold in what the embedder set before this renderer existed.
+  WebContents* web_contents = WebContents::FromRenderViewHost(render_view_host);
+  WebContentsDelegateEfl* delegate = web_contents ?
+      static_cast<WebContentsDelegateEfl*>(web_contents->GetDelegate()) : NULL;
+  if (delegate && delegate->web_view() && delegate->web_view()->settings())
+    delegate->web_view()->settings()->applyPreferences(prefs);
+
   // TODO(dennis.oh): See http://107.108.218.239/bugzilla/show_bug.cgi?id=9507
   //                  This pref should be set to false again someday.
   // This pref is set to true by default
@@ -231,8 +247,12 @@ void ContentBrowserClientEfl::OverrideWebkitPrefs(
 void ContentBrowserClientEfl::RenderProcessWillLaunch(
     content::RenderProcessHost* host) {
   host->AddFilter(new RenderMessageFilterEfl(host->GetID()));
+  static_cast<BrowserContextEfl*>(host->GetBrowserContext())->WebContext()->
+      registered_scripts()->RenderProcessLaunched(host->GetID());
   host->AddFilter(new VibrationMessageFilter());
   host->AddFilter(new editing::EditorClientObserver(host->GetID()));
+  if (CommandLine::ForCurrentProcess()->HasSwitch(switches::kCountIpcMessages))
+    IPCMessageCounterEfl::AttachTo(host);
 
   scoped_ptr<RenderWidgetHostIterator> widgets(RenderWidgetHost::GetRenderWidgetHosts());
   RenderWidgetHost* widget = NULL;
@@ -241,7 +261,8 @@ void ContentBrowserClientEfl::RenderProcessWillLaunch(
     if (widget->GetProcess() == host)
       break;
 
-  DCHECK(widget);
+  // Spare renderers are launched before any view, the view claiming one
+  // adds the filter, see EWebView::InitializeContent().
   if (widget) {
     RenderViewHost* vh = RenderViewHost::From(widget);
     DCHECK(vh);
@@ -33,6 +33,8 @@ class ContentBrowserClientEfl: public ContentBrowserClient {
       ProtocolHandlerMap* protocol_handlers,
       URLRequestInterceptorScopedVector request_interceptors) override;
 
+  virtual bool IsHandledURL(const GURL& url) override;
+
   virtual AccessTokenStore* CreateAccessTokenStore() override;
 #if defined(OS_TIZEN)
   virtual LocationProvider* OverrideSystemLocationProvider() override;
@@ -5,9 +5,12 @@
 #include <Elementary.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 
 #include "API/ewk_context_menu_private.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/numerics/safe_math.h"
 #include "components/clipboard/clipboard_helper_efl.h"
 #include "context_menu_controller_efl.h"
 #include "content/public/browser/browser_thread.h"
@@ -17,7 +20,9 @@
 #include "net/base/net_util.h"
 #include "net/base/filename_util.h"
 #include "third_party/WebKit/public/platform/WebReferrerPolicy.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 #include "ui/base/clipboard/clipboard.h"
+#include "ui/gfx/codec/png_codec.h"
 
 #include "tizen_webview/public/tw_webview.h"
 #include "tizen_webview/public/tw_selection_controller.h"
@@ -35,6 +40,64 @@ using tizen_webview::SelectionController;
 namespace {
 static const int kMaxHeightVertical = 680;
 static const int kMaxHeightHorizontal = 360;
+
+base::FilePath UniqueFilePath(const base::FilePath& outputDir,
+                              const base::FilePath& fileName) {
+  base::FilePath fullPath = outputDir.Append(fileName);
+
+  while (base::PathExists(fullPath)) {
+    unsigned int i;
+    base::FilePath fileNameTmp;
+    for (i = 0; base::PathExists(fullPath) && i <= 999; i++) {
+      char buffer[6];
+      snprintf(buffer, sizeof(buffer), "(%d)", i);
+      fileNameTmp = fileName.InsertBeforeExtension(std::string(buffer));
+      fullPath = outputDir.Append(fileNameTmp);
+    }
+  }
+  return fullPath;
+}
+
+// Encodes the pixels sent by the renderer to PNG, which the clipboard
+// manager takes as a file, and returns the path written or an empty path.
+base::FilePath WriteImageToFile(scoped_ptr<base::SharedMemory> pixels,
+                                uint32 buffer_size,
+                                const gfx::Size& size,
+                                const base::FilePath& fileName) {
+  DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::FILE));
+  // Neither the size nor the segment come from a trusted process, the
+  // pixels have to fit in both before they are read.
+  base::CheckedNumeric<size_t> row_bytes = size.width();
+  row_bytes *= 4;
+  base::CheckedNumeric<size_t> pixels_size = row_bytes;
+  pixels_size *= size.height();
+  struct stat segment;
+  if (size.width() <= 0 || size.height() <= 0 || !pixels_size.IsValid() ||
+      pixels_size.ValueOrDie() > buffer_size ||
+      fstat(pixels->handle().fd, &segment) || segment.st_size < 0 ||
+      static_cast<uint64>(segment.st_size) < buffer_size) {
+    LOG(ERROR) << "Image of " << size.ToString() << " in a smaller or invalid"
+               << " segment of " << buffer_size << " bytes";
+    return base::FilePath();
+  }
+  if (!pixels->Map(buffer_size))
+    return base::FilePath();
+
+  SkBitmap bitmap;
+  bitmap.installPixels(SkImageInfo::MakeN32Premul(size.width(), size.height()),
+                       pixels->memory(), row_bytes.ValueOrDie());
+  std::vector<unsigned char> png_data;
+  if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &png_data))
+    return base::FilePath();
+
+  base::FilePath fullPath = UniqueFilePath(base::FilePath("/tmp/"), fileName);
+  int written = base::WriteFile(fullPath,
+      reinterpret_cast<const char*>(&png_data[0]), png_data.size());
+  if (written != static_cast<int>(png_data.size()))
+    return base::FilePath();
+  return fullPath;
+}
+
 }
 
 namespace content {
@@ -530,7 +593,8 @@ void ContextMenuControllerEfl::OnDownloadUpdated(content::DownloadItem* download
 base::FilePath ContextMenuControllerEfl::DownloadFile(const GURL url,
     const base::FilePath outputDir,
     const DownloadUrlParameters::OnStartedCallback &callback =
-        DownloadUrlParameters::OnStartedCallback()) {
+        DownloadUrlParameters::OnStartedCallback(),
+    bool prefer_cache = false) {
   LOG(INFO) << "Downloading file: " << url << "to: "<< outputDir.value();
   const GURL referrer = web_contents_.GetVisibleURL();
   DownloadManager* dlm = BrowserContext::GetDownloadManager(
@@ -542,19 +606,10 @@ base::FilePath ContextMenuControllerEfl::DownloadFile(const GURL url,
   dl_params->set_referrer(
       content::Referrer(referrer, blink::WebReferrerPolicyAlways));
   dl_params->set_referrer_encoding("utf8");
+  // Resources the page shows are usually still in the HTTP cache.
+  dl_params->set_prefer_cache(prefer_cache);
   base::FilePath fileName = net::GenerateFileName(url,"","","","","");
-  base::FilePath fullPath = outputDir.Append(fileName);
-
-  while (PathExists(fullPath)) {
-    unsigned int i;
-    base::FilePath fileNameTmp;
-    for (i = 0; PathExists(fullPath) && i <= 999; i++) {
-      char buffer[6];
-      snprintf(buffer, sizeof(buffer), "(%d)", i);
-      fileNameTmp = fileName.InsertBeforeExtension(std::string(buffer));
-      fullPath = outputDir.Append(fileNameTmp);
-    }
-  }
+  base::FilePath fullPath = UniqueFilePath(outputDir, fileName);
 
   dl_params->set_file_path(fullPath);
   dl_params->set_prompt(true);
@@ -563,6 +618,60 @@ base::FilePath ContextMenuControllerEfl::DownloadFile(const GURL url,
   return fullPath;
 }
 
+void ContextMenuControllerEfl::CopyImageToClipboard() {
+  EWebView* view = webview_->GetImpl();
+  if (!view || !view->RequestImageContentsAt(params_.x, params_.y,
+                                             params_.src_url)) {
+    DownloadImageToClipboard();
+    return;
+  }
+  is_waiting_for_image_contents_ = true;
+}
+
+void ContextMenuControllerEfl::DownloadImageToClipboard() {
+  DownloadFile(GURL(params_.src_url.spec()),
+               base::FilePath("/tmp/"),
+               base::Bind(&ContextMenuControllerEfl::OnDownloadStarted, weak_ptr_factory_.GetWeakPtr()),
+               true);
+}
+
+void ContextMenuControllerEfl::OnImageContentsReceived(
+    base::SharedMemoryHandle handle, uint32 buffer_size, const gfx::Size& size) {
+  bool valid_handle = base::SharedMemory::IsHandleValid(handle);
+  if (!is_waiting_for_image_contents_) {
+    if (valid_handle)
+      base::SharedMemory::CloseHandle(handle);
+    return;
+  }
+  is_waiting_for_image_contents_ = false;
+
+  // The image is no longer decoded, fetch it, from the HTTP cache if possible.
+  if (!valid_handle || !buffer_size || size.IsEmpty()) {
+    if (valid_handle)
+      base::SharedMemory::CloseHandle(handle);
+    DownloadImageToClipboard();
+    return;
+  }
+
+  scoped_ptr<base::SharedMemory> pixels(new base::SharedMemory(handle, true));
+  base::FilePath fileName = net::GenerateFileName(
+      GURL(params_.src_url.spec()), "", "", "", "", "").ReplaceExtension("png");
+  BrowserThread::PostTaskAndReplyWithResult(BrowserThread::FILE, FROM_HERE,
+      base::Bind(&WriteImageToFile, base::Passed(&pixels), buffer_size, size,
+                 fileName),
+      base::Bind(&ContextMenuControllerEfl::OnImageFileWritten,
+                 weak_ptr_factory_.GetWeakPtr()));
+}
+
+void ContextMenuControllerEfl::OnImageFileWritten(const base::FilePath& path) {
+  if (path.empty()) {
+    DownloadImageToClipboard();
+    return;
+  }
+  ClipboardHelperEfl::GetInstance()->SetData(path.value(),
+                                             ClipboardHelperEfl::CLIPBOARD_DATA_TYPE_IMAGE);
+}
+
 bool ContextMenuControllerEfl::TriggerDownloadCb(const GURL url) {
   BrowserContextEfl* browser_context =
       static_cast<BrowserContextEfl*>(web_contents_.GetBrowserContext());
@@ -738,9 +847,7 @@ void ContextMenuControllerEfl::MenuItemSelected(ContextMenuItemEfl* menu_item)
       break;
     }
     case MENU_ITEM_COPY_IMAGE_TO_CLIPBOARD: {
-      DownloadFile(GURL(params_.src_url.spec()),
-                        base::FilePath("/tmp/"),
-                        base::Bind(&ContextMenuControllerEfl::OnDownloadStarted,weak_ptr_factory_.GetWeakPtr()));
+      CopyImageToClipboard();
       break;
     }
     case MENU_ITEM_COPY_LINK_TO_CLIPBOARD: {
@@ -761,10 +868,12 @@ void ContextMenuControllerEfl::MenuItemSelected(ContextMenuItemEfl* menu_item)
     case MENU_ITEM_DOWNLOAD_IMAGE_TO_DISK: {
 #if defined(OS_TIZEN_MOBILE)
       if (!TriggerDownloadCb(GURL(params_.src_url.spec())))
-        DownloadFile(GURL(params_.src_url.spec()), base::FilePath("/opt/usr/media/Images/"));
+        DownloadFile(GURL(params_.src_url.spec()), base::FilePath("/opt/usr/media/Images/"),
+                     DownloadUrlParameters::OnStartedCallback(), true);
 #else
       if (!TriggerDownloadCb(GURL(params_.src_url.spec())))
-        DownloadFile(GURL(params_.src_url.spec()), base::FilePath("/tmp/"));
+        DownloadFile(GURL(params_.src_url.spec()), base::FilePath("/tmp/"),
+                     DownloadUrlParameters::OnStartedCallback(), true);
 #endif
       break;
     }
@@ -8,11 +8,13 @@
 #include <Evas.h>
 #include <set>
 
+#include "base/memory/shared_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/download_item.h"
 #include "content/public/browser/download_url_parameters.h"
 #include "content/public/common/context_menu_params.h"
+#include "ui/gfx/size.h"
 
 #include "tizen_webview/public/tw_context_menu_controller.h"
 #include "tizen_webview/public/tw_webview.h"
@@ -183,6 +185,7 @@ class ContextMenuControllerEfl
       menu_items_(NULL),
       type_(type),
       web_contents_(web_contents),
+      is_waiting_for_image_contents_(false),
       weak_ptr_factory_(this) {
   }
 
@@ -192,6 +195,8 @@ class ContextMenuControllerEfl
   void MenuItemSelected(ContextMenuItemEfl* menu_item);
   void HideContextMenu();
   gfx::Point GetContextMenuShowPos() const { return context_menu_show_pos_; };
+  void OnImageContentsReceived(base::SharedMemoryHandle handle,
+                               uint32 buffer_size, const gfx::Size& size);
 
 
  private:
@@ -218,7 +223,11 @@ class ContextMenuControllerEfl
   void OnDownloadStarted(content::DownloadItem* item, content::DownloadInterruptReason interrupt_reason);
   base::FilePath DownloadFile(const GURL url,
                               const base::FilePath outputDir,
-                              const DownloadUrlParameters::OnStartedCallback& callback);
+                              const DownloadUrlParameters::OnStartedCallback& callback,
+                              bool prefer_cache);
+  void CopyImageToClipboard();
+  void DownloadImageToClipboard();
+  void OnImageFileWritten(const base::FilePath& path);
   bool TriggerDownloadCb(const GURL url);
   void OpenInNewTab(const GURL url);
   Evas_Object* GetWebViewEvasObject();
@@ -235,6 +244,7 @@ class ContextMenuControllerEfl
   ContextMenuType type_;
   ContextMenuParams params_;
   WebContents& web_contents_;
+  bool is_waiting_for_image_contents_;
   base::WeakPtrFactory<ContextMenuControllerEfl> weak_ptr_factory_;
   gfx::Point context_menu_show_pos_;
   bool is_text_selection_;
@@ -4,6 +4,7 @@
 
 #include "eweb_context.h"
 
+#include "base/debug/trace_event.h"
 #include "base/synchronization/waitable_event.h"
 #include "components/autofill/content/browser/content_autofill_driver.h"
 #include "content/public/browser/appcache_service.h"
@@ -11,6 +12,7 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
 #include "content/public/browser/local_storage_usage_info.h"
 #include "content/public/browser/dom_storage_context.h"
 #include "browser/favicon/favicon_service.h"
@@ -234,16 +236,43 @@ EWebContext::EWebContext(bool incognito)
       incognito_(incognito) {
   CHECK(EwkGlobalData::GetInstance());
 
+  // Tracing is only started by the content runner above.
+  TRACE_EVENT0("startup", "EWebContext::EWebContext");
   browser_context_.reset(new BrowserContextEfl(this));
   // Notification Service gets init in BrowserMainRunner init,
   // so cache manager can register for notifications only after that.
   web_cache_manager_.reset(new WebCacheManagerEfl(browser_context_.get()));
+  registered_scripts_.reset(new RegisteredScriptsEfl());
 }
 
 EWebContext::~EWebContext() {
   VibrationProviderClient::DeleteInstance();
 }
 
+void EWebContext::SetSpareRendererEnabled(bool enable) {
+  if (enable == GetSpareRendererEnabled())
+    return;
+
+  if (enable)
+    spare_renderer_.reset(new SpareRendererEfl(browser_context_.get()));
+  else
+    spare_renderer_.reset();
+}
+
+scoped_refptr<content::SiteInstance> EWebContext::ClaimSpareRenderer() {
+  if (!spare_renderer_)
+    return NULL;
+  return spare_renderer_->Claim();
+}
+
+int EWebContext::RegisterScript(const char* script) {
+  return registered_scripts_->Register(script);
+}
+
+bool EWebContext::UnregisterScript(int script_id) {
+  return registered_scripts_->Unregister(script_id);
+}
+
 void EWebContext::ClearNetworkCache() {
   BrowsingDataRemoverEfl* remover = BrowsingDataRemoverEfl::CreateForUnboundedRange(browser_context_.get());
   remover->ClearNetworkCache();
@@ -302,7 +331,12 @@ void EWebContext::SetCertificate(const char* certificate_file) {
 }
 
 void EWebContext::NotifyLowMemory() {
-  MemoryPurger::PurgeAll(browser_context_.get());
+  NotifyMemoryPressure(tizen_webview::TW_MEMORY_PRESSURE_LEVEL_CRITICAL);
+}
+
+void EWebContext::NotifyMemoryPressure(
+    tizen_webview::Memory_Pressure_Level level) {
+  MemoryPurger::PurgeAll(browser_context_.get(), level);
 }
 
 void EWebContext::SetProxyUri(const char* uri) {
@@ -8,8 +8,11 @@
 #include "API/ewk_cookie_manager_private.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "browser/registered_scripts_efl.h"
 #include "browser/renderer_host/web_cache_manager_efl.h"
+#include "browser/spare_renderer_efl.h"
 #include "tizen_webview/public/tw_cache_model.h"
+#include "tizen_webview/public/tw_memory_pressure_level.h"
 #include "tizen_webview/public/tw_callbacks.h"
 #include "devtools_delegate_efl.h"
 
@@ -26,6 +29,7 @@ class FaviconDatabase;
 
 namespace content {
 class BrowserContextEfl;
+class SiteInstance;
 }
 
 class EwkDidStartDownloadCallback {
@@ -51,10 +55,13 @@ class EWebContext {
 
   void SetCacheModel(tizen_webview::Cache_Model);
   tizen_webview::Cache_Model GetCacheModel() const;
+  WebCacheManagerEfl* web_cache_manager() const
+  { return web_cache_manager_.get(); }
   void SetNetworkCacheEnable(bool enable);
   bool GetNetworkCacheEnable() const;
 
   void NotifyLowMemory();
+  void NotifyMemoryPressure(tizen_webview::Memory_Pressure_Level level);
   Ewk_Cookie_Manager* ewkCookieManager();
   base::WeakPtr<CookieManager> cookieManager()
   { return ewkCookieManager()->cookieManager(); }
@@ -102,6 +109,20 @@ class EWebContext {
   unsigned int InspectorServerStart(unsigned int port);
   bool InspectorServerStop();
 
+  // Keeps a renderer launched for the next view of this context, see
+  // SpareRendererEfl. Disabling drops an unclaimed spare.
+  void SetSpareRendererEnabled(bool enable);
+  bool GetSpareRendererEnabled() const { return spare_renderer_.get() != NULL; }
+  // Site instance new views are created in, NULL for a new one.
+  scoped_refptr<content::SiteInstance> ClaimSpareRenderer();
+
+  // Scripts to execute in the views of this context, see
+  // RegisteredScriptsEfl. RegisterScript() returns 0 on failure.
+  int RegisterScript(const char* script);
+  bool UnregisterScript(int script_id);
+  RegisteredScriptsEfl* registered_scripts() const
+  { return registered_scripts_.get(); }
+
  private:
   EWebContext(bool incognito);
   ~EWebContext();
@@ -114,9 +135,12 @@ class EWebContext {
   scoped_ptr<Ewk_Cookie_Manager> ewk_cookie_manager_;
   std::string proxy_uri_;
   scoped_ptr<EwkDidStartDownloadCallback> start_download_callback_;
+  scoped_ptr<RegisteredScriptsEfl> registered_scripts_;
   int m_pixmap;
   content::DevToolsDelegateEfl* inspector_server_;
   bool incognito_;
+  // Uses browser_context_, so declared after it.
+  scoped_ptr<SpareRendererEfl> spare_renderer_;
 };
 
 #endif
@@ -5,24 +5,32 @@
 #include "eweb_view.h"
 #include <config.h>
 
-#include "base/pickle.h"
+#include "base/bind.h"
+#include "base/debug/trace_event.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
 #include "base/threading/thread_restrictions.h"
+#include "browser/in_memory_data_efl.h"
 #include "browser/navigation_policy_handler_efl.h"
 #include "browser/renderer_host/render_widget_host_view_efl.h"
 #include "browser/renderer_host/web_event_factory_efl.h"
+#include "browser/session_store_efl.h"
+#include "browser/web_view_browser_message_filter.h"
 #include "browser/web_contents/web_contents_view_efl.h"
 #include "common/content_client_efl.h"
 #include "common/render_messages_efl.h"
+#include "ipc/ipc_platform_file.h"
 #include "common/version_info.h"
-#include "components/sessions/serialized_navigation_entry.h"
-#include "components/sessions/content/content_serialized_navigation_builder.h"
 #include "API/ewk_policy_decision_private.h"
 #include "API/ewk_settings_private.h"
 #include "API/ewk_text_style_private.h"
 #include "web_contents_delegate_efl.h"
 #include "public/platform/WebString.h"
 #include "base/command_line.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/strings/utf_string_conversions.h"
 #include "content/common/view_messages.h"
@@ -35,7 +43,10 @@
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/resource_dispatcher_host.h"
 #include "content/public/browser/screen_orientation_dispatcher_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/site_instance.h"
 #include "content/public/common/content_client.h"
+#include "content/public/common/page_zoom.h"
 #include "content/public/common/user_agent.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/host_zoom_map.h"
@@ -44,8 +55,11 @@
 #include "ui/events/event_switches.h"
 #include "browser/motion/wkext_motion.h"
 #include "ui/base/l10n/l10n_util.h"
+#include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/screen.h"
+#include "ui/gfx/size_conversions.h"
 #include "devtools_delegate_efl.h"
+#include "screen_efl.h"
 
 #include "tizen_webview/public/tw_hit_test.h"
 #include "tizen_webview/public/tw_touch_point.h"
@@ -57,9 +71,6 @@
 
 #ifdef OS_TIZEN
 #include <vconf.h>
-#include "browser/selectpicker/popup_menu_item.h"
-#include "browser/selectpicker/popup_menu_item_private.h"
-#include "browser/selectpicker/WebPopupItem.h"
 #endif
 #include <Ecore_Evas.h>
 #include <Elementary.h>
@@ -113,6 +124,21 @@ bool GetTiltZoomEnabled()
 }
 #endif // OS_TIZEN
 
+base::File OpenPdfFile(const base::FilePath& path) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+  return base::File(path, base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+}
+
+void ClosePdfFile(base::File file) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+}
+
+void DiscardPdfFile(base::File file, const base::FilePath& path) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+  file.Close();
+  base::DeleteFile(path, false);
+}
+
 void GetEinaRectFromGfxRect(const gfx::Rect& gfx_rect, Eina_Rectangle* eina_rect)
 {
   eina_rect->x = gfx_rect.x();
@@ -303,6 +329,7 @@ class WebViewGeolocationPermissionCallback {
 
 WebContents* EWebView::contents_for_new_window_ = NULL;
 int EWebView::find_request_id_counter_ = 0;
+int EWebView::pdf_export_job_id_counter_ = 0;
 
 EWebView* EWebView::FromEvasObject(Evas_Object* eo) {
   WebView *wv = WebView::FromEvasObject(eo);
@@ -345,7 +372,11 @@ EWebView::EWebView(tizen_webview::WebView* owner, tizen_webview::WebContext* con
       min_page_scale_factor_(-1.0),
       max_page_scale_factor_(-1.0),
       inspector_server_(NULL),
-      is_initialized_(false) {
+      is_initialized_(false),
+      settings_transaction_depth_(0),
+      settings_dirty_(false),
+      settings_flush_scheduled_(false),
+      weak_factory_(this) {
 }
 
 void EWebView::Initialize() {
@@ -353,6 +384,8 @@ void EWebView::Initialize() {
     return;
   }
 
+  TRACE_EVENT0("startup", "EWebView::Initialize");
+
   evas_event_handler_ = new tizen_webview::WebViewEvasEventHandler(public_webview_);
   selection_controller_.reset(new content::SelectionControllerEfl(this));
 
@@ -362,6 +395,7 @@ void EWebView::Initialize() {
     // embedder creates a new view in the "create,window" callback as long as
     // the result of the callback is the first one that has been created.
     contents_for_new_window_ = NULL;
+    session_store_.reset(new SessionStoreEfl(web_contents_.get()));
   } else {
     InitializeContent();
   }
@@ -398,7 +432,6 @@ void EWebView::Initialize() {
     SetMouseEventsEnabled(true);
 
 #if defined(OS_TIZEN)
-  popupMenuItems_ = 0;
   popupPicker_ = 0;
 
   formNavigation_.count = 1;
@@ -413,6 +446,8 @@ void EWebView::Initialize() {
 
 EWebView::~EWebView()
 {
+  InMemoryDataStoreEfl::GetInstance()->RemoveForOwner(this);
+
   std::map<int64_t, WebViewAsyncRequestHitTestDataCallback*>::iterator it;
   for (it = hit_test_callback_.begin(); it != hit_test_callback_.end(); it++)
     delete it->second;
@@ -432,10 +467,9 @@ EWebView::~EWebView()
   mhtml_callback_map_.Clear();
 
 #if defined(OS_TIZEN)
-  ReleasePopupMenuList();
-
   if (popupPicker_)
     popup_picker_del(popupPicker_);
+  popup_menu_model_.reset();
 
   formNavigation_.count = 1;
   formNavigation_.position = 0;
@@ -447,20 +481,6 @@ EWebView::~EWebView()
   public_webview_ = NULL;
 }
 
-#if defined(OS_TIZEN)
-void EWebView::ReleasePopupMenuList() {
-  if (!popupMenuItems_)
-    return;
-
-  void* dummyItem;
-  EINA_LIST_FREE(popupMenuItems_, dummyItem) {
-    delete static_cast<Popup_Menu_Item*>(dummyItem);
-  }
-
-  popupMenuItems_ = 0;
-}
-#endif
-
 void EWebView::SetFocus(Eina_Bool focus)
 {
   if (HasFocus() != focus) {
@@ -483,28 +503,38 @@ void EWebView::CreateNewWindow(WebContents* new_contents) {
 }
 
 void EWebView::SetURL(const char* url_string) {
+  RestorePendingSession();
+  FlushWebKitPreferences();
   GURL url(url_string);
   NavigationController::LoadURLParams params(url);
   web_contents_->GetController().LoadURLWithParams(params);
 }
 
 const char* EWebView::GetURL() const {
+  if (session_store_->HasPendingRestore())
+    return session_store_->GetPendingURL().possibly_invalid_spec().c_str();
   return web_contents_->GetVisibleURL().possibly_invalid_spec().c_str();
 }
 
 void EWebView::Reload() {
+  RestorePendingSession();
+  FlushWebKitPreferences();
   web_contents_->GetController().Reload(true);
 }
 
 void EWebView::ReloadIgnoringCache() {
+  RestorePendingSession();
+  FlushWebKitPreferences();
   web_contents_->GetController().ReloadIgnoringCache(true);
 }
 
 Eina_Bool EWebView::CanGoBack() {
+  RestorePendingSession();
   return web_contents_->GetController().CanGoBack();
 }
 
 Eina_Bool EWebView::CanGoForward() {
+  RestorePendingSession();
   return web_contents_->GetController().CanGoForward();
 }
 
@@ -513,17 +543,21 @@ Eina_Bool EWebView::HasFocus() const {
 }
 
 Eina_Bool EWebView::GoBack() {
+  RestorePendingSession();
   if (!web_contents_->GetController().CanGoBack())
     return EINA_FALSE;
 
+  FlushWebKitPreferences();
   web_contents_->GetController().GoBack();
   return EINA_TRUE;
 }
 
 Eina_Bool EWebView::GoForward() {
+  RestorePendingSession();
   if (!web_contents_->GetController().CanGoForward())
     return EINA_FALSE;
 
+  FlushWebKitPreferences();
   web_contents_->GetController().GoForward();
   return EINA_TRUE;
 }
@@ -637,28 +671,18 @@ void EWebView::SetOrientation(int orientation) {
     orientation = 270;
   screen_orientation_ = orientation;
 
-  RenderWidgetHostViewEfl* view = rwhv();
-  if (view && (
-      screen_orientation_ == 0   ||
+  if (screen_orientation_ == 0   ||
       screen_orientation_ == 90  ||
       screen_orientation_ == 180 ||
-      screen_orientation_ == 270
-      )
-     ) {
-    RenderWidgetHost* rwh = view->GetRenderWidgetHost();
-
-    blink::WebScreenInfo screen_info;
-    rwh->GetWebScreenInfo(&screen_info);
-    screen_info.orientationAngle = screen_orientation_;
+      screen_orientation_ == 270) {
+    // The views observe the screen and resize their renderers with the new
+    // screen info.
+    ui::UpdateScreenDisplay();
 
-    ViewMsg_Resize_Params params;
-    params.screen_info = screen_info;
-
-    rwh->Send(new ViewMsg_Resize(rwh->GetRoutingID(), params));
-    view->UpdateScreenInfo(view->GetNativeView());
-
-    WebContentsImpl& contents_impl = static_cast<WebContentsImpl&>(web_contents());
-    contents_impl.screen_orientation_dispatcher_host()->OnOrientationChange();
+    if (rwhv()) {
+      WebContentsImpl& contents_impl = static_cast<WebContentsImpl&>(web_contents());
+      contents_impl.screen_orientation_dispatcher_host()->OnOrientationChange();
+    }
   }
 }
 
@@ -671,6 +695,7 @@ void EWebView::SetOrientationLockCallback(tizen_webview::Orientation_Lock_Cb fun
 }
 
 void EWebView::Show() {
+  RestorePendingSession();
   web_contents_->WasShown();
 }
 
@@ -985,6 +1010,56 @@ bool EWebView::ExecuteJavaScript(const char* script, tizen_webview::View_Script_
   return true;
 }
 
+void RegisteredScriptCallback::TriggerCallback(Evas_Object* obj, const std::string& result)
+{
+  if (callback_)
+    callback_(obj, result.c_str(), user_data_);
+}
+
+bool EWebView::ExecuteRegisteredScript(int script_id, tizen_webview::View_Script_Execute_Callback callback, void* userdata) {
+  if (!web_contents_)
+    return false;
+
+  RenderViewHost* render_view_host = web_contents_->GetRenderViewHost();
+  if (!render_view_host)
+    return false;
+
+  // Only the first execution in a renderer ships the script there.
+  if (!context_->GetImpl()->registered_scripts()->SendTo(
+          render_view_host->GetProcess(), script_id))
+    return false;
+
+  int callback_id = registered_script_callback_map_.Add(
+      new RegisteredScriptCallback(script_id, callback, userdata));
+  return render_view_host->Send(new EwkViewMsg_ExecuteRegisteredScript(
+      render_view_host->GetRoutingID(), script_id, callback_id));
+}
+
+void EWebView::InvokeRegisteredScriptCallback(int callback_id, const std::string& result,
+                                              base::TimeDelta compile_time,
+                                              base::TimeDelta compile_time_saved,
+                                              const std::vector<uint8>& code_cache) {
+  RegisteredScriptCallback* callback = registered_script_callback_map_.Lookup(callback_id);
+  if (!callback)
+    return;
+
+  int script_id = callback->script_id();
+  if (!code_cache.empty()) {
+    RenderViewHost* render_view_host = web_contents_->GetRenderViewHost();
+    context_->GetImpl()->registered_scripts()->SetCodeCache(script_id,
+        render_view_host->GetProcess()->GetID(), code_cache, compile_time);
+  }
+
+  UMA_HISTOGRAM_TIMES("EWK.RegisteredScript.CompileTime", compile_time);
+  UMA_HISTOGRAM_TIMES("EWK.RegisteredScript.CompileTimeSaved", compile_time_saved);
+  VLOG(1) << "Registered script " << script_id << " compiled in "
+          << compile_time.InMillisecondsF() << " ms, "
+          << compile_time_saved.InMillisecondsF() << " ms saved";
+
+  callback->TriggerCallback(evas_object(), result);
+  registered_script_callback_map_.Remove(callback_id);
+}
+
 #ifdef GCC_4_6_X
 #undef override
 #endif
@@ -1063,12 +1138,64 @@ tizen_webview::Frame* EWebView::GetMainFrame() {
 }
 
 void EWebView::UpdateWebKitPreferences() {
+  settings_dirty_ = true;
+  if (settings_transaction_depth_ > 0 || settings_flush_scheduled_)
+    return;
+
+  // Embedders usually call many setters in a row, send them all at once.
+  settings_flush_scheduled_ = true;
+  base::MessageLoop::current()->PostTask(FROM_HERE,
+      base::Bind(&EWebView::FlushWebKitPreferences,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void EWebView::BeginSettingsTransaction() {
+  ++settings_transaction_depth_;
+}
+
+void EWebView::CommitSettingsTransaction() {
+  if (!settings_transaction_depth_) {
+    LOG(WARNING) << "Settings transaction committed without begin";
+    return;
+  }
+  if (--settings_transaction_depth_ == 0)
+    FlushWebKitPreferences();
+}
+
+void EWebView::FlushWebKitPreferences() {
+  settings_flush_scheduled_ = false;
+  if (!settings_dirty_ || settings_transaction_depth_ > 0 || !settings_)
+    return;
+
   RenderViewHost* render_view_host = web_contents_->GetRenderViewHost();
   if (!render_view_host)
     return;
 
+  settings_dirty_ = false;
   web_contents_delegate_->OnUpdateSettings(settings_.get());
-  render_view_host->UpdateWebkitPreferences(settings_->getPreferences());
+
+  // Without a renderer there is nothing to update, the settings are folded
+  // into its initial preferences by ContentBrowserClientEfl and sent along
+  // in RenderViewCreated().
+  if (!render_view_host->IsRenderViewLive())
+    return;
+
+  WebPreferences preferences = render_view_host->GetWebkitPreferences();
+  settings_->applyPreferences(&preferences);
+  render_view_host->UpdateWebkitPreferences(preferences);
+  render_view_host->Send(
+      new EflViewMsg_UpdateSettings(render_view_host->GetRoutingID(),
+                                    settings_->getWebViewSettings()));
+}
+
+void EWebView::RenderViewCreated(RenderViewHost* render_view_host) {
+  InMemoryDataStoreEfl::GetInstance()->AddRenderView(
+      this, render_view_host->GetProcess()->GetID(),
+      render_view_host->GetRoutingID());
+
+  if (!settings_)
+    return;
+
   render_view_host->Send(
       new EflViewMsg_UpdateSettings(render_view_host->GetRoutingID(),
                                     settings_->getWebViewSettings()));
@@ -1093,26 +1220,46 @@ void EWebView::LoadData(const char* data, size_t size, const char* mime_type, co
   SetDefaultStringIfNull(base_uri, "about:blank");  // Webkit2 compatible
   SetDefaultStringIfNull(unreachable_uri, "");
 
-  std::string str_data = data;
-
-  if (size < str_data.length())
-    str_data = str_data.substr(0, size);
-
-  std::string url_str("data:");
-  url_str.append(mime_type);
-  url_str.append(";charset=");
-  url_str.append(encoding);
-  url_str.append(",");
-  url_str.append(str_data);
+  // Only NUL terminated strings come without a size, binary data has one.
+  if (size == std::string::npos)
+    size = data ? strlen(data) : 0;
+
+  // The only copy of the payload, the network stack reads it from the store
+  // instead of a data: URL that would also end up in the session history.
+  std::string payload(data ? data : "", size);
+  scoped_refptr<base::RefCountedString> buffer(
+      base::RefCountedString::TakeString(&payload));
+  InMemoryDataStoreEfl* store = InMemoryDataStoreEfl::GetInstance();
+  std::string token = store->Add(this, buffer, mime_type, encoding);
+  // Render views created later, e.g. for a cross-site base URL, are added in
+  // RenderViewCreated().
+  RenderViewHost* render_view_host = web_contents_->GetRenderViewHost();
+  if (render_view_host) {
+    store->AddRenderView(this, render_view_host->GetProcess()->GetID(),
+                         render_view_host->GetRoutingID());
+  }
 
-  NavigationController::LoadURLParams data_params(GURL(url_str.c_str()));
+  GURL base_url(base_uri);
+  NavigationController::LoadURLParams data_params(
+      InMemoryDataStoreEfl::GetURLForToken(token));
+  if (base_url.SchemeIsHTTPOrHTTPS() || base_url.SchemeIsFile()) {
+    // Commit under the base URL itself, so that relative URLs and the
+    // security origin are the same as with a data: URL and a base URL.
+    data_params.url = base_url;
+    data_params.extra_headers =
+        std::string(kInMemoryDataTokenHeader) + ": " + token;
+  }
+  data_params.should_replace_current_entry = false;
 
-  data_params.base_url_for_data_url = GURL(base_uri);
-  data_params.virtual_url_for_data_url = GURL(unreachable_uri);
+  RestorePendingSession();
+  FlushWebKitPreferences();
+  NavigationController& controller = web_contents_->GetController();
+  controller.LoadURLWithParams(data_params);
 
-  data_params.load_type = NavigationController::LOAD_TYPE_DATA;
-  data_params.should_replace_current_entry = false;
-  web_contents_->GetController().LoadURLWithParams(data_params);
+  GURL unreachable_url(unreachable_uri);
+  NavigationEntry* entry = controller.GetPendingEntry();
+  if (entry && unreachable_url.is_valid())
+    entry->SetVirtualURL(unreachable_url);
 }
 
 void EWebView::InvokeLoadError(const tizen_webview::Error &error) {
@@ -1126,18 +1273,12 @@ void EWebView::InvokeLoadError(const tizen_webview::Error &error) {
 
 void EWebView::ShowPopupMenu(const gfx::Rect& rect, blink::TextDirection textDirection, double pageScaleFactor, const std::vector<content::MenuItem>& items, int data, int selectedIndex, bool multiple) {
 #if defined(OS_TIZEN)
-  Eina_List* popupItems = 0;
-  const size_t size = items.size();
-  for (size_t i = 0; i < size; ++i) {
-    popupItems = eina_list_append(popupItems, Popup_Menu_Item::create(blink::WebPopupItem(blink::WebPopupItem::Type(items[i].type), base::UTF16ToUTF8(items[i].label), blink::TextDirection(items[i].rtl), items[i].has_directional_override, base::UTF16ToUTF8(items[i].tool_tip), base::UTF16ToUTF8(items[i].label), items[i].enabled, true, items[i].checked)).leakPtr());
-  }
-
-  ReleasePopupMenuList();
-  popupMenuItems_ = popupItems;
-
-  if (popupPicker_ && FormIsNavigating()) {
-    popupPicker_->multiSelect = multiple;
-    PopupMenuUpdate(popupMenuItems_, selectedIndex);
+  // The picker is still up when the renderer moves to another <select> or
+  // re-shows this one after its options changed, update it in place.
+  if (popupPicker_ && popup_menu_model_) {
+    PopupMenuModel::Diff diff;
+    popup_menu_model_->Update(items, &diff);
+    PopupMenuUpdate(diff, multiple ? 0 : selectedIndex, multiple);
     SetFormIsNavigating(false);
     return;
   }
@@ -1145,11 +1286,12 @@ void EWebView::ShowPopupMenu(const gfx::Rect& rect, blink::TextDirection textDir
   if (popupPicker_)
     popup_picker_del(popupPicker_);
   popupPicker_ = 0;
+  popup_menu_model_.reset(new PopupMenuModel(items));
 
   if (multiple)
-    popupPicker_ = popup_picker_new(this, evas_object(), popupMenuItems_, 0, multiple);
+    popupPicker_ = popup_picker_new(this, evas_object(), popup_menu_model_.get(), 0, multiple);
   else
-    popupPicker_ = popup_picker_new(this, evas_object(), popupMenuItems_, selectedIndex, multiple);
+    popupPicker_ = popup_picker_new(this, evas_object(), popup_menu_model_.get(), selectedIndex, multiple);
 
   popup_picker_buttons_update(popupPicker_, formNavigation_.position, formNavigation_.count, false);
 #endif
@@ -1197,16 +1339,16 @@ void EWebView::SetFormIsNavigating(bool formIsNavigating) {
 #endif
 }
 
-Eina_Bool EWebView::PopupMenuUpdate(Eina_List* items, int selectedIndex) {
 #if defined(OS_TIZEN)
+Eina_Bool EWebView::PopupMenuUpdate(const PopupMenuModel::Diff& diff, int selectedIndex, bool multiple) {
   if (!popupPicker_)
     return false;
 
-  popup_picker_update(evas_object(), popupPicker_, items, selectedIndex);
+  popup_picker_update(popupPicker_, diff, selectedIndex, multiple);
   popup_picker_buttons_update(popupPicker_, formNavigation_.position, formNavigation_.count, false);
-#endif
   return true;
 }
+#endif
 
 void EWebView::FormNavigate(bool direction) {
 #if defined(OS_TIZEN)
@@ -1231,13 +1373,13 @@ Eina_Bool EWebView::DidSelectPopupMenuItem(int selectedIndex) {
   if (!render_frame_host)
     return false;
 
-  if (!popupMenuItems_)
+  if (!popup_menu_model_)
     return false;
 
   //When user select empty space then no index is selected, so selectedIndex value is -1
   //In that case we should call valueChanged() with -1 index.That in turn call popupDidHide()
   //in didChangeSelectedIndex() for reseting the value of m_popupIsVisible in RenderMenuList.
-  if (selectedIndex != -1 && selectedIndex >= (int)eina_list_count(popupMenuItems_))
+  if (selectedIndex != -1 && selectedIndex >= (int)popup_menu_model_->size())
     return false;
 
   //In order to reuse RenderFrameHostImpl::DidSelectPopupMenuItems() method in Android,
@@ -1256,7 +1398,7 @@ Eina_Bool EWebView::DidMultipleSelectPopupMenuItem(std::vector<int>& selectedInd
   if (!render_frame_host)
     return false;
 
-  if (!popupMenuItems_)
+  if (!popup_menu_model_)
     return false;
 
   render_frame_host->DidSelectPopupMenuItems(selectedIndices);
@@ -1278,18 +1420,14 @@ Eina_Bool EWebView::PopupMenuClose() {
 // DJKim : FIXME
 #if 1//ENABLE(TIZEN_WEBKIT2_POPUP_INTERNAL)
   //ewk_view_touch_events_enabled_set(ewkView, true);
-  //releasePopupMenuList(popupMenuItems_);
-  if (!popupMenuItems_)
+  if (!popup_menu_model_)
     return false;
 
-  void* item;
-  EINA_LIST_FREE(popupMenuItems_, item)
-  delete static_cast<Popup_Menu_Item*>(item);
-  popupMenuItems_ = 0;
+  // Kept while navigating, the next <select> is diffed against it.
+  if (!popupPicker_)
+    popup_menu_model_.reset();
 #else
-  void* item;
-  EINA_LIST_FREE(popupMenuItems_, item)
-  delete static_cast<Popup_Menu_Item*>(item);
+  popup_menu_model_.reset();
 #endif
 
   RenderFrameHostImpl* render_frame_host = static_cast<RenderFrameHostImpl*>(web_contents_->GetMainFrame());
@@ -1340,6 +1478,26 @@ void EWebView::CancelContextMenu(int request_id) {
     context_menu_->HideContextMenu();
 }
 
+bool EWebView::RequestImageContentsAt(int x, int y, const GURL& image_url) {
+  RenderViewHost* render_view_host = web_contents_->GetRenderViewHost();
+  if (!render_view_host)
+    return false;
+
+  int view_x, view_y;
+  EvasToBlinkCords(x, y, &view_x, &view_y);
+  return render_view_host->Send(new EwkViewMsg_GetImageContentsAt(
+      render_view_host->GetRoutingID(), view_x, view_y, image_url));
+}
+
+void EWebView::OnImageContentsReceived(base::SharedMemoryHandle handle,
+                                       uint32 buffer_size,
+                                       const gfx::Size& size) {
+  if (context_menu_)
+    context_menu_->OnImageContentsReceived(handle, buffer_size, size);
+  else if (base::SharedMemory::IsHandleValid(handle))
+    base::SharedMemory::CloseHandle(handle);
+}
+
 void EWebView::Find(const char* text, tizen_webview::Find_Options find_options) {
   base::string16 find_text = base::UTF8ToUTF16(text);
   bool find_next = (previous_text_ == find_text);
@@ -1595,16 +1753,17 @@ void EWebView::EvasToBlinkCords(int x, int y, int* view_x, int* view_y) {
   Evas_Coord tmpX, tmpY;
   evas_object_geometry_get(evas_object_, &tmpX, &tmpY, NULL, NULL);
 
+  float device_scale_factor = gfx::Screen::GetNativeScreen()->
+      GetPrimaryDisplay().device_scale_factor();
+
   if (view_x) {
     *view_x = x - tmpX;
-    *view_x /= gfx::Screen::GetNativeScreen()->
-        GetPrimaryDisplay().device_scale_factor();
+    *view_x /= device_scale_factor;
   }
 
   if (view_y) {
     *view_y = y - tmpY;
-    *view_y /= gfx::Screen::GetNativeScreen()->
-        GetPrimaryDisplay().device_scale_factor();
+    *view_y /= device_scale_factor;
   }
 }
 
@@ -1650,10 +1809,38 @@ void EWebView::FindAndRunSnapshotCallback(Evas_Object* image, int snapshotId) {
   screen_capture_cb_map_.Remove(snapshotId);
 }
 
-bool EWebView::GetSnapshotAsync(Eina_Rectangle rect, Evas* canvas, tizen_webview::Web_App_Screenshot_Captured_Callback callback, void* user_data) {
- #ifdef OS_TIZEN
+bool EWebView::GetSnapshotAsync(Eina_Rectangle rect, float scale_factor, Evas* canvas, tizen_webview::Web_App_Screenshot_Captured_Callback callback, void* user_data) {
   if (!rwhv())
     return false;
+
+  // Scaled on the GPU from the composited page, which is also what makes
+  // thumbnails of many tabs cheap.
+  if (rwhv()->IsSurfaceAvailableForCopy()) {
+    gfx::Rect pixel_rect(rect.x, rect.y, rect.w, rect.h);
+    pixel_rect.Intersect(gfx::Rect(rwhv()->GetViewBoundsInPix().size()));
+    if (pixel_rect.IsEmpty())
+      return false;
+    float device_scale_factor = rwhv()->device_scale_factor();
+    gfx::Rect dip_rect = gfx::ToEnclosingRect(
+        gfx::ScaleRect(pixel_rect, 1.0f / device_scale_factor));
+    gfx::Size output_size =
+        gfx::ToCeiledSize(gfx::ScaleSize(pixel_rect.size(), scale_factor));
+
+    int snapshot_id = screen_capture_cb_map_.Add(
+        new WebAppScreenshotCapturedCallback(callback, user_data, canvas));
+    rwhv()->CopyFromCompositingSurface(dip_rect, output_size,
+        base::Bind(&EWebView::OnSnapshotCopied,
+                   weak_factory_.GetWeakPtr(), snapshot_id),
+        kN32_SkColorType);
+    return true;
+  }
+
+  if (!content::ZoomValuesEqual(scale_factor, 1.0)) {
+    LOG(ERROR) << "Scaled snapshots need the compositing surface of the view.";
+    return false;
+  }
+
+#ifdef OS_TIZEN
   int width = rect.w;
   int height = rect.h;
   int x = rect.x;
@@ -1671,15 +1858,50 @@ bool EWebView::GetSnapshotAsync(Eina_Rectangle rect, Evas* canvas, tizen_webview
   gfx::Rect rect1(x, y, width, height);
   rwhv()->GetSnapshotAsync(gfx::Rect(x, y, width, height), cbId);
   return true;
+#else
+  return false;
 #endif
 }
 
+void EWebView::OnSnapshotCopied(int snapshot_id, bool success,
+                                const SkBitmap& bitmap) {
+  WebAppScreenshotCapturedCallback* callback =
+      screen_capture_cb_map_.Lookup(snapshot_id);
+  if (!callback)
+    return;
+
+  Evas_Object* image = NULL;
+  if (success) {
+    SkAutoLockPixels lock(bitmap);
+    image = evas_object_image_filled_add(callback->canvas());
+    evas_object_image_size_set(image, bitmap.width(), bitmap.height());
+    evas_object_image_data_copy_set(image, bitmap.getPixels());
+  }
+  FindAndRunSnapshotCallback(image, snapshot_id);
+}
+
 void EWebView::GetSnapShotForRect(gfx::Rect& rect) {
 #ifdef OS_TIZEN
   rwhv()->GetSnapshotForRect(rect);
 #endif
 }
 
+bool EWebView::AttachMagnifierImage(Evas_Object* image, const gfx::Size& size) {
+#ifdef OS_TIZEN
+  return rwhv() && rwhv()->AttachMagnifier(image, size);
+#else
+  return false;
+#endif
+}
+
+bool EWebView::UpdateMagnifierImage(const gfx::Rect& rect) {
+#ifdef OS_TIZEN
+  return rwhv() && rwhv()->SetMagnifierSourceRect(rect);
+#else
+  return false;
+#endif
+}
+
 Evas_Object* EWebView::GetSnapshot(Eina_Rectangle rect) {
   Evas_Object* image = NULL;
 #ifdef OS_TIZEN
@@ -1717,6 +1939,7 @@ Evas_Object* EWebView::GetSnapshot(Eina_Rectangle rect) {
 }
 
 void EWebView::BackForwardListClear() {
+  RestorePendingSession();
   content::NavigationController& controller = web_contents_->GetController();
 
   int entry_count = controller.GetEntryCount();
@@ -1737,6 +1960,7 @@ void EWebView::BackForwardListClear() {
 }
 
 tizen_webview::BackForwardList* EWebView::GetBackForwardList() const {
+  RestorePendingSession();
   return back_forward_list_.get();
 }
 
@@ -1745,6 +1969,7 @@ void EWebView::InvokeBackForwardListChangedCallback() {
 }
 
 tizen_webview::BackForwardHistory* EWebView::GetBackForwardHistory() const {
+  RestorePendingSession();
   return new tizen_webview::BackForwardHistory(web_contents_->GetController());
 }
 
@@ -1868,17 +2093,133 @@ double EWebView::GetProgressValue() {
 }
 
 const char* EWebView::GetTitle() {
+  if (session_store_->HasPendingRestore()) {
+    title_ = UTF16ToUTF8(session_store_->GetPendingTitle());
+    return title_.c_str();
+  }
   title_ = UTF16ToUTF8(web_contents_->GetTitle());
   return title_.c_str();
 }
 
+void EwkViewPdfExportCallback::TriggerProgressCallback(Evas_Object* obj, int pages_printed, int page_count)
+{
+  if (progress_callback_)
+    (progress_callback_)(obj, pages_printed, page_count, user_data_);
+}
+
+void EwkViewPdfExportCallback::TriggerFinishedCallback(Evas_Object* obj, tizen_webview::Pdf_Export_Status status)
+{
+  if (finished_callback_)
+    (finished_callback_)(obj, status, user_data_);
+}
+
 bool EWebView::SaveAsPdf(int width, int height, const std::string& filename) {
+  return SaveAsPdf(width, height, 0, -1, filename, NULL, NULL, NULL);
+}
+
+bool EWebView::SaveAsPdf(int width, int height, int first_page, int last_page,
+                         const std::string& filename,
+                         tizen_webview::View_Pdf_Export_Progress_Callback progress_callback,
+                         tizen_webview::View_Pdf_Export_Finished_Callback finished_callback,
+                         void* user_data) {
+  if (pdf_export_callback_ || !web_contents_->GetRenderViewHost())
+    return false;
+
+  PdfExportParams params;
+  params.job_id = ++pdf_export_job_id_counter_;
+  params.page_size.SetSize(width, height);
+  params.first_page = first_page;
+  params.last_page = last_page;
+  base::FilePath file_path(filename);
+  pdf_export_callback_.reset(new EwkViewPdfExportCallback(params.job_id,
+      file_path, progress_callback, finished_callback, user_data));
+
+  // The renderer can not open files, so the browser creates the target and
+  // hands the descriptor over once it is ready.
+  BrowserThread::PostTaskAndReplyWithResult(BrowserThread::FILE, FROM_HERE,
+      base::Bind(&OpenPdfFile, file_path),
+      base::Bind(&EWebView::OnPdfFileOpened, weak_factory_.GetWeakPtr(),
+                 params, file_path));
+  return true;
+}
+
+void EWebView::OnPdfFileOpened(const PdfExportParams& params,
+                               const base::FilePath& file_path,
+                               base::File file) {
+  if (!pdf_export_callback_ || pdf_export_callback_->job_id() != params.job_id) {
+    // Cancelled while the file was being opened, it is deleted already.
+    BrowserThread::PostTask(BrowserThread::FILE, FROM_HERE,
+        base::Bind(&ClosePdfFile, base::Passed(&file)));
+    return;
+  }
+
   RenderViewHost* render_view_host = web_contents_->GetRenderViewHost();
-  if (!render_view_host)
+  if (!file.IsValid() || !render_view_host) {
+    if (file.IsValid()) {
+      BrowserThread::PostTask(BrowserThread::FILE, FROM_HERE,
+          base::Bind(&DiscardPdfFile, base::Passed(&file), file_path));
+    }
+    OnPdfExportFinished(params.job_id, TW_PDF_EXPORT_FAILED);
+    return;
+  }
+
+  IPC::PlatformFileForTransit transit = IPC::TakeFileHandleForProcess(
+      file.Pass(), render_view_host->GetProcess()->GetHandle());
+  pdf_export_callback_->set_sent_to_renderer();
+  if (!render_view_host->Send(new EwkViewMsg_PrintToPdf(
+          render_view_host->GetRoutingID(), params, transit))) {
+    OnPdfExportFinished(params.job_id, TW_PDF_EXPORT_FAILED);
+  }
+}
+
+bool EWebView::CancelPdfExport() {
+  if (!pdf_export_callback_)
     return false;
 
-  return render_view_host->Send(new EwkViewMsg_PrintToPdf(render_view_host->GetRoutingID(),
-      width, height, base::FilePath(filename)));
+  // Once the renderer owns the job it reports the cancellation itself.
+  RenderViewHost* render_view_host = web_contents_->GetRenderViewHost();
+  int job_id = pdf_export_callback_->job_id();
+  if (!pdf_export_callback_->sent_to_renderer() || !render_view_host ||
+      !render_view_host->Send(new EwkViewMsg_CancelPdfExport(
+          render_view_host->GetRoutingID(), job_id))) {
+    OnPdfExportFinished(job_id, TW_PDF_EXPORT_CANCELLED);
+  }
+  return true;
+}
+
+void EWebView::OnPdfExportProgress(int job_id, int pages_printed, int page_count) {
+  if (!pdf_export_callback_ || pdf_export_callback_->job_id() != job_id)
+    return;
+  pdf_export_callback_->TriggerProgressCallback(evas_object(), pages_printed, page_count);
+}
+
+void EWebView::OnPdfExportFinished(int job_id, tizen_webview::Pdf_Export_Status status) {
+  if (!pdf_export_callback_ || pdf_export_callback_->job_id() != job_id)
+    return;
+  // Released right away so that another export may start, and reported
+  // from a task of its own so that CancelPdfExport() never calls back into
+  // the client. The file of an export that did not complete is deleted
+  // before; the FILE thread gets to it after OpenPdfFile() even when the
+  // export is cancelled while the file is being opened.
+  scoped_ptr<EwkViewPdfExportCallback> callback(pdf_export_callback_.Pass());
+  bool delete_file = status == TW_PDF_EXPORT_CANCELLED ||
+      (status != TW_PDF_EXPORT_SUCCEEDED && callback->sent_to_renderer());
+  base::FilePath file_path = callback->file_path();
+  base::Closure notify = base::Bind(&EWebView::NotifyPdfExportFinished,
+      weak_factory_.GetWeakPtr(), base::Passed(&callback), status);
+  if (delete_file) {
+    BrowserThread::PostTaskAndReply(BrowserThread::FILE, FROM_HERE,
+        base::Bind(base::IgnoreResult(&base::DeleteFile), file_path, false),
+        notify);
+  } else {
+    base::MessageLoop::current()->PostTask(FROM_HERE, notify);
+  }
+}
+
+void EWebView::NotifyPdfExportFinished(
+    scoped_ptr<EwkViewPdfExportCallback> callback,
+    tizen_webview::Pdf_Export_Status status) {
+  callback->TriggerFinishedCallback(evas_object(), status);
 }
 
 bool EWebView::GetMHTMLData(tizen_webview::View_MHTML_Data_Get_Callback callback, void* user_data) {
@@ -1974,65 +2315,19 @@ void EWebView::SetDrawsTransparentBackground(bool enabled) {
 }
 
 void EWebView::GetSessionData(const char **data, unsigned *length) const {
-  static const int MAX_SESSION_ENTRY_SIZE = std::numeric_limits<int>::max();
-
-  NavigationController &navigationController = web_contents_->GetController();
-  Pickle sessionPickle;
-  const int itemCount = navigationController.GetEntryCount();
-
-  sessionPickle.WriteInt(itemCount);
-  sessionPickle.WriteInt(navigationController.GetCurrentEntryIndex());
-
-  for (int i = 0; i < itemCount; i++) {
-    NavigationEntry *navigationEntry = navigationController.GetEntryAtIndex(i);
-    sessions::SerializedNavigationEntry serializedEntry =
-      sessions::ContentSerializedNavigationBuilder::FromNavigationEntry(i, *navigationEntry);
-    serializedEntry.WriteToPickle(MAX_SESSION_ENTRY_SIZE, &sessionPickle);
-  }
+  session_store_->GetSessionData(data, length);
+}
 
-  *data = static_cast<char *>(malloc(sizeof(char) * sessionPickle.size()));
-  memcpy(const_cast<char *>(*data), sessionPickle.data(), sessionPickle.size());
-  *length = sessionPickle.size();
+bool EWebView::WriteSessionData(int fd, int flags) const {
+  return session_store_->WriteSnapshot(fd, flags);
 }
 
 bool EWebView::RestoreFromSessionData(const char *data, unsigned length) {
-  Pickle sessionPickle(data, length);
-  PickleIterator pickleIterator(sessionPickle);
-  int entryCount;
-  int currentEntry;
-
-  if (!pickleIterator.ReadInt(&entryCount))
-    return false;
-  if (!pickleIterator.ReadInt(&currentEntry))
-    return false;
-
-  std::vector<sessions::SerializedNavigationEntry> serializedEntries;
-  serializedEntries.resize(entryCount);
-  for (int i = 0; i < entryCount; ++i) {
-    if (!serializedEntries.at(i).ReadFromPickle(&pickleIterator))
-      return false;
-  }
-
-  if (!entryCount)
-    return true;
-
-  ScopedVector<content::NavigationEntry> scopedEntries =
-    sessions::ContentSerializedNavigationBuilder::ToNavigationEntries(serializedEntries, context()->browser_context());
-  std::vector<NavigationEntry *> navigationEntries;
-  scopedEntries.release(&navigationEntries);
-
-  NavigationController &navigationController = web_contents_->GetController();
-
-  if (currentEntry < 0)
-    currentEntry = 0;
-
-  if (currentEntry >= static_cast<int>(navigationEntries.size()))
-    currentEntry = navigationEntries.size() - 1;
+  return session_store_->Restore(data, length);
+}
 
-  navigationController.Restore(currentEntry,
-                               NavigationController::RESTORE_LAST_SESSION_EXITED_CLEANLY,
-                               &navigationEntries);
-  return true;
+void EWebView::RestorePendingSession() const {
+  session_store_->RestoreIfPending();
 }
 
 void EWebView::SetBrowserFont() {
@@ -2150,6 +2445,8 @@ bool EWebView::StopInspectorServer() {
 }
 
 void EWebView::HandleRendererProcessCrash() {
+  if (pdf_export_callback_)
+    OnPdfExportFinished(pdf_export_callback_->job_id(), TW_PDF_EXPORT_FAILED);
   InitializeContent();
 }
 
@@ -2170,17 +2467,27 @@ void EWebView::InitializeContent() {
     CHECK(width > 0 && height > 0);
   }
 
-  WebContents::CreateParams params(context_->browser_context());
+  // A spare renderer of the context, if any, is already launched and
+  // initialized. Without one a new site instance launches its own.
+  scoped_refptr<content::SiteInstance> site_instance =
+      context_->GetImpl()->ClaimSpareRenderer();
+  WebContents::CreateParams params(context_->browser_context(),
+                                   site_instance.get());
   params.context = GetContentImageObject();
   params.initial_size = gfx::Size(width, height);
   web_contents_.reset(WebContents::Create(params));
   web_contents_delegate_.reset(new WebContentsDelegateEfl(this));
   web_contents_->SetDelegate(web_contents_delegate_.get());
+  if (site_instance.get()) {
+    site_instance->GetProcess()->AddFilter(
+        new tizen_webview::WebViewBrowserMessageFilter(web_contents_.get()));
+  }
   back_forward_list_.reset(new tizen_webview::BackForwardList(
       web_contents_->GetController()));
 
   back_forward_list_.reset(
     new tizen_webview::BackForwardList(web_contents_->GetController()));
+  session_store_.reset(new SessionStoreEfl(web_contents_.get()));
 
   LOG(INFO) << "Initial WebContents size: " << params.initial_size.ToString();
 }
@@ -2279,10 +2586,13 @@ void EWebView::UrlRequestSet(const char* url,
     eina_iterator_free(it);
   }
 
+  RestorePendingSession();
+  FlushWebKitPreferences();
   web_contents_->GetController().LoadURLWithParams(params);
 }
 
 bool EWebView::HandleShow() {
+  RestorePendingSession();
   if (rwhv()) {
     rwhv()->HandleShow();
     return true;
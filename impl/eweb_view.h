@@ -18,8 +18,12 @@
 #include <Evas.h>
 #include <locale.h>
 
+#include "base/files/file.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "base/memory/weak_ptr.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/time/time.h"
 #include "content/public/common/context_menu_params.h"
 #include "content/public/common/file_chooser_params.h"
 #include "content/browser/renderer_host/event_with_latency_info.h"
@@ -54,6 +58,7 @@
 #endif
 
 #if defined(OS_TIZEN)
+#include "browser/selectpicker/popup_menu_model.h"
 #include "browser/selectpicker/popup_picker.h"
 #endif
 
@@ -95,6 +100,8 @@ class PolicyDecision;
 class Error;
 }
 
+struct PdfExportParams;
+
 class WebAppScreenshotCapturedCallback : public base::RefCounted<WebAppScreenshotCapturedCallback> {
  public:
       WebAppScreenshotCapturedCallback(tizen_webview::Web_App_Screenshot_Captured_Callback func, void *user_data, Evas* canvas)
@@ -103,6 +110,7 @@ class WebAppScreenshotCapturedCallback : public base::RefCounted<WebAppScreensho
     if (func_ != NULL)
       (func_)(image, user_data_);
   }
+  Evas* canvas() const { return canvas_; }
 
  private:
   tizen_webview::Web_App_Screenshot_Captured_Callback func_;
@@ -123,6 +131,49 @@ class EwkViewPlainTextGetCallback {
   void* user_data_;
 };
 
+class EwkViewPdfExportCallback {
+ public:
+  EwkViewPdfExportCallback(int job_id,
+                           const base::FilePath& file_path,
+                           tizen_webview::View_Pdf_Export_Progress_Callback progress_callback,
+                           tizen_webview::View_Pdf_Export_Finished_Callback finished_callback,
+                           void* user_data)
+    : job_id_(job_id), file_path_(file_path), sent_to_renderer_(false),
+      progress_callback_(progress_callback),
+      finished_callback_(finished_callback), user_data_(user_data)
+    { }
+  int job_id() const { return job_id_; }
+  const base::FilePath& file_path() const { return file_path_; }
+  bool sent_to_renderer() const { return sent_to_renderer_; }
+  void set_sent_to_renderer() { sent_to_renderer_ = true; }
+  void TriggerProgressCallback(Evas_Object* obj, int pages_printed, int page_count);
+  void TriggerFinishedCallback(Evas_Object* obj, tizen_webview::Pdf_Export_Status status);
+
+ private:
+  int job_id_;
+  base::FilePath file_path_;
+  bool sent_to_renderer_;
+  tizen_webview::View_Pdf_Export_Progress_Callback progress_callback_;
+  tizen_webview::View_Pdf_Export_Finished_Callback finished_callback_;
+  void* user_data_;
+};
+
+class RegisteredScriptCallback {
+ public:
+  RegisteredScriptCallback(int script_id,
+                           tizen_webview::View_Script_Execute_Callback callback,
+                           void* user_data)
+    : script_id_(script_id), callback_(callback), user_data_(user_data)
+    { }
+  int script_id() const { return script_id_; }
+  void TriggerCallback(Evas_Object* obj, const std::string& result);
+
+ private:
+  int script_id_;
+  tizen_webview::View_Script_Execute_Callback callback_;
+  void* user_data_;
+};
+
 class OrientationLockCallback {
  public:
   OrientationLockCallback(tizen_webview::Orientation_Lock_Cb lock,
@@ -221,6 +272,7 @@ private:
   void* user_data_;
 };
 
+class SessionStoreEfl;
 class WebViewAsyncRequestHitTestDataCallback;
 class JavaScriptDialogManagerEfl;
 class WebViewGeolocationPermissionCallback;
@@ -284,6 +336,11 @@ class EWebView {
   void Show();
   void Hide();
   bool ExecuteJavaScript(const char* script, tizen_webview::View_Script_Execute_Callback callback, void* userdata);
+  bool ExecuteRegisteredScript(int script_id, tizen_webview::View_Script_Execute_Callback callback, void* userdata);
+  void InvokeRegisteredScriptCallback(int callback_id, const std::string& result,
+                                      base::TimeDelta compile_time,
+                                      base::TimeDelta compile_time_saved,
+                                      const std::vector<uint8>& code_cache);
   bool SetUserAgent(const char* userAgent);
   bool SetUserAgentAppName(const char* application_name);
   const char* GetUserAgent() const;
@@ -291,8 +348,16 @@ class EWebView {
   const char* GetSelectedText() const;
   bool IsLastAvailableTextEmpty() const;
   Ewk_Settings* GetSettings();
+  // Returns NULL instead of creating the settings.
+  Ewk_Settings* settings() const { return settings_.get(); }
   tizen_webview::Frame* GetMainFrame();
+  // Settings changes are pushed to the renderer once per main loop
+  // iteration, or when the outermost transaction is committed.
   void UpdateWebKitPreferences();
+  void BeginSettingsTransaction();
+  void CommitSettingsTransaction();
+  // Sends the settings to a newly created renderer.
+  void RenderViewCreated(content::RenderViewHost* render_view_host);
   void LoadHTMLString(const char* html, const char* base_uri, const char* unreachable_uri);
   void LoadPlainTextString(const char* plain_text);
   void LoadData(const char* data, size_t size, const char* mime_type, const char* encoding, const char* base_uri, const char* unreachable_uri = NULL);
@@ -310,7 +375,9 @@ class EWebView {
   void CloseSelectPicker();
   bool FormIsNavigating() const { return formIsNavigating_; }
   void SetFormIsNavigating(bool formIsNavigating);
-  Eina_Bool PopupMenuUpdate(Eina_List* items, int selectedIndex);
+#if defined(OS_TIZEN)
+  Eina_Bool PopupMenuUpdate(const PopupMenuModel::Diff& diff, int selectedIndex, bool multiple);
+#endif
   Eina_Bool DidSelectPopupMenuItem(int selectedIndex);
   Eina_Bool DidMultipleSelectPopupMenuItem(std::vector<int>& selectedIndices);
   Eina_Bool PopupMenuClose();
@@ -319,6 +386,11 @@ class EWebView {
       content::ContextMenuType type = content::MENU_TYPE_LINK,
       bool show_selection = true);
   void CancelContextMenu(int request_id);
+  // Asks the renderer for the decoded image of |image_url| at the given evas
+  // position, the context menu receives the answer.
+  bool RequestImageContentsAt(int x, int y, const GURL& image_url);
+  void OnImageContentsReceived(base::SharedMemoryHandle handle,
+                               uint32 buffer_size, const gfx::Size& size);
   void SetScale(double scale_factor, int x, int y);
   bool GetScrollPosition(int* x, int* y) const;
   void SetScroll(int x, int y);
@@ -340,6 +412,10 @@ class EWebView {
   bool GetSelectionRange(Eina_Rectangle* left_rect, Eina_Rectangle* right_rect);
   bool ClearSelection();
   void GetSnapShotForRect(gfx::Rect& rect);
+  // Let |image| of |size| show a part of the page straight from the
+  // compositor, see RenderWidgetHostViewEfl::AttachMagnifier().
+  bool AttachMagnifierImage(Evas_Object* image, const gfx::Size& size);
+  bool UpdateMagnifierImage(const gfx::Rect& rect);
 
   // Callback OnCopyFromBackingStore will be called once we get the snapshot from render
   void OnCopyFromBackingStore(bool success, const SkBitmap& bitmap);
@@ -355,7 +431,7 @@ class EWebView {
   Evas_Object* GetSnapshot(Eina_Rectangle rect);
   void set_policy_decision(tizen_webview::PolicyDecision* pr) { policy_decision_.reset(pr); }
   tizen_webview::PolicyDecision* get_policy_decision() const { return policy_decision_.get(); }
-  bool GetSnapshotAsync(Eina_Rectangle rect, Evas* canvas, tizen_webview::Web_App_Screenshot_Captured_Callback callback, void* user_data);
+  bool GetSnapshotAsync(Eina_Rectangle rect, float scale_factor, Evas* canvas, tizen_webview::Web_App_Screenshot_Captured_Callback callback, void* user_data);
   void InvokePolicyResponseCallback(tizen_webview::PolicyDecision* policy_decision);
   void InvokePolicyNavigationCallback(content::RenderViewHost* rvh,
       NavigationPolicyParams params, bool* handled);
@@ -390,6 +466,17 @@ class EWebView {
   double GetProgressValue();
   const char* GetTitle();
   bool SaveAsPdf(int width, int height, const std::string& file_name);
+  // Exports the zero based, inclusive page range [first_page, last_page],
+  // last_page < 0 exports up to the end of the document. Only one export per
+  // view may run at a time.
+  bool SaveAsPdf(int width, int height, int first_page, int last_page,
+                 const std::string& file_name,
+                 tizen_webview::View_Pdf_Export_Progress_Callback progress_callback,
+                 tizen_webview::View_Pdf_Export_Finished_Callback finished_callback,
+                 void* user_data);
+  bool CancelPdfExport();
+  void OnPdfExportProgress(int job_id, int pages_printed, int page_count);
+  void OnPdfExportFinished(int job_id, tizen_webview::Pdf_Export_Status status);
   void BackForwardListClear();
   tizen_webview::BackForwardList* GetBackForwardList() const;
   void InvokeBackForwardListChangedCallback();
@@ -421,7 +508,11 @@ class EWebView {
   void DidChangePageScaleRange(double min_scale, double max_scale);
   void SetDrawsTransparentBackground(bool enabled);
   void GetSessionData(const char **data, unsigned *length) const;
+  // Writes a record of the session, |flags| are SessionStoreEfl::WriteFlags.
+  bool WriteSessionData(int fd, int flags) const;
+  // The history is restored once the view is shown or navigated.
   bool RestoreFromSessionData(const char *data, unsigned length);
+  void RestorePendingSession() const;
   void ShowFileChooser(const content::FileChooserParams&);
   void DidChangeContentsArea(int width, int height);
   void SetBrowserFont();
@@ -492,10 +583,7 @@ class EWebView {
 #endif
   content::RenderWidgetHostViewEfl* rwhv() const;
   JavaScriptDialogManagerEfl* GetJavaScriptDialogManagerEfl();
-
-#if defined(OS_TIZEN)
-  void ReleasePopupMenuList();
-#endif
+  void OnSnapshotCopied(int snapshot_id, bool success, const SkBitmap& bitmap);
 
   // For popup windows the WebContents is created internally and we need to associate it with the
   // new view created by the embedder. We set this before calling the "create,window" callback and
@@ -522,7 +610,7 @@ class EWebView {
   scoped_ptr<_Ewk_Auth_Challenge> auth_challenge_;
   scoped_ptr<tizen_webview::PolicyDecision> policy_decision_;
 #if defined(OS_TIZEN)
-  Eina_List* popupMenuItems_;
+  scoped_ptr<PopupMenuModel> popup_menu_model_;
   Popup_Picker* popupPicker_;
 #endif
   bool formIsNavigating_;
@@ -543,6 +631,9 @@ class EWebView {
   int current_find_request_id_;
   static int find_request_id_counter_;
   IDMap<EwkViewPlainTextGetCallback, IDMapOwnPointer> plain_text_get_callback_map_;
+  scoped_ptr<EwkViewPdfExportCallback> pdf_export_callback_;
+  static int pdf_export_job_id_counter_;
+  IDMap<RegisteredScriptCallback, IDMapOwnPointer> registered_script_callback_map_;
   gfx::Size contents_size_;
   double progress_;
   mutable std::string title_;
@@ -571,8 +662,18 @@ class EWebView {
   bool is_initialized_;
 
   scoped_ptr<tizen_webview::BackForwardList> back_forward_list_;
+  scoped_ptr<SessionStoreEfl> session_store_;
 
 private:
+  // Sends the settings changed since the last flush, unless a settings
+  // transaction holds them. Also called before every navigation the view
+  // starts, so that it does not run with the settings of the previous one.
+  void FlushWebKitPreferences();
+  void OnPdfFileOpened(const PdfExportParams& params,
+                       const base::FilePath& file_path, base::File file);
+  void NotifyPdfExportFinished(scoped_ptr<EwkViewPdfExportCallback> callback,
+                               tizen_webview::Pdf_Export_Status status);
+
   Eina_Bool AsyncRequestHitTestPrivate(
       int x, int y, tizen_webview::Hit_Test_Mode mode,
       AsyncHitTestRequest* asyncHitTestRequest);
@@ -580,6 +681,12 @@ private:
   gfx::Vector2d previous_scroll_position_;
 
   std::map<int64_t, WebViewAsyncRequestHitTestDataCallback*> hit_test_callback_;
+
+  int settings_transaction_depth_;
+  bool settings_dirty_;
+  bool settings_flush_scheduled_;
+  base::WeakPtrFactory<EWebView> weak_factory_;
+
   // only tizen_webview::WebView can create and delete this
   EWebView(tizen_webview::WebView* owner, tizen_webview::WebContext*, Evas_Object* smart_object);
   ~EWebView();
@@ -4,11 +4,14 @@
 
 #include "ewk_global_data.h"
 
+#include "base/bind.h"
 #include "base/cpu.h"
+#include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/path_service.h"
 #include "base/message_loop/message_loop.h"
 #include "content/browser/gpu/gpu_process_host.h"
+#include "content/common/gpu/gpu_process_launch_causes.h"
 #include "content/gpu/in_process_gpu_thread.h"
 #include "content/public/app/content_main_runner.h"
 #include "content/public/browser/browser_main_runner.h"
@@ -16,6 +19,7 @@
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/utility_process_host.h"
 #include "content/public/common/content_switches.h"
+#include "content/public/common/main_function_params.h"
 #include "content/public/app/content_main.h"
 #include "content/renderer/in_process_renderer_thread.h"
 #include "content/utility/in_process_utility_thread.h"
@@ -55,32 +59,99 @@ scoped_ptr<base::MessagePump> MessagePumpFactory() {
 
 EwkGlobalData::EwkGlobalData()
   : content_main_runner_(ContentMainRunner::Create())
-  , browser_main_runner_(BrowserMainRunner::Create()) {
+  , browser_main_runner_(BrowserMainRunner::Create())
+  , stage_(STAGE_NONE)
+  , prewarm_idler_(NULL) {
 }
 
 EwkGlobalData::~EwkGlobalData() {
-  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
-  // We need to pretend that message loop was stopped so chromium unwinds correctly
-  MessageLoop *loop = MessageLoop::current();
-  loop->QuitNow();
+  if (prewarm_idler_)
+    ecore_idler_del(prewarm_idler_);
+
+  if (stage_ >= STAGE_BROWSER_MAIN) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+    // We need to pretend that message loop was stopped so chromium unwinds correctly
+    MessageLoop *loop = MessageLoop::current();
+    loop->QuitNow();
+  }
   // browser_main_runner must be deleted first as it depends on content_main_runner
   delete browser_main_runner_;
   delete content_main_runner_;
 }
 
 EwkGlobalData* EwkGlobalData::GetInstance() {
-  if (instance_) {
+  if (instance_ && instance_->stage_ >= STAGE_RESOURCES) {
     CHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::UI));
     return instance_;
   }
 
+  if (!instance_)
+    instance_ = new EwkGlobalData();
+
+  // Finishes what a pending Prewarm() did not get to yet.
+  while (instance_->stage_ < STAGE_RESOURCES)
+    instance_->RunNextStage();
+
+  return instance_;
+}
+
+void EwkGlobalData::Prewarm(const base::Closure& done) {
+  if (!instance_)
+    instance_ = new EwkGlobalData();
+
+  if (!done.is_null())
+    instance_->prewarm_callbacks_.push_back(done);
+  if (!instance_->prewarm_idler_)
+    instance_->prewarm_idler_ = ecore_idler_add(PrewarmIdler, instance_);
+}
+
+Eina_Bool EwkGlobalData::PrewarmIdler(void* data) {
+  EwkGlobalData* self = static_cast<EwkGlobalData*>(data);
+  if (self->stage_ < STAGE_GPU) {
+    self->RunNextStage();
+    return ECORE_CALLBACK_RENEW;
+  }
+
+  self->prewarm_idler_ = NULL;
+  std::vector<base::Closure> callbacks;
+  callbacks.swap(self->prewarm_callbacks_);
+  for (size_t i = 0; i < callbacks.size(); ++i)
+    callbacks[i].Run();
+  return ECORE_CALLBACK_CANCEL;
+}
+
+void EwkGlobalData::RunNextStage() {
+  switch (stage_) {
+    case STAGE_NONE:
+      InitializeContentMain();
+      stage_ = STAGE_CONTENT_MAIN;
+      break;
+    case STAGE_CONTENT_MAIN:
+      InitializeBrowserMain();
+      stage_ = STAGE_BROWSER_MAIN;
+      break;
+    case STAGE_BROWSER_MAIN:
+      InitializeResources();
+      stage_ = STAGE_RESOURCES;
+      break;
+    case STAGE_RESOURCES:
+      LaunchGpu();
+      stage_ = STAGE_GPU;
+      break;
+    case STAGE_GPU:
+      NOTREACHED();
+      break;
+  }
+}
+
+void EwkGlobalData::InitializeContentMain() {
+  TRACE_EVENT0("startup", "EwkGlobalData::InitializeContentMain");
+
   // Workaround for cpu info logging asserting if executed on the wrong thread
   // during cpu info lazy instance initialization.
   base::CPU cpu;
   DCHECK(cpu.cpu_brand() != "");
 
-  instance_ = new EwkGlobalData();
-
   bool message_pump_overridden =
       base::MessageLoop::InitMessagePumpForUIFactory(&MessagePumpFactory);
   DCHECK(message_pump_overridden);
@@ -94,19 +165,30 @@ EwkGlobalData* EwkGlobalData::GetInstance() {
   // Call to CommandLineEfl::GetDefaultPortParams() should be before content
   // main runner initialization in order to pass command line parameters
   // for current process that are used in content main runner initialization.
-  content::MainFunctionParams main_funtion_params =
-      CommandLineEfl::GetDefaultPortParams();
+  main_function_params_.reset(
+      new content::MainFunctionParams(CommandLineEfl::GetDefaultPortParams()));
+
+  content_main_runner_->Initialize(params);
+}
+
+void EwkGlobalData::InitializeBrowserMain() {
+  TRACE_EVENT0("startup", "EwkGlobalData::InitializeBrowserMain");
 
-  instance_->content_main_runner_->Initialize(params);
-  instance_->browser_main_runner_->Initialize(main_funtion_params);
+  browser_main_runner_->Initialize(*main_function_params_);
+  main_function_params_.reset();
+}
 
+void EwkGlobalData::InitializeResources() {
   base::ThreadRestrictions::SetIOAllowed(true);
 
-  base::FilePath pak_dir;
-  base::FilePath pak_file;
-  PathService::Get(base::DIR_EXE, &pak_dir);
-  pak_file = pak_dir.Append(FILE_PATH_LITERAL("content_shell.pak"));
-  ui::ResourceBundle::InitSharedInstanceWithPakPath(pak_file);
+  {
+    TRACE_EVENT0("startup", "EwkGlobalData::LoadResourceBundle");
+    base::FilePath pak_dir;
+    base::FilePath pak_file;
+    PathService::Get(base::DIR_EXE, &pak_dir);
+    pak_file = pak_dir.Append(FILE_PATH_LITERAL("content_shell.pak"));
+    ui::ResourceBundle::InitSharedInstanceWithPakPath(pak_file);
+  }
 
   if (CommandLine::ForCurrentProcess()->HasSwitch(switches::kSingleProcess)) {
     content::UtilityProcessHostImpl::RegisterUtilityMainThreadFactory(
@@ -128,8 +210,15 @@ EwkGlobalData* EwkGlobalData::GetInstance() {
   if (!EflAssistHandle)
     EflAssistHandle = dlopen("/usr/lib/libefl-assist.so.0", RTLD_LAZY);
 #endif
+}
 
-  return instance_;
+void EwkGlobalData::LaunchGpu() {
+  // The GPU process, or thread in single process mode, is otherwise only
+  // launched when the compositor of the first view asks for a channel.
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(base::IgnoreResult(&GpuProcessHost::Get),
+                 GpuProcessHost::GPU_PROCESS_KIND_SANDBOXED,
+                 content::CAUSE_FOR_GPU_LAUNCH_BROWSER_STARTUP));
 }
 
 void EwkGlobalData::Delete()
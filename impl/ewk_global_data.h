@@ -5,11 +5,18 @@
 #ifndef EWK_GLOBAL_DATA_H_
 #define EWK_GLOBAL_DATA_H_
 
+#include <vector>
+
+#include <Ecore.h>
+
+#include <base/callback.h>
 #include <base/macros.h>
+#include <base/memory/scoped_ptr.h>
 
 namespace content {
   class BrowserMainRunner;
   class ContentMainRunner;
+  struct MainFunctionParams;
 }
 
 class EwkGlobalData
@@ -18,14 +25,44 @@ class EwkGlobalData
   static EwkGlobalData* GetInstance();
   static void Delete();
 
+  // Runs the initialization GetInstance() does in stages, one per idle
+  // round of the main loop, and then starts the GPU process so that the
+  // first view does not wait for it. |done| runs on the main loop once all
+  // stages ran. A GetInstance() call in between runs the remaining
+  // mandatory stages synchronously.
+  static void Prewarm(const base::Closure& done);
+
  private:
+  // Initialization stages, in order. STAGE_RESOURCES is the last one
+  // GetInstance() waits for.
+  enum Stage {
+    STAGE_NONE,
+    STAGE_CONTENT_MAIN,
+    STAGE_BROWSER_MAIN,
+    STAGE_RESOURCES,
+    STAGE_GPU
+  };
+
   EwkGlobalData();
   ~EwkGlobalData();
 
+  void RunNextStage();
+  void InitializeContentMain();
+  void InitializeBrowserMain();
+  void InitializeResources();
+  void LaunchGpu();
+
+  static Eina_Bool PrewarmIdler(void* data);
+
   static EwkGlobalData* instance_;
 
   content::ContentMainRunner* content_main_runner_;
   content::BrowserMainRunner* browser_main_runner_;
+  scoped_ptr<content::MainFunctionParams> main_function_params_;
+
+  Stage stage_;
+  Ecore_Idler* prewarm_idler_;
+  std::vector<base::Closure> prewarm_callbacks_;
 
   DISALLOW_COPY_AND_ASSIGN(EwkGlobalData);
 };
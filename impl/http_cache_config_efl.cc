@@ -0,0 +1,200 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "http_cache_config_efl.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/metrics/histogram.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/sys_info.h"
+#include "common/content_switches_efl.h"
+#include "net/url_request/url_request.h"
+
+namespace content {
+
+namespace {
+
+const int64 kMegabyte = 1024 * 1024;
+
+const base::FilePath::CharType kBlockfileCacheDir[] = FILE_PATH_LITERAL("Cache");
+const base::FilePath::CharType kSimpleCacheDir[] =
+    FILE_PATH_LITERAL("SimpleCache");
+
+// Devices are classed by physical memory, in megabytes, which goes along with
+// the size of their flash.
+enum DeviceClass {
+  DEVICE_CLASS_LOW,     // Below 1024.
+  DEVICE_CLASS_MEDIUM,  // Below 2048.
+  DEVICE_CLASS_HIGH,
+};
+
+// Upper bounds of the disk cache per device class. The high end one is what
+// the blockfile backend picks for itself on desktop.
+const int64 kMaxDiskCacheSize[] = {
+    20 * kMegabyte,
+    50 * kMegabyte,
+    80 * kMegabyte,
+};
+
+// Size of the cache when it is kept in memory.
+const int64 kMemoryCacheSize[] = {
+    4 * kMegabyte,
+    8 * kMegabyte,
+    16 * kMegabyte,
+};
+
+// The disk cache takes at most this fraction of the free space...
+const int kFreeDiskSpaceDivisor = 10;
+// ...and is not worth having on disk below this size.
+const int64 kMinDiskCacheSize = 5 * kMegabyte;
+
+DeviceClass GetDeviceClass() {
+  int64 memory_size = base::SysInfo::AmountOfPhysicalMemory() / kMegabyte;
+  if (memory_size < 1024)
+    return DEVICE_CLASS_LOW;
+  if (memory_size < 2048)
+    return DEVICE_CLASS_MEDIUM;
+  return DEVICE_CLASS_HIGH;
+}
+
+}  // namespace
+
+HttpCacheConfigEfl::HttpCacheConfigEfl()
+    : type(net::MEMORY_CACHE),
+      backend(net::CACHE_BACKEND_DEFAULT),
+      max_bytes(0) {
+}
+
+HttpCacheConfigEfl::~HttpCacheConfigEfl() {
+}
+
+// static
+HttpCacheConfigEfl HttpCacheConfigEfl::Create(
+    const base::FilePath& base_path) {
+  const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+  std::string backend_name =
+      command_line.GetSwitchValueASCII(switches::kHttpCacheBackend);
+  DeviceClass device_class = GetDeviceClass();
+
+  HttpCacheConfigEfl config;
+  int64 size = 0;
+  if (!base_path.empty() && backend_name != "memory") {
+    int64 free_space = base::SysInfo::AmountOfFreeDiskSpace(base_path);
+    size = std::min(kMaxDiskCacheSize[device_class],
+                    free_space / kFreeDiskSpaceDivisor);
+    if (size >= kMinDiskCacheSize) {
+      config.type = net::DISK_CACHE;
+      if (backend_name == "simple") {
+        config.backend = net::CACHE_BACKEND_SIMPLE;
+        config.path = base_path.Append(kSimpleCacheDir);
+      } else {
+        LOG_IF(WARNING, !backend_name.empty() && backend_name != "blockfile")
+            << "Unknown HTTP cache backend " << backend_name;
+        config.backend = net::CACHE_BACKEND_BLOCKFILE;
+        config.path = base_path.Append(kBlockfileCacheDir);
+      }
+    } else {
+      LOG(WARNING) << "Only " << free_space / kMegabyte
+                   << "MB free, keeping the HTTP cache in memory";
+    }
+  }
+  if (config.type == net::MEMORY_CACHE)
+    size = kMemoryCacheSize[device_class];
+
+  std::string size_switch =
+      command_line.GetSwitchValueASCII(switches::kHttpCacheSize);
+  int64 forced_size = 0;
+  if (!size_switch.empty() && base::StringToInt64(size_switch, &forced_size) &&
+      forced_size > 0) {
+    size = forced_size;
+  }
+  config.max_bytes = static_cast<int>(std::min<int64>(size, kint32max));
+
+  if (!base_path.empty()) {
+    if (config.backend != net::CACHE_BACKEND_BLOCKFILE)
+      config.unused_paths.push_back(base_path.Append(kBlockfileCacheDir));
+    if (config.backend != net::CACHE_BACKEND_SIMPLE)
+      config.unused_paths.push_back(base_path.Append(kSimpleCacheDir));
+  }
+
+  VLOG(1) << "HTTP cache: " << config.BackendName() << ", "
+          << config.max_bytes / kMegabyte << "MB";
+  return config;
+}
+
+net::HttpCache::BackendFactory* HttpCacheConfigEfl::CreateBackendFactory(
+    const scoped_refptr<base::SingleThreadTaskRunner>& cache_thread) const {
+  return new net::HttpCache::DefaultBackend(
+      type, backend, path, max_bytes, cache_thread);
+}
+
+void HttpCacheConfigEfl::DeleteUnusedCaches(
+    const scoped_refptr<base::SingleThreadTaskRunner>& cache_thread) const {
+  for (size_t i = 0; i < unused_paths.size(); ++i) {
+    cache_thread->PostTask(FROM_HERE, base::Bind(
+        base::IgnoreResult(&base::DeleteFile), unused_paths[i], true));
+  }
+}
+
+const char* HttpCacheConfigEfl::BackendName() const {
+  if (type == net::MEMORY_CACHE)
+    return "Memory";
+  return backend == net::CACHE_BACKEND_SIMPLE ? "Simple" : "Blockfile";
+}
+
+HttpCacheStatsEfl::HttpCacheStatsEfl(const char* backend_name)
+    : backend_name_(backend_name),
+      requests_(0),
+      hits_(0),
+      bytes_from_cache_(0),
+      bytes_from_network_(0) {
+}
+
+HttpCacheStatsEfl::~HttpCacheStatsEfl() {
+  VLOG(1) << "HTTP cache (" << backend_name_ << "): " << hits_ << "/"
+          << requests_ << " hits, " << bytes_from_cache_ / 1024
+          << "kB from cache, " << bytes_from_network_ / 1024
+          << "kB from network";
+}
+
+void HttpCacheStatsEfl::OnRequestCompleted(const net::URLRequest& request) {
+  if (!request.url().SchemeIsHTTPOrHTTPS() || !request.status().is_success())
+    return;
+
+  // Revalidated entries count as hits, their body still comes from the
+  // cache.
+  bool hit = request.was_cached();
+  int64 network_bytes = request.GetTotalReceivedBytes();
+  int64 cache_bytes = hit ? request.received_response_content_length() : 0;
+
+  ++requests_;
+  if (hit)
+    ++hits_;
+  bytes_from_cache_ += cache_bytes;
+  bytes_from_network_ += network_bytes;
+
+  base::BooleanHistogram::FactoryGet(
+      "Net.HttpCacheEfl.Hit." + backend_name_,
+      base::HistogramBase::kUmaTargetedHistogramFlag)->AddBoolean(hit);
+  std::string bytes_histogram = std::string(hit ?
+      "Net.HttpCacheEfl.KBFromCache." : "Net.HttpCacheEfl.KBFromNetwork.") +
+      backend_name_;
+  base::Histogram::FactoryGet(
+      bytes_histogram, 1, 10 * 1024, 50,
+      base::HistogramBase::kUmaTargetedHistogramFlag)->Add(
+          (hit ? cache_bytes : network_bytes) / 1024);
+}
+
+double HttpCacheStatsEfl::HitRatio() const {
+  return requests_ ? static_cast<double>(hits_) / requests_ : 0;
+}
+
+}  // namespace content
@@ -0,0 +1,89 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef HTTP_CACHE_CONFIG_EFL_H_
+#define HTTP_CACHE_CONFIG_EFL_H_
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "net/base/cache_type.h"
+#include "net/http/http_cache.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}
+
+namespace net {
+class URLRequest;
+}
+
+namespace content {
+
+// Type, backend, location and size of the HTTP cache of a browser context.
+//
+// The disk cache gets a share of the free space of its partition, bounded by
+// the device class, i.e. the amount of physical memory, so that devices with
+// little flash do not give much of it away. The embedder picks the backend
+// with --http-cache-backend: "blockfile", the default, "simple", which opens
+// much faster on cold start as it has no index to map and verify, or
+// "memory". The cache is also kept in memory when the disk is nearly full.
+struct HttpCacheConfigEfl {
+  HttpCacheConfigEfl();
+  ~HttpCacheConfigEfl();
+
+  // Reads the command line and the free space under |base_path|.
+  static HttpCacheConfigEfl Create(const base::FilePath& base_path);
+
+  net::HttpCache::BackendFactory* CreateBackendFactory(
+      const scoped_refptr<base::SingleThreadTaskRunner>& cache_thread) const;
+
+  // Removes what other backends left on disk, on |cache_thread|.
+  void DeleteUnusedCaches(
+      const scoped_refptr<base::SingleThreadTaskRunner>& cache_thread) const;
+
+  // "Blockfile", "Simple" or "Memory", for histograms.
+  const char* BackendName() const;
+
+  net::CacheType type;
+  net::BackendType backend;
+  base::FilePath path;
+  int max_bytes;
+  std::vector<base::FilePath> unused_paths;
+};
+
+// Hit ratio and bytes served by the HTTP cache of a browser context, fed with
+// the HTTP(S) requests its network delegate sees complete. Every request is
+// also recorded in histograms suffixed with the backend name. Only used on
+// the IO thread.
+class HttpCacheStatsEfl {
+ public:
+  explicit HttpCacheStatsEfl(const char* backend_name);
+  ~HttpCacheStatsEfl();
+
+  void OnRequestCompleted(const net::URLRequest& request);
+
+  int64 requests() const { return requests_; }
+  int64 hits() const { return hits_; }
+  // Response bytes read from the cache and received from the network.
+  int64 bytes_from_cache() const { return bytes_from_cache_; }
+  int64 bytes_from_network() const { return bytes_from_network_; }
+  double HitRatio() const;
+
+ private:
+  std::string backend_name_;
+  int64 requests_;
+  int64 hits_;
+  int64 bytes_from_cache_;
+  int64 bytes_from_network_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpCacheStatsEfl);
+};
+
+}  // namespace content
+
+#endif  // HTTP_CACHE_CONFIG_EFL_H_
@@ -0,0 +1,258 @@
+// Copyright 2014 Samsung Electronics Inc. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/tizen/gst_pipeline_pool_tizen.h"
+
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
+
+namespace media {
+
+namespace {
+
+const char* kPlaybinKey = "playbin";
+const char* kPlaybinName = "gst_playbin";
+const char* kVideoSink = "gst_video_sink";
+
+// A page rarely has more than a couple of videos loading at once.
+const size_t kMaxIdlePipelinesPerKey = 2;
+
+// Idle pipelines hold their elements and plugin state, so they are only kept
+// around while pages are likely to load more media.
+const int kIdlePipelineTimeoutSeconds = 30;
+
+void DestroyPipeline(GstElement* pipeline) {
+  gst_element_set_state(pipeline, GST_STATE_NULL);
+  gst_object_unref(pipeline);
+}
+
+// The callbacks point at the player that owned the pipeline.
+void ClearAppCallbacks(GstElement* element) {
+  static GstAppSinkCallbacks sink_callbacks = {
+      NULL, NULL, NULL, NULL, {NULL, NULL, NULL}};
+  static GstAppSrcCallbacks src_callbacks = {NULL, NULL, NULL, {NULL}};
+
+  if (GST_IS_APP_SINK(element)) {
+    gst_app_sink_set_callbacks(
+        GST_APP_SINK(element), &sink_callbacks, NULL, NULL);
+  } else if (GST_IS_APP_SRC(element)) {
+    gst_app_src_set_callbacks(
+        GST_APP_SRC(element), &src_callbacks, NULL, NULL);
+  }
+}
+
+void ClearBinAppCallbacks(GstElement* bin) {
+  GstIterator* it = gst_bin_iterate_recurse(GST_BIN(bin));
+  gpointer item = NULL;
+  bool done = false;
+  while (!done) {
+    switch (gst_iterator_next(it, &item)) {
+      case GST_ITERATOR_OK:
+        ClearAppCallbacks(GST_ELEMENT(item));
+        gst_object_unref(item);
+        break;
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync(it);
+        break;
+      default:
+        done = true;
+        break;
+    }
+  }
+  gst_iterator_free(it);
+}
+
+// Back to READY: decoders, sources and queued buffers are released but the
+// elements and their links are kept.
+bool ResetPipeline(GstElement* pipeline) {
+  if (gst_element_set_state(
+      pipeline, GST_STATE_READY) == GST_STATE_CHANGE_FAILURE) {
+    LOG(ERROR) << "GStreamer state change failed in READY";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+// static
+GstPipelinePoolTizen* GstPipelinePoolTizen::GetInstance() {
+  return Singleton<GstPipelinePoolTizen>::get();
+}
+
+GstPipelinePoolTizen::GstPipelinePoolTizen()
+    : is_prewarm_pending_(false) {
+}
+
+GstPipelinePoolTizen::~GstPipelinePoolTizen() {
+  DropIdlePipelines();
+}
+
+GstElement* GstPipelinePoolTizen::ClaimPlaybin(bool* from_pool) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  GstElement* playbin = TakeIdle(kPlaybinKey);
+  *from_pool = !!playbin;
+  UMA_HISTOGRAM_BOOLEAN("Media.Tizen.PipelinePool.PlaybinHit", *from_pool);
+  if (!playbin)
+    playbin = CreatePlaybin();
+
+  // Have the next one ready, pages with one video often have more.
+  if (playbin && !is_prewarm_pending_ &&
+      idle_pipelines_[kPlaybinKey].empty()) {
+    is_prewarm_pending_ = true;
+    base::MessageLoop::current()->PostTask(FROM_HERE, base::Bind(
+        &GstPipelinePoolTizen::PrewarmPlaybin, base::Unretained(this)));
+  }
+  return playbin;
+}
+
+GstElement* GstPipelinePoolTizen::ClaimPipeline(const std::string& key) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  GstElement* pipeline = TakeIdle(key);
+  UMA_HISTOGRAM_BOOLEAN("Media.Tizen.PipelinePool.PipelineHit", !!pipeline);
+  return pipeline;
+}
+
+void GstPipelinePoolTizen::ReturnPlaybin(GstElement* playbin) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  GstElement* video_sink = NULL;
+  g_object_get(playbin, "video-sink", &video_sink, NULL);
+  if (video_sink) {
+    ClearAppCallbacks(video_sink);
+    gst_object_unref(video_sink);
+  }
+
+  if (!ResetPipeline(playbin)) {
+    DestroyPipeline(playbin);
+    return;
+  }
+  AddIdle(kPlaybinKey, playbin);
+}
+
+void GstPipelinePoolTizen::ReturnPipeline(
+    const std::string& key,
+    GstElement* pipeline) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  ClearBinAppCallbacks(pipeline);
+
+  if (!ResetPipeline(pipeline)) {
+    DestroyPipeline(pipeline);
+    return;
+  }
+  AddIdle(key, pipeline);
+}
+
+GstElement* GstPipelinePoolTizen::CreatePlaybin() {
+  if (!gst_is_initialized())
+    gst_init_check(NULL, NULL, 0);
+  if (!gst_is_initialized()) {
+    LOG(ERROR) << "Unable to initialize GST";
+    return NULL;
+  }
+
+  GstElement* playbin = gst_element_factory_make("playbin2", kPlaybinName);
+#if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
+  GstElement* video_sink = gst_element_factory_make("xvimagesink", kVideoSink);
+#else
+  GstElement* video_sink = gst_element_factory_make("appsink", kVideoSink);
+#endif
+  if (!playbin || !video_sink) {
+    if (playbin)
+      gst_object_unref(playbin);
+    if (video_sink)
+      gst_object_unref(video_sink);
+    LOG(ERROR) << "Unable to create GStreamer elements";
+    return NULL;
+  }
+
+  // QoS property will enable the quality-of-service features of the
+  // basesink which gather statistics about the real-time performance
+  // of the clock synchronisation. For each buffer received in the sink,
+  // statistics are gathered and a QOS event is sent upstream with
+  // these numbers. This information can then be used by upstream
+  // elements to reduce their processing rate, for example.
+  if (!gst_base_sink_is_qos_enabled(GST_BASE_SINK(video_sink)))
+    gst_base_sink_set_qos_enabled(GST_BASE_SINK(video_sink), true);
+
+  g_object_set(playbin, "video-sink", video_sink, NULL);
+  return playbin;
+}
+
+void GstPipelinePoolTizen::PrewarmPlaybin() {
+  is_prewarm_pending_ = false;
+  if (!idle_pipelines_[kPlaybinKey].empty())
+    return;
+
+  GstElement* playbin = CreatePlaybin();
+  if (!playbin)
+    return;
+  if (!ResetPipeline(playbin)) {
+    DestroyPipeline(playbin);
+    return;
+  }
+  AddIdle(kPlaybinKey, playbin);
+}
+
+GstElement* GstPipelinePoolTizen::TakeIdle(const std::string& key) {
+  PipelineMap::iterator it = idle_pipelines_.find(key);
+  if (it == idle_pipelines_.end() || it->second.empty())
+    return NULL;
+  GstElement* pipeline = it->second.back();
+  it->second.pop_back();
+  return pipeline;
+}
+
+void GstPipelinePoolTizen::AddIdle(
+    const std::string& key,
+    GstElement* pipeline) {
+  std::vector<GstElement*>& idle = idle_pipelines_[key];
+  if (idle.size() >= kMaxIdlePipelinesPerKey) {
+    DestroyPipeline(pipeline);
+    return;
+  }
+  idle.push_back(pipeline);
+  idle_timer_.Start(FROM_HERE,
+      base::TimeDelta::FromSeconds(kIdlePipelineTimeoutSeconds),
+      this, &GstPipelinePoolTizen::DropIdlePipelines);
+}
+
+void GstPipelinePoolTizen::DropIdlePipelines() {
+  for (PipelineMap::iterator it = idle_pipelines_.begin();
+      it != idle_pipelines_.end(); ++it) {
+    for (size_t i = 0; i < it->second.size(); ++i)
+      DestroyPipeline(it->second[i]);
+  }
+  idle_pipelines_.clear();
+}
+
+FirstFrameTimerTizen::FirstFrameTimerTizen(const char* player_type)
+    : player_type_(player_type),
+      from_pool_(false) {
+}
+
+void FirstFrameTimerTizen::Start(bool from_pool) {
+  start_time_ = base::TimeTicks::Now();
+  from_pool_ = from_pool;
+}
+
+void FirstFrameTimerTizen::OnFrame() {
+  if (start_time_.is_null())
+    return;
+
+  std::string name = std::string("Media.Tizen.TimeToFirstFrame.") +
+      player_type_ + (from_pool_ ? ".Pooled" : ".New");
+  base::HistogramBase* histogram = base::Histogram::FactoryTimeGet(
+      name, base::TimeDelta::FromMilliseconds(1),
+      base::TimeDelta::FromSeconds(30), 50,
+      base::HistogramBase::kUmaTargetedHistogramFlag);
+  histogram->AddTime(base::TimeTicks::Now() - start_time_);
+  start_time_ = base::TimeTicks();
+}
+
+}  // namespace media
@@ -0,0 +1,93 @@
+// Copyright 2014 Samsung Electronics Inc. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_BASE_TIZEN_GST_PIPELINE_POOL_TIZEN_H_
+#define MEDIA_BASE_TIZEN_GST_PIPELINE_POOL_TIZEN_H_
+
+#include <gst/gst.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/singleton.h"
+#include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "media/base/media_export.h"
+
+namespace media {
+
+// Keeps built and linked GStreamer pipelines in READY state so that players
+// do not pay for element creation, linking and the NULL to READY transition
+// on every load. Pipelines are keyed by the elements they contain: one key
+// for URL playback (playbin2 with the video sink set) and one per MSE codec
+// combination. Players return their pipeline on Release() instead of
+// destroying it; idle pipelines are dropped after a while.
+//
+// Only used on the browser main thread.
+class MEDIA_EXPORT GstPipelinePoolTizen {
+ public:
+  static GstPipelinePoolTizen* GetInstance();
+
+  // Returns a playbin2 with the video sink set, reused when possible, or NULL
+  // if GStreamer could not build one. The caller owns the reference.
+  GstElement* ClaimPlaybin(bool* from_pool);
+
+  // Returns an idle MSE pipeline built for |key|, or NULL. The caller owns
+  // the reference.
+  GstElement* ClaimPipeline(const std::string& key);
+
+  // Takes over the caller's reference to |pipeline|, which must no longer
+  // have a bus handler pointing at the caller. The app source and sink
+  // callbacks are cleared here.
+  void ReturnPlaybin(GstElement* playbin);
+  void ReturnPipeline(const std::string& key, GstElement* pipeline);
+
+ private:
+  friend struct DefaultSingletonTraits<GstPipelinePoolTizen>;
+
+  typedef std::map<std::string, std::vector<GstElement*> > PipelineMap;
+
+  GstPipelinePoolTizen();
+  ~GstPipelinePoolTizen();
+
+  GstElement* CreatePlaybin();
+  void PrewarmPlaybin();
+  GstElement* TakeIdle(const std::string& key);
+  void AddIdle(const std::string& key, GstElement* pipeline);
+  void DropIdlePipelines();
+
+  PipelineMap idle_pipelines_;
+  bool is_prewarm_pending_;
+  base::OneShotTimer<GstPipelinePoolTizen> idle_timer_;
+  base::ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(GstPipelinePoolTizen);
+};
+
+// Reports the time from a player getting its pipeline to its first video
+// frame, split by player type and by whether the pipeline came from the
+// pool.
+class MEDIA_EXPORT FirstFrameTimerTizen {
+ public:
+  // |player_type| is part of the histogram name, e.g. "URL" or "MSE".
+  explicit FirstFrameTimerTizen(const char* player_type);
+
+  void Start(bool from_pool);
+  // Only the first call after Start() is recorded.
+  void OnFrame();
+
+ private:
+  const char* player_type_;
+  base::TimeTicks start_time_;
+  bool from_pool_;
+
+  DISALLOW_COPY_AND_ASSIGN(FirstFrameTimerTizen);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BASE_TIZEN_GST_PIPELINE_POOL_TIZEN_H_
@@ -0,0 +1,114 @@
+// Copyright 2014 Samsung Electronics Inc. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/tizen/media_clock_tizen.h"
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/time/time.h"
+
+namespace media {
+
+namespace {
+
+// Readers give up after this many torn reads and return the last value.
+const int kMaxReadAttempts = 16;
+
+}  // namespace
+
+// Written as a sequence lock: |sequence| is odd while an update is in
+// progress, so readers retry when it is odd or changed under them.
+struct MediaClockTizen::State {
+  base::subtle::Atomic32 sequence;
+  double position;
+  double rate;
+  int64 anchor;  // base::TimeTicks internal value.
+};
+
+MediaClockTizen::MediaClockTizen()
+    : state_(NULL),
+      last_time_(0) {
+}
+
+MediaClockTizen::~MediaClockTizen() {
+}
+
+bool MediaClockTizen::Create() {
+  DCHECK(!state_);
+  scoped_ptr<base::SharedMemory> shared_memory(new base::SharedMemory());
+  if (!shared_memory->CreateAndMapAnonymous(sizeof(State))) {
+    LOG(ERROR) << "Media clock shared memory creation failed.";
+    return false;
+  }
+  shared_memory_ = shared_memory.Pass();
+  state_ = static_cast<State*>(shared_memory_->memory());
+  state_->sequence = 0;
+  state_->position = 0;
+  state_->rate = 0;
+  state_->anchor = base::TimeTicks::Now().ToInternalValue();
+  return true;
+}
+
+bool MediaClockTizen::ShareToProcess(base::ProcessHandle process,
+                                     base::SharedMemoryHandle* handle) {
+  if (!state_)
+    return false;
+  return shared_memory_->ShareToProcess(process, handle);
+}
+
+void MediaClockTizen::Update(double position, double rate) {
+  if (!state_)
+    return;
+
+  base::subtle::Atomic32 sequence =
+      base::subtle::NoBarrier_Load(&state_->sequence);
+  base::subtle::NoBarrier_Store(&state_->sequence, sequence + 1);
+  base::subtle::MemoryBarrier();
+  state_->position = position;
+  state_->rate = rate;
+  state_->anchor = base::TimeTicks::Now().ToInternalValue();
+  base::subtle::Release_Store(&state_->sequence, sequence + 2);
+}
+
+bool MediaClockTizen::Map(base::SharedMemoryHandle handle) {
+  DCHECK(!state_);
+  scoped_ptr<base::SharedMemory> shared_memory(
+      new base::SharedMemory(handle, true));
+  if (!shared_memory->Map(sizeof(State))) {
+    LOG(ERROR) << "Media clock shared memory mapping failed.";
+    return false;
+  }
+  shared_memory_ = shared_memory.Pass();
+  state_ = static_cast<State*>(shared_memory_->memory());
+  return true;
+}
+
+double MediaClockTizen::GetCurrentTime() const {
+  if (!state_)
+    return 0;
+
+  for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+    base::subtle::Atomic32 sequence =
+        base::subtle::Acquire_Load(&state_->sequence);
+    if (sequence & 1)
+      continue;
+
+    double position = state_->position;
+    double rate = state_->rate;
+    int64 anchor = state_->anchor;
+    base::subtle::MemoryBarrier();
+    if (base::subtle::NoBarrier_Load(&state_->sequence) != sequence)
+      continue;
+
+    base::TimeDelta elapsed =
+        base::TimeTicks::Now() - base::TimeTicks::FromInternalValue(anchor);
+    last_time_ = std::max(0.0, position + rate * elapsed.InSecondsF());
+    break;
+  }
+  return last_time_;
+}
+
+}  // namespace media
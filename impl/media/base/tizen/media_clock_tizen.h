@@ -0,0 +1,53 @@
+// Copyright 2014 Samsung Electronics Inc. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_BASE_TIZEN_MEDIA_CLOCK_TIZEN_H_
+#define MEDIA_BASE_TIZEN_MEDIA_CLOCK_TIZEN_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "base/process/process_handle.h"
+#include "media/base/media_export.h"
+
+namespace media {
+
+// Playback position of a browser side player published through shared
+// memory. The player writes an anchor (position, rate and the time it was
+// taken) whenever playback state changes, and the renderer extrapolates the
+// current time from it without a time update IPC per tick.
+//
+// base::TimeTicks is CLOCK_MONOTONIC, which is the same in both processes.
+class MEDIA_EXPORT MediaClockTizen {
+ public:
+  MediaClockTizen();
+  ~MediaClockTizen();
+
+  // Writer side, used on the browser main thread.
+  bool Create();
+  bool ShareToProcess(base::ProcessHandle process,
+                      base::SharedMemoryHandle* handle);
+  // |rate| is 0 while the pipeline is not advancing.
+  void Update(double position, double rate);
+
+  // Reader side. Takes ownership of |handle|.
+  bool Map(base::SharedMemoryHandle handle);
+  bool IsValid() const { return !!state_; }
+  double GetCurrentTime() const;
+
+ private:
+  struct State;
+
+  scoped_ptr<base::SharedMemory> shared_memory_;
+  State* state_;
+
+  // Returned when a reader keeps racing the writer.
+  mutable double last_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(MediaClockTizen);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BASE_TIZEN_MEDIA_CLOCK_TIZEN_H_
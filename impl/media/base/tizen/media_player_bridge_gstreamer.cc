@@ -59,7 +59,6 @@ typedef enum {
 
 // Playbin element name
 const char* kPlaybinName = "gst_playbin";
-const char* kVideoSink = "gst_video_sink";
 const char* kPropertyBufferSize = "buffer-size";
 const char* kPropertyMaxBuffers = "max-buffers";
 const char* kPropertyVolume = "volume";
@@ -68,8 +67,6 @@ const char* kPropertyAudioStream = "n-audio";
 const char* kPropertyVideoStream = "n-video";
 const char* kPropertyTextStream = "n-text";
 
-// Update duration every 100ms.
-const int kDurationUpdateInterval = 100;
 const int kMaxBuffer = 1;
 
 // buffer size for audio/video buffering
@@ -98,6 +95,18 @@ const double ConvertNanoSecondsToSeconds(int64 time) {
   return seconds;
 }
 
+bool SameTimeRanges(
+    const std::vector<media::MediaPlayerTizen::TimeRanges>& a,
+    const std::vector<media::MediaPlayerTizen::TimeRanges>& b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].start != b[i].start || a[i].end != b[i].end)
+      return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 namespace media {
@@ -188,6 +197,9 @@ MediaPlayerBridgeGstreamer::MediaPlayerBridgeGstreamer(
       gst_height_(0),
       is_prerolled_(false),
       is_paused_(true),
+      is_pipeline_released_(false),
+      resume_position_(0),
+      resume_playing_(false),
       duration_(0),
       playback_rate_(1.0f),
       buffered_(0),
@@ -201,56 +213,48 @@ MediaPlayerBridgeGstreamer::MediaPlayerBridgeGstreamer(
       seek_duration_(0),
       error_occured_(false),
       missing_plugins_(false),
-      is_pixmap_used_(false),
 #if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
+      is_pixmap_used_(true),
       pixmap_id_(0),
       efl_pixmap_(NULL),
       m_damage(0),
       m_damageHandler(NULL),
+#else
+      is_pixmap_used_(false),
 #endif
       bufsize_sn12_(0),
-      shared_memory_size(0) {
+      shared_memory_size(0),
+      first_frame_timer_("URL") {
   LOG(INFO) << "MediaPlayerBridgeGstreamer - URL = " << url_.spec().c_str();
+  media_clock()->Create();
 
-  // gstreamer port
-  if (!gst_is_initialized()) {
-    gst_init_check(NULL, NULL, 0);
-  }
+  bool from_pool = false;
+  gst_playbin_ = GstPipelinePoolTizen::GetInstance()->ClaimPlaybin(&from_pool);
+  if (gst_playbin_) {
+    first_frame_timer_.Start(from_pool);
+    // |gst_playbin_| keeps the sink alive.
+    g_object_get(gst_playbin_, "video-sink", &gst_appsink_, NULL);
+    gst_object_unref(gst_appsink_);
 
-  if (gst_is_initialized()) {
-    gst_playbin_ = gst_element_factory_make("playbin2", kPlaybinName);
-    gst_appsink_ = GetVideoSink();
-    if (gst_playbin_ && gst_appsink_) {
-      g_object_set(gst_playbin_, "video-sink", gst_appsink_, NULL);
-
-    // QoS property will enable the quality-of-service features of the
-    // basesink which gather statistics about the real-time performance
-    // of the clock synchronisation. For each buffer received in the sink,
-    // statistics are gathered and a QOS event is sent upstream with
-    // these numbers. This information can then be used by upstream
-    // elements to reduce their processing rate, for example.
-    if(!gst_base_sink_is_qos_enabled(GST_BASE_SINK(gst_appsink_)))
-      gst_base_sink_set_qos_enabled(GST_BASE_SINK(gst_appsink_), true);
-
-      GstBus* bus = gst_pipeline_get_bus(GST_PIPELINE(gst_playbin_));
-      if (!bus) {
-        LOG(ERROR) << "GStreamer bus creation failed";
-        HandleError(MediaPlayerTizen::NetworkStateDecodeError);
-        return;
-      }
-      gst_bus_set_sync_handler(
-          bus, (GstBusSyncHandler)gst_pipeline_message_cb, this);
-      gst_object_unref (bus);
+    GstBus* bus = gst_pipeline_get_bus(GST_PIPELINE(gst_playbin_));
+    if (!bus) {
+      LOG(ERROR) << "GStreamer bus creation failed";
+      HandleError(MediaPlayerTizen::NetworkStateDecodeError);
+      return;
+    }
+    gst_bus_set_sync_handler(
+        bus, (GstBusSyncHandler)gst_pipeline_message_cb, this);
+    gst_object_unref (bus);
 
 #if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
-      PrepareForVideoSink();
+    PrepareForVideoSink();
 #else
-      PrepareForVideoFrame();
+    PrepareForVideoFrame();
 #endif
 
-      g_object_set(G_OBJECT(gst_playbin_), kPropertyVolume, volume_, NULL);
-      g_object_set(
-          G_OBJECT(gst_playbin_), kPropertyUri, url_.spec().c_str(), NULL);
+    g_object_set(G_OBJECT(gst_playbin_), kPropertyVolume, volume_, NULL);
+    g_object_set(
+        G_OBJECT(gst_playbin_), kPropertyUri, url_.spec().c_str(), NULL);
 
     if (gst_element_set_state(
         gst_playbin_, GST_STATE_READY) == GST_STATE_CHANGE_FAILURE)
@@ -261,22 +265,10 @@ MediaPlayerBridgeGstreamer::MediaPlayerBridgeGstreamer(
     manager()->OnNetworkStateChange(
         GetPlayerId(), MediaPlayerTizen::NetworkStateLoaded);
 
-      if(url_.SchemeIsFile())
-        is_file_url_ = true;
-    } else {
-      if (gst_playbin_) {
-        gst_object_unref(gst_playbin_);
-        gst_playbin_ = NULL;
-      }
-      if(gst_appsink_) {
-        gst_object_unref(gst_appsink_);
-        gst_appsink_ = NULL;
-      }
-      LOG(ERROR) << "Unable to create GStreamer elements";
-      HandleError(MediaPlayerTizen::NetworkStateDecodeError);
-    }
+    if(url_.SchemeIsFile())
+      is_file_url_ = true;
   } else {
-    LOG(ERROR) << "Unable to initialize GST";
+    LOG(ERROR) << "Unable to create GStreamer elements";
     HandleError(MediaPlayerTizen::NetworkStateDecodeError);
   }
 }
@@ -301,10 +293,23 @@ void MediaPlayerBridgeGstreamer::Play() {
     return;
   if (error_occured_ || is_end_reached_)
     return;
+  resume_playing_ = false;
   if (playback_rate_ == 0.0) {
     is_paused_ = false;
     return;
   }
+  if (is_pipeline_released_) {
+    // Preroll again and continue from where the player was released.
+    is_pipeline_released_ = false;
+    if (gst_element_set_state(
+        gst_playbin_, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE) {
+      LOG(ERROR) << "GStreamer state change failed in PLAY";
+      return;
+    }
+    gst_element_get_state(gst_playbin_, NULL, NULL, GST_CLOCK_TIME_NONE);
+    SeekTo(ConvertToGstClockTime(resume_position_), playback_rate_,
+        static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE));
+  }
   if (gst_element_set_state(
       gst_playbin_, GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
     LOG(ERROR) << "GStreamer state change failed in PLAY";
@@ -316,9 +321,9 @@ void MediaPlayerBridgeGstreamer::Play() {
     LOG(ERROR) << "|device_power_request_lock| request failed";
 #endif
 
-  StartCurrentTimeUpdateTimer();
   is_paused_ = false;
   is_end_reached_ = false;
+  UpdateMediaClock();
 }
 
 void MediaPlayerBridgeGstreamer::Pause(bool is_media_related_action) {
@@ -327,6 +332,12 @@ void MediaPlayerBridgeGstreamer::Pause(bool is_media_related_action) {
     return;
   if (error_occured_)
     return;
+  resume_playing_ = false;
+  if (is_pipeline_released_) {
+    // Stays released until Play() prerolls it again.
+    is_paused_ = true;
+    return;
+  }
   if (gst_element_set_state(
       gst_playbin_, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE) {
     LOG(ERROR) << "GStreamer state change failed in PAUSE";
@@ -338,8 +349,8 @@ void MediaPlayerBridgeGstreamer::Pause(bool is_media_related_action) {
     LOG(ERROR) << "|device_power_release_lock| request failed";
 #endif
 
-  StopCurrentTimeUpdateTimer();
   is_paused_ = true;
+  UpdateMediaClock();
 }
 
 void MediaPlayerBridgeGstreamer::SetRate(double rate) {
@@ -366,10 +377,8 @@ void MediaPlayerBridgeGstreamer::SetRate(double rate) {
   }
 
   // If rate was zero and requested rate is non-zero, change the paused state
-  if(playback_rate_ == 0.0 && rate != 0.0) {
+  if(playback_rate_ == 0.0 && rate != 0.0)
     Play();
-    StartCurrentTimeUpdateTimer();
-  }
 
   double current_position = GetCurrentTime() * GST_SECOND;
 
@@ -381,6 +390,7 @@ void MediaPlayerBridgeGstreamer::SetRate(double rate) {
 
     // FIXME: Is is required to mute at abnormal playback rate?
     playback_rate_ = rate;
+    UpdateMediaClock();
   } else {
     LOG(ERROR) << "Setting Rate " << rate << " failed";
     HandleError(MediaPlayerTizen::NetworkStateDecodeError);
@@ -393,6 +403,15 @@ void MediaPlayerBridgeGstreamer::Seek(const double time) {
   if (IsPlayerDestructing())
     return;
 
+  if (is_pipeline_released_ && !error_occured_ && !is_live_stream_) {
+    // Applied when the pipeline is prerolled again in Play().
+    resume_position_ = time;
+    is_end_reached_ = time != duration_ ? false : true;
+    UpdateMediaClock();
+    manager()->OnTimeChanged(GetPlayerId());
+    return;
+  }
+
   if (!gst_playbin_ || error_occured_ || is_live_stream_ ||
       time == GetCurrentTime()) {
     main_loop_->PostTask(FROM_HERE, base::Bind(
@@ -409,19 +428,16 @@ void MediaPlayerBridgeGstreamer::Seek(const double time) {
     return;
   }
 
-  StopCurrentTimeUpdateTimer();
   if (SeekTo(
       ConvertToGstClockTime(time), playback_rate_, static_cast<GstSeekFlags>
       (GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE))) {
     UpdateSeekState(true);
     seek_duration_ = time;
     is_end_reached_ = time != duration_ ? false : true;
-    manager()->OnTimeUpdate(GetPlayerId(), time);
-    if (!is_paused_)
-      StartCurrentTimeUpdateTimer();
+    UpdateMediaClock();
   } else {
     LOG(ERROR) << "MediaPlayerBridgeGstreamer::" << __FUNCTION__<<": Failed!";
-    manager()->OnTimeUpdate(GetPlayerId(), GetCurrentTime());
+    UpdateMediaClock();
     manager()->OnTimeChanged(GetPlayerId());
   }
 }
@@ -450,8 +466,6 @@ bool MediaPlayerBridgeGstreamer::SeekTo(
 
 void MediaPlayerBridgeGstreamer::Release() {
   VLOG(1) << __FUNCTION__ << " : Player Id = " << GetPlayerId();
-  StopCurrentTimeUpdateTimer();
-  StopBufferingUpdateTimer();
   if (gst_playbin_) {
     GstBus* bus = gst_pipeline_get_bus(GST_PIPELINE(gst_playbin_));
     if (bus) {
@@ -461,8 +475,14 @@ void MediaPlayerBridgeGstreamer::Release() {
       gst_object_unref(bus);
     }
 
-    gst_element_set_state(gst_playbin_, GST_STATE_NULL);
-    gst_object_unref(gst_playbin_);
+    // A playbin that failed, or is tied to this player's pixmap, is not
+    // handed to the next player.
+    if (!error_occured_ && !missing_plugins_ && !is_pixmap_used_) {
+      GstPipelinePoolTizen::GetInstance()->ReturnPlaybin(gst_playbin_);
+    } else {
+      gst_element_set_state(gst_playbin_, GST_STATE_NULL);
+      gst_object_unref(gst_playbin_);
+    }
     gst_playbin_ = NULL;
     gst_appsink_ = NULL;
   }
@@ -481,6 +501,54 @@ void MediaPlayerBridgeGstreamer::Release() {
 #endif
 }
 
+int64 MediaPlayerBridgeGstreamer::ReleaseIdleResources() {
+  if (!is_paused_ || !CanReleasePipeline() || !ReleasePipeline())
+    return 0;
+  return shared_memory_size;
+}
+
+bool MediaPlayerBridgeGstreamer::Suspend() {
+  if (!CanReleasePipeline())
+    return false;
+
+  bool was_playing = !is_paused_;
+  if (was_playing)
+    Pause(true);
+  resume_playing_ = was_playing;
+  return ReleasePipeline();
+}
+
+bool MediaPlayerBridgeGstreamer::Resume() {
+  if (!resume_playing_)
+    return false;
+  resume_playing_ = false;
+  Play();
+  return !is_paused_;
+}
+
+bool MediaPlayerBridgeGstreamer::HasVideo() {
+  return media_type_ & MEDIA_VIDEO_MASK;
+}
+
+bool MediaPlayerBridgeGstreamer::CanReleasePipeline() const {
+  return gst_playbin_ && !is_pipeline_released_ && !error_occured_ &&
+      !is_live_stream_ && !is_seeking_;
+}
+
+bool MediaPlayerBridgeGstreamer::ReleasePipeline() {
+  resume_position_ = GetCurrentTime();
+  // READY keeps the elements but frees decoders and queued buffers.
+  if (gst_element_set_state(
+      gst_playbin_, GST_STATE_READY) == GST_STATE_CHANGE_FAILURE) {
+    LOG(ERROR) << "GStreamer state change failed in READY";
+    return false;
+  }
+  is_pipeline_released_ = true;
+  VLOG(1) << __FUNCTION__ << " : Player Id = " << GetPlayerId()
+          << " position " << resume_position_;
+  return true;
+}
+
 void MediaPlayerBridgeGstreamer::SetVolume(double volume) {
   g_object_set(G_OBJECT(gst_playbin_), kPropertyVolume, volume, NULL);
 }
@@ -530,6 +598,10 @@ double MediaPlayerBridgeGstreamer::GetCurrentTime() {
   if (error_occured_)
     return 0.0;
 
+  // Position queries on a READY pipeline return 0.
+  if (is_pipeline_released_)
+    return resume_position_;
+
   gint64 current_time = 0;
   GstFormat format = GST_FORMAT_TIME;
 
@@ -558,42 +630,19 @@ double MediaPlayerBridgeGstreamer::GetCurrentTime() {
   return ConvertNanoSecondsToSeconds(current_time);
 }
 
-void MediaPlayerBridgeGstreamer::OnCurrentTimeUpdateTimerFired() {
-  manager()->OnTimeUpdate(GetPlayerId(), GetCurrentTime());
-}
-
-void MediaPlayerBridgeGstreamer::StartCurrentTimeUpdateTimer() {
-  if (!current_time_update_timer_.IsRunning()) {
-    current_time_update_timer_.Start(
-        FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kDurationUpdateInterval),
-        this, &MediaPlayerBridgeGstreamer::OnCurrentTimeUpdateTimerFired);
-  }
-}
-
-void MediaPlayerBridgeGstreamer::StopCurrentTimeUpdateTimer() {
-  if (current_time_update_timer_.IsRunning())
-    current_time_update_timer_.Stop();
-}
-
-void MediaPlayerBridgeGstreamer::OnBufferingUpdateTimerFired() {
-  if (IsPlayerDestructing())
+void MediaPlayerBridgeGstreamer::UpdateMediaClock() {
+  DCHECK(main_loop_->BelongsToCurrentThread());
+  if (is_seeking_) {
+    media_clock()->Update(seek_duration_, 0.0);
     return;
-  GetBufferedTimeRanges();
-}
-
-void MediaPlayerBridgeGstreamer::StartBufferingUpdateTimer() {
-  if (!buffering_update_timer_.IsRunning()) {
-    buffering_update_timer_.Start(
-        FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kDurationUpdateInterval),
-        this, &MediaPlayerBridgeGstreamer::OnBufferingUpdateTimerFired);
   }
-}
 
-void MediaPlayerBridgeGstreamer::StopBufferingUpdateTimer() {
-  if (buffering_update_timer_.IsRunning())
-    buffering_update_timer_.Stop();
+  GstState state = GST_STATE_NULL;
+  if (gst_playbin_ && !is_pipeline_released_ && !error_occured_)
+    gst_element_get_state(gst_playbin_, &state, NULL, 0);
+  bool advancing = state == GST_STATE_PLAYING && !is_paused_ &&
+      !is_end_reached_;
+  media_clock()->Update(GetCurrentTime(), advancing ? playback_rate_ : 0.0);
 }
 
 GstBuffer* MediaPlayerBridgeGstreamer::PullBuffer() {
@@ -605,6 +654,7 @@ void MediaPlayerBridgeGstreamer::BufferReady(
   if (!GST_BUFFER_DATA(buffer) || !GST_BUFFER_SIZE(buffer))
     return;
 
+  first_frame_timer_.OnFrame();
   if (!gst_width_ || !gst_height_)
     GetFrameDetails();
   // FIXME: Cross check the end results.
@@ -648,7 +698,17 @@ void MediaPlayerBridgeGstreamer::ProcessBufferingStats(GstMessage* message) {
 
   gst_message_parse_buffering(message, &buffered_);
     main_loop_->PostTask(FROM_HERE, base::Bind(
-        &MediaPlayerBridgeGstreamer::OnUpdateStates, base::Unretained(this)));
+        &MediaPlayerBridgeGstreamer::OnBufferingUpdated,
+        base::Unretained(this)));
+}
+
+void MediaPlayerBridgeGstreamer::OnBufferingUpdated() {
+  DCHECK(main_loop_->BelongsToCurrentThread());
+  if (IsPlayerDestructing())
+    return;
+  if (!is_file_url_ && gst_playbin_ && !is_pipeline_released_)
+    GetBufferedTimeRanges();
+  UpdateStates();
 }
 
 // To Update Buffered Ranges for Media Playback
@@ -666,9 +726,6 @@ void MediaPlayerBridgeGstreamer::GetBufferedTimeRanges() {
       gint64 start = 0, stop = 0;
       gst_query_parse_nth_buffering_range(query, range, &start, &stop);
       media::MediaPlayerTizen::TimeRanges b_range;
-      // Stop the Timer on Buffer completion
-      if(start == 0 && stop == 100)
-        StopBufferingUpdateTimer();
       // Parsed value is in percentage. Converted into time range
       b_range.start = static_cast<double>(start) * duration_ / 100
           * base::Time::kMicrosecondsPerSecond;
@@ -676,8 +733,12 @@ void MediaPlayerBridgeGstreamer::GetBufferedTimeRanges() {
           * base::Time::kMicrosecondsPerSecond;
       buffer_range.push_back(b_range);
     }
-    manager()->OnBufferUpdate(GetPlayerId(), buffer_range);
+    if (!SameTimeRanges(buffer_range, buffered_ranges_)) {
+      buffered_ranges_ = buffer_range;
+      manager()->OnBufferUpdate(GetPlayerId(), buffer_range);
+    }
   }
+  gst_query_unref(query);
 }
 
 void MediaPlayerBridgeGstreamer::HandleMessage(GstMessage* message) {
@@ -717,7 +778,6 @@ void MediaPlayerBridgeGstreamer::HandleMessage(GstMessage* message) {
     if (missing_plugins_)
       break;
 
-    StopBufferingUpdateTimer();
     GError* error;
     gst_message_parse_error(message, &error, NULL);
     MediaPlayerTizen::NetworkState network_state_error;
@@ -842,9 +902,6 @@ void MediaPlayerBridgeGstreamer::UpdateStates() {
       break;
     case GST_STATE_PAUSED:
     case GST_STATE_PLAYING:
-      if (!is_file_url_)
-        StartBufferingUpdateTimer();
-
       VLOG(1) << "state " << gst_element_state_get_name(state)
               << " buffered_ " << buffered_
               << " is_file_url_ " << is_file_url_
@@ -990,8 +1047,7 @@ void MediaPlayerBridgeGstreamer::OnPlaybackComplete() {
     LOG(ERROR) << "|device_power_release_lock| request failed";
 #endif
 
-  StopCurrentTimeUpdateTimer();
-  manager()->OnTimeUpdate(GetPlayerId(), GetCurrentTime());
+  UpdateMediaClock();
   manager()->OnTimeChanged(GetPlayerId());
 }
 
@@ -1002,6 +1058,7 @@ void MediaPlayerBridgeGstreamer::UpdateSeekState(bool state) {
 void MediaPlayerBridgeGstreamer::OnTimeChanged() {
   VLOG(1) << __FUNCTION__ << " : Player Id = " << GetPlayerId();
   DCHECK(main_loop_->BelongsToCurrentThread());
+  UpdateMediaClock();
   manager()->OnTimeChanged(GetPlayerId());
 }
 
@@ -1009,16 +1066,7 @@ void MediaPlayerBridgeGstreamer::OnUpdateStates() {
   VLOG(1) << __FUNCTION__ << " : Player Id = " << GetPlayerId();
   DCHECK(main_loop_->BelongsToCurrentThread());
   UpdateStates();
-}
-
-GstElement* MediaPlayerBridgeGstreamer::GetVideoSink() {
-#if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
-  is_pixmap_used_ = true;
-  return gst_element_factory_make("xvimagesink", kVideoSink);
-#else
-  is_pixmap_used_ = false;
-  return gst_element_factory_make("appsink", kVideoSink);
-#endif
+  UpdateMediaClock();
 }
 
 void MediaPlayerBridgeGstreamer::PrepareForVideoFrame() {
@@ -1093,6 +1141,7 @@ void MediaPlayerBridgeGstreamer::SetPixmap() {
 }
 
 void MediaPlayerBridgeGstreamer::PlatformSurfaceUpdated() {
+  first_frame_timer_.OnFrame();
   gint64 current_time = 0;
   GstFormat format = GST_FORMAT_TIME;
   gst_element_query_position(gst_playbin_, &format, &current_time);
@@ -9,6 +9,8 @@
 #include <gst/pbutils/install-plugins.h>
 #include <gst/pbutils/missing-plugins.h>
 
+#include <vector>
+
 #if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
 #include <Ecore.h>
 #include <Ecore_X.h>
@@ -16,9 +18,9 @@
 
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
-#include "base/timer/timer.h"
 #include "content/public/browser/browser_message_filter.h"
 #include "media/base/ranges.h"
+#include "media/base/tizen/gst_pipeline_pool_tizen.h"
 #include "media/base/tizen/media_player_tizen.h"
 #include "media/base/video_frame.h"
 
@@ -45,6 +47,10 @@ class MEDIA_EXPORT MediaPlayerBridgeGstreamer
   virtual void Seek(const double time) override;
   virtual void SetVolume(double volume) override;
   virtual double GetCurrentTime() override;
+  virtual int64 ReleaseIdleResources() override;
+  virtual bool Suspend() override;
+  virtual bool Resume() override;
+  virtual bool HasVideo() override;
   virtual void Destroy() override;
 
   // Error handling API
@@ -65,17 +71,17 @@ class MEDIA_EXPORT MediaPlayerBridgeGstreamer
   virtual void Release();
 
  private:
-  // |duration_update_timer_| related
-  void OnCurrentTimeUpdateTimerFired();
-  void StartCurrentTimeUpdateTimer();
-  void StopCurrentTimeUpdateTimer();
+  // Re-anchors the media clock at the current position. Called on every
+  // change to whether, or how fast, the pipeline advances.
+  void UpdateMediaClock();
 
-  // |Buffering_update_timer_| related
-  void OnBufferingUpdateTimerFired();
-  void StartBufferingUpdateTimer();
-  void StopBufferingUpdateTimer();
+  // Puts the pipeline back to READY, which frees decoders and queued
+  // buffers; Play() prerolls it again at |resume_position_|.
+  bool CanReleasePipeline() const;
+  bool ReleasePipeline();
 
   void UpdateStates();
+  void OnBufferingUpdated();
   void OnUpdateStates();
   void UpdateDuration();
   void UpdateMediaType();
@@ -90,7 +96,6 @@ class MEDIA_EXPORT MediaPlayerBridgeGstreamer
   void GetBufferedTimeRanges();
   bool SeekTo(gint64 position, float rate, GstSeekFlags seekType);
 
-  GstElement* GetVideoSink();
   void PrepareForVideoFrame();
 
 #if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
@@ -111,6 +116,11 @@ class MEDIA_EXPORT MediaPlayerBridgeGstreamer
 
   bool is_prerolled_;
   bool is_paused_;
+  // Pipeline was put back to READY by ReleaseIdleResources().
+  bool is_pipeline_released_;
+  double resume_position_;
+  // Suspend() paused a playing pipeline; Resume() plays it again.
+  bool resume_playing_;
   double duration_;
   double playback_rate_;
   int buffered_;
@@ -140,8 +150,10 @@ class MEDIA_EXPORT MediaPlayerBridgeGstreamer
   uint32 shared_memory_size;
   base::SharedMemoryHandle foreign_memory_handle;
 
-  base::RepeatingTimer<MediaPlayerBridgeGstreamer> current_time_update_timer_;
-  base::RepeatingTimer<MediaPlayerBridgeGstreamer> buffering_update_timer_;
+  // Last ranges sent, so unchanged buffering reports are not forwarded.
+  std::vector<media::MediaPlayerTizen::TimeRanges> buffered_ranges_;
+
+  FirstFrameTimerTizen first_frame_timer_;
 
   DISALLOW_COPY_AND_ASSIGN(MediaPlayerBridgeGstreamer);
 };
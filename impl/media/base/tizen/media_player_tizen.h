@@ -12,6 +12,7 @@
 #include "base/time/time.h"
 #include "content/common/media/tizen/media_player_messages_enums_tizen.h"
 #include "media/base/media_export.h"
+#include "media/base/tizen/media_clock_tizen.h"
 #include "url/gurl.h"
 
 namespace media {
@@ -84,9 +85,29 @@ class MEDIA_EXPORT MediaPlayerTizen{
 
   bool IsPlayerDestructing() { return destructing_; }
 
+  // Players that keep it updated create it; others report the time through
+  // MediaPlayerManager::OnTimeUpdate().
+  MediaClockTizen* media_clock() { return &media_clock_; }
+
   // Destroy this object when all messages for it are delivered
   virtual void Destroy() = 0;
 
+  // Drops decoder state a paused player can rebuild on the next Play().
+  // Returns an estimate of the bytes released.
+  virtual int64 ReleaseIdleResources() { return 0; }
+
+  // Pauses and releases the pipeline's decoders, keeping only the position
+  // and configuration, until the next Play() or Resume(). Returns false if
+  // the player cannot be suspended in its current state.
+  virtual bool Suspend() { return false; }
+
+  // Prerolls a suspended player again if it was playing when suspended.
+  // Returns true if it is playing again.
+  virtual bool Resume() { return false; }
+
+  // Whether the media has a video track, and so holds a video decoder.
+  virtual bool HasVideo() { return false; }
+
  protected:
   // Release the player resources.
   virtual void Release() = 0;
@@ -105,6 +126,8 @@ class MEDIA_EXPORT MediaPlayerTizen{
   // Resource manager for all the media players.
   MediaPlayerManager* manager_;
 
+  MediaClockTizen media_clock_;
+
   DISALLOW_COPY_AND_ASSIGN(MediaPlayerTizen);
 };
 
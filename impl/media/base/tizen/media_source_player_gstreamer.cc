@@ -27,9 +27,6 @@ const uint SN12_TILE_SIZE = SN12_TILE_WIDTH * SN12_TILE_HEIGHT;
 // Pipeline element name
 const char* kPipelineName = "gst_pipeline";
 
-// Update duration every 100ms.
-const int kDurationUpdateInterval = 100;
-
 // For smooth playback, seeking will be done to I-Frame + kSixteenMilliSeconds
 // Reason to choose kSixteenMilliSeconds is duration of each video frame at
 // 60 fps video will be ~16 milliseconds.
@@ -79,6 +76,30 @@ const VideoCodecGstElementsMapping VideoMapping[] = {
     {media::kUnknownVideoCodec, NULL}
 };
 
+// Pooled pipelines are only interchangeable between streams that need the
+// same decoders.
+std::string GetPipelineKey(const media::DemuxerConfigs& configs) {
+  std::string key("mse");
+  for (int i = 0; VideoMapping[i].codec != media::kUnknownVideoCodec; ++i) {
+    if (configs.video_codec == VideoMapping[i].codec)
+      key.append(":").append(VideoMapping[i].elements[1]);
+  }
+  for (int i = 0; AudioMapping[i].codec != media::kUnknownAudioCodec; ++i) {
+    if (configs.audio_codec == AudioMapping[i].codec)
+      key.append(":").append(AudioMapping[i].elements[1]);
+  }
+  return key;
+}
+
+// The bin holds the element, so the returned pointer stays valid as long as
+// |bin| does.
+GstElement* GetBinElement(GstElement* bin, const char* name) {
+  GstElement* element = gst_bin_get_by_name(GST_BIN(bin), name);
+  if (element)
+    gst_object_unref(element);
+  return element;
+}
+
 GstClockTime ConvertToGstClockTime(double time) {
   if (time < 0) {
     LOG(ERROR) << "Invalid time:" << time << " Reset to 0";
@@ -363,10 +384,14 @@ MediaSourcePlayerGstreamer::MediaSourcePlayerGstreamer(
       is_download_finished_(false),
       is_end_reached_(false),
       error_occured_(false),
+      is_suspended_(false),
+      resume_position_(0),
       raw_video_frame_size_(0),
       video_seek_offset_(0),
       audio_seek_offset_(0),
-      is_seeking_iframe_(false) {
+      is_seeking_iframe_(false),
+      first_frame_timer_("MSE") {
+  media_clock()->Create();
   demuxer_->Initialize(this);
   audio_buffer_queue_.clear();
   video_buffer_queue_.clear();
@@ -404,6 +429,13 @@ void MediaSourcePlayerGstreamer::Play() {
     playing_ = true;
     return;
   }
+  if (is_suspended_) {
+    // Plays once the seek back to the saved position completes.
+    playing_ = true;
+    PrerollSuspendedPipeline();
+    RequestPlayerSeek(resume_position_);
+    return;
+  }
 #if defined(OS_TIZEN_TV)
   if (!audio_session_manager_->SetSoundState(ASM_STATE_PLAYING))
     return;
@@ -420,14 +452,20 @@ void MediaSourcePlayerGstreamer::Play() {
 #endif
 
   gst_element_set_state(pipeline_, GST_STATE_PLAYING);
-  StartCurrentTimeUpdateTimer();
   playing_ = true;
   is_paused_due_underflow_ = false;
+  UpdateMediaClock();
 }
 
 void MediaSourcePlayerGstreamer::Pause(bool is_media_related_action) {
   if (!pipeline_ || error_occured_)
     return;
+  if (is_suspended_) {
+    // Stays suspended until Play() prerolls it again.
+    if (!is_media_related_action)
+      playing_ = false;
+    return;
+  }
 
 #if defined(OS_TIZEN_TV)
   if (!audio_session_manager_->SetSoundState(ASM_STATE_PAUSE))
@@ -437,7 +475,7 @@ void MediaSourcePlayerGstreamer::Pause(bool is_media_related_action) {
   VLOG(1) << "MediaSourcePlayerGstreamer::" << __FUNCTION__;
   gst_element_set_state(pipeline_, GST_STATE_PAUSED);
 
-  StopCurrentTimeUpdateTimer();
+  UpdateMediaClock();
   if (!is_media_related_action) {
 
 #if defined(OS_TIZEN_MOBILE) && (defined(TIZEN_V_2_3) || defined(TIZEN_V_2_4))
@@ -464,10 +502,8 @@ void MediaSourcePlayerGstreamer::SetRate(double rate) {
   }
 
   // If rate was zero and requested rate is non-zero, change the paused state
-  if(play_rate_ == 0.0 && rate != 0.0) {
+  if(play_rate_ == 0.0 && rate != 0.0)
     Play();
-    StartCurrentTimeUpdateTimer();
-  }
 
   play_rate_ = rate;
 
@@ -500,6 +536,10 @@ void MediaSourcePlayerGstreamer::Seek(const double time) {
   VLOG(1) << "MediaSourcePlayerGstreamer::" << __FUNCTION__
           << " : " << time << " state : " << gst_element_state_get_name(state);
 
+  // The seek refills the pipeline from the demuxer.
+  if (is_suspended_)
+    PrerollSuspendedPipeline();
+
   is_demuxer_seeking_ = true;
   if (state == GST_STATE_PLAYING)
     Pause(true);
@@ -530,6 +570,7 @@ void MediaSourcePlayerGstreamer::SeekInternal(const GstClockTime position) {
   VLOG(1) << "MediaSourcePlayerGstreamer::" << __FUNCTION__
           << " : " << position;
 
+  is_end_reached_ = false;
   UpdateSeekState(true);
   audio_buffer_queue_.clear();
   video_buffer_queue_.clear();
@@ -545,17 +586,71 @@ double MediaSourcePlayerGstreamer::GetCurrentTime() {
   if (!pipeline_ || error_occured_)
     return 0.0;
 
+  // Position queries on a READY pipeline return 0.
+  if (is_suspended_)
+    return resume_position_;
+
   gint64 current_time = 0;
   GstFormat format = GST_FORMAT_TIME;
   gst_element_query_position(pipeline_, &format, &current_time);
   return ConvertNanoSecondsToSeconds(current_time);
 }
 
+bool MediaSourcePlayerGstreamer::Suspend() {
+  if (!pipeline_ || error_occured_ || is_suspended_)
+    return false;
+  if (is_seeking_ || is_demuxer_seeking_)
+    return false;
+
+  // A media related pause keeps |playing_|, which Resume() plays again on.
+  Pause(true);
+  resume_position_ = GetCurrentTime();
+  // READY keeps the elements but frees decoders and queued buffers.
+  if (gst_element_set_state(
+      pipeline_, GST_STATE_READY) == GST_STATE_CHANGE_FAILURE) {
+    LOG(ERROR) << "GStreamer state change failed in READY";
+    return false;
+  }
+  audio_buffer_queue_.clear();
+  video_buffer_queue_.clear();
+#if defined(OS_TIZEN_TV)
+  audio_session_manager_->DeallocateResources();
+#endif
+  is_suspended_ = true;
+  is_paused_due_underflow_ = false;
+  UpdateMediaClock();
+  VLOG(1) << "MediaSourcePlayerGstreamer::" << __FUNCTION__
+          << " Player ID : " << GetPlayerId()
+          << " position " << resume_position_;
+  return true;
+}
+
+bool MediaSourcePlayerGstreamer::Resume() {
+  if (!is_suspended_ || !playing_)
+    return false;
+  Play();
+  return true;
+}
+
+void MediaSourcePlayerGstreamer::PrerollSuspendedPipeline() {
+  is_suspended_ = false;
+#if defined(OS_TIZEN_TV)
+  if (audio_decoder_ && audio_sink_) {
+    audio_session_manager_->AllocateResources(audio_decoder_);
+    audio_session_manager_->AllocateResources(audio_sink_);
+  }
+#endif
+  if (gst_element_set_state(
+      pipeline_, GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE) {
+    LOG(ERROR) << "GStreamer state change failed in PAUSE";
+    HandleError(MediaPlayerTizen::NetworkStateDecodeError);
+  }
+}
+
 void MediaSourcePlayerGstreamer::Release() {
   VLOG(1) << "MediaSourcePlayerGstreamer::" << __FUNCTION__;
   DCHECK(IsPlayerDestructing());
   playing_ = false;
-  StopCurrentTimeUpdateTimer();
   audio_buffer_queue_.clear();
   video_buffer_queue_.clear();
 
@@ -568,8 +663,13 @@ void MediaSourcePlayerGstreamer::Release() {
       gst_object_unref(bus);
     }
 
-    gst_element_set_state(pipeline_, GST_STATE_NULL);
-    gst_object_unref(pipeline_);
+    if (CanReturnPipeline()) {
+      GstPipelinePoolTizen::GetInstance()->ReturnPipeline(
+          pipeline_key_, pipeline_);
+    } else {
+      gst_element_set_state(pipeline_, GST_STATE_NULL);
+      gst_object_unref(pipeline_);
+    }
     pipeline_ = NULL;
   }
 
@@ -642,6 +742,17 @@ void MediaSourcePlayerGstreamer::OnDemuxerConfigsAvailable(
   }
 
   if (gst_is_initialized() && !err) {
+    pipeline_key_ = GetPipelineKey(configs);
+    pipeline_ =
+        GstPipelinePoolTizen::GetInstance()->ClaimPipeline(pipeline_key_);
+    if (pipeline_) {
+      first_frame_timer_.Start(true);
+      AttachPooledPipeline();
+      StartPipeline();
+      return;
+    }
+
+    first_frame_timer_.Start(false);
     pipeline_ = gst_pipeline_new(kPipelineName);
     if (!pipeline_) {
       LOG(ERROR) << "Unable to Create |Pipeline|";
@@ -716,14 +827,6 @@ void MediaSourcePlayerGstreamer::OnDemuxerConfigsAvailable(
 
         gst_element_link_many(video_appsrc_,video_queue_, video_parse_,
             video_decoder_, video_sink_, NULL);
-        static GstAppSrcCallbacks video_callbacks = {
-            on_gst_start_video_feed_cb,
-            on_gst_stop_video_feed_cb,
-            on_gst_seek_video_feed_cb, {NULL}};
-
-        // FIXME: Try fourth argument for destructy notification.
-        gst_app_src_set_callbacks(GST_APP_SRC(video_appsrc_), &video_callbacks,
-            this, NULL);
         break;
       }
       i++;
@@ -788,42 +891,100 @@ void MediaSourcePlayerGstreamer::OnDemuxerConfigsAvailable(
         gst_element_link_many(audio_appsrc_, audio_queue_, audio_parse_,
             audio_decoder_, audio_convert_, audio_resampler_, audio_volume_,
             audio_sink_, NULL);
-
-        static GstAppSrcCallbacks audio_callbacks = {
-            on_gst_start_audio_feed_cb,
-            on_gst_stop_audio_feed_cb,
-            on_gst_seek_audio_feed_cb, {NULL}};
-
-        gst_app_src_set_callbacks(GST_APP_SRC(audio_appsrc_), &audio_callbacks,
-            this, NULL);
         break;
       }
       i++;
     }
 
-    GstBus*bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
-    if (!bus) {
-      LOG(ERROR) << "GStreamer bus creation failed";
-      HandleError(MediaPlayerTizen::NetworkStateDecodeError);
-      return;
-    }
-    gst_bus_set_sync_handler(
-        bus, (GstBusSyncHandler)gst_pipeline_message_cb, this);
-    gst_object_unref(bus);
+    StartPipeline();
+  } else {
+    LOG(ERROR) << "Unable to initialize GST";
+    HandleError(MediaPlayerTizen::NetworkStateDecodeError);
+  }
+}
 
-    manager()->OnMediaDataChange(GetPlayerId(), video_format_,
-        gst_height_, gst_width_, media_type);
+void MediaSourcePlayerGstreamer::AttachPooledPipeline() {
+  VLOG(1) << "MediaSource reusing pipeline " << pipeline_key_;
+  video_appsrc_ = GetBinElement(pipeline_, "video-source");
+  if (video_appsrc_) {
+    media_type |= MEDIA_VIDEO_MASK;
+    video_queue_ = GetBinElement(pipeline_, "video-queue");
+    video_parse_ = GetBinElement(pipeline_, "video-parse");
+    video_decoder_ = GetBinElement(pipeline_, "video-decoder");
+    video_sink_ = GetBinElement(pipeline_, "sink");
+    // Only |appsink| backed pipelines are pooled, see CanReturnPipeline().
+    is_xwindow_handle_set_ = true;
+    SetVideoSinkCallbacks();
+  }
 
-    manager()->OnReadyStateChange(GetPlayerId(),
-        MediaPlayerTizen::ReadyStateHaveMetadata);
+  audio_appsrc_ = GetBinElement(pipeline_, "audio-source");
+  if (audio_appsrc_) {
+    media_type |= MEDIA_AUDIO_MASK;
+    audio_queue_ = GetBinElement(pipeline_, "audio-queue");
+    audio_parse_ = GetBinElement(pipeline_, "audio-parse");
+    audio_decoder_ = GetBinElement(pipeline_, "audio-decoder");
+    audio_convert_ = GetBinElement(pipeline_, "audio-convert");
+    audio_resampler_ = GetBinElement(pipeline_, "audio-resample");
+    audio_volume_ = GetBinElement(pipeline_, "volume");
+    audio_sink_ = GetBinElement(pipeline_, "audio-sink");
+    // Back to the defaults of a new |volume| element, the previous player
+    // may have changed both.
+    g_object_set(G_OBJECT(audio_volume_), "volume", 1.0, "mute", false, NULL);
+  }
+}
 
-    if (gst_element_set_state(pipeline_, GST_STATE_PAUSED) ==
-        GST_STATE_CHANGE_FAILURE)
-      LOG(ERROR) << "GStreamer state change failed";
-  } else {
-    LOG(ERROR) << "Unable to initialize GST";
+void MediaSourcePlayerGstreamer::StartPipeline() {
+  if (video_appsrc_) {
+    static GstAppSrcCallbacks video_callbacks = {
+        on_gst_start_video_feed_cb,
+        on_gst_stop_video_feed_cb,
+        on_gst_seek_video_feed_cb, {NULL}};
+
+    // FIXME: Try fourth argument for destructy notification.
+    gst_app_src_set_callbacks(GST_APP_SRC(video_appsrc_), &video_callbacks,
+        this, NULL);
+  }
+
+  if (audio_appsrc_) {
+    static GstAppSrcCallbacks audio_callbacks = {
+        on_gst_start_audio_feed_cb,
+        on_gst_stop_audio_feed_cb,
+        on_gst_seek_audio_feed_cb, {NULL}};
+
+    gst_app_src_set_callbacks(GST_APP_SRC(audio_appsrc_), &audio_callbacks,
+        this, NULL);
+  }
+
+  GstBus*bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
+  if (!bus) {
+    LOG(ERROR) << "GStreamer bus creation failed";
     HandleError(MediaPlayerTizen::NetworkStateDecodeError);
+    return;
   }
+  gst_bus_set_sync_handler(
+      bus, (GstBusSyncHandler)gst_pipeline_message_cb, this);
+  gst_object_unref(bus);
+
+  manager()->OnMediaDataChange(GetPlayerId(), video_format_,
+      gst_height_, gst_width_, media_type);
+
+  manager()->OnReadyStateChange(GetPlayerId(),
+      MediaPlayerTizen::ReadyStateHaveMetadata);
+
+  if (gst_element_set_state(pipeline_, GST_STATE_PAUSED) ==
+      GST_STATE_CHANGE_FAILURE)
+    LOG(ERROR) << "GStreamer state change failed";
+}
+
+bool MediaSourcePlayerGstreamer::CanReturnPipeline() const {
+  if (!pipeline_ || error_occured_ || is_backed_by_pixmap)
+    return false;
+#if defined(OS_TIZEN_TV)
+  // |alsasink| keeps the audio device open in READY.
+  if (audio_sink_)
+    return false;
+#endif
+  return true;
 }
 
 #if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
@@ -849,13 +1010,19 @@ void MediaSourcePlayerGstreamer::PrepareForVideoFrame() {
   is_xwindow_handle_set_ = true;
   VLOG(1) << "MediaSource using |appsink| for Video Playback";
   video_sink_ = gst_element_factory_make("appsink", "sink");
+  if (!video_sink_)
+    return;
+  SetVideoSinkCallbacks();
+  g_object_set(G_OBJECT(video_sink_), "max-buffers", (guint)1, NULL);
+}
+
+void MediaSourcePlayerGstreamer::SetVideoSinkCallbacks() {
   GstAppSinkCallbacks callbacks = {NULL,
       on_gst_appsink_preroll,
       on_gst_appsink_buffer,
       NULL, {NULL, NULL, NULL}};
   gst_app_sink_set_callbacks(GST_APP_SINK(video_sink_), &callbacks,
       this, NULL);
-  g_object_set(G_OBJECT(video_sink_), "max-buffers", (guint)1, NULL);
 }
 
 void MediaSourcePlayerGstreamer::ReadDemuxedData(
@@ -1210,6 +1377,7 @@ void MediaSourcePlayerGstreamer::OnNewFrameAvailable(const GstBuffer* buffer) {
   if (!GST_BUFFER_DATA(buffer) || !GST_BUFFER_SIZE(buffer))
     return;
 
+  first_frame_timer_.OnFrame();
   if (!gst_width_ || !gst_height_)
     GetFrameDetails();
   // FIXME: Cross check the end results.
@@ -1268,6 +1436,7 @@ void MediaSourcePlayerGstreamer::XWindowIdPrepared(GstMessage* message) {
 }
 
 void MediaSourcePlayerGstreamer::PlatformSurfaceUpdated() {
+  first_frame_timer_.OnFrame();
   gint64 current_time = 0;
   GstFormat format = GST_FORMAT_TIME;
   gst_element_query_position(pipeline_, &format, &current_time);
@@ -1384,22 +1553,18 @@ bool MediaSourcePlayerGstreamer::HasAudio() {
   return media_type & MEDIA_AUDIO_MASK;
 }
 
-void MediaSourcePlayerGstreamer::OnCurrentTimeUpdateTimerFired() {
-  manager()->OnTimeUpdate(GetPlayerId(), GetCurrentTime());
-}
-
-void MediaSourcePlayerGstreamer::StartCurrentTimeUpdateTimer() {
-  if (!current_time_update_timer_.IsRunning()) {
-    current_time_update_timer_.Start(
-        FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kDurationUpdateInterval),
-        this, &MediaSourcePlayerGstreamer::OnCurrentTimeUpdateTimerFired);
+void MediaSourcePlayerGstreamer::UpdateMediaClock() {
+  // GStreamer EOS time and the media duration do not always match.
+  if (is_end_reached_) {
+    media_clock()->Update(duration_, 0.0);
+    return;
   }
-}
 
-void MediaSourcePlayerGstreamer::StopCurrentTimeUpdateTimer() {
-  if (current_time_update_timer_.IsRunning())
-    current_time_update_timer_.Stop();
+  GstState state = GST_STATE_NULL;
+  if (pipeline_ && !error_occured_)
+    gst_element_get_state(pipeline_, &state, NULL, 0);
+  bool advancing = state == GST_STATE_PLAYING && !is_seeking_;
+  media_clock()->Update(GetCurrentTime(), advancing ? play_rate_ : 0.0);
 }
 
 void MediaSourcePlayerGstreamer::HandleMessage(GstMessage* message) {
@@ -1476,7 +1641,6 @@ void MediaSourcePlayerGstreamer::HandleMessage(GstMessage* message) {
         main_loop_->PostTask(FROM_HERE, base::Bind(
             &MediaSourcePlayerGstreamer::Play, base::Unretained(this)));
 
-      manager()->OnTimeUpdate(GetPlayerId(), GetCurrentTime());
       main_loop_->PostTask(FROM_HERE, base::Bind(
           &MediaSourcePlayerGstreamer::OnTimeChanged, base::Unretained(this)));
     }
@@ -1540,6 +1704,8 @@ void MediaSourcePlayerGstreamer::OnUpdateStates() {
           << gst_element_state_get_name(pending)
           << " ID " << GetPlayerId();
 
+  UpdateMediaClock();
+
   // FIXME: Handle all state changes
   switch (ret) {
   case GST_STATE_CHANGE_SUCCESS:
@@ -1594,12 +1760,9 @@ void MediaSourcePlayerGstreamer::HandleBufferingMessage() {
 }
 
 void MediaSourcePlayerGstreamer::OnPlaybackComplete() {
-  // GStreamer pipeline EOS time and media duration doesnt match.
-  double time = GetCurrentTime() != duration_ ? duration_ : GetCurrentTime();
   is_end_reached_ = true;
   is_download_finished_ = false;
-  StopCurrentTimeUpdateTimer();
-  manager()->OnTimeUpdate(GetPlayerId(), time);
+  UpdateMediaClock();
   manager()->OnTimeChanged(GetPlayerId());
 
 #if defined(OS_TIZEN_MOBILE) && (defined(TIZEN_V_2_3) || defined(TIZEN_V_2_4))
@@ -1617,6 +1780,7 @@ void MediaSourcePlayerGstreamer::UpdateSeekState(bool state) {
 void MediaSourcePlayerGstreamer::OnTimeChanged() {
   VLOG(1) << "OnTimeChanged" << "Player ID : " << GetPlayerId();
   DCHECK(main_loop_->BelongsToCurrentThread());
+  UpdateMediaClock();
   manager()->OnTimeChanged(GetPlayerId());
 }
 
@@ -15,8 +15,8 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/threading/thread.h"
 #include "base/time/default_tick_clock.h"
-#include "base/timer/timer.h"
 #include "media/base/tizen/demuxer_tizen.h"
+#include "media/base/tizen/gst_pipeline_pool_tizen.h"
 #include "media/base/tizen/media_player_tizen.h"
 #include "media/base/decoder_buffer.h"
 
@@ -63,6 +63,9 @@ class MEDIA_EXPORT MediaSourcePlayerGstreamer : public MediaPlayerTizen,
   virtual void Seek(const double time) override;
   virtual void SetVolume(double volume) override;
   virtual double GetCurrentTime() override;
+  virtual bool Suspend() override;
+  virtual bool Resume() override;
+  virtual bool HasVideo() override;
   virtual void Destroy() override;
 
   // DemuxerTizenClient implementation.
@@ -106,6 +109,13 @@ class MEDIA_EXPORT MediaSourcePlayerGstreamer : public MediaPlayerTizen,
 
  private:
   void PrepareForVideoFrame();
+  void SetVideoSinkCallbacks();
+
+  // Picks up the elements of a pipeline claimed from GstPipelinePoolTizen.
+  void AttachPooledPipeline();
+  // Hooks this player up to |pipeline_| and prerolls it.
+  void StartPipeline();
+  bool CanReturnPipeline() const;
 
 #if defined(TIZEN_MULTIMEDIA_PIXMAP_SUPPORT)
   void PrepareForVideoSink();
@@ -124,7 +134,6 @@ class MEDIA_EXPORT MediaSourcePlayerGstreamer : public MediaPlayerTizen,
   void ReadFromQueueIfAny(DemuxerStream::Type type);
 
   bool HasAudio();
-  bool HasVideo();
 
   // Note: Must be invoked only if elements are not added into the pipeline.
   void ReleaseAudioElements();
@@ -135,10 +144,13 @@ class MEDIA_EXPORT MediaSourcePlayerGstreamer : public MediaPlayerTizen,
   // For internal seeks.
   void RequestPlayerSeek(double seekTime);
 
-  // |current_time_update_timer_| related
-  void OnCurrentTimeUpdateTimerFired();
-  void StartCurrentTimeUpdateTimer();
-  void StopCurrentTimeUpdateTimer();
+  // Takes a suspended pipeline from READY back to PAUSED. The caller seeks
+  // it so that the demuxer feeds it again.
+  void PrerollSuspendedPipeline();
+
+  // Re-anchors the media clock at the current position. Called on every
+  // change to whether, or how fast, the pipeline advances.
+  void UpdateMediaClock();
   void OnGetFrameDetails();
 
   void OnUpdateStates();
@@ -182,6 +194,8 @@ class MEDIA_EXPORT MediaSourcePlayerGstreamer : public MediaPlayerTizen,
   bool is_backed_by_pixmap;
 
   GstElement* pipeline_;
+  // GstPipelinePoolTizen key of |pipeline_|, from the codecs it decodes.
+  std::string pipeline_key_;
   GstElement* video_appsrc_;
   GstElement* video_parse_;
   GstElement* video_decoder_;
@@ -227,7 +241,11 @@ class MEDIA_EXPORT MediaSourcePlayerGstreamer : public MediaPlayerTizen,
   bool is_end_reached_;
   bool error_occured_;
 
-  base::RepeatingTimer<MediaSourcePlayerGstreamer> current_time_update_timer_;
+  // Suspend() left the pipeline in READY; |resume_position_| is where it
+  // prerolls again.
+  bool is_suspended_;
+  double resume_position_;
+
   int raw_video_frame_size_;
   guint64 video_seek_offset_;
   guint64 audio_seek_offset_;
@@ -241,6 +259,8 @@ class MEDIA_EXPORT MediaSourcePlayerGstreamer : public MediaPlayerTizen,
   // gst-pipeline is also seeked to nearest I-Frame i.e. |x-delta_x|.
   bool is_seeking_iframe_;
 
+  FirstFrameTimerTizen first_frame_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(MediaSourcePlayerGstreamer);
 };
 
@@ -6,6 +6,8 @@
 
 #include <gst/gst.h>
 
+#include <algorithm>
+
 #include "cc/blink/web_layer_impl.h"
 #include "cc/layers/video_layer.h"
 #include "content/renderer/media/render_media_log.h"
@@ -291,6 +293,10 @@ double WebMediaPlayerTizen::duration() const {
 double WebMediaPlayerTizen::currentTime() const {
   if (seeking())
     return pending_seek_ ? pending_seek_time_ : seek_time_;
+  if (media_clock_.IsValid()) {
+    double time = media_clock_.GetCurrentTime();
+    return duration_ > 0 ? std::min(time, duration_) : time;
+  }
   return current_time_;
 }
 
@@ -570,6 +576,12 @@ scoped_refptr<media::VideoFrame>
   return video_frame;
 }
 
+void WebMediaPlayerTizen::OnMediaClockCreated(
+    base::SharedMemoryHandle handle) {
+  if (!media_clock_.Map(handle))
+    LOG(ERROR) << "Falling back to time updates for player " << player_id_;
+}
+
 void WebMediaPlayerTizen::OnTimeUpdate(double current_time) {
   current_time_ = current_time;
 }
@@ -9,6 +9,7 @@
 #include "cc/layers/video_frame_provider_client_impl.h"
 #include "content/renderer/media/tizen/media_source_delegate_tizen.h"
 #include "content/renderer/media/tizen/renderer_media_player_manager_tizen.h"
+#include "media/base/tizen/media_clock_tizen.h"
 #include "media/blink/video_frame_compositor.h"
 #include "media/filters/skcanvas_video_renderer.h"
 
@@ -120,6 +121,7 @@ class WebMediaPlayerTizen
 
   void OnMediaDataChange(int format, int height, int width, int media);
   void OnDurationChange(double duration);
+  void OnMediaClockCreated(base::SharedMemoryHandle handle);
   void OnTimeUpdate(double current_time);
   void OnBufferUpdate(
       std::vector<media::MediaPlayerTizen::TimeRanges> buffer_range);
@@ -190,6 +192,8 @@ class WebMediaPlayerTizen
   bool audio_;
   bool video_;
 
+  // Read instead of |current_time_| once the browser player shares it.
+  MediaClockTizen media_clock_;
   double current_time_;
   double duration_;
   bool is_paused_;
@@ -10,17 +10,28 @@
 #include "base/allocator/allocator_extension.h"
 #include "base/bind.h"
 #include "base/threading/thread.h"
+#include "browser/favicon/favicon_database.h"
+#include "browser/renderer_host/render_widget_host_view_efl.h"
+#include "common/memory_purge_stats_efl.h"
 #include "common/render_messages_efl.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/proxy/proxy_resolver.h"
-#include "net/proxy/proxy_service.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/host_resolver.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_transaction_factory.h"
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_getter.h"
 
+#if defined(TIZEN_MULTIMEDIA_SUPPORT)
+#include "content/browser/media/tizen/browser_media_player_manager_tizen.h"
+#endif
+
 using content::BrowserContext;
 using content::BrowserThread;
+using tizen_webview::Memory_Pressure_Level;
 
 // PurgeMemoryHelper -----------------------------------------------------------
 
@@ -36,7 +47,7 @@ class PurgeMemoryIOHelper
   void AddRequestContextGetter(
       scoped_refptr<net::URLRequestContextGetter> request_context_getter);
 
-  void PurgeMemoryOnIOThread();
+  void PurgeMemoryOnIOThread(Memory_Pressure_Level level);
 
  private:
   friend class base::RefCountedThreadSafe<PurgeMemoryIOHelper>;
@@ -54,44 +65,78 @@ void PurgeMemoryIOHelper::AddRequestContextGetter(
   request_context_getters_.push_back(request_context_getter);
 }
 
-void PurgeMemoryIOHelper::PurgeMemoryOnIOThread() {
-  // Ask ProxyServices to purge any memory they can (generally garbage in the
-  // wrapped ProxyResolver's JS engine).
-#warning "[M37] Fix memory purge"
-#if 0
+void PurgeMemoryIOHelper::PurgeMemoryOnIOThread(Memory_Pressure_Level level) {
   for (size_t i = 0; i < request_context_getters_.size(); ++i) {
-    request_context_getters_[i]->GetURLRequestContext()->proxy_service()->
-        PurgeMemory();
+    net::URLRequestContext* context =
+        request_context_getters_[i]->GetURLRequestContext();
+    if (!context)
+      continue;
+
+    // Idle sockets keep their read buffers and SSL state alive.
+    net::HttpTransactionFactory* factory = context->http_transaction_factory();
+    if (factory && factory->GetSession())
+      factory->GetSession()->CloseIdleConnections();
+
+    if (level != tizen_webview::TW_MEMORY_PRESSURE_LEVEL_CRITICAL)
+      continue;
+
+    net::HostCache* host_cache = context->host_resolver() ?
+        context->host_resolver()->GetHostCache() : NULL;
+    if (host_cache)
+      host_cache->clear();
   }
-#endif
 }
 
 // -----------------------------------------------------------------------------
 
 // static
-void MemoryPurger::PurgeAll(BrowserContext* browser_context) {
-  PurgeBrowser(browser_context);
-  PurgeRenderers();
+void MemoryPurger::PurgeAll(BrowserContext* browser_context,
+                            Memory_Pressure_Level level) {
+  PurgeBrowser(browser_context, level);
+  PurgeRenderers(level);
   // TODO(pk):
   // * Tell the plugin processes to release their free memory?  Other stuff?
   // * Enumerate what other processes exist and what to do for them.
 }
 
 // static
-void MemoryPurger::PurgeBrowser(BrowserContext* browser_context) {
-  // Dump the backing stores.
-#warning "[M37] backing stores were removed, so the code below is probably safe to remove, check this."
-  //content::RenderWidgetHost::RemoveAllBackingStores();
+void MemoryPurger::PurgeBrowser(BrowserContext* browser_context,
+                                Memory_Pressure_Level level) {
+  // Favicon bitmaps are backed by the database and are read back on demand.
+  memory_purge_stats::RecordReclaimedBytes(
+      memory_purge_stats::FAVICON_DATABASE,
+      FaviconDatabase::Instance()->PurgeMemory());
+
+#if defined(TIZEN_MULTIMEDIA_SUPPORT)
+  // Paused players preroll again when playback is resumed.
+  memory_purge_stats::RecordReclaimedBytes(
+      memory_purge_stats::MEDIA_PIPELINES,
+      content::BrowserMediaPlayerManagerTizen::ReleaseIdlePlayers());
+#endif
+
+  if (level == tizen_webview::TW_MEMORY_PRESSURE_LEVEL_CRITICAL) {
+    // Hidden views recreate their surface, and repaint, when shown again.
+    int64 gpu_bytes = 0;
+    scoped_ptr<content::RenderWidgetHostIterator> widgets(
+        content::RenderWidgetHost::GetRenderWidgetHosts());
+    while (content::RenderWidgetHost* widget = widgets->GetNextHost()) {
+      content::RenderWidgetHostViewEfl* view =
+          static_cast<content::RenderWidgetHostViewEfl*>(widget->GetView());
+      if (view)
+        gpu_bytes += view->ReleaseGpuResourcesIfHidden();
+    }
+    memory_purge_stats::RecordReclaimedBytes(
+        memory_purge_stats::HIDDEN_VIEW_GPU_SURFACES, gpu_bytes);
+  }
+
   scoped_refptr<PurgeMemoryIOHelper> purge_memory_io_helper(
       new PurgeMemoryIOHelper());
   purge_memory_io_helper->AddRequestContextGetter(
         make_scoped_refptr(browser_context->GetRequestContext()));
-#warning "[M37] Another non existing function"
-  //BrowserContext::PurgeMemory(browser_context);
   BrowserThread::PostTask(
       BrowserThread::IO, FROM_HERE,
       base::Bind(&PurgeMemoryIOHelper::PurgeMemoryOnIOThread,
-                 purge_memory_io_helper.get()));
+                 purge_memory_io_helper.get(), level));
   // Tell our allocator to release any free pages it's still holding.
   //
   // TODO(pk): A lot of the above calls kick off actions on other threads.
@@ -101,7 +146,7 @@ void MemoryPurger::PurgeBrowser(BrowserContext* browser_context) {
 }
 
 // static
-void MemoryPurger::PurgeRenderers() {
+void MemoryPurger::PurgeRenderers(Memory_Pressure_Level level) {
   // Direct all renderers to free everything they can.
   //
   // Concern: Telling a bunch of renderer processes to destroy their data may
@@ -110,13 +155,13 @@ void MemoryPurger::PurgeRenderers() {
   for (content::RenderProcessHost::iterator i(
           content::RenderProcessHost::AllHostsIterator());
        !i.IsAtEnd(); i.Advance())
-    PurgeRendererForHost(i.GetCurrentValue());
+    PurgeRendererForHost(i.GetCurrentValue(), level);
 }
 
 // static
-void MemoryPurger::PurgeRendererForHost(content::RenderProcessHost* host) {
-#if !defined(EWK_BRINGUP)
-  // Direct the renderer to free everything it can.
-  host->Send(new EwkViewMsg_PurgeMemory());
-#endif
+void MemoryPurger::PurgeRendererForHost(content::RenderProcessHost* host,
+                                        Memory_Pressure_Level level) {
+  // Direct the renderer to free everything it can. The renderer records the
+  // bytes reclaimed by every stage on its side.
+  host->Send(new EwkViewMsg_PurgeMemory(level));
 }
@@ -10,12 +10,15 @@
 // This was implemented in an attempt to speed up suspend-to-disk by throwing
 // away any cached data that can be recomputed.  Memory use will rapidly
 // re-expand after this purge is run.
+//
+// Every stage reports the bytes it reclaimed through memory_purge_stats.
 
 #ifndef MEMORY_PURGER_H_
 #define MEMORY_PURGER_H_
 
 #include "base/basictypes.h"
 #include "content/public/browser/browser_context.h"
+#include "tizen_webview/public/tw_memory_pressure_level.h"
 
 namespace content {
 class RenderProcessHost;
@@ -24,10 +27,15 @@ class RenderProcessHost;
 class MemoryPurger {
  public:
   // Call any of these on the UI thread to purge memory from the named places.
-  static void PurgeAll(content::BrowserContext* browser_context);
-  static void PurgeBrowser(content::BrowserContext* browser_context);
-  static void PurgeRenderers();
-  static void PurgeRendererForHost(content::RenderProcessHost* host);
+  // At moderate level only caches that are cheap to rebuild are dropped,
+  // critical level frees everything that can be recomputed.
+  static void PurgeAll(content::BrowserContext* browser_context,
+                       tizen_webview::Memory_Pressure_Level level);
+  static void PurgeBrowser(content::BrowserContext* browser_context,
+                           tizen_webview::Memory_Pressure_Level level);
+  static void PurgeRenderers(tizen_webview::Memory_Pressure_Level level);
+  static void PurgeRendererForHost(content::RenderProcessHost* host,
+                                   tizen_webview::Memory_Pressure_Level level);
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryPurger);
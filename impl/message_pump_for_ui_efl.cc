@@ -4,10 +4,14 @@
 
 #include "message_pump_for_ui_efl.h"
 
+#include <algorithm>
+
+#include "base/debug/trace_event.h"
+#include "base/logging.h"
+#include "base/metrics/histogram.h"
 #define private public
 #include "base/run_loop.h"
 #undef private
-#include "base/time/time.h"
 #include <Ecore.h>
 
 namespace base {
@@ -15,25 +19,43 @@ namespace base {
 namespace {
 static const char dummy_pipe_message[] = "W";
 static const int dummy_pipe_message_size = 1;
+
+// Delays shorter than this fire on time, longer ones may fire up to an
+// eighth of their delay late, but never more than kMaxTimerSlackMs, so
+// that timers due around the same time share a wakeup.
+const int kMinCoalescedDelayMs = 50;
+const int kMaxTimerSlackMs = 100;
+
+const int kStatsPeriodSeconds = 30;
+
+base::TimeDelta GetTimerSlack(base::TimeDelta delay) {
+  if (delay < base::TimeDelta::FromMilliseconds(kMinCoalescedDelayMs))
+    return base::TimeDelta();
+  return std::min(delay / 8, base::TimeDelta::FromMilliseconds(kMaxTimerSlackMs));
+}
+}
+
+MessagePumpForUIEfl::Stats::Stats()
+  : wakeups(0)
+  , timer_rearms(0) {
 }
 
 MessagePumpForUIEfl::MessagePumpForUIEfl()
   : pipe_(ecore_pipe_add(&PipeCallback, this))
   , delegate_(base::MessageLoopForUI::current())
   , run_loop_(new RunLoop())
-  , work_scheduled_(false) {
+  , work_scheduled_(0)
+  , delayed_work_timer_(NULL) {
   // Since the RunLoop was just created above, BeforeRun should be guaranteed to
   // return true (it only returns false if the RunLoop has been Quit already).
   bool result = run_loop_->BeforeRun();
   DCHECK(result);
+  stats_.period_start = base::TimeTicks::Now();
 }
 
 MessagePumpForUIEfl::~MessagePumpForUIEfl() {
-  for (std::unordered_set<TimerPair*>::iterator it = pending_timers_.begin();
-       it != pending_timers_.end(); ++it) {
-    ecore_timer_del((*it)->second);
-    delete *it;
-  }
+  if (delayed_work_timer_)
+    ecore_timer_del(delayed_work_timer_);
 }
 
 // FIXME: need to be implemented for tests.
@@ -53,12 +75,10 @@ void MessagePumpForUIEfl::Quit() {
 }
 
 void MessagePumpForUIEfl::ScheduleWork() {
-  {
-    base::AutoLock locker(schedule_work_lock_);
-    if (work_scheduled_)
-      return;
-    work_scheduled_ = true;
-  }
+  // Called from any thread. The message loop calls it with its incoming
+  // queue locked, which orders it with DoWork() clearing the flag.
+  if (base::subtle::Acquire_CompareAndSwap(&work_scheduled_, 0, 1))
+    return;
 
   DCHECK(pipe_);
   bool ok = ecore_pipe_write(pipe_, dummy_pipe_message, dummy_pipe_message_size);
@@ -67,16 +87,23 @@ void MessagePumpForUIEfl::ScheduleWork() {
 
 void MessagePumpForUIEfl::ScheduleDelayedWork(const base::TimeTicks& delayed_work_time) {
   base::TimeTicks now = base::TimeTicks::Now();
-  double delay;
-  if (delayed_work_time < now)
-    delay = 0;
-  else
-    delay = base::TimeDelta(delayed_work_time - now).InSecondsF();
-
-  TimerPair* new_pair = new TimerPair();
-  new_pair->first = this;
-  new_pair->second = ecore_timer_add(delay, &TimerCallback, new_pair);
-  pending_timers_.insert(new_pair);
+  base::TimeDelta delay = std::max(delayed_work_time - now, base::TimeDelta());
+  base::TimeDelta slack = GetTimerSlack(delay);
+
+  // An armed timer firing earlier runs the work and schedules the next
+  // deadline itself, one firing within the slack serves this one as well.
+  if (delayed_work_timer_ && delayed_work_timer_time_ <= delayed_work_time + slack)
+    return;
+
+  delay += slack;
+  delayed_work_timer_time_ = now + delay;
+  if (delayed_work_timer_) {
+    ecore_timer_interval_set(delayed_work_timer_, delay.InSecondsF());
+    ecore_timer_reset(delayed_work_timer_);
+  } else {
+    delayed_work_timer_ = ecore_timer_add(delay.InSecondsF(), &TimerCallback, this);
+  }
+  stats_.timer_rearms++;
 }
 
 void MessagePumpForUIEfl::PipeCallback(void *data, void*, unsigned int) {
@@ -84,47 +111,69 @@ void MessagePumpForUIEfl::PipeCallback(void *data, void*, unsigned int) {
 }
 
 Eina_Bool MessagePumpForUIEfl::TimerCallback(void* data) {
-  TimerPair* current_timer_pair = static_cast<TimerPair*>(data);
-  current_timer_pair->first->DoDelayedWork();
-  current_timer_pair->first->pending_timers_.erase(current_timer_pair);
-
-  delete current_timer_pair;
-  return false;
+  MessagePumpForUIEfl* pump = static_cast<MessagePumpForUIEfl*>(data);
+  // The timer is deleted by returning ECORE_CALLBACK_CANCEL, DoDelayedWork()
+  // arms a new one for the next deadline.
+  pump->delayed_work_timer_ = NULL;
+  pump->DoDelayedWork();
+  return ECORE_CALLBACK_CANCEL;
 }
 
 void MessagePumpForUIEfl::DoWork() {
-  {
-    base::AutoLock locker(schedule_work_lock_);
-    DCHECK(work_scheduled_);
-    work_scheduled_ = false;
-  }
+  TRACE_EVENT0("toplevel", "MessagePumpForUIEfl::DoWork");
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::subtle::Release_Store(&work_scheduled_, 0);
 
   bool more_work_is_plausible = delegate_->DoWork();
 
   base::TimeTicks delayed_work_time;
   more_work_is_plausible |= delegate_->DoDelayedWork(&delayed_work_time);
 
-  if (more_work_is_plausible) {
-    ScheduleWork();
-    return;
-  }
+  if (!more_work_is_plausible)
+    more_work_is_plausible |= delegate_->DoIdleWork();
 
-  more_work_is_plausible |= delegate_->DoIdleWork();
-  if (more_work_is_plausible) {
+  if (more_work_is_plausible)
     ScheduleWork();
-    return;
-  }
-
-  if (!delayed_work_time.is_null())
+  else if (!delayed_work_time.is_null())
     ScheduleDelayedWork(delayed_work_time);
+
+  RecordWakeup(start);
 }
 
 void MessagePumpForUIEfl::DoDelayedWork() {
+  TRACE_EVENT0("toplevel", "MessagePumpForUIEfl::DoDelayedWork");
+  base::TimeTicks start = base::TimeTicks::Now();
   base::TimeTicks next_delayed_work_time;
   delegate_->DoDelayedWork(&next_delayed_work_time);
 
   if (!next_delayed_work_time.is_null())
     ScheduleDelayedWork(next_delayed_work_time);
+
+  RecordWakeup(start);
+}
+
+void MessagePumpForUIEfl::RecordWakeup(const base::TimeTicks& start) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  stats_.wakeups++;
+  stats_.work_time += now - start;
+
+  base::TimeDelta period = now - stats_.period_start;
+  if (period < base::TimeDelta::FromSeconds(kStatsPeriodSeconds))
+    return;
+
+  double seconds = period.InSecondsF();
+  int wakeups_per_second = static_cast<int>(stats_.wakeups / seconds + 0.5);
+  int busy_percent = static_cast<int>(100 * stats_.work_time.InSecondsF() / seconds);
+  UMA_HISTOGRAM_COUNTS_1000("EWK.MessagePump.WakeupsPerSecond", wakeups_per_second);
+  UMA_HISTOGRAM_PERCENTAGE("EWK.MessagePump.BusyPercent", busy_percent);
+  VLOG(1) << "UI message pump: " << stats_.wakeups / seconds << " wakeups/s, "
+          << stats_.timer_rearms / seconds << " timer re-arms/s, "
+          << (delayed_work_timer_ ? 1 : 0) << " timers alive, "
+          << stats_.work_time.InMillisecondsF() << " ms in DoWork over "
+          << seconds << " s";
+
+  stats_ = Stats();
+  stats_.period_start = now;
 }
 
 }
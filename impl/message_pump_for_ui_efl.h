@@ -5,19 +5,21 @@
 #ifndef MESSAGE_PUMP_FOR_UI_EFL
 #define MESSAGE_PUMP_FOR_UI_EFL
 
+#include "base/atomicops.h"
 #include "base/message_loop/message_pump.h"
-#include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include <Ecore.h>
 #include <Eina.h>
-#include <unordered_set>
 
 namespace base {
 
 class RunLoop;
-class TimeTicks;
-class MessagePumpForUIEfl;
-typedef std::pair<MessagePumpForUIEfl*, Ecore_Timer*> TimerPair;
 
+// Runs the tasks of the UI thread message loop from the Ecore main loop.
+//
+// Delayed work is driven by a single Ecore timer, moved only when a
+// deadline earlier than the armed one comes up. Deadlines far enough away
+// may fire a little late so that they share wakeups with others.
 class BASE_EXPORT MessagePumpForUIEfl : public base::MessagePump {
  public:
   MessagePumpForUIEfl();
@@ -29,17 +31,37 @@ class BASE_EXPORT MessagePumpForUIEfl : public base::MessagePump {
   virtual void ScheduleDelayedWork(const base::TimeTicks&) override;
 
  private:
+  // Wakeups and time spent running tasks, reported periodically.
+  struct Stats {
+    Stats();
+
+    base::TimeTicks period_start;
+    int wakeups;
+    int timer_rearms;
+    base::TimeDelta work_time;
+  };
+
   static void PipeCallback(void*, void*, unsigned int);
   static Eina_Bool TimerCallback(void*);
   void DoWork();
   void DoDelayedWork();
 
-  std::unordered_set<TimerPair*> pending_timers_;
+  // Accounts a wakeup that ran tasks between |start| and now, and reports
+  // the stats once a period is over.
+  void RecordWakeup(const base::TimeTicks& start);
+
   Ecore_Pipe* pipe_;
   Delegate* delegate_;
   RunLoop* run_loop_;
-  base::Lock schedule_work_lock_;
-  bool work_scheduled_;
+  // Set while a write to |pipe_| is pending, so that posting tasks from
+  // any thread costs at most one pipe write per DoWork().
+  base::subtle::Atomic32 work_scheduled_;
+
+  Ecore_Timer* delayed_work_timer_;
+  // When |delayed_work_timer_| fires.
+  base::TimeTicks delayed_work_timer_time_;
+
+  Stats stats_;
 
   DISALLOW_COPY_AND_ASSIGN(MessagePumpForUIEfl);
 };
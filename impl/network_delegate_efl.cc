@@ -6,14 +6,23 @@
 #include "network_delegate_efl.h"
 
 #include "content/public/browser/browser_thread.h"
+#include "http_cache_config_efl.h"
 #include "net/base/net_errors.h"
 #include "net/http/http_response_headers.h"
+#include "net/url_request/url_request.h"
 
 namespace net {
 
 NetworkDelegateEfl::NetworkDelegateEfl(
-    base::WeakPtr<CookieManager> cookie_manager)
-    : cookie_manager_(cookie_manager) {
+    base::WeakPtr<CookieManager> cookie_manager,
+    content::HttpCacheStatsEfl* cache_stats)
+    : cookie_manager_(cookie_manager),
+      cache_stats_(cache_stats) {
+}
+
+void NetworkDelegateEfl::OnCompleted(URLRequest* request, bool started) {
+  if (started && cache_stats_)
+    cache_stats_->OnRequestCompleted(*request);
 }
 
 NetworkDelegate::AuthRequiredResponse NetworkDelegateEfl::OnAuthRequired(
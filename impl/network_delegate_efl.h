@@ -11,14 +11,21 @@
 #include "net/base/network_delegate.h"
 #include "cookie_manager.h"
 
+namespace content {
+class HttpCacheStatsEfl;
+}
+
 namespace net {
 
 class NetworkDelegateEfl : public NetworkDelegate {
  public:
-  NetworkDelegateEfl(base::WeakPtr<CookieManager> cookie_manager);
+  // |cache_stats| must outlive the delegate.
+  NetworkDelegateEfl(base::WeakPtr<CookieManager> cookie_manager,
+                     content::HttpCacheStatsEfl* cache_stats);
 
  private:
   // NetworkDelegate implementation.
+  virtual void OnCompleted(URLRequest* request, bool started) override;
   virtual AuthRequiredResponse OnAuthRequired(
       URLRequest* request,
       const AuthChallengeInfo& auth_info,
@@ -34,6 +41,7 @@ class NetworkDelegateEfl : public NetworkDelegate {
   virtual bool OnCanThrottleRequest(const URLRequest& request) const override;
 
   base::WeakPtr<CookieManager> cookie_manager_;
+  content::HttpCacheStatsEfl* cache_stats_;
 };
 
 } // namespace net
@@ -56,9 +56,11 @@ void ContentRendererClientEfl::RenderThreadStarted()
 {
   render_process_observer_.reset(new RenderProcessObserverEfl(this));
   visited_link_slave_.reset(new visitedlink::VisitedLinkSlave());
+  registered_script_runner_.reset(new RegisteredScriptRunnerEfl());
   content::RenderThread* thread = content::RenderThread::Get();
   thread->AddObserver(render_process_observer_.get());
   thread->AddObserver(visited_link_slave_.get());
+  thread->AddObserver(registered_script_runner_.get());
 }
 
 void ContentRendererClientEfl::RenderFrameCreated(content::RenderFrame* render_frame) {
@@ -9,6 +9,7 @@
 #include "renderer/content_renderer_client_efl.h"
 #include "tizen_webview/public/tw_settings.h"
 #include "v8/include/v8.h"
+#include "renderer/registered_script_runner_efl.h"
 #include "renderer/render_process_observer_efl.h"
 
 namespace content {
@@ -90,6 +91,8 @@ class ContentRendererClientEfl : public content::ContentRendererClient
 
   bool IsLinkVisited(unsigned long long link_hash) override;
   void SetWebViewSettings(const tizen_webview::Settings& settings) { m_settings = settings; }
+  RegisteredScriptRunnerEfl* registered_script_runner() const
+  { return registered_script_runner_.get(); }
 
   blink::WebSpeechSynthesizer* OverrideSpeechSynthesizer(
       blink::WebSpeechSynthesizerClient* client) override;
@@ -98,6 +101,7 @@ class ContentRendererClientEfl : public content::ContentRendererClient
   scoped_ptr<WrtWidget> wrt_widget_;
   scoped_ptr<RenderProcessObserverEfl> render_process_observer_;
   scoped_ptr<visitedlink::VisitedLinkSlave> visited_link_slave_;
+  scoped_ptr<RegisteredScriptRunnerEfl> registered_script_runner_;
   tizen_webview::Settings m_settings;
 };
 
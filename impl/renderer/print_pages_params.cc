@@ -19,3 +19,10 @@ PrintParams::PrintParams()
 PrintPagesParams::PrintPagesParams()
   : pages() {
 }
+
+PdfExportParams::PdfExportParams()
+  : job_id(0),
+    page_size(),
+    first_page(0),
+    last_page(-1) {
+}
@@ -8,8 +8,6 @@
 #include <vector>
 
 #include "base/basictypes.h"
-#include "base/files/file_path.h"
-#include "base/memory/shared_memory.h"
 #include "printing/printing_export.h"
 #include "third_party/WebKit/public/web/WebPrintScalingOption.h"
 #include "ui/gfx/rect.h"
@@ -43,11 +41,15 @@ struct PrintPageParams {
   int page_number;
 };
 
-struct DidPrintPagesParams {
-  base::SharedMemoryHandle metafile_data_handle;
-  uint32 data_size;
-  int document_cookie;
-  base::FilePath filename;
+// page range export requested by the browser
+struct PdfExportParams {
+  PdfExportParams();
+
+  int job_id;
+  gfx::Size page_size;
+  // zero based and inclusive, |last_page| < 0 means up to the last page
+  int first_page;
+  int last_page;
 };
 
 #endif // PRINT_PAGES_PARAMS_H_
@@ -4,8 +4,11 @@
 
 #include "renderer/print_web_view_helper_efl.h"
 
+#include <algorithm>
+
+#include "base/bind.h"
 #include "base/logging.h"
-#include "content/public/renderer/render_thread.h"
+#include "base/message_loop/message_loop.h"
 #include "content/public/renderer/render_view.h"
 #include "common/render_messages_efl.h"
 #include "renderer/print_pages_params.h"
@@ -22,6 +25,9 @@
 
 namespace {
 
+// Pages printed per task, a batch lays the document out for print once.
+const int kPagesPerTask = 4;
+
 int ConvertUnit(int value, int old_unit, int new_unit) {
   DCHECK_GT(new_unit, 0);
   DCHECK_GT(old_unit, 0);
@@ -71,18 +77,60 @@ void ComputeWebKitPrintParamsInDesiredDpi(const PrintParams& print_params,
 } //namespace
 
 PrintWebViewHelperEfl::PrintWebViewHelperEfl(content::RenderView* view,
-    const base::FilePath& filename)
+    const PdfExportParams& params,
+    base::File file,
+    const base::Closure& done_callback)
   : view_(view),
-    filename_(filename) {
+    export_params_(params),
+    file_(file.Pass()),
+    done_callback_(done_callback),
+    page_count_(0),
+    next_page_(0),
+    pages_printed_(0),
+    weak_factory_(this) {
 }
 
 PrintWebViewHelperEfl::~PrintWebViewHelperEfl() {
 }
 
-void PrintWebViewHelperEfl::PrintToPdf(int width, int height) {
-  InitPrintSettings(width, height, true);
+void PrintWebViewHelperEfl::PrintToPdf() {
+  if (!file_.IsValid()) {
+    Finish(tizen_webview::TW_PDF_EXPORT_FAILED);
+    return;
+  }
+
   DCHECK(view_->GetWebView());
-  RenderPagesForPrint(view_->GetWebView()->mainFrame());
+  InitPrintSettings(export_params_.page_size.width(),
+      export_params_.page_size.height(), true);
+
+  // The range is fixed against the document as it is now, the batches lay
+  // it out again.
+  blink::WebPrintParams webkit_print_params;
+  ComputeWebKitPrintParamsInDesiredDpi(print_pages_params_->params,
+      &webkit_print_params);
+  blink::WebFrame* frame = view_->GetWebView()->mainFrame();
+  int document_page_count = frame->printBegin(webkit_print_params);
+  frame->printEnd();
+
+  next_page_ = std::max(export_params_.first_page, 0);
+  int last_page = document_page_count - 1;
+  if (export_params_.last_page >= 0)
+    last_page = std::min(export_params_.last_page, last_page);
+  page_count_ = last_page - next_page_ + 1;
+
+  metafile_.reset(new printing::PdfMetafileSkia);
+  if (page_count_ <= 0 || !metafile_->Init()) {
+    Finish(tizen_webview::TW_PDF_EXPORT_FAILED);
+    return;
+  }
+
+  base::MessageLoop::current()->PostTask(FROM_HERE,
+      base::Bind(&PrintWebViewHelperEfl::PrintNextPages,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void PrintWebViewHelperEfl::Cancel() {
+  Finish(tizen_webview::TW_PDF_EXPORT_CANCELLED);
 }
 
 void PrintWebViewHelperEfl::InitPrintSettings(int width, int height, bool fit_to_paper_size) {
@@ -104,82 +152,64 @@ void PrintWebViewHelperEfl::InitPrintSettings(int width, int height, bool fit_to
   print_pages_params_.reset(new PrintPagesParams(settings));
 }
 
-bool PrintWebViewHelperEfl::RenderPagesForPrint(blink::WebFrame* frame) {
-  DCHECK(frame);
-  const PrintPagesParams& params = *print_pages_params_;
-  const PrintParams& print_params = params.params;
+void PrintWebViewHelperEfl::PrintNextPages() {
   blink::WebPrintParams webkit_print_params;
-  ComputeWebKitPrintParamsInDesiredDpi(print_params, &webkit_print_params);
-  int page_count = frame->printBegin(webkit_print_params);
-  gfx::Size print_canvas_size(webkit_print_params.printContentArea.width,
+  ComputeWebKitPrintParamsInDesiredDpi(print_pages_params_->params,
+      &webkit_print_params);
+  gfx::Size canvas_size(webkit_print_params.printContentArea.width,
       webkit_print_params.printContentArea.height);
-  bool result = PrintPagesToPdf(frame, page_count, print_canvas_size);
-  frame->printEnd();
-  return result;
-}
+  blink::WebFrame* frame = view_->GetWebView()->mainFrame();
+  int document_page_count = frame->printBegin(webkit_print_params);
 
-bool PrintWebViewHelperEfl::PrintPagesToPdf(blink::WebFrame* frame,
-    int page_count, const gfx::Size& canvas_size) {
-  printing::PdfMetafileSkia metafile;
-  if (!metafile.Init())
-    return false;
-
-  const PrintPagesParams& params = *print_pages_params_;
-  std::vector<int> printed_pages;
-
-  if (params.pages.empty()) {
-    for (int i = 0; i < page_count; ++i)
-      printed_pages.push_back(i);
-  } else {
-    for (size_t i = 0; i < params.pages.size(); ++i) {
-      if (params.pages[i] >= 0 && params.pages[i] < page_count)
-        printed_pages.push_back(params.pages[i]);
+  PrintPageParams page_params;
+  page_params.params = print_pages_params_->params;
+  int batch_end = std::min(pages_printed_ + kPagesPerTask, page_count_);
+  bool printed = true;
+  while (printed && pages_printed_ < batch_end) {
+    page_params.page_number = next_page_;
+    // Scripts that ran since the previous batch may have shortened it.
+    printed = page_params.page_number < document_page_count &&
+        PrintPageInternal(page_params, canvas_size, frame, metafile_.get());
+    if (printed) {
+      ++next_page_;
+      ++pages_printed_;
+      view_->Send(new EwkHostMsg_PdfExportProgress(view_->GetRoutingID(),
+          export_params_.job_id, pages_printed_, page_count_));
     }
   }
+  frame->printEnd();
 
-  if (printed_pages.empty())
-    return false;
-
-  PrintPageParams page_params;
-  page_params.params = params.params;
-
-  for (size_t i = 0; i < printed_pages.size(); ++i) {
-    page_params.page_number = printed_pages[i];
-    if (!PrintPageInternal(page_params, canvas_size, frame, &metafile))
-      LOG(ERROR) << "Could not write page #" << page_params.page_number << " in pdf.";
+  if (!printed) {
+    LOG(ERROR) << "Could not write page #" << page_params.page_number << " in pdf.";
+    Finish(tizen_webview::TW_PDF_EXPORT_FAILED);
+    return;
   }
 
-  metafile.FinishDocument();
+  if (pages_printed_ == page_count_) {
+    Finish(tizen_webview::TW_PDF_EXPORT_SUCCEEDED);
+    return;
+  }
 
-  // Get the size of the resulting metafile.
-  uint32 buf_size = metafile.GetDataSize();
-  DCHECK_GT(buf_size, 0u);
+  base::MessageLoop::current()->PostTask(FROM_HERE,
+      base::Bind(&PrintWebViewHelperEfl::PrintNextPages,
+                 weak_factory_.GetWeakPtr()));
+}
 
-  DidPrintPagesParams printed_page_params;
-  printed_page_params.data_size = 0;
-  printed_page_params.document_cookie = params.params.document_cookie;
-  printed_page_params.filename = filename_;
+void PrintWebViewHelperEfl::Finish(tizen_webview::Pdf_Export_Status status) {
+  weak_factory_.InvalidateWeakPtrs();
 
-  {
-    scoped_ptr<base::SharedMemory> shared_mem(
-        content::RenderThread::Get()->HostAllocateSharedMemoryBuffer(
-             buf_size).release());
-    if (!shared_mem.get()) {
-      NOTREACHED() << "AllocateSharedMemoryBuffer failed";
-      return false;
-    }
-
-    if (!shared_mem->Map(buf_size)) {
-      NOTREACHED() << "Map failed";
-      return false;
-    }
-    metafile.GetData(shared_mem->memory(), buf_size);
-    printed_page_params.data_size = buf_size;
-    shared_mem->GiveToProcess(base::GetCurrentProcessHandle(),
-        &(printed_page_params.metafile_data_handle));
-  } // shared memory handle scope
+  // PdfMetafileSkia only serializes the document once it is complete, so
+  // the file is written in one go after the last page.
+  if (status == tizen_webview::TW_PDF_EXPORT_SUCCEEDED &&
+      (!metafile_->FinishDocument() || !metafile_->SaveTo(&file_))) {
+    status = tizen_webview::TW_PDF_EXPORT_FAILED;
+  }
+  metafile_.reset();
+  file_.Close();
 
-  return view_->Send(new EwkHostMsg_DidPrintPagesToPdf(view_->GetRoutingID(), printed_page_params));
+  view_->Send(new EwkHostMsg_PdfExportFinished(view_->GetRoutingID(),
+      export_params_.job_id, status));
+  done_callback_.Run();
 }
 
 bool PrintWebViewHelperEfl::PrintPageInternal(
@@ -5,10 +5,13 @@
 #ifndef PRINT_WEB_VIEW_HELPER_H_
 #define PRINT_WEB_VIEW_HELPER_H_
 
-#include "base/files/file_path.h"
+#include "base/callback.h"
+#include "base/files/file.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "renderer/print_pages_params.h"
 #include "third_party/WebKit/public/platform/WebCanvas.h"
+#include "tizen_webview/public/tw_pdf_export_status.h"
 
 namespace content {
 class RenderView;
@@ -24,23 +27,49 @@ class PdfMetafileSkia;
 
 struct PrintPagesParams;
 
+// Prints a range of pages of the main frame into a file opened by the
+// browser. The pages are printed kPagesPerTask at a time, each batch in a
+// task of its own between printBegin() and printEnd(), so that a long
+// document does not stall the renderer and no script or layout runs while
+// the frame is in print mode. Progress is reported after every page.
+// PdfMetafileSkia only serializes a complete document, so the file itself
+// is written once, after the last page.
 class PrintWebViewHelperEfl {
  public:
-  PrintWebViewHelperEfl(content::RenderView* view, const base::FilePath& filename);
+  PrintWebViewHelperEfl(content::RenderView* view,
+                        const PdfExportParams& params,
+                        base::File file,
+                        const base::Closure& done_callback);
   virtual ~PrintWebViewHelperEfl();
-  void PrintToPdf(int width, int height);
-  void InitPrintSettings(int width, int height, bool fit_to_paper_size);
+
+  void PrintToPdf();
+  // Stops before the next page and reports TW_PDF_EXPORT_CANCELLED.
+  void Cancel();
+  int job_id() const { return export_params_.job_id; }
 
  private:
-  bool PrintPagesToPdf(blink::WebFrame* frame, int page_count,
-      const gfx::Size& canvas_size);
+  void InitPrintSettings(int width, int height, bool fit_to_paper_size);
+  void PrintNextPages();
+  void Finish(tizen_webview::Pdf_Export_Status status);
   bool PrintPageInternal(const PrintPageParams& params,
-      const gfx::Size& canvas_size, blink::WebFrame* frame, printing::PdfMetafileSkia* metafile);
-  bool RenderPagesForPrint(blink::WebFrame* frame);
+      const gfx::Size& canvas_size, blink::WebFrame* frame,
+      printing::PdfMetafileSkia* metafile);
 
   scoped_ptr<PrintPagesParams> print_pages_params_;
   content::RenderView* view_;
-  base::FilePath filename_;
+  PdfExportParams export_params_;
+  base::File file_;
+  base::Closure done_callback_;
+
+  scoped_ptr<printing::PdfMetafileSkia> metafile_;
+  // number of pages in the requested range
+  int page_count_;
+  int next_page_;
+  int pages_printed_;
+
+  base::WeakPtrFactory<PrintWebViewHelperEfl> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrintWebViewHelperEfl);
 };
 
 #endif // PRINT_WEB_VIEW_HELPER_H_
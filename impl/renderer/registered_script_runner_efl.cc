@@ -0,0 +1,247 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "renderer/registered_script_runner_efl.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "common/render_messages_efl.h"
+#include "third_party/WebKit/public/web/WebLocalFrame.h"
+#include "v8/include/v8.h"
+
+using blink::WebLocalFrame;
+
+namespace {
+
+// Source of a registered script, mapped from the browser's shared memory.
+// Outlives its script as long as V8 uses it, lazily compiled functions are
+// compiled from the source when first called.
+class SharedSource : public base::RefCounted<SharedSource> {
+ public:
+  SharedSource(base::SharedMemoryHandle handle, uint32 size)
+      : memory_(handle, true),
+        size_(size),
+        is_ascii_(false) {
+    if (memory_.Map(size))
+      is_ascii_ = base::IsStringASCII(base::StringPiece(data(), size_));
+  }
+
+  bool is_mapped() const { return memory_.memory() != NULL; }
+  const char* data() const { return static_cast<const char*>(memory_.memory()); }
+  uint32 size() const { return size_; }
+  bool is_ascii() const { return is_ascii_; }
+
+ private:
+  friend class base::RefCounted<SharedSource>;
+  ~SharedSource() {}
+
+  base::SharedMemory memory_;
+  uint32 size_;
+  bool is_ascii_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedSource);
+};
+
+// Lets V8 use an ASCII source in place, without a copy on its heap.
+class SharedSourceResource
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  explicit SharedSourceResource(SharedSource* source) : source_(source) {}
+
+  virtual const char* data() const override { return source_->data(); }
+  virtual size_t length() const override { return source_->size(); }
+
+ private:
+  scoped_refptr<SharedSource> source_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedSourceResource);
+};
+
+} // namespace
+
+class RegisteredScriptRunnerEfl::Script {
+ public:
+  explicit Script(SharedSource* source)
+      : source_(source),
+        code_cache_size_(0) {
+  }
+
+  ~Script() {
+    unbound_.Reset();
+  }
+
+  bool is_compiled() const { return !unbound_.IsEmpty(); }
+  base::TimeDelta cold_compile_time() const { return cold_compile_time_; }
+
+  v8::Local<v8::UnboundScript> GetUnbound(v8::Isolate* isolate) const {
+    return v8::Local<v8::UnboundScript>::New(isolate, unbound_);
+  }
+
+  void SetCodeCache(scoped_ptr<base::SharedMemory> code_cache,
+                    uint32 code_cache_size,
+                    base::TimeDelta cold_compile_time) {
+    code_cache_ = code_cache.Pass();
+    code_cache_size_ = code_cache_size;
+    cold_compile_time_ = cold_compile_time;
+  }
+
+  // Compiles the source for the current isolate, with the code cache when
+  // there is one, and produces the cache otherwise.
+  bool Compile(v8::Isolate* isolate, int script_id, Execution* execution) {
+    v8::Local<v8::String> source_string;
+    if (source_->is_ascii()) {
+      source_string = v8::String::NewExternal(
+          isolate, new SharedSourceResource(source_.get()));
+    } else {
+      source_string = v8::String::NewFromUtf8(
+          isolate, source_->data(), v8::String::kNormalString, source_->size());
+    }
+    std::string name = base::StringPrintf("ewk-registered-script-%d", script_id);
+    v8::ScriptOrigin origin(v8::String::NewFromUtf8(isolate, name.c_str()));
+
+    // Owned by |source|, the data stays owned by |code_cache_|.
+    v8::ScriptCompiler::CachedData* cached_data = NULL;
+    if (code_cache_) {
+      cached_data = new v8::ScriptCompiler::CachedData(
+          static_cast<const uint8_t*>(code_cache_->memory()),
+          code_cache_size_);
+    }
+    v8::ScriptCompiler::Source source(source_string, origin, cached_data);
+
+    base::TimeTicks start = base::TimeTicks::Now();
+    v8::Local<v8::UnboundScript> unbound = v8::ScriptCompiler::CompileUnbound(
+        isolate, &source, cached_data ? v8::ScriptCompiler::kConsumeCodeCache
+                                      : v8::ScriptCompiler::kProduceCodeCache);
+    execution->compile_time = base::TimeTicks::Now() - start;
+    if (unbound.IsEmpty())
+      return false;
+    unbound_.Reset(isolate, unbound);
+
+    if (cached_data) {
+      execution->compile_time_saved = std::max(
+          base::TimeDelta(), cold_compile_time_ - execution->compile_time);
+    } else {
+      cold_compile_time_ = execution->compile_time;
+      const v8::ScriptCompiler::CachedData* produced = source.GetCachedData();
+      if (produced && produced->length > 0) {
+        execution->produced_code_cache.assign(
+            produced->data, produced->data + produced->length);
+      }
+    }
+    // Compiled scripts do not refer to the cache.
+    code_cache_.reset();
+    return true;
+  }
+
+ private:
+  scoped_refptr<SharedSource> source_;
+  scoped_ptr<base::SharedMemory> code_cache_;
+  uint32 code_cache_size_;
+  // Compile time without a code cache, of this renderer or of the one that
+  // produced |code_cache_|.
+  base::TimeDelta cold_compile_time_;
+  v8::Persistent<v8::UnboundScript> unbound_;
+
+  DISALLOW_COPY_AND_ASSIGN(Script);
+};
+
+RegisteredScriptRunnerEfl::RegisteredScriptRunnerEfl() {
+}
+
+RegisteredScriptRunnerEfl::~RegisteredScriptRunnerEfl() {
+}
+
+bool RegisteredScriptRunnerEfl::Execute(WebLocalFrame* frame,
+                                        int script_id,
+                                        Execution* execution) {
+  ScriptMap::iterator it = scripts_.find(script_id);
+  if (it == scripts_.end())
+    return false;
+  Script* script = it->second.get();
+
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = frame->mainWorldScriptContext();
+  if (context.IsEmpty())
+    return false;
+  v8::Context::Scope context_scope(context);
+  v8::TryCatch try_catch;
+
+  if (script->is_compiled()) {
+    // Compiled by an earlier execution in this process.
+    execution->compile_time_saved = script->cold_compile_time();
+  } else if (!script->Compile(isolate, script_id, execution)) {
+    LOG(ERROR) << "Registered script " << script_id << " does not compile";
+    return false;
+  }
+
+  v8::Local<v8::Value> value =
+      script->GetUnbound(isolate)->BindToCurrentContext()->Run();
+  if (try_catch.HasCaught()) {
+    VLOG(1) << "Registered script " << script_id << " threw: "
+            << *v8::String::Utf8Value(try_catch.Exception());
+    return false;
+  }
+
+  if (!value.IsEmpty() && value->IsString())
+    execution->result = *v8::String::Utf8Value(value);
+  return true;
+}
+
+bool RegisteredScriptRunnerEfl::OnControlMessageReceived(
+    const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(RegisteredScriptRunnerEfl, message)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_RegisterScript, OnRegisterScript)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_SetScriptCodeCache, OnSetScriptCodeCache)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_UnregisterScript, OnUnregisterScript)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+void RegisteredScriptRunnerEfl::OnRenderProcessShutdown() {
+  // Compiled scripts must go before the isolate.
+  scripts_.clear();
+}
+
+void RegisteredScriptRunnerEfl::OnRegisterScript(
+    int script_id,
+    base::SharedMemoryHandle source,
+    uint32 source_size) {
+  scoped_refptr<SharedSource> shared_source(
+      new SharedSource(source, source_size));
+  if (!shared_source->is_mapped()) {
+    LOG(ERROR) << "Cannot map registered script " << script_id;
+    return;
+  }
+  scripts_[script_id] = make_linked_ptr(new Script(shared_source.get()));
+}
+
+void RegisteredScriptRunnerEfl::OnSetScriptCodeCache(
+    int script_id,
+    base::SharedMemoryHandle code_cache,
+    uint32 code_cache_size,
+    base::TimeDelta cold_compile_time) {
+  // Closes the handle unless the cache is kept.
+  scoped_ptr<base::SharedMemory> memory(
+      new base::SharedMemory(code_cache, true));
+
+  ScriptMap::iterator it = scripts_.find(script_id);
+  if (it == scripts_.end() || it->second->is_compiled())
+    return;
+  if (!memory->Map(code_cache_size))
+    return;
+  it->second->SetCodeCache(memory.Pass(), code_cache_size, cold_compile_time);
+}
+
+void RegisteredScriptRunnerEfl::OnUnregisterScript(int script_id) {
+  scripts_.erase(script_id);
+}
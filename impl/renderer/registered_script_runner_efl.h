@@ -0,0 +1,72 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef REGISTERED_SCRIPT_RUNNER_EFL_H_
+#define REGISTERED_SCRIPT_RUNNER_EFL_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/linked_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "base/time/time.h"
+#include "content/public/renderer/render_process_observer.h"
+
+namespace blink {
+class WebLocalFrame;
+}
+
+// Executes the scripts registered with the context, see RegisteredScriptsEfl
+// in the browser. Sources arrive once per process in shared memory.
+//
+// The first execution in the process compiles the source, consuming the
+// code cache the browser sent back from an earlier process of the same host
+// if any and producing one otherwise, and keeps
+// the unbound script so that later executions, in any frame, only run it.
+class RegisteredScriptRunnerEfl : public content::RenderProcessObserver {
+ public:
+  struct Execution {
+    Execution() {}
+
+    // The completion value when it is a string, like ExecuteJavaScript.
+    std::string result;
+    base::TimeDelta compile_time;
+    base::TimeDelta compile_time_saved;
+    // Set when this execution produced the code cache of the script.
+    std::vector<uint8> produced_code_cache;
+  };
+
+  RegisteredScriptRunnerEfl();
+  virtual ~RegisteredScriptRunnerEfl();
+
+  // Runs |script_id| in the main world of |frame|. Returns false if the
+  // script is unknown, failed to compile or threw.
+  bool Execute(blink::WebLocalFrame* frame, int script_id,
+               Execution* execution);
+
+  // content::RenderProcessObserver implementation.
+  virtual bool OnControlMessageReceived(const IPC::Message& message) override;
+  virtual void OnRenderProcessShutdown() override;
+
+ private:
+  class Script;
+  typedef std::map<int, linked_ptr<Script> > ScriptMap;
+
+  void OnRegisterScript(int script_id,
+                        base::SharedMemoryHandle source,
+                        uint32 source_size);
+  void OnSetScriptCodeCache(int script_id,
+                            base::SharedMemoryHandle code_cache,
+                            uint32 code_cache_size,
+                            base::TimeDelta cold_compile_time);
+  void OnUnregisterScript(int script_id);
+
+  ScriptMap scripts_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegisteredScriptRunnerEfl);
+};
+
+#endif // REGISTERED_SCRIPT_RUNNER_EFL_H_
@@ -7,9 +7,11 @@
 #include "base/allocator/allocator_extension.h"
 #include "base/command_line.h"
 #include "common/content_switches_efl.h"
+#include "common/memory_purge_stats_efl.h"
 #include "common/render_messages_efl.h"
 #include "content/public/renderer/render_thread.h"
 #include "third_party/WebKit/public/web/WebCache.h"
+#include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/sqlite/sqlite3.h"
 #include "v8/include/v8.h"
 #include "renderer/content_renderer_client_efl.h"
@@ -19,14 +21,37 @@
 // XXX2: It'd be great if we did not include internal blibk headers.
 #include "third_party/WebKit/Source/config.h"
 #include "third_party/WebKit/Source/platform/fonts/FontCache.h"
+#include "third_party/WebKit/Source/platform/graphics/ImageDecodingStore.h"
 
 
 using blink::WebCache;
 using blink::WebRuntimeFeatures;
 using content::RenderThread;
+using tizen_webview::Memory_Pressure_Level;
+
+namespace {
+
+// Time V8 may spend on an idle GC round under moderate pressure.
+const int kV8IdleNotificationTimeMs = 100;
+
+int64 MemoryCacheSize() {
+  WebCache::UsageStats stats;
+  WebCache::getUsageStats(&stats);
+  return stats.liveSize + stats.deadSize;
+}
+
+int64 V8UsedHeapSize() {
+  v8::HeapStatistics stats;
+  v8::Isolate::GetCurrent()->GetHeapStatistics(&stats);
+  return stats.used_heap_size();
+}
+
+} // namespace
 
 RenderProcessObserverEfl::RenderProcessObserverEfl(ContentRendererClientEfl* content_client)
-    : content_client_(content_client), webkit_initialized_(false) {
+    : content_client_(content_client),
+      webkit_initialized_(false),
+      has_pending_cache_params_(false) {
   const CommandLine& command_line = *CommandLine::ForCurrentProcess();
   if (command_line.HasSwitch(switches::kEnableViewMode))
     WebRuntimeFeatures::enableCSSViewModeMediaFeature(true);
@@ -39,6 +64,7 @@ bool RenderProcessObserverEfl::OnControlMessageReceived(const IPC::Message& mess
     IPC_MESSAGE_HANDLER(EflViewMsg_ClearCache, OnClearCache)
     IPC_MESSAGE_HANDLER(EflViewMsg_SetCache, OnSetCache)
     IPC_MESSAGE_HANDLER(EwkViewMsg_PurgeMemory, OnPurgeMemory)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_Prewarm, OnPrewarm)
     IPC_MESSAGE_HANDLER(EwkViewMsg_SetWidgetInfo, OnWidgetInfo)
     IPC_MESSAGE_HANDLER(EwkViewMsg_SendWrtMessage, OnWrtMessage)
     IPC_MESSAGE_UNHANDLED(handled = false)
@@ -62,7 +88,8 @@ void RenderProcessObserverEfl::OnWrtMessage(const tizen_webview::WrtIpcMessageDa
 void RenderProcessObserverEfl::WebKitInitialized()
 {
   webkit_initialized_ = true;
-  OnSetCache(pending_cache_params_);
+  if (has_pending_cache_params_)
+    OnSetCache(pending_cache_params_);
 }
 void RenderProcessObserverEfl::OnClearCache()
 {
@@ -72,6 +99,7 @@ void RenderProcessObserverEfl::OnClearCache()
 void RenderProcessObserverEfl::OnSetCache(const CacheParamsEfl& params)
 {
   pending_cache_params_ = params;
+  has_pending_cache_params_ = true;
   if(!webkit_initialized_)
     return;
 
@@ -80,20 +108,73 @@ void RenderProcessObserverEfl::OnSetCache(const CacheParamsEfl& params)
     static_cast<size_t>(params.cache_total_capacity));
 }
 
-void RenderProcessObserverEfl::OnPurgeMemory()
+void RenderProcessObserverEfl::OnPrewarm()
+{
+  RenderThread::Get()->EnsureWebKitInitialized();
+}
+
+void RenderProcessObserverEfl::OnPurgeMemory(Memory_Pressure_Level level)
 {
   RenderThread::Get()->EnsureWebKitInitialized();
-  // Clear the object cache (as much as possible; some live objects cannot be
-  // freed).
-  OnClearCache();
-  // Clear the font/glyph cache.
-  blink::FontCache::fontCache()->invalidate();
-  // TODO(pk): currently web process not linking sqlite. when used this should enable
-  // Release all freeable memory from the SQLite process-global page cache (a
-  // low-level object which backs the Connection-specific page caches).
-  //while (sqlite3_release_memory(std::numeric_limits<int>::max()) > 0) {
-  //}
-  v8::Isolate::GetCurrent()->LowMemoryNotification();
+
+  PurgeDecodedImages();
+  PurgeMemoryCache(level);
+  PurgeV8Heap(level);
+
+  if (level == tizen_webview::TW_MEMORY_PRESSURE_LEVEL_CRITICAL) {
+    // Clear the font/glyph cache.
+    blink::FontCache::fontCache()->invalidate();
+    // TODO(pk): currently web process not linking sqlite. when used this should enable
+    // Release all freeable memory from the SQLite process-global page cache (a
+    // low-level object which backs the Connection-specific page caches).
+    //while (sqlite3_release_memory(std::numeric_limits<int>::max()) > 0) {
+    //}
+  }
+
   // Tell our allocator to release any free pages it's still holding.
   base::allocator::ReleaseFreeMemory();
 }
+
+void RenderProcessObserverEfl::PurgeDecodedImages()
+{
+  // Decoded images live both in Blink's decoding store and in the Skia
+  // resource cache backing discardable bitmaps.
+  int64 before = blink::ImageDecodingStore::instance()->memoryUsageInBytes() +
+      SkGraphics::GetResourceCacheTotalBytesUsed();
+  blink::ImageDecodingStore::instance()->clear();
+  SkGraphics::PurgeResourceCache();
+  int64 after = blink::ImageDecodingStore::instance()->memoryUsageInBytes() +
+      SkGraphics::GetResourceCacheTotalBytesUsed();
+  memory_purge_stats::RecordReclaimedBytes(
+      memory_purge_stats::DECODED_IMAGE_CACHE, before - after);
+}
+
+void RenderProcessObserverEfl::PurgeMemoryCache(Memory_Pressure_Level level)
+{
+  int64 before = MemoryCacheSize();
+  if (level == tizen_webview::TW_MEMORY_PRESSURE_LEVEL_CRITICAL) {
+    // Clear the object cache (as much as possible; some live objects cannot
+    // be freed).
+    OnClearCache();
+  } else if (has_pending_cache_params_) {
+    // Shrinking the dead capacity to zero evicts every dead resource, live
+    // ones stay. The browser assigned capacities are restored right after.
+    WebCache::setCapacities(0, 0,
+        static_cast<size_t>(pending_cache_params_.cache_total_capacity));
+    OnSetCache(pending_cache_params_);
+  }
+  memory_purge_stats::RecordReclaimedBytes(
+      memory_purge_stats::BLINK_MEMORY_CACHE, before - MemoryCacheSize());
+}
+
+void RenderProcessObserverEfl::PurgeV8Heap(Memory_Pressure_Level level)
+{
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  int64 before = V8UsedHeapSize();
+  if (level == tizen_webview::TW_MEMORY_PRESSURE_LEVEL_CRITICAL)
+    isolate->LowMemoryNotification();
+  else
+    isolate->IdleNotification(kV8IdleNotificationTimeMs);
+  memory_purge_stats::RecordReclaimedBytes(
+      memory_purge_stats::V8_HEAP, before - V8UsedHeapSize());
+}
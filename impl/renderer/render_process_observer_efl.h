@@ -9,6 +9,7 @@
 #include "base/compiler_specific.h"
 #include "content/public/renderer/render_process_observer.h"
 #include "cache_params_efl.h"
+#include "tizen_webview/public/tw_memory_pressure_level.h"
 
 namespace IPC {
 class Message;
@@ -26,7 +27,7 @@ public:
   bool OnControlMessageReceived(const IPC::Message& message) override;
   void WebKitInitialized() override;
   void OnClearCache();
-  void OnPurgeMemory();
+  void OnPurgeMemory(tizen_webview::Memory_Pressure_Level level);
   
 private:
   void OnWidgetInfo(int widget_id,
@@ -34,9 +35,14 @@ private:
                     const std::string &theme,
                     const std::string &encoded_bundle);
   void OnSetCache(const CacheParamsEfl& params);
+  void OnPrewarm();
+  void PurgeDecodedImages();
+  void PurgeMemoryCache(tizen_webview::Memory_Pressure_Level level);
+  void PurgeV8Heap(tizen_webview::Memory_Pressure_Level level);
   void OnWrtMessage(const tizen_webview::WrtIpcMessageData& data);
   ContentRendererClientEfl* content_client_;
   bool webkit_initialized_;
+  bool has_pending_cache_params_;
   CacheParamsEfl pending_cache_params_;
 };
 
@@ -7,14 +7,18 @@
 #include <string>
 #include <limits.h>
 
-#include "base/files/file_path.h"
+#include "base/bind.h"
+#include "base/memory/shared_memory.h"
+#include "base/message_loop/message_loop.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "content/public/renderer/content_renderer_client.h"
+#include "content/public/renderer/render_thread.h"
 #include "content/public/renderer/render_view.h"
 #include "common/render_messages_efl.h"
+#include "wrt/wrt_async_message_channel.h"
 #include "third_party/WebKit/public/platform/WebCString.h"
 #include "third_party/WebKit/public/platform/WebData.h"
 #include "third_party/WebKit/public/platform/WebPoint.h"
@@ -22,6 +26,8 @@
 #include "third_party/WebKit/public/platform/WebString.h"
 #include "third_party/WebKit/public/platform/WebURLError.h"
 #include "third_party/WebKit/public/platform/WebURLRequest.h"
+#include "third_party/WebKit/public/web/WebCache.h"
+#include "third_party/WebKit/public/platform/WebImage.h"
 #include "third_party/WebKit/public/web/WebDocument.h"
 #include "third_party/WebKit/public/web/WebDataSource.h"
 #include "third_party/WebKit/public/web/WebFormElement.h"
@@ -137,6 +143,7 @@ RenderViewObserverEfl::RenderViewObserverEfl(
 
 RenderViewObserverEfl::~RenderViewObserverEfl()
 {
+  WrtAsyncMessageChannel::GetInstance()->CancelRequests(routing_id());
 }
 
 bool RenderViewObserverEfl::OnMessageReceived(const IPC::Message& message)
@@ -148,12 +155,16 @@ bool RenderViewObserverEfl::OnMessageReceived(const IPC::Message& message)
     IPC_MESSAGE_HANDLER(EwkViewMsg_SetScroll, OnSetScroll)
     IPC_MESSAGE_HANDLER(EwkViewMsg_UseSettingsFont, OnUseSettingsFont)
     IPC_MESSAGE_HANDLER(EwkViewMsg_PlainTextGet, OnPlainTextGet)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_ExecuteRegisteredScript, OnExecuteRegisteredScript)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_WrtAsyncMessageReply, OnWrtAsyncMessageReply)
     IPC_MESSAGE_HANDLER(EwkViewMsg_GetSelectionStyle, OnGetSelectionStyle);
     IPC_MESSAGE_HANDLER(EwkViewMsg_SelectClosestWord, OnSelectClosestWord);
     IPC_MESSAGE_HANDLER(EwkViewMsg_DoHitTest, OnDoHitTest)
     IPC_MESSAGE_HANDLER(EwkViewMsg_DoHitTestAsync, OnDoHitTestAsync)
     IPC_MESSAGE_HANDLER(EwkViewMsg_PrintToPdf, OnPrintToPdf)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_CancelPdfExport, OnCancelPdfExport)
     IPC_MESSAGE_HANDLER(EwkViewMsg_GetMHTMLData, OnGetMHTMLData);
+    IPC_MESSAGE_HANDLER(EwkViewMsg_GetImageContentsAt, OnGetImageContentsAt)
     IPC_MESSAGE_HANDLER(EwkViewMsg_WebAppIconUrlGet, OnWebAppIconUrlGet);
     IPC_MESSAGE_HANDLER(EwkViewMsg_WebAppIconUrlsGet, OnWebAppIconUrlsGet);
     IPC_MESSAGE_HANDLER(EwkViewMsg_WebAppCapableGet, OnWebAppCapableGet);
@@ -168,6 +179,20 @@ bool RenderViewObserverEfl::OnMessageReceived(const IPC::Message& message)
   return handled;
 }
 
+void RenderViewObserverEfl::Navigate(const GURL& url)
+{
+  // The browser splits one memory cache budget between all renderers,
+  // report our usage so that it can revise the split.
+  blink::WebCache::UsageStats usage;
+  blink::WebCache::getUsageStats(&usage);
+
+  CacheStatsEfl stats;
+  stats.capacity = usage.capacity;
+  stats.live_size = usage.liveSize;
+  stats.dead_size = usage.deadSize;
+  content::RenderThread::Get()->Send(new EflViewHostMsg_CacheStats(stats));
+}
+
 void RenderViewObserverEfl::DidCreateDocumentElement(blink::WebLocalFrame* frame)
 {
   std::string policy;
@@ -230,6 +255,26 @@ void RenderViewObserverEfl::OnPlainTextGet(int plain_text_get_callback_id)
   Send(new EwkHostMsg_PlainTextGetContents(render_view()->GetRoutingID(), content.utf8(), plain_text_get_callback_id));
 }
 
+void RenderViewObserverEfl::OnExecuteRegisteredScript(int script_id, int callback_id)
+{
+  RegisteredScriptRunnerEfl::Execution execution;
+  blink::WebFrame* frame = render_view()->GetWebView()->mainFrame();
+  if (frame && frame->isWebLocalFrame()) {
+    static_cast<ContentRendererClientEfl*>(renderer_client_)->
+        registered_script_runner()->Execute(frame->toWebLocalFrame(), script_id, &execution);
+  }
+  // Replies even on failure, the browser holds the callback.
+  Send(new EwkHostMsg_RegisteredScriptExecuted(render_view()->GetRoutingID(), callback_id,
+      execution.result, execution.compile_time, execution.compile_time_saved,
+      execution.produced_code_cache));
+}
+
+void RenderViewObserverEfl::OnWrtAsyncMessageReply(int request_id, bool success,
+                                                   const WrtMessageValueEfl& value)
+{
+  WrtAsyncMessageChannel::GetInstance()->OnReply(request_id, success, value);
+}
+
 void RenderViewObserverEfl::DidChangeScrollOffset(blink::WebLocalFrame* frame)
 {
   if (!frame || (render_view()->GetWebView()->mainFrame() != frame))
@@ -339,12 +384,83 @@ bool RenderViewObserverEfl::DoHitTest(int view_x, int view_y, tizen_webview::Hit
   return true;
 }
 
-void RenderViewObserverEfl::OnPrintToPdf(int width, int height, const base::FilePath& filename)
+void RenderViewObserverEfl::OnPrintToPdf(const PdfExportParams& params,
+    const IPC::PlatformFileForTransit& file)
 {
+  // The browser runs one export per view at a time, a new request means
+  // the previous one has been given up.
+  if (print_helper_)
+    print_helper_->Cancel();
+
   blink::WebView* web_view = render_view()->GetWebView();
   DCHECK(web_view);
-  PrintWebViewHelperEfl print_helper(render_view(), filename);
-  print_helper.PrintToPdf(width, height);
+  print_helper_.reset(new PrintWebViewHelperEfl(render_view(), params,
+      IPC::PlatformFileForTransitToFile(file),
+      base::Bind(&RenderViewObserverEfl::OnPdfExportDone,
+                 base::Unretained(this))));
+  print_helper_->PrintToPdf();
+}
+
+void RenderViewObserverEfl::OnCancelPdfExport(int job_id)
+{
+  if (print_helper_ && print_helper_->job_id() == job_id)
+    print_helper_->Cancel();
+}
+
+void RenderViewObserverEfl::OnPdfExportDone()
+{
+  // Called from within the helper, so it can not be deleted right away.
+  base::MessageLoop::current()->DeleteSoon(FROM_HERE, print_helper_.release());
+}
+
+void RenderViewObserverEfl::DidStartProvisionalLoad(blink::WebLocalFrame* frame)
+{
+  // The export prints the main frame over several tasks, do not let a page
+  // that is going away be exported.
+  if (print_helper_ && !frame->parent())
+    print_helper_->Cancel();
+}
+
+void RenderViewObserverEfl::OnGetImageContentsAt(int view_x, int view_y,
+                                                 const GURL& image_url)
+{
+  base::SharedMemoryHandle handle = base::SharedMemory::NULLHandle();
+  uint32 buffer_size = 0;
+  gfx::Size size;
+
+  blink::WebView* view = render_view()->GetWebView();
+  blink::WebNode node;
+  if (view) {
+    // The page may have changed since the context menu was shown, only hand
+    // over the image the menu was for.
+    blink::WebHitTestResult hit_test =
+        view->hitTestResultAt(blink::WebPoint(view_x, view_y));
+    if (GURL(hit_test.absoluteImageURL()) == image_url)
+      node = hit_test.node();
+  }
+
+  if (!node.isNull() && node.isElementNode()) {
+    // The decoded image is still around as long as the element shows it,
+    // hand it over instead of letting the browser fetch it again.
+    SkBitmap bitmap = node.toConst<blink::WebElement>().imageContents().getSkBitmap();
+    size_t row_bytes = bitmap.width() * 4;
+    size_t pixels_size = row_bytes * bitmap.height();
+    if (!bitmap.isNull() && bitmap.colorType() == kN32_SkColorType &&
+        pixels_size && pixels_size <= kuint32max) {
+      scoped_ptr<base::SharedMemory> shared_mem(
+          content::RenderThread::Get()->HostAllocateSharedMemoryBuffer(pixels_size));
+      if (shared_mem && shared_mem->Map(pixels_size)) {
+        SkAutoLockPixels lock(bitmap);
+        if (bitmap.copyPixelsTo(shared_mem->memory(), pixels_size, row_bytes)) {
+          shared_mem->GiveToProcess(base::GetCurrentProcessHandle(), &handle);
+          buffer_size = pixels_size;
+          size.SetSize(bitmap.width(), bitmap.height());
+        }
+      }
+    }
+  }
+
+  Send(new EwkHostMsg_ImageContents(routing_id(), handle, buffer_size, size));
 }
 
 void RenderViewObserverEfl::OnGetMHTMLData(int callback_id)
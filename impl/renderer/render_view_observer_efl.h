@@ -6,7 +6,9 @@
 #define RENDER_VIEW_OBSERVER_EFL_H_
 
 #include <string>
+#include "base/memory/scoped_ptr.h"
 #include "base/timer/timer.h"
+#include "ipc/ipc_platform_file.h"
 #include "content/public/renderer/render_view_observer.h"
 #include "content/public/renderer/render_view_observer.h"
 #include "renderer/content_renderer_client_efl.h"
@@ -19,10 +21,6 @@
 #include "tizen_webview/public/tw_hit_test.h"
 #include "tizen_webview/public/tw_view_mode.h"
 
-namespace base {
-class FilePath;
-}
-
 namespace content {
 class ContentRendererClient;
 class RenderView;
@@ -37,6 +35,7 @@ class Settings;
 }
 
 class EwkViewMsg_LoadData_Params;
+struct WrtMessageValueEfl;
 
 class RenderViewObserverEfl: public content::RenderViewObserver {
  public:
@@ -46,11 +45,13 @@ class RenderViewObserverEfl: public content::RenderViewObserver {
   virtual ~RenderViewObserverEfl();
 
   void DidChangeScrollOffset(blink::WebLocalFrame* frame) override;
+  void Navigate(const GURL& url) override;
   bool OnMessageReceived(const IPC::Message& message) override;
   virtual void DidCreateDocumentElement(blink::WebLocalFrame* frame) override;
 #if !defined(EWK_BRINGUP)
   virtual void DidChangePageScaleFactor() override;
 #endif
+  void DidStartProvisionalLoad(blink::WebLocalFrame* frame) override;
   void DidFailLoad(blink::WebLocalFrame* frame,
                    const blink::WebURLError& error) override;
   void DidFailProvisionalLoad(blink::WebLocalFrame* frame,
@@ -68,13 +69,19 @@ class RenderViewObserverEfl: public content::RenderViewObserver {
   void OnSetScroll(int x, int y);
   void OnUseSettingsFont();
   void OnPlainTextGet(int plain_text_get_callback_id);
+  void OnExecuteRegisteredScript(int script_id, int callback_id);
+  void OnWrtAsyncMessageReply(int request_id, bool success,
+                              const WrtMessageValueEfl& value);
   void OnGetSelectionStyle();
   void OnSelectClosestWord(int x, int y);
   void OnDoHitTest(int x, int y, tizen_webview::Hit_Test_Mode mode);
   void OnDoHitTestAsync(int view_x, int view_y, tizen_webview::Hit_Test_Mode mode, int64_t request_id);
   bool DoHitTest(int view_x, int view_y, tizen_webview::Hit_Test_Mode mode, _Ewk_Hit_Test* hit_test_result, NodeAttributesMap* attributes);
-  void OnPrintToPdf(int width, int height, const base::FilePath& filename);
+  void OnPrintToPdf(const PdfExportParams& params, const IPC::PlatformFileForTransit& file);
+  void OnCancelPdfExport(int job_id);
+  void OnPdfExportDone();
   void OnGetMHTMLData(int callback_id);
+  void OnGetImageContentsAt(int view_x, int view_y, const GURL& image_url);
   void OnSetDrawsTransparentBackground(bool enabled);
   void OnWebAppIconUrlGet(int callback_id);
   void OnWebAppIconUrlsGet(int callback_id);
@@ -96,6 +103,9 @@ class RenderViewObserverEfl: public content::RenderViewObserver {
   base::OneShotTimer<RenderViewObserverEfl> check_contents_size_timer_;
 
   content::ContentRendererClient* renderer_client_;
+
+  // The PDF export in progress, if any.
+  scoped_ptr<PrintWebViewHelperEfl> print_helper_;
 };
 
 #endif /* RENDER_VIEW_OBSERVER_EFL_H_ */
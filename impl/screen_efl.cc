@@ -6,7 +6,11 @@
 #include "eweb_view.h"
 
 #include <X11/Xlib.h>
+#include <Ecore.h>
+#include <Ecore_Input.h>
+#include "ecore_x_wrapper.h"
 
+#include "base/observer_list.h"
 #include "ui/gfx/screen_type_delegate.h"
 #include "ui/base/x/x11_util.h"
 #include "ui/gfx/display.h"
@@ -28,15 +32,56 @@ const float kDefaultDeviceScaleFactor = 1.0f;
 #endif
 } // namespace
 
+// The display is read from Xlib once and cached, it is only recomputed on
+// RandR screen changes and when the embedder sets the orientation. Observers,
+// e.g. the views, are told what changed and push it to their renderers.
 class EflScreen : public gfx::Screen {
  public:
-  EflScreen() {
+  EflScreen()
+      : display_initialized_(false),
+        has_cursor_point_(false) {
+    ecore_x_randr_events_select(ecore_x_window_root_first_get(), EINA_TRUE);
+    screen_change_handler_ = ecore_event_handler_add(
+        ECORE_X_EVENT_SCREEN_CHANGE, OnScreenChange, this);
+    mouse_move_handler_ = ecore_event_handler_add(
+        ECORE_EVENT_MOUSE_MOVE, OnMouseMove, this);
   }
 
   virtual ~EflScreen() {
+    ecore_event_handler_del(screen_change_handler_);
+    ecore_event_handler_del(mouse_move_handler_);
   }
 
+  // Recomputes the cached display and notifies observers if it changed.
+  void UpdateDisplay() {
+    if (!display_initialized_)
+      return;
+
+    gfx::Display old_display = display_;
+    display_ = ComputePrimaryDisplay();
+
+    uint32_t changed_metrics = gfx::DisplayObserver::DISPLAY_METRIC_NONE;
+    if (display_.bounds() != old_display.bounds())
+      changed_metrics |= gfx::DisplayObserver::DISPLAY_METRIC_BOUNDS;
+    if (display_.work_area() != old_display.work_area())
+      changed_metrics |= gfx::DisplayObserver::DISPLAY_METRIC_WORK_AREA;
+    if (display_.device_scale_factor() != old_display.device_scale_factor())
+      changed_metrics |= gfx::DisplayObserver::DISPLAY_METRIC_DEVICE_SCALE_FACTOR;
+    if (display_.rotation() != old_display.rotation())
+      changed_metrics |= gfx::DisplayObserver::DISPLAY_METRIC_ROTATION;
+
+    if (changed_metrics != gfx::DisplayObserver::DISPLAY_METRIC_NONE) {
+      FOR_EACH_OBSERVER(gfx::DisplayObserver, observers_,
+                        OnDisplayMetricsChanged(display_, changed_metrics));
+    }
+  }
+
+  // Falls back to asking the X server until the pointer has moved over one
+  // of our windows.
   virtual gfx::Point GetCursorScreenPoint() override {
+    if (has_cursor_point_)
+      return cursor_point_;
+
     XDisplay* display = gfx::GetXDisplay();
 
     ::Window root, child;
@@ -85,8 +130,30 @@ class EflScreen : public gfx::Screen {
     return GetPrimaryDisplay();
   }
 
+  // Computed on first use rather than at construction, the screen is
+  // installed before the command line forcing the scale factor is parsed.
   virtual gfx::Display GetPrimaryDisplay() const override {
-    ::Screen* screen = DefaultScreenOfDisplay(gfx::GetXDisplay());
+    if (!display_initialized_) {
+      display_ = ComputePrimaryDisplay();
+      display_initialized_ = true;
+    }
+    return display_;
+  }
+
+  virtual void AddObserver(gfx::DisplayObserver* observer) override {
+    observers_.AddObserver(observer);
+  }
+
+  virtual void RemoveObserver(gfx::DisplayObserver* observer) override {
+    observers_.RemoveObserver(observer);
+  }
+
+ private:
+  gfx::Display ComputePrimaryDisplay() const {
+    if (screen_size_.IsEmpty()) {
+      ::Screen* screen = DefaultScreenOfDisplay(gfx::GetXDisplay());
+      screen_size_.SetSize(WidthOfScreen(screen), HeightOfScreen(screen));
+    }
 
     const float device_scale_factor =
         gfx::Display::HasForceDeviceScaleFactor() ?
@@ -101,11 +168,11 @@ class EflScreen : public gfx::Screen {
     int width, height;
     if (display.rotation() == gfx::Display::ROTATE_90 ||
         display.rotation() == gfx::Display::ROTATE_270) {
-      width = HeightOfScreen(screen);
-      height = WidthOfScreen(screen);
+      width = screen_size_.height();
+      height = screen_size_.width();
     } else {
-      width = WidthOfScreen(screen);
-      height = HeightOfScreen(screen);
+      width = screen_size_.width();
+      height = screen_size_.height();
     }
 
     const gfx::Rect bounds_in_pixels = gfx::Rect(width, height);
@@ -118,13 +185,34 @@ class EflScreen : public gfx::Screen {
     return display;
   }
 
-  virtual void AddObserver(gfx::DisplayObserver* observer) override {
+  static Eina_Bool OnScreenChange(void* data, int type, void* event) {
+    // Xlib's screen keeps the old size, the event has the new one.
+    EflScreen* screen = static_cast<EflScreen*>(data);
+    Ecore_X_Event_Screen_Change* change =
+        static_cast<Ecore_X_Event_Screen_Change*>(event);
+    screen->screen_size_.SetSize(change->size.width, change->size.height);
+    screen->UpdateDisplay();
+    return ECORE_CALLBACK_PASS_ON;
   }
 
-  virtual void RemoveObserver(gfx::DisplayObserver* observer) override {
+  static Eina_Bool OnMouseMove(void* data, int type, void* event) {
+    EflScreen* screen = static_cast<EflScreen*>(data);
+    Ecore_Event_Mouse_Move* move = static_cast<Ecore_Event_Mouse_Move*>(event);
+    screen->cursor_point_.SetPoint(move->root.x, move->root.y);
+    screen->has_cursor_point_ = true;
+    return ECORE_CALLBACK_PASS_ON;
   }
 
- private:
+  mutable gfx::Display display_;
+  mutable bool display_initialized_;
+  // In pixels, unrotated.
+  mutable gfx::Size screen_size_;
+  gfx::Point cursor_point_;
+  bool has_cursor_point_;
+  Ecore_Event_Handler* screen_change_handler_;
+  Ecore_Event_Handler* mouse_move_handler_;
+  ObserverList<gfx::DisplayObserver> observers_;
+
   DISALLOW_COPY_AND_ASSIGN(EflScreen);
 };
 
@@ -136,6 +224,10 @@ void InstallScreenInstance()
     gfx::Screen::SetScreenInstance(gfx::SCREEN_TYPE_NATIVE, new ui::EflScreen());
   }
 }
+
+void UpdateScreenDisplay() {
+  static_cast<EflScreen*>(gfx::Screen::GetNativeScreen())->UpdateDisplay();
+}
 } // namespace ui
 
 namespace gfx {
@@ -11,6 +11,10 @@ namespace ui {
 
 void InstallScreenInstance();
 
+// Recomputes the cached display, e.g. after the embedder changed the
+// orientation, and notifies gfx::DisplayObservers of what changed.
+void UpdateScreenDisplay();
+
 }
 
 #endif
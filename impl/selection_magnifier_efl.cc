@@ -21,6 +21,7 @@ const float kZoomScale = 0.66;
 SelectionMagnifierEfl::SelectionMagnifierEfl(content::SelectionControllerEfl* controller)
   : controller_(controller),
     content_image_(0),
+    content_image_attached_(false),
     animator_(0),
     shown_(false) {
   Evas_Object* top_widget = elm_object_top_widget_get(
@@ -36,6 +37,12 @@ SelectionMagnifierEfl::SelectionMagnifierEfl(content::SelectionControllerEfl* co
   container_ = elm_layout_add(top_widget);
   elm_layout_file_set(container_, magnifier_edj.AsUTF8Unsafe().c_str(), "magnifier");
   edje_object_part_geometry_get(elm_layout_edje_get(container_), "bg", 0, 0, &width_, &height_);
+
+  // Kept for the lifetime of the magnifier, moves only update what it shows.
+  content_image_ = evas_object_image_filled_add(evas_object_evas_get(container_));
+  elm_object_part_content_set(container_, "swallow", content_image_);
+  evas_object_pass_events_set(content_image_, EINA_TRUE);
+  evas_object_clip_set(content_image_, container_);
 }
 
 SelectionMagnifierEfl::~SelectionMagnifierEfl() {
@@ -136,25 +143,33 @@ void SelectionMagnifierEfl::UpdateLocation(const gfx::Point& location) {
   else if (content_rect.y() > device_height - zoomedHeight)
     content_rect.set_y(device_height - zoomedHeight);
 
+  // Drawn from the page texture with the next frame, the pixel readback is
+  // only left for views not composited on the GPU.
+  if (AttachContentImage() &&
+      controller_->GetParentView()->UpdateMagnifierImage(content_rect))
+    return;
   controller_->GetParentView()->GetSnapShotForRect(content_rect);
 }
 
+bool SelectionMagnifierEfl::AttachContentImage() {
+  // The view releases its GL surfaces while hidden, so this is checked on
+  // every use. Attaching the image again is a no-op.
+  content_image_attached_ = controller_->GetParentView()->AttachMagnifierImage(
+      content_image_, gfx::Size(width_, height_));
+  return content_image_attached_;
+}
+
 void SelectionMagnifierEfl::UpdateScreen(const SkBitmap& display_image) {
-  if (content_image_) {
-    evas_object_del(content_image_);
-    content_image_ = 0;
-  }
+  if (content_image_attached_)
+    return;
 
-  Evas* evas = evas_object_evas_get(controller_->GetParentView()->evas_object());
-  content_image_ = evas_object_image_filled_add(evas);
-  evas_object_image_size_set(content_image_, width_ * kZoomScale, height_ * kZoomScale);
+  int image_width = width_ * kZoomScale;
+  int image_height = height_ * kZoomScale;
+  evas_object_image_size_set(content_image_, image_width, image_height);
   evas_object_image_data_copy_set(content_image_, display_image.getPixels());
+  evas_object_image_data_update_add(content_image_, 0, 0, image_width, image_height);
   evas_object_show(content_image_);
 
-  elm_object_part_content_set(container_, "swallow", content_image_);
-  evas_object_pass_events_set(content_image_, EINA_TRUE);
-  evas_object_clip_set(content_image_, container_);
-
   evas_object_layer_set(container_, EVAS_LAYER_MAX);
   evas_object_layer_set(content_image_, EVAS_LAYER_MAX);
 }
@@ -185,6 +200,11 @@ void SelectionMagnifierEfl::Move(const gfx::Point& location) {
 
 void SelectionMagnifierEfl::Show() {
   shown_ = true;
+  if (AttachContentImage()) {
+    evas_object_show(content_image_);
+    evas_object_layer_set(container_, EVAS_LAYER_MAX);
+    evas_object_layer_set(content_image_, EVAS_LAYER_MAX);
+  }
   evas_object_show(container_);
   controller_->GetParentView()->SmartCallback<EWebViewCallbacks::MagnifierShow>().call();
   controller_->GetParentView()->set_magnifier(true);
@@ -32,6 +32,7 @@ class SelectionMagnifierEfl {
 
  private:
   void DestroyAnimator();
+  bool AttachContentImage();
 
   static Eina_Bool MoveAnimatorCallback(void* data);
   static void OnAnimatorUp(void* data, Evas*, Evas_Object*, void*);
@@ -42,8 +43,9 @@ class SelectionMagnifierEfl {
   // Magnifier
   Evas_Object* container_;
 
-  // Image displayed on popup
+  // Image displayed on popup, drawn by the compositor when possible.
   Evas_Object* content_image_;
+  bool content_image_attached_;
 
   // Magnifier Height
   int height_;
@@ -8,6 +8,8 @@
 
 #include <Evas.h>
 
+#include "tizen_webview/public/tw_pdf_export_status.h"
+
 namespace tizen_webview {
 class Hit_Test;
 class Security_Origin;
@@ -92,6 +94,25 @@ typedef void (*View_Plain_Text_Get_Callback)(Evas_Object* o, const char* plain_t
  */
 typedef void (*View_MHTML_Data_Get_Callback)(Evas_Object *o, const char *data, void *user_data);
 
+/**
+ * Callback for the progress of ewk_view_contents_pdf_range_get
+ *
+ * @param o the view object
+ * @param pages_printed number of pages printed so far
+ * @param page_count number of pages to print
+ * @param user_data user data
+ */
+typedef void (*View_Pdf_Export_Progress_Callback)(Evas_Object* o, int pages_printed, int page_count, void* user_data);
+
+/**
+ * Callback for the completion of ewk_view_contents_pdf_range_get
+ *
+ * @param o the view object
+ * @param status how the export ended
+ * @param user_data user data
+ */
+typedef void (*View_Pdf_Export_Finished_Callback)(Evas_Object* o, Pdf_Export_Status status, void* user_data);
+
 
 //typedef Eina_Bool (*View_Password_Confirm_Popup_Callback)(Evas_Object* o, const char* message, void* user_data);
 typedef Eina_Bool (*View_JavaScript_Alert_Callback)(Evas_Object* o, const char* alert_text, void* user_data);
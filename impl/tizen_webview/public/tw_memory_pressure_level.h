@@ -0,0 +1,17 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TIZEN_WEBVIEW_PUBLIC_TW_MEMORY_PRESSURE_LEVEL_H_
+#define TIZEN_WEBVIEW_PUBLIC_TW_MEMORY_PRESSURE_LEVEL_H_
+
+namespace tizen_webview {
+
+enum Memory_Pressure_Level {
+  TW_MEMORY_PRESSURE_LEVEL_MODERATE, // Drop caches that are cheap to rebuild.
+  TW_MEMORY_PRESSURE_LEVEL_CRITICAL  // Free everything that can be recomputed.
+};
+
+} // namespace tizen_webview
+
+#endif  // TIZEN_WEBVIEW_PUBLIC_TW_MEMORY_PRESSURE_LEVEL_H_
@@ -0,0 +1,19 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TIZEN_WEBVIEW_PUBLIC_TW_PDF_EXPORT_STATUS_H_
+#define TIZEN_WEBVIEW_PUBLIC_TW_PDF_EXPORT_STATUS_H_
+
+namespace tizen_webview {
+
+// Keep in sync with Ewk_Pdf_Export_Status.
+enum Pdf_Export_Status {
+  TW_PDF_EXPORT_SUCCEEDED,
+  TW_PDF_EXPORT_FAILED,
+  TW_PDF_EXPORT_CANCELLED
+};
+
+} // namespace tizen_webview
+
+#endif  // TIZEN_WEBVIEW_PUBLIC_TW_PDF_EXPORT_STATUS_H_
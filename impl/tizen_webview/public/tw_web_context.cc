@@ -105,6 +105,10 @@ void WebContext::NotifyLowMemory() {
   impl->NotifyLowMemory();
 }
 
+void WebContext::NotifyMemoryPressure(Memory_Pressure_Level level) {
+  impl->NotifyMemoryPressure(level);
+}
+
 bool WebContext::HTTPCustomHeaderAdd(const char* name, const char* value) {
   BrowserContextEfl::ResourceContextEfl* rc = GetResourceContextEfl(impl);
 
@@ -248,4 +252,20 @@ bool WebContext::InspectorServerStop() const {
   return impl->InspectorServerStop();
 }
 
+int WebContext::RegisterScript(const char* script) {
+  return impl->RegisterScript(script);
+}
+
+bool WebContext::UnregisterScript(int script_id) {
+  return impl->UnregisterScript(script_id);
+}
+
+void WebContext::SetSpareRendererEnabled(bool enable) {
+  impl->SetSpareRendererEnabled(enable);
+}
+
+bool WebContext::GetSpareRendererEnabled() const {
+  return impl->GetSpareRendererEnabled();
+}
+
 } // namespace tizen_webview
@@ -12,6 +12,7 @@
 #include "base/memory/weak_ptr.h"
 #include "tizen_webview/public/tw_callbacks.h"
 #include "tizen_webview/public/tw_cache_model.h"
+#include "tizen_webview/public/tw_memory_pressure_level.h"
 #include "tizen_webview/public/tw_ref_counted.h"
 
 class CookieManager;
@@ -56,6 +57,7 @@ struct WebContext : public tizen_webview::RefCounted<WebContext> {
   // System
   void AddExtraPluginDir(const char *path);
   void NotifyLowMemory();
+  void NotifyMemoryPressure(Memory_Pressure_Level level);
 
   // HTTP Custom Header
   bool HTTPCustomHeaderAdd(const char* name, const char* value);
@@ -129,6 +131,14 @@ struct WebContext : public tizen_webview::RefCounted<WebContext> {
   unsigned int InspectorServerStart(unsigned int port) const;
   bool InspectorServerStop() const;
 
+  // Registered scripts
+  int RegisterScript(const char* script);
+  bool UnregisterScript(int script_id);
+
+  // Spare renderer
+  void SetSpareRendererEnabled(bool enable);
+  bool GetSpareRendererEnabled() const;
+
  private:
   EWebContext* impl;
 
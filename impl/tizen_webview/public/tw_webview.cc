@@ -10,6 +10,7 @@
 #include <base/memory/scoped_ptr.h>
 
 #include "browser/renderer_host/render_widget_host_view_efl.h"
+#include "browser/session_store_efl.h"
 #include <tizen_webview/public/tw_webview_delegate.h>
 
 namespace {
@@ -319,8 +320,8 @@ Evas_Object* WebView::GetSnapshot(Eina_Rectangle rect) {
   return impl_->GetSnapshot(rect);
 }
 
-bool WebView::GetSnapshotAsync(Eina_Rectangle rect, Evas* canvas, Web_App_Screenshot_Captured_Callback callback, void* user_data) {
-  return impl_->GetSnapshotAsync(rect, canvas, callback, user_data);
+bool WebView::GetSnapshotAsync(Eina_Rectangle rect, float scale_factor, Evas* canvas, Web_App_Screenshot_Captured_Callback callback, void* user_data) {
+  return impl_->GetSnapshotAsync(rect, scale_factor, canvas, callback, user_data);
 }
 
 void WebView::SetDrawsTransparentBackground(bool enabled) {
@@ -384,6 +385,15 @@ void WebView::GetSessionData(const char **data, unsigned *length) const {
   return impl_->GetSessionData(data, length);
 }
 
+bool WebView::WriteSessionData(int fd, bool delta, bool compressed) const {
+  int flags = SessionStoreEfl::WRITE_FULL;
+  if (delta)
+    flags |= SessionStoreEfl::WRITE_DELTA;
+  if (compressed)
+    flags |= SessionStoreEfl::WRITE_COMPRESSED;
+  return impl_->WriteSessionData(fd, flags);
+}
+
 bool WebView::RestoreFromSessionData(const char *data, unsigned length) {
   return impl_->RestoreFromSessionData(data, length);
 }
@@ -424,10 +434,22 @@ void WebView::UpdateWebKitPreferences() {
   return impl_->UpdateWebKitPreferences();
 }
 
+void WebView::BeginSettingsTransaction() {
+  return impl_->BeginSettingsTransaction();
+}
+
+void WebView::CommitSettingsTransaction() {
+  return impl_->CommitSettingsTransaction();
+}
+
 bool WebView::ExecuteJavaScript(const char* script, View_Script_Execute_Callback callback, void* userdata) {
   return impl_->ExecuteJavaScript(script, callback, userdata);
 }
 
+bool WebView::ExecuteRegisteredScript(int script_id, View_Script_Execute_Callback callback, void* userdata) {
+  return impl_->ExecuteRegisteredScript(script_id, callback, userdata);
+}
+
 void WebView::SetJavaScriptAlertCallback(View_JavaScript_Alert_Callback callback, void* user_data) {
   return impl_->SetJavaScriptAlertCallback(callback, user_data);
 }
@@ -485,6 +507,19 @@ bool WebView::SaveAsPdf(int width, int height, const std::string& file_name) {
   return impl_->SaveAsPdf(width, height, file_name);
 }
 
+bool WebView::SaveAsPdf(int width, int height, int first_page, int last_page,
+                        const std::string& file_name,
+                        View_Pdf_Export_Progress_Callback progress_callback,
+                        View_Pdf_Export_Finished_Callback finished_callback,
+                        void* user_data) {
+  return impl_->SaveAsPdf(width, height, first_page, last_page, file_name,
+                          progress_callback, finished_callback, user_data);
+}
+
+bool WebView::CancelPdfExport() {
+  return impl_->CancelPdfExport();
+}
+
 int WebView::StartInspectorServer(int port ) {
   return impl_->StartInspectorServer(port);
 }
@@ -148,7 +148,8 @@ class WebView {
   // > View Snapshot
   // Get snapshot for given |rect|. Return a new created Evas_Object.
   Evas_Object* GetSnapshot(Eina_Rectangle rect);
-  bool GetSnapshotAsync(Eina_Rectangle rect, Evas* canvas, Web_App_Screenshot_Captured_Callback callback, void* user_data);
+  // |scale_factor| other than 1.0 needs hardware acceleration.
+  bool GetSnapshotAsync(Eina_Rectangle rect, float scale_factor, Evas* canvas, Web_App_Screenshot_Captured_Callback callback, void* user_data);
   // > View Misc.
   void SetDrawsTransparentBackground(bool enabled);
 
@@ -170,6 +171,7 @@ class WebView {
 
   // ---- Session
   void GetSessionData(const char **data, unsigned *length) const;
+  bool WriteSessionData(int fd, bool delta, bool compressed) const;
   bool RestoreFromSessionData(const char *data, unsigned length);
 
   // ---- Settings
@@ -182,9 +184,12 @@ class WebView {
   void SetLinkMagnifierEnabled(bool enabled);
   void SetBrowserFont(); // browser specific? make static?
   void UpdateWebKitPreferences(); // global? make static
+  void BeginSettingsTransaction();
+  void CommitSettingsTransaction();
 
   //---- JavaScript
   bool ExecuteJavaScript(const char* script, View_Script_Execute_Callback callback, void* userdata);
+  bool ExecuteRegisteredScript(int script_id, View_Script_Execute_Callback callback, void* userdata);
   void SetJavaScriptAlertCallback(View_JavaScript_Alert_Callback callback, void* user_data);
   void JavaScriptAlertReply();
   void SetJavaScriptConfirmCallback(View_JavaScript_Confirm_Callback callback, void* user_data);
@@ -207,6 +212,12 @@ class WebView {
 
   // ---- Misc.
   bool SaveAsPdf(int width, int height, const std::string& file_name);
+  bool SaveAsPdf(int width, int height, int first_page, int last_page,
+                 const std::string& file_name,
+                 View_Pdf_Export_Progress_Callback progress_callback,
+                 View_Pdf_Export_Finished_Callback finished_callback,
+                 void* user_data);
+  bool CancelPdfExport();
   // Returns TCP port number with Inspector, or 0 if error.
   int StartInspectorServer(int port = 0);
   bool StopInspectorServer();
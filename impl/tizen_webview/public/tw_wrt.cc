@@ -5,13 +5,26 @@
 
 #include "tw_wrt.h"
 
+#include "base/bind.h"
 #include "content/public/renderer/render_view.h"
 #include "common/render_messages_efl.h"
 #include "eweb_context.h"
 #include "tizen_webview/public/tw_web_context.h"
+#include "wrt/wrt_async_message_channel.h"
 
 namespace tizen_webview {
 
+namespace {
+
+void RunReplyCallback(Wrt_Plugins_Reply_Callback callback,
+                      void* user_data,
+                      bool success,
+                      const WrtIpcMessageData& reply) {
+  callback(&reply, success, user_data);
+}
+
+} // namespace
+
 const char* WrtIpcMessageData::GetType() const {
   return type.c_str();
 }
@@ -73,4 +86,14 @@ bool WrtPluginsIpc::SendSyncMessage(int routing_id, WrtIpcMessageData* data) {
   return true;
 }
 
+bool WrtPluginsIpc::SendAsyncMessage(int routing_id,
+                                     const WrtIpcMessageData& data,
+                                     Wrt_Plugins_Reply_Callback callback,
+                                     void* user_data) {
+  if (!callback)
+    return false;
+  return WrtAsyncMessageChannel::GetInstance()->Send(routing_id, data,
+      base::Bind(&RunReplyCallback, callback, user_data)) != 0;
+}
+
 } // namespace tizen_webview
@@ -28,13 +28,26 @@ struct WrtIpcMessageData {
 
 class WebContext;
 
+// Runs on the renderer main thread with the data of the request, its value
+// replaced by the reply. |success| is false if the view closed first.
+typedef void (*Wrt_Plugins_Reply_Callback)(const WrtIpcMessageData* reply,
+                                           bool success,
+                                           void* user_data);
+
 struct WrtIpc {
   static bool SendMessage(WebContext* ctx, const WrtIpcMessageData& data);
 };
 
 struct WrtPluginsIpc {
   static bool SendMessage(int routing_id, const WrtIpcMessageData& data);
+  // Blocks the renderer main thread until the browser answers, prefer
+  // SendAsyncMessage().
   static bool SendSyncMessage(int routing_id, WrtIpcMessageData* data);
+  // Returns false if |data| cannot be sent, |callback| does not run then.
+  static bool SendAsyncMessage(int routing_id,
+                               const WrtIpcMessageData& data,
+                               Wrt_Plugins_Reply_Callback callback,
+                               void* user_data);
 };
 
 } // namespace tizen_webview
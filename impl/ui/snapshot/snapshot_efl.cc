@@ -8,14 +8,70 @@
 #include "base/callback.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/task_runner_util.h"
+#include "browser/renderer_host/render_widget_host_view_efl.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/display.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/rect.h"
+#include "ui/gfx/size_conversions.h"
 #include "ui/gfx/screen.h"
 
 namespace ui {
 
+namespace {
+
+// Pages are drawn by their RenderWidgetHostViewEfl into its own image, so
+// |window| is looked up among them. Anything else, e.g. the toplevel window,
+// stands for the page showing on its canvas.
+content::RenderWidgetHostViewEfl* FindViewForWindow(
+    gfx::NativeWindow window) {
+  content::RenderWidgetHostViewEfl* showing_view = NULL;
+  scoped_ptr<content::RenderWidgetHostIterator> widgets(
+      content::RenderWidgetHost::GetRenderWidgetHosts());
+  while (content::RenderWidgetHost* widget = widgets->GetNextHost()) {
+    content::RenderWidgetHostViewEfl* view =
+        static_cast<content::RenderWidgetHostViewEfl*>(widget->GetView());
+    if (!view)
+      continue;
+    if (view->GetNativeView() == window)
+      return view;
+    if (!showing_view && view->IsShowing() &&
+        evas_object_evas_get(view->GetNativeView()) ==
+            evas_object_evas_get(window)) {
+      showing_view = view;
+    }
+  }
+  return showing_view;
+}
+
+scoped_refptr<base::RefCountedBytes> EncodeBitmap(const SkBitmap& bitmap) {
+  scoped_refptr<base::RefCountedBytes> png_data(new base::RefCountedBytes);
+  if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &png_data->data()))
+    return NULL;
+  return png_data;
+}
+
+void OnSnapshotCopied(
+    scoped_refptr<base::TaskRunner> background_task_runner,
+    const GrabWindowSnapshotAsyncPNGCallback& callback,
+    bool success,
+    const SkBitmap& bitmap) {
+  if (!success) {
+    callback.Run(scoped_refptr<base::RefCountedBytes>());
+    return;
+  }
+  base::PostTaskAndReplyWithResult(background_task_runner.get(), FROM_HERE,
+                                   base::Bind(EncodeBitmap, bitmap),
+                                   callback);
+}
+
+}  // namespace
+
 bool GrabViewSnapshot(gfx::NativeView view,
                       std::vector<unsigned char>* png_representation,
                       const gfx::Rect& snapshot_bounds) {
@@ -34,7 +90,22 @@ void GrabWindowSnapshotAsync(
   const gfx::Rect& source_rect,
   scoped_refptr<base::TaskRunner> background_task_runner,
   const GrabWindowSnapshotAsyncPNGCallback& callback) {
-  NOTIMPLEMENTED();
+  content::RenderWidgetHostViewEfl* view = FindViewForWindow(window);
+  if (!view) {
+    callback.Run(scoped_refptr<base::RefCountedBytes>());
+    return;
+  }
+
+  // |source_rect| is in DIP, the snapshot is taken at the display's
+  // resolution.
+  float scale = gfx::Screen::GetNativeScreen()->
+      GetPrimaryDisplay().device_scale_factor();
+  gfx::Size output_size =
+      gfx::ToFlooredSize(gfx::ScaleSize(source_rect.size(), scale));
+  view->CopyFromCompositingSurface(
+      source_rect, output_size,
+      base::Bind(&OnSnapshotCopied, background_task_runner, callback),
+      kN32_SkColorType);
 }
 
 void GrabViewSnapshotAsync(
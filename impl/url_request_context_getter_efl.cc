@@ -10,6 +10,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/threading/worker_pool.h"
 #include "base/threading/sequenced_worker_pool.h"
+#include "browser/in_memory_data_efl.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/cookie_store_factory.h"
 #include "content/public/common/content_switches.h"
@@ -67,6 +68,8 @@ URLRequestContextGetterEfl::URLRequestContextGetterEfl(
     net::NetLog* net_log)
     : ignore_certificate_errors_(ignore_certificate_errors),
       base_path_(base_path),
+      // Sized here as it looks at the disk, which the IO thread must not.
+      http_cache_config_(HttpCacheConfigEfl::Create(base_path)),
       io_task_runner_(io_task_runner),
       file_task_runner_(file_task_runner),
       net_log_(net_log),
@@ -96,7 +99,10 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
     if (net_log_) {
       url_request_context_->set_net_log(net_log_);
     }
-    network_delegate_.reset(new net::NetworkDelegateEfl(cookie_manager_));
+    http_cache_stats_.reset(
+        new HttpCacheStatsEfl(http_cache_config_.BackendName()));
+    network_delegate_.reset(new net::NetworkDelegateEfl(
+        cookie_manager_, http_cache_stats_.get()));
 
     url_request_context_->set_network_delegate(network_delegate_.get());
     storage_.reset(
@@ -129,26 +135,11 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
         scoped_ptr<net::HttpServerProperties>(
             new net::HttpServerPropertiesImpl()));
 
-    net::HttpCache::DefaultBackend* main_backend = NULL;
     scoped_refptr<base::MessageLoopProxy> message_loop_proxy =
         BrowserThread::GetMessageLoopProxyForThread(BrowserThread::CACHE);
-    if (base_path_.empty()) {
-      main_backend = new net::HttpCache::DefaultBackend(
-          net::MEMORY_CACHE,
-          net::CACHE_BACKEND_DEFAULT,
-          base::FilePath(),
-          0,
-          message_loop_proxy.get());
-    } else {
-      base::FilePath cache_path = base_path_.Append(FILE_PATH_LITERAL("Cache"));
-
-      main_backend = new net::HttpCache::DefaultBackend(
-          net::DISK_CACHE,
-          net::CACHE_BACKEND_DEFAULT,
-          cache_path,
-          0,
-          message_loop_proxy.get());
-    }
+    net::HttpCache::BackendFactory* main_backend =
+        http_cache_config_.CreateBackendFactory(message_loop_proxy);
+    http_cache_config_.DeleteUnusedCaches(message_loop_proxy);
     net::HttpNetworkSession::Params network_session_params;
     network_session_params.cert_verifier =
         url_request_context_->cert_verifier();
@@ -214,6 +205,9 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
                 GetTaskRunnerWithShutdownBehavior(
                     base::SequencedWorkerPool::SKIP_ON_SHUTDOWN)));
     DCHECK(set_protocol);
+    set_protocol = job_factory->SetProtocolHandler(
+        kInMemoryDataScheme, new InMemoryDataProtocolHandlerEfl);
+    DCHECK(set_protocol);
 
     // Set up interceptors in the reverse order.
     scoped_ptr<net::URLRequestJobFactory> top_job_factory =
@@ -226,6 +220,11 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
           top_job_factory.Pass(), make_scoped_ptr(*i)));
     }
     request_interceptors_.weak_clear();
+    // In-memory data loaded on top of a base URL must never hit the network.
+    top_job_factory.reset(new net::URLRequestInterceptingJobFactory(
+        top_job_factory.Pass(),
+        make_scoped_ptr<net::URLRequestInterceptor>(
+            new InMemoryDataInterceptorEfl)));
 
     storage_->set_job_factory(top_job_factory.release());
   }
@@ -9,6 +9,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/content_browser_client.h"
+#include "http_cache_config_efl.h"
 #include "net/url_request/url_request_context_getter.h"
 
 namespace base {
@@ -65,6 +66,8 @@ class URLRequestContextGetterEfl : public net::URLRequestContextGetter {
 
   bool ignore_certificate_errors_;
   base::FilePath base_path_;
+  HttpCacheConfigEfl http_cache_config_;
+  scoped_ptr<HttpCacheStatsEfl> http_cache_stats_;
   const scoped_refptr<base::SingleThreadTaskRunner>& io_task_runner_;
   const scoped_refptr<base::SingleThreadTaskRunner>& file_task_runner_;
   net::NetLog* net_log_;
@@ -74,6 +77,7 @@ class URLRequestContextGetterEfl : public net::URLRequestContextGetter {
   base::WeakPtr<CookieManager> cookie_manager_;
 
   scoped_ptr<net::ProxyConfigService> proxy_config_service_;
+  // Declared after |http_cache_stats_|, which it reports to.
   scoped_ptr<net::NetworkDelegate> network_delegate_;
   scoped_ptr<net::URLRequestContextStorage> storage_;
   scoped_ptr<net::URLRequestContext> url_request_context_;
@@ -4,6 +4,9 @@
 
 #include "web_contents_delegate_efl.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "API/ewk_console_message_private.h"
 #include "API/ewk_error_private.h"
 #include "API/ewk_certificate_private.h"
@@ -13,21 +16,25 @@
 #include "browser/renderer_host/render_widget_host_view_efl.h"
 #include "browser/inputpicker/color_chooser_efl.h"
 #include "common/render_messages_efl.h"
+#include "common/wrt_message_value_efl.h"
 #include "eweb_view.h"
 #include "eweb_view_callbacks.h"
 
+#include "base/debug/trace_event.h"
 #include "base/strings/utf_string_conversions.h"
 #include "content/common/view_messages.h"
 #include "content/public/browser/invalidate_type.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/favicon_status.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/common/favicon_url.h"
 #include "content/common/date_time_suggestion.h"
 #include "net/base/load_states.h"
 #include "net/http/http_response_headers.h"
-#include "printing/pdf_metafile_skia.h"
+#include "ui/gfx/favicon_size.h"
 #include "url/gurl.h"
+#include "browser/favicon/favicon_downloader.h"
 #include "browser/favicon/favicon_service.h"
 
 #include "tizen_webview/public/tw_web_context.h"
@@ -51,15 +58,34 @@ using namespace ui;
 
 namespace content {
 
-void WritePdfDataToFile(printing::PdfMetafileSkia* metafile, const base::FilePath& filename) {
-  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
-  DCHECK(metafile);
-  base::File file(filename, base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
-  metafile->SaveTo(&file);
-  file.Close();
-  delete metafile;
+namespace {
+
+// Assumed sizes of icons that do not declare theirs.
+const int kAssumedTouchIconSize = 114;
+
+// How far the closest declared size of |favicon| is from |target_size|,
+// relative to it. Icons would rather be scaled down than up.
+float FaviconSizeMismatch(const FaviconURL& favicon, int target_size) {
+  std::vector<gfx::Size> sizes = favicon.icon_sizes;
+  if (sizes.empty()) {
+    int assumed = favicon.icon_type == FaviconURL::FAVICON ?
+        gfx::kFaviconSize : kAssumedTouchIconSize;
+    sizes.push_back(gfx::Size(assumed, assumed));
+  }
+
+  float best = std::numeric_limits<float>::max();
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    int size = std::max(sizes[i].width(), sizes[i].height());
+    float mismatch = size >= target_size ?
+        static_cast<float>(size - target_size) / target_size :
+        2.0f * (target_size - size) / target_size;
+    best = std::min(best, mismatch);
+  }
+  return best;
 }
 
+} // namespace
+
 WebContentsDelegateEfl::WebContentsDelegateEfl(EWebView* view)
     : web_view_(view)
     , is_fullscreen_(false)
@@ -315,19 +341,16 @@ void WebContentsDelegateEfl::DidFinishLoad(RenderFrameHost* render_frame_host,
     FaviconService fs;
     fs.SetFaviconURLForPageURL(favicon.url, validated_url);
 
-    // download favicon if there is no such in database
-    if (!fs.ExistsForFaviconURL(favicon.url)) {
-      LOG(ERROR) << "[DidFinishLoad] :: no favicon in database for URL: "
-                 << favicon.url.spec();
-      favicon_downloader_.reset(
-        new FaviconDownloader(&web_contents_,
-                              favicon.url,
-                              base::Bind(
-                                &WebContentsDelegateEfl::DidDownloadFavicon,
-                                weak_ptr_factory_.GetWeakPtr())));
-      favicon_downloader_->Start();
-    } else {
+    // a stored icon is shown right away, and downloaded again once its
+    // HTTP response is no longer fresh
+    if (fs.ExistsForFaviconURL(favicon.url))
       web_view_->SmartCallback<EWebViewCallbacks::IconReceived>().call();
+    if (!fs.IsFreshForFaviconURL(favicon.url)) {
+      FaviconDownloader::Start(&web_contents_,
+                               favicon.url,
+                               base::Bind(
+                                 &WebContentsDelegateEfl::DidDownloadFavicon,
+                                 weak_ptr_factory_.GetWeakPtr()));
     }
   }
 
@@ -339,26 +362,32 @@ void WebContentsDelegateEfl::DidStartLoading(RenderViewHost* render_view_host) {
 }
 
 void WebContentsDelegateEfl::DidUpdateFaviconURL(const std::vector<FaviconURL>& candidates) {
-  // select and set proper favicon
+  // select and set proper favicon, the one closest to the stored size
+  int target_size = FaviconDownloader::GetTargetSize();
+  const FaviconURL* best = NULL;
+  float best_mismatch = 0;
   for (unsigned int i = 0; i < candidates.size(); ++i) {
-    FaviconURL favicon = candidates[i];
-    if (favicon.icon_type == FaviconURL::FAVICON && !favicon.icon_url.is_empty()) {
-      NavigationEntry *entry = web_contents_.GetController().GetVisibleEntry();
-      if (!entry)
-        return;
-      entry->GetFavicon().url = favicon.icon_url;
-      entry->GetFavicon().valid = true;
-      return;
+    const FaviconURL& favicon = candidates[i];
+    if (favicon.icon_type == FaviconURL::INVALID_ICON || favicon.icon_url.is_empty())
+      continue;
+    float mismatch = FaviconSizeMismatch(favicon, target_size);
+    if (!best || mismatch < best_mismatch) {
+      best = &favicon;
+      best_mismatch = mismatch;
     }
   }
-  return;
+  if (!best)
+    return;
+
+  NavigationEntry *entry = web_contents_.GetController().GetVisibleEntry();
+  if (!entry)
+    return;
+  entry->GetFavicon().url = best->icon_url;
+  entry->GetFavicon().valid = true;
 }
 
-void WebContentsDelegateEfl::DidDownloadFavicon(bool success, const GURL& icon_url, const SkBitmap& bitmap) {
-  favicon_downloader_.reset();
+void WebContentsDelegateEfl::DidDownloadFavicon(bool success, const GURL& icon_url) {
   if (success) {
-    FaviconService fs;
-    fs.SetBitmapForFaviconURL(bitmap, icon_url);
     // emit "icon,received"
     web_view_->SmartCallback<EWebViewCallbacks::IconReceived>().call();
   }
@@ -468,10 +497,13 @@ bool WebContentsDelegateEfl::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(WebContentsDelegateEfl, message)
     IPC_MESSAGE_HANDLER_DELAY_REPLY(EwkHostMsg_GetContentSecurityPolicy, OnGetContentSecurityPolicy)
-    IPC_MESSAGE_HANDLER(EwkHostMsg_DidPrintPagesToPdf, OnPrintedMetafileReceived)
+    IPC_MESSAGE_FORWARD(EwkHostMsg_PdfExportProgress, web_view_, EWebView::OnPdfExportProgress)
+    IPC_MESSAGE_FORWARD(EwkHostMsg_PdfExportFinished, web_view_, EWebView::OnPdfExportFinished)
+    IPC_MESSAGE_FORWARD(EwkHostMsg_ImageContents, web_view_, EWebView::OnImageContentsReceived)
     IPC_MESSAGE_HANDLER(EwkHostMsg_WrtMessage, OnWrtPluginMessage)
     IPC_MESSAGE_HANDLER(EwkHostMsg_FormSubmit, OnFormSubmit)
     IPC_MESSAGE_HANDLER_DELAY_REPLY(EwkHostMsg_WrtSyncMessage, OnWrtPluginSyncMessage)
+    IPC_MESSAGE_HANDLER(EwkHostMsg_WrtAsyncMessage, OnWrtPluginAsyncMessage)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -501,7 +533,38 @@ void WebContentsDelegateEfl::OnWrtPluginSyncMessage(const tizen_webview::WrtIpcM
   Send(reply);
 }
 
+void WebContentsDelegateEfl::OnWrtPluginAsyncMessage(int request_id,
+                                                     const tizen_webview::WrtIpcMessageData& data,
+                                                     const WrtMessageValueEfl& value) {
+  TRACE_EVENT1("wrt", "WebContentsDelegateEfl::OnWrtPluginAsyncMessage",
+               "type", TRACE_STR_COPY(data.type.c_str()));
+  scoped_ptr<tizen_webview::WrtIpcMessageData> p(new tizen_webview::WrtIpcMessageData);
+  p->type = data.type;
+  p->id = data.id;
+  p->reference_id = data.reference_id;
+  bool success = value.Read(&p->value);
+  if (success)
+    web_view_->SmartCallback<EWebViewCallbacks::WrtPluginsMessage>().call(p.get());
+  else
+    LOG(ERROR) << "Dropped the WRT message " << data.type << " with an unreadable value";
+
+  // Always answers, the renderer holds the request until then.
+  WrtMessageValueEfl reply;
+  base::SharedMemory memory;
+  if (!WrtMessageValueEfl::ShouldShare(p->value.size()) ||
+      !memory.CreateAndMapAnonymous(p->value.size()) ||
+      !reply.SetShared(p->value, &memory,
+                       web_contents_.GetRenderProcessHost()->GetHandle())) {
+    reply.SetInline(p->value);
+  }
+  Send(new EwkViewMsg_WrtAsyncMessageReply(routing_id(), request_id, success,
+                                           reply));
+}
+
 void WebContentsDelegateEfl::DidFirstVisuallyNonEmptyPaint() {
+  TRACE_EVENT_INSTANT0("startup",
+                       "WebContentsDelegateEfl::DidFirstVisuallyNonEmptyPaint",
+                       TRACE_EVENT_SCOPE_THREAD);
   web_view_->SmartCallback<EWebViewCallbacks::LoadNonEmptyLayoutFinished>().call();
   web_view_->SmartCallback<EWebViewCallbacks::FrameRendered>().call(0);
 }
@@ -518,21 +581,6 @@ void WebContentsDelegateEfl::OnGetContentSecurityPolicy(IPC::Message* reply_msg)
   Send(reply_msg);
 }
 
-void WebContentsDelegateEfl::OnPrintedMetafileReceived(const DidPrintPagesParams& params) {
-  base::SharedMemory shared_buf(params.metafile_data_handle, true);
-  if (!shared_buf.Map(params.data_size)) {
-     NOTREACHED() << "couldn't map";
-     return;
-  }
-  scoped_ptr<printing::PdfMetafileSkia> metafile(new printing::PdfMetafileSkia);
-  if (!metafile->InitFromData(shared_buf.memory(), params.data_size)) {
-    NOTREACHED() << "Invalid metafile header";
-    return;
-  }
-  BrowserThread::PostTask(BrowserThread::FILE, FROM_HERE,
-        base::Bind(&WritePdfDataToFile, metafile.release(), params.filename));
-}
-
 void WebContentsDelegateEfl::NavigationEntryCommitted(const LoadCommittedDetails& load_details) {
   int forward_backward_list_count = web_contents_.GetController().GetEntryCount();
   if (forward_backward_list_count != forward_backward_list_count_) {
@@ -550,6 +598,11 @@ void WebContentsDelegateEfl::RenderProcessGone(base::TerminationStatus status) {
   }
 }
 
+void WebContentsDelegateEfl::RenderViewCreated(
+    RenderViewHost* render_view_host) {
+  web_view_->RenderViewCreated(render_view_host);
+}
+
 bool WebContentsDelegateEfl::AddMessageToConsole(WebContents* source,
                                               int32 level,
                                               const string16& message,
@@ -25,7 +25,7 @@
 
 #include "tizen_webview/public/tw_content_security_policy.h"
 
-class DidPrintPagesParams;
+struct WrtMessageValueEfl;
 
 namespace tizen_webview {
 class WrtIpcMessageData;
@@ -128,7 +128,7 @@ class WebContentsDelegateEfl
 
   virtual void DidStartLoading(RenderViewHost* render_view_host) override;
   virtual void DidUpdateFaviconURL(const std::vector<FaviconURL>& candidates) override;
-  virtual void DidDownloadFavicon(bool success, const GURL& icon_url, const SkBitmap& bitmap);
+  virtual void DidDownloadFavicon(bool success, const GURL& icon_url);
 
   void OnFormSubmit(const GURL&);
   void OnUpdateSettings(const Ewk_Settings *settings);
@@ -152,9 +152,9 @@ class WebContentsDelegateEfl
   void DidFirstVisuallyNonEmptyPaint() override;
 
   bool OnMessageReceived(const IPC::Message& message) override;
-  void OnPrintedMetafileReceived(const DidPrintPagesParams& params);
   virtual void NavigationEntryCommitted(const LoadCommittedDetails& load_details) override;
   virtual void RenderProcessGone(base::TerminationStatus status) override;
+  virtual void RenderViewCreated(RenderViewHost* render_view_host) override;
   virtual bool AddMessageToConsole(WebContents* source,
                                    int32 level,
                                    const base::string16& message,
@@ -174,6 +174,9 @@ class WebContentsDelegateEfl
   void OnWrtPluginMessage(const tizen_webview::WrtIpcMessageData& data);
   void OnWrtPluginSyncMessage(const tizen_webview::WrtIpcMessageData& data,
                               IPC::Message* reply);
+  void OnWrtPluginAsyncMessage(int request_id,
+                               const tizen_webview::WrtIpcMessageData& data,
+                               const WrtMessageValueEfl& value);
 
   EWebView* web_view_;
   bool is_fullscreen_;
@@ -207,7 +210,6 @@ class WebContentsDelegateEfl
   bool should_open_new_window_;
   JavaScriptDialogManagerEfl* dialog_manager_;
   int forward_backward_list_count_;
-  scoped_ptr<FaviconDownloader> favicon_downloader_;
   base::WeakPtrFactory<WebContentsDelegateEfl> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(WebContentsDelegateEfl);
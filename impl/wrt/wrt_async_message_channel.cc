@@ -0,0 +1,145 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "wrt/wrt_async_message_channel.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
+#include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
+#include "base/process/process_handle.h"
+#include "content/public/renderer/render_thread.h"
+#include "content/public/renderer/render_view.h"
+
+#include "common/render_messages_efl.h"
+#include "common/wrt_message_value_efl.h"
+
+namespace {
+
+base::LazyInstance<WrtAsyncMessageChannel>::Leaky g_channel =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Moves |value| to shared memory when it is big enough, inline otherwise.
+void PackValue(const std::string& value, WrtMessageValueEfl* packed) {
+  if (WrtMessageValueEfl::ShouldShare(value.size())) {
+    scoped_ptr<base::SharedMemory> memory(
+        content::RenderThread::Get()->HostAllocateSharedMemoryBuffer(
+            value.size()));
+    if (memory && memory->Map(value.size()) &&
+        packed->SetShared(value, memory.get(),
+                          base::GetCurrentProcessHandle())) {
+      return;
+    }
+    LOG(WARNING) << "Sending a WRT message value of " << value.size()
+                 << " bytes inline, it cannot be shared";
+  }
+  packed->SetInline(value);
+}
+
+} // namespace
+
+WrtAsyncMessageChannel::WrtAsyncMessageChannel()
+    : next_request_id_(1) {
+}
+
+WrtAsyncMessageChannel::~WrtAsyncMessageChannel() {
+}
+
+// static
+WrtAsyncMessageChannel* WrtAsyncMessageChannel::GetInstance() {
+  return g_channel.Pointer();
+}
+
+int WrtAsyncMessageChannel::Send(int routing_id,
+                                 const tizen_webview::WrtIpcMessageData& data,
+                                 const ReplyCallback& callback) {
+  content::RenderView* render_view =
+      content::RenderView::FromRoutingID(routing_id);
+  if (!render_view)
+    return 0;
+
+  WrtMessageValueEfl value;
+  PackValue(data.value, &value);
+
+  Request request;
+  request.routing_id = routing_id;
+  request.data.type = data.type;
+  request.data.id = data.id;
+  request.data.reference_id = data.reference_id;
+  request.callback = callback;
+  request.start_time = base::TimeTicks::Now();
+
+  int request_id = next_request_id_++;
+  if (!render_view->Send(new EwkHostMsg_WrtAsyncMessage(routing_id, request_id,
+                                                         request.data,
+                                                         value))) {
+    return 0;
+  }
+  requests_[request_id] = request;
+  return request_id;
+}
+
+void WrtAsyncMessageChannel::OnReply(int request_id,
+                                     bool success,
+                                     const WrtMessageValueEfl& value) {
+  std::string reply;
+  success = value.Read(&reply) && success;
+  Complete(request_id, success, reply);
+}
+
+void WrtAsyncMessageChannel::CancelRequests(int routing_id) {
+  std::vector<int> request_ids;
+  for (RequestMap::const_iterator it = requests_.begin();
+       it != requests_.end(); ++it) {
+    if (it->second.routing_id == routing_id)
+      request_ids.push_back(it->first);
+  }
+
+  // The view is being destroyed, callbacks must not run from within it.
+  for (size_t i = 0; i < request_ids.size(); ++i) {
+    base::MessageLoop::current()->PostTask(FROM_HERE,
+        base::Bind(&WrtAsyncMessageChannel::Complete, base::Unretained(this),
+                   request_ids[i], false, std::string()));
+  }
+}
+
+WrtAsyncMessageChannel::LatencyStats
+WrtAsyncMessageChannel::GetLatencyStats(const std::string& type) const {
+  std::map<std::string, LatencyStats>::const_iterator it =
+      latency_stats_.find(type);
+  return it != latency_stats_.end() ? it->second : LatencyStats();
+}
+
+void WrtAsyncMessageChannel::Complete(int request_id,
+                                      bool success,
+                                      const std::string& value) {
+  RequestMap::iterator it = requests_.find(request_id);
+  if (it == requests_.end())
+    return;
+
+  Request request = it->second;
+  requests_.erase(it);
+
+  if (success) {
+    base::TimeDelta latency = base::TimeTicks::Now() - request.start_time;
+    LatencyStats& stats = latency_stats_[request.data.type];
+    stats.count++;
+    stats.total += latency;
+    stats.max = std::max(stats.max, latency);
+    UMA_HISTOGRAM_TIMES("EWK.WrtAsyncMessage.Latency", latency);
+    VLOG(1) << "WRT message " << request.data.type << " answered in "
+            << latency.InMillisecondsF() << " ms, average "
+            << (stats.total / stats.count).InMillisecondsF() << " ms over "
+            << stats.count << " requests, maximum "
+            << stats.max.InMillisecondsF() << " ms";
+  }
+
+  request.data.value = value;
+  request.callback.Run(success, request.data);
+}
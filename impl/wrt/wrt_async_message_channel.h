@@ -0,0 +1,89 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef WRT_ASYNC_MESSAGE_CHANNEL_H
+#define WRT_ASYNC_MESSAGE_CHANNEL_H
+
+#include <map>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/lazy_instance.h"
+#include "base/time/time.h"
+#include "tizen_webview/public/tw_wrt.h"
+
+struct WrtMessageValueEfl;
+
+// Requests of WRT plugins to the browser that do not block the renderer
+// main thread, unlike EwkHostMsg_WrtSyncMessage.
+//
+// Every request gets an id that its EwkViewMsg_WrtAsyncMessageReply
+// carries back, and completes exactly once: with the reply, or with a
+// failure if its view goes away first.
+//
+// Keeps the round trip latency per message type, logged with VLOG(1) and
+// recorded to the EWK.WrtAsyncMessage.Latency histogram.
+//
+// Lives on the renderer main thread.
+class WrtAsyncMessageChannel {
+ public:
+  struct LatencyStats {
+    LatencyStats() : count(0) {}
+
+    int count;
+    base::TimeDelta total;
+    base::TimeDelta max;
+  };
+
+  // Runs with the request data, its value replaced by the one of the
+  // reply.
+  typedef base::Callback<void(bool success,
+                              const tizen_webview::WrtIpcMessageData& reply)>
+      ReplyCallback;
+
+  static WrtAsyncMessageChannel* GetInstance();
+
+  // Sends |data| from the view |routing_id|. Returns the id of the request,
+  // or 0 if it could not be sent, in which case |callback| never runs.
+  int Send(int routing_id,
+           const tizen_webview::WrtIpcMessageData& data,
+           const ReplyCallback& callback);
+
+  // Completes |request_id| with the reply value from the browser, as a
+  // failure if the browser could not handle the request.
+  void OnReply(int request_id, bool success, const WrtMessageValueEfl& value);
+
+  // Fails the requests of the view |routing_id|, which is closing.
+  void CancelRequests(int routing_id);
+
+  // Latency of the requests of |type| that completed so far.
+  LatencyStats GetLatencyStats(const std::string& type) const;
+
+ private:
+  struct Request {
+    Request() : routing_id(0) {}
+
+    int routing_id;
+    tizen_webview::WrtIpcMessageData data;
+    ReplyCallback callback;
+    base::TimeTicks start_time;
+  };
+  typedef std::map<int, Request> RequestMap;
+
+  WrtAsyncMessageChannel();
+  ~WrtAsyncMessageChannel();
+
+  // Removes |request_id| and runs its callback.
+  void Complete(int request_id, bool success, const std::string& value);
+
+  RequestMap requests_;
+  int next_request_id_;
+  std::map<std::string, LatencyStats> latency_stats_;
+
+  friend struct base::DefaultLazyInstanceTraits<WrtAsyncMessageChannel>;
+  DISALLOW_COPY_AND_ASSIGN(WrtAsyncMessageChannel);
+};
+
+#endif // WRT_ASYNC_MESSAGE_CHANNEL_H
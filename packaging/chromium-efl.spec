@@ -231,7 +231,7 @@ build/prebuild/ninja %{_smp_mflags} -C"%{OUTPUT_FOLDER}" \
   content_shell_efl \
 %endif
 %if 0%{?build_ewk_unittests}
-  ewk_unittests \
+  ewk_unittests ewk_perftests \
 %endif
   chromium-efl efl_webprocess chromium-ewk efl_webview_app mini_browser
 
@@ -317,7 +317,9 @@ mkdir -p %{buildroot}/opt/usr/resources/
 mkdir -p %{buildroot}/opt/usr/utc_exec/
 cp -r ewk/unittest/resources/* %{buildroot}/opt/usr/resources/
 install -m 0644 "%{OUTPUT_FOLDER}"/ewk_unittests %{buildroot}/opt/usr/utc_exec/
+install -m 0755 "%{OUTPUT_FOLDER}"/ewk_perftests %{buildroot}/opt/usr/utc_exec/
 install -m 0755 ewk/utc_gtest_run.sh %{buildroot}/opt/usr/utc_exec/
+install -m 0755 ewk/perf_run.sh %{buildroot}/opt/usr/utc_exec/
 %endif
 
 